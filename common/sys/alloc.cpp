@@ -275,6 +275,36 @@ namespace embree
   void os_advise(void *ptr, size_t bytes)
   {
   }
+
+  void os_bind_numa_node(void* ptr, size_t bytes, unsigned int node)
+  {
+  }
+
+  void* os_map_file(const char* fileName, size_t offset, size_t bytes)
+  {
+    HANDLE file = CreateFileA(fileName,GENERIC_READ,FILE_SHARE_READ,nullptr,OPEN_EXISTING,FILE_ATTRIBUTE_NORMAL,nullptr);
+    if (file == INVALID_HANDLE_VALUE)
+      return nullptr;
+
+    /* the mapping object stays alive as long as some view references it */
+    HANDLE mapping = CreateFileMappingA(file,nullptr,PAGE_WRITECOPY,0,0,nullptr);
+    CloseHandle(file);
+    if (mapping == nullptr)
+      return nullptr;
+
+    void* ptr = MapViewOfFile(mapping,FILE_MAP_COPY,DWORD(uint64_t(offset) >> 32),DWORD(uint64_t(offset) & 0xFFFFFFFF),bytes);
+    CloseHandle(mapping);
+    return ptr;
+  }
+
+  void os_unmap_file(void* ptr, size_t bytes)
+  {
+    if (ptr == nullptr)
+      return;
+
+    if (!UnmapViewOfFile(ptr))
+      throw std::bad_alloc();
+  }
 }
 
 #endif
@@ -286,11 +316,17 @@ namespace embree
 #if defined(__UNIX__)
 
 #include <sys/mman.h>
+#include <fcntl.h>
+#include <unistd.h>
 #include <errno.h>
 #include <stdlib.h>
 #include <string.h>
 #include <sstream>
 
+#if defined(__LINUX__)
+#include <sys/syscall.h>
+#endif
+
 #if defined(__MACOSX__)
 #include <mach/vm_statistics.h>
 #endif
@@ -414,6 +450,46 @@ namespace embree
     madvise(pptr,bytes,MADV_HUGEPAGE); 
 #endif
   }
+
+  /* sets the preferred NUMA node for pages that get touched the first time */
+  void os_bind_numa_node(void* pptr, size_t bytes, unsigned int node)
+  {
+#if defined(__LINUX__) && defined(SYS_mbind)
+    /* only bind the pages fully contained in the range */
+    const size_t begin = ((size_t)pptr+PAGE_SIZE_4K-1) & ~(PAGE_SIZE_4K-1);
+    const size_t end   = ((size_t)pptr+bytes) & ~(PAGE_SIZE_4K-1);
+    if (end <= begin || node >= 8*sizeof(unsigned long))
+      return;
+
+    const int MPOL_PREFERRED_ = 1;
+    unsigned long nodeMask = 1ul << node;
+    syscall(SYS_mbind,(void*)begin,end-begin,MPOL_PREFERRED_,&nodeMask,8*sizeof(nodeMask),0); // may fail, only a hint
+#endif
+  }
+
+  void* os_map_file(const char* fileName, size_t offset, size_t bytes)
+  {
+    int fd = open(fileName,O_RDONLY);
+    if (fd == -1)
+      return nullptr;
+
+    /* private mapping, thus pages are shared through the page cache until they get written */
+    void* ptr = mmap(nullptr,bytes,PROT_READ | PROT_WRITE,MAP_PRIVATE,fd,(off_t)offset);
+    close(fd);
+    if (ptr == MAP_FAILED)
+      return nullptr;
+
+    return ptr;
+  }
+
+  void os_unmap_file(void* ptr, size_t bytes)
+  {
+    if (ptr == nullptr)
+      return;
+
+    if (munmap(ptr,bytes) == -1)
+      throw std::bad_alloc();
+  }
 }
 
 #endif
@@ -113,6 +113,14 @@ namespace embree
   void  os_free   (void* ptr, size_t bytes, bool hugepages);
   void  os_advise (void* ptr, size_t bytes);
 
+  /*! hint to place pages of the range that are not yet touched on the specified NUMA node */
+  void  os_bind_numa_node (void* ptr, size_t bytes, unsigned int node);
+
+  /*! maps some file range copy-on-write into memory, offset has to be a multiple of os_map_file_alignment */
+  static const size_t os_map_file_alignment = 64*1024;
+  void* os_map_file  (const char* fileName, size_t offset, size_t bytes);
+  void  os_unmap_file(void* ptr, size_t bytes);
+
   /*! allocator that performs OS allocations */
   template<typename T>
     struct os_allocator
@@ -443,6 +443,8 @@ namespace embree
     if (hasISA(features,NEON_2X)) v += "2xNEON ";
     return v;
   }
+
+  __thread int thread_numa_node = -1;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -493,6 +495,22 @@ namespace embree
     return nThreads;
   }
 
+  unsigned int getNumberOfNUMANodes()
+  {
+    ULONG highestNode = 0;
+    if (!GetNumaHighestNodeNumber(&highestNode)) return 1;
+    return (unsigned int) highestNode+1;
+  }
+
+  unsigned int getCurrentNUMANode()
+  {
+    PROCESSOR_NUMBER processor;
+    GetCurrentProcessorNumberEx(&processor);
+    USHORT node = 0;
+    if (!GetNumaProcessorNodeEx(&processor,&node)) return 0;
+    return (unsigned int) node;
+  }
+
   int getTerminalWidth() 
   {
     HANDLE handle = GetStdHandle(STD_OUTPUT_HANDLE);
@@ -539,6 +557,7 @@ namespace embree
 
 #include <stdio.h>
 #include <unistd.h>
+#include <sys/syscall.h>
 
 namespace embree
 {
@@ -567,6 +586,38 @@ namespace embree
     buffer >> virt >> resident >> shared;
     return resident*sysconf(_SC_PAGE_SIZE);
   }
+
+  unsigned int getNumberOfNUMANodes()
+  {
+    static int nNodes = -1;
+    if (nNodes != -1) return nNodes;
+
+    /* the online node list has the form 0-1,4 */
+    nNodes = 1;
+    std::ifstream buffer("/sys/devices/system/node/online");
+    std::string list; buffer >> list;
+    for (size_t i=0; i<list.size(); )
+    {
+      size_t end = i;
+      while (end < list.size() && list[end] >= '0' && list[end] <= '9') end++;
+      if (end > i) {
+        const int node = atoi(list.substr(i,end-i).c_str());
+        if (node+1 > nNodes) nNodes = node+1;
+      }
+      i = end+1;
+    }
+    return nNodes;
+  }
+
+  unsigned int getCurrentNUMANode()
+  {
+#if defined(SYS_getcpu)
+    unsigned int cpu = 0, node = 0;
+    if (syscall(SYS_getcpu,&cpu,&node,nullptr) == 0)
+      return node;
+#endif
+    return 0;
+  }
 }
 
 #endif
@@ -599,6 +650,14 @@ namespace embree
   size_t getResidentMemoryBytes() {
     return 0;
   }
+
+  unsigned int getNumberOfNUMANodes() {
+    return 1;
+  }
+
+  unsigned int getCurrentNUMANode() {
+    return 0;
+  }
 }
 
 #endif
@@ -629,6 +688,14 @@ namespace embree
   size_t getResidentMemoryBytes() {
     return 0;
   }
+
+  unsigned int getNumberOfNUMANodes() {
+    return 1;
+  }
+
+  unsigned int getCurrentNUMANode() {
+    return 0;
+  }
 }
 
 #endif
@@ -170,6 +170,21 @@ namespace embree
   /*! return the number of logical threads of the system */
   unsigned int getNumberOfLogicalThreads();
 
+  /*! returns the number of NUMA nodes of the system */
+  unsigned int getNumberOfNUMANodes();
+
+  /*! returns the NUMA node the calling thread currently runs on */
+  unsigned int getCurrentNUMANode();
+
+  /*! NUMA node of the calling thread, queried once per thread as worker threads are pinned */
+  extern __thread int thread_numa_node;
+  __forceinline unsigned int getThreadNUMANode()
+  {
+    if (unlikely(thread_numa_node < 0))
+      thread_numa_node = (int) getCurrentNUMANode();
+    return (unsigned int) thread_numa_node;
+  }
+
   /*! returns the size of the terminal window in characters */
   int getTerminalWidth();
 
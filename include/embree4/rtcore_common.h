@@ -303,6 +303,7 @@ enum RTCRayQueryFlags
   /* embree specific flags */
   RTC_RAY_QUERY_FLAG_INCOHERENT = (0 << 16), // optimize for incoherent rays
   RTC_RAY_QUERY_FLAG_COHERENT   = (1 << 16), // optimize for coherent rays
+  RTC_RAY_QUERY_FLAG_TREELETS   = (1 << 17), // trace ray streams breadth first through cache sized BVH treelets
 };
 
 /* Arguments for RTCFilterFunctionN */
@@ -389,6 +390,16 @@ struct RTC_ALIGN(64) RTCPointQuery16
   float radius[16];           // radius of the point query
 };
 
+/* Batch of N query points stored as structure of pointers */
+struct RTCPointQueryNp
+{
+  const float* x;             // x coordinates of the query points
+  const float* y;             // y coordinates of the query points
+  const float* z;             // z coordinates of the query points
+  const float* time;          // time of the point queries (optional)
+  float* radius;              // radius of the point queries
+};
+
 struct RTCPointQueryN;
 
 struct RTC_ALIGN(16) RTCPointQueryContext
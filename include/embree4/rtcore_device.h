@@ -65,7 +65,9 @@ enum RTCDeviceProperty
 
   RTC_DEVICE_PROPERTY_TASKING_SYSTEM        = 128,
   RTC_DEVICE_PROPERTY_JOIN_COMMIT_SUPPORTED = 129,
-  RTC_DEVICE_PROPERTY_PARALLEL_COMMIT_SUPPORTED = 130
+  RTC_DEVICE_PROPERTY_PARALLEL_COMMIT_SUPPORTED = 130,
+
+  RTC_DEVICE_PROPERTY_TESSELLATION_CACHE_SIZE = 160
 };
 
 /* Gets a device property. */
@@ -73,6 +75,21 @@ RTC_API ssize_t rtcGetDeviceProperty(RTCDevice device, enum RTCDeviceProperty pr
 
 /* Sets a device property. */
 RTC_API void rtcSetDeviceProperty(RTCDevice device, const enum RTCDeviceProperty prop, ssize_t value);
+
+/* Statistics of the tessellation cache of a device */
+struct RTCTessellationCacheStatistics
+{
+  size_t size;     // size of the cache in bytes
+  size_t hits;     // number of lookups that found a valid cache entry
+  size_t misses;   // number of lookups that had to construct the cache entry
+  size_t flushes;  // number of evicted cache segments
+};
+
+/* Returns the statistics of the tessellation cache of the device. */
+RTC_API void rtcGetDeviceTessellationCacheStatistics(RTCDevice device, struct RTCTessellationCacheStatistics* stats);
+
+/* Resets the statistics of the tessellation cache of the device. */
+RTC_API void rtcResetDeviceTessellationCacheStatistics(RTCDevice device);
   
 /* Error codes */
 enum RTCError
@@ -101,4 +118,13 @@ typedef bool (*RTCMemoryMonitorFunction)(void* ptr, ssize_t bytes, bool post);
 /* Sets the memory monitor callback function. */
 RTC_API void rtcSetDeviceMemoryMonitorFunction(RTCDevice device, RTCMemoryMonitorFunction memoryMonitor, void* userPtr);
 
+/* Memory allocation callback function */
+typedef void* (*RTCAllocFunction)(void* userPtr, size_t bytes, size_t align);
+
+/* Memory deallocation callback function */
+typedef void (*RTCFreeFunction)(void* userPtr, void* ptr);
+
+/* Sets the callback functions used to allocate and free device memory. */
+RTC_API void rtcSetDeviceAllocator(RTCDevice device, RTCAllocFunction alloc, RTCFreeFunction free, void* userPtr);
+
 RTC_NAMESPACE_END
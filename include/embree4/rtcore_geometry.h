@@ -232,6 +232,9 @@ RTC_API void rtcGetGeometryTransform(RTCGeometry geometry, float time, enum RTCF
 /* Sets the uniform tessellation rate of the geometry. */
 RTC_API void rtcSetGeometryTessellationRate(RTCGeometry geometry, float tessellationRate);
 
+/* Sets the camera used to reduce the tessellation rate of the geometry to the ray footprint. */
+RTC_API void rtcSetGeometryTessellationCamera(RTCGeometry geometry, const float* position, float spreadAngle);
+
 /* Sets the number of topologies of a subdivision surface. */
 RTC_API void rtcSetGeometryTopologyCount(RTCGeometry geometry, unsigned int topologyCount);
 
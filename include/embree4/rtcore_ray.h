@@ -48,6 +48,13 @@ struct RTCRayHit
   struct RTCHit hit;
 };
 
+/* Hit structure of a multi-hit query for a single ray */
+struct RTCMultiHit
+{
+  struct RTCHit hit;
+  float tfar;          // distance of the hit
+};
+
 /* Ray structure for a packet of 4 rays */
 struct RTC_ALIGN(16) RTCRay4
 {
@@ -171,6 +178,47 @@ struct RTCRayHit16
   struct RTCHit16 hit;
 };
 
+/* Ray structure for a stream of N rays in SOA layout */
+struct RTCRayNp
+{
+  float* org_x;
+  float* org_y;
+  float* org_z;
+  float* tnear;
+
+  float* dir_x;
+  float* dir_y;
+  float* dir_z;
+  float* time;
+
+  float* tfar;
+  unsigned int* mask;
+  unsigned int* id;
+  unsigned int* flags;
+};
+
+/* Hit structure for a stream of N rays in SOA layout */
+struct RTCHitNp
+{
+  float* Ng_x;
+  float* Ng_y;
+  float* Ng_z;
+
+  float* u;
+  float* v;
+
+  unsigned int* primID;
+  unsigned int* geomID;
+  unsigned int* instID[RTC_MAX_INSTANCE_LEVEL_COUNT];
+};
+
+/* Combined ray/hit structure for a stream of N rays in SOA layout */
+struct RTCRayHitNp
+{
+  struct RTCRayNp ray;
+  struct RTCHitNp hit;
+};
+
 struct RTCRayN;
 struct RTCHitN;
 struct RTCRayHitN;
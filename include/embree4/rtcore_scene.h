@@ -20,7 +20,8 @@ enum RTCSceneFlags
   RTC_SCENE_FLAG_DYNAMIC                 = (1 << 0),
   RTC_SCENE_FLAG_COMPACT                 = (1 << 1),
   RTC_SCENE_FLAG_ROBUST                  = (1 << 2),
-  RTC_SCENE_FLAG_FILTER_FUNCTION_IN_ARGUMENTS = (1 << 3)
+  RTC_SCENE_FLAG_FILTER_FUNCTION_IN_ARGUMENTS = (1 << 3),
+  RTC_SCENE_FLAG_PERSISTENT_BUILD_MEMORY = (1 << 4)
 };
 
 /* Additional arguments for rtcIntersect1/4/8/16 calls */
@@ -117,6 +118,12 @@ RTC_API void rtcCommitScene(RTCScene scene);
 /* Commits the scene from multiple threads. */
 RTC_API void rtcJoinCommitScene(RTCScene scene);
 
+/* Writes the acceleration structures of a committed scene to a file. */
+RTC_API void rtcSaveScene(RTCScene scene, const char* filename);
+
+/* Commits the scene by mapping acceleration structures from a file written by rtcSaveScene. */
+RTC_API void rtcLoadScene(RTCScene scene, const char* filename);
+
 
 /* Progress monitor callback function */
 typedef bool (*RTCProgressMonitorFunction)(void* ptr, double n);
@@ -140,6 +147,87 @@ RTC_API void rtcGetSceneBounds(RTCScene scene, struct RTCBounds* bounds_o);
 RTC_API void rtcGetSceneLinearBounds(RTCScene scene, struct RTCLinearBounds* bounds_o);
 
 
+/* Traversal statistics of the sampled queries of one query type */
+struct RTCTraversalStatistics
+{
+  size_t queries;     // number of sampled rays or point queries
+  size_t nodes;       // number of traversed inner nodes
+  size_t leaves;      // number of traversed leaf nodes
+  size_t primitives;  // number of primitive intersection tests
+  size_t filters;     // number of filter function invocations
+  size_t instances;   // number of instance transitions
+  size_t earlyOuts;   // number of traversals terminated early by an occluder
+};
+
+/* Traversal statistics of the sampled queries of a scene */
+struct RTCSceneStatistics
+{
+  struct RTCTraversalStatistics intersect;   // rtcIntersect queries
+  struct RTCTraversalStatistics occluded;    // rtcOccluded queries
+  struct RTCTraversalStatistics pointQuery;  // rtcPointQuery queries
+};
+
+/* Returns the traversal statistics gathered for the scene. */
+RTC_API void rtcGetSceneStatistics(RTCScene scene, struct RTCSceneStatistics* stats);
+
+/* Resets the traversal statistics gathered for the scene. */
+RTC_API void rtcResetSceneStatistics(RTCScene scene);
+
+
+/* Quality metrics of the nodes of one type of a BVH */
+struct RTCBVHNodeStatistics
+{
+  size_t numNodes;   // number of nodes
+  size_t bytes;      // memory consumed by the nodes
+  float sah;         // contribution of the nodes to the SAH cost
+  float fillRate;    // fraction of used child or primitive slots
+};
+
+/* Quality metrics of a BVH of a scene */
+struct RTCBVHStatistics
+{
+  unsigned int branchingFactor;  // number of children of inner nodes
+  const char* primitiveType;     // name of the primitive type stored in the leaves
+  size_t numPrimitives;          // number of primitives
+  size_t depth;                  // maximal depth of the BVH
+  size_t bytes;                  // memory consumed by nodes and leaves
+  float sah;                     // SAH cost of the BVH
+  float fillRate;                // fraction of used child and primitive slots
+  float leafOverlap;             // expected number of additionally entered leaves due to overlapping sibling leaves
+  float traversalCost;           // expected number of traversed inner nodes and primitive tests of a random ray
+  struct RTCBVHNodeStatistics aabbNodes;
+  struct RTCBVHNodeStatistics obbNodes;
+  struct RTCBVHNodeStatistics aabbNodesMB;
+  struct RTCBVHNodeStatistics aabbNodesMB4D;
+  struct RTCBVHNodeStatistics obbNodesMB;
+  struct RTCBVHNodeStatistics quantizedNodes;
+  struct RTCBVHNodeStatistics compressedNodes;
+  struct RTCBVHNodeStatistics leaves;
+};
+
+/* Returns the quality metrics of the BVHs of a committed scene. */
+RTC_API unsigned int rtcGetSceneBVHStatistics(RTCScene scene, struct RTCBVHStatistics* stats, unsigned int maxCount);
+
+/* Time in seconds spent in the build phases of a BVH of a scene */
+struct RTCBuildStatistics
+{
+  const char* builder;           // name of the builder
+  const char* primitiveType;     // name of the primitive type stored in the leaves
+  size_t numPrimitives;          // number of primitives
+  double total;                  // wall clock time of the build
+  double primRefs;               // generation of primitive references
+  double presplits;              // splitting of primitives before the build
+  double binning;                // binning to find the best split
+  double partitioning;           // partitioning of primitives
+  double leaves;                 // creation of leaves
+  double allocator;              // allocation of memory blocks
+  double topLevel;               // build of the top level BVH of a two level build
+};
+
+/* Returns the build phase timings of the last commit of a scene. */
+RTC_API unsigned int rtcGetSceneBuildStatistics(RTCScene scene, struct RTCBuildStatistics* stats, unsigned int maxCount);
+
+
 /* Perform a closest point query of the scene. */
 RTC_API bool rtcPointQuery(RTCScene scene, struct RTCPointQuery* query, struct RTCPointQueryContext* context, RTCPointQueryFunction queryFunc, void* userPtr);
 
@@ -152,6 +240,9 @@ RTC_API bool rtcPointQuery8(const int* valid, RTCScene scene, struct RTCPointQue
 /* Perform a closest point query with a packet of 4 points with the scene. */
 RTC_API bool rtcPointQuery16(const int* valid, RTCScene scene, struct RTCPointQuery16* query, struct RTCPointQueryContext* context, RTCPointQueryFunction queryFunc, void** userPtr);
 
+/* Perform closest point queries for a batch of N points with the scene. */
+RTC_API bool rtcPointQueryBatch(RTCScene scene, const struct RTCPointQueryNp* query, unsigned int N, struct RTCPointQueryContext* context, RTCPointQueryFunction queryFunc, void** userPtr);
+
 
 /* Intersects a single ray with the scene. */
 RTC_SYCL_API void rtcIntersect1(RTCScene scene, struct RTCRayHit* rayhit, struct RTCIntersectArguments* args RTC_OPTIONAL_ARGUMENT);
@@ -165,6 +256,15 @@ RTC_API void rtcIntersect8(const int* valid, RTCScene scene, struct RTCRayHit8*
 /* Intersects a packet of 16 rays with the scene. */
 RTC_API void rtcIntersect16(const int* valid, RTCScene scene, struct RTCRayHit16* rayhit, struct RTCIntersectArguments* args RTC_OPTIONAL_ARGUMENT);
 
+/* Intersects a stream of M rays in AOS layout with the scene. */
+RTC_API void rtcIntersect1M(RTCScene scene, struct RTCRayHit* rayhit, unsigned int M, size_t byteStride, struct RTCIntersectArguments* args RTC_OPTIONAL_ARGUMENT);
+
+/* Intersects a stream of N rays in SOA layout with the scene. */
+RTC_API void rtcIntersectNp(RTCScene scene, const struct RTCRayHitNp* rayhit, unsigned int N, struct RTCIntersectArguments* args RTC_OPTIONAL_ARGUMENT);
+
+/* Finds the up to capacity closest hits of a single ray with the scene, returns the number of hits found. */
+RTC_API unsigned int rtcIntersect1Multi(RTCScene scene, struct RTCRayHit* rayhit, struct RTCMultiHit* hits, unsigned int capacity, struct RTCIntersectArguments* args RTC_OPTIONAL_ARGUMENT);
+
 
 /* Forwards ray inside user geometry callback. */
 RTC_SYCL_API void rtcForwardIntersect1(const struct RTCIntersectFunctionNArguments* args, RTCScene scene, struct RTCRay* ray, unsigned int instID);
@@ -191,6 +291,12 @@ RTC_API void rtcOccluded8(const int* valid, RTCScene scene, struct RTCRay8* ray,
 /* Tests a packet of 16 rays for occlusion with the scene. */
 RTC_API void rtcOccluded16(const int* valid, RTCScene scene, struct RTCRay16* ray, struct RTCOccludedArguments* args RTC_OPTIONAL_ARGUMENT);
 
+/* Tests a stream of M rays in AOS layout for occlusion with the scene. */
+RTC_API void rtcOccluded1M(RTCScene scene, struct RTCRay* ray, unsigned int M, size_t byteStride, struct RTCOccludedArguments* args RTC_OPTIONAL_ARGUMENT);
+
+/* Tests a stream of N rays in SOA layout for occlusion with the scene. */
+RTC_API void rtcOccludedNp(RTCScene scene, const struct RTCRayNp* ray, unsigned int N, struct RTCOccludedArguments* args RTC_OPTIONAL_ARGUMENT);
+
 
 /* Forwards single occlusion ray inside user geometry callback. */
 RTC_SYCL_API void rtcForwardOccluded1(const struct RTCOccludedFunctionNArguments* args, RTCScene scene, struct RTCRay* ray, unsigned int instID);
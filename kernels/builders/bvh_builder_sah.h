@@ -29,12 +29,12 @@ namespace embree
         /*! default settings */
         Settings ()
         : branchingFactor(2), maxDepth(32), logBlockSize(0), minLeafSize(1), maxLeafSize(7),
-          travCost(1.0f), intCost(1.0f), singleThreadThreshold(1024), primrefarrayalloc(inf) {}
+          travCost(1.0f), intCost(1.0f), singleThreadThreshold(1024), primrefarrayalloc(inf), buildStats(nullptr) {}
 
         /*! initialize settings from API settings */
         Settings (const RTCBuildArguments& settings)
         : branchingFactor(2), maxDepth(32), logBlockSize(0), minLeafSize(1), maxLeafSize(7),
-          travCost(1.0f), intCost(1.0f), singleThreadThreshold(1024), primrefarrayalloc(inf)
+          travCost(1.0f), intCost(1.0f), singleThreadThreshold(1024), primrefarrayalloc(inf), buildStats(nullptr)
         {
           if (RTC_BUILD_ARGUMENTS_HAS(settings,maxBranchingFactor)) branchingFactor = settings.maxBranchingFactor;
           if (RTC_BUILD_ARGUMENTS_HAS(settings,maxDepth          )) maxDepth        = settings.maxDepth;
@@ -49,7 +49,7 @@ namespace embree
 
         Settings (size_t sahBlockSize, size_t minLeafSize, size_t maxLeafSize, float travCost, float intCost, size_t singleThreadThreshold, size_t primrefarrayalloc = inf)
         : branchingFactor(2), maxDepth(32), logBlockSize(bsr(sahBlockSize)), minLeafSize(minLeafSize), maxLeafSize(maxLeafSize),
-          travCost(travCost), intCost(intCost), singleThreadThreshold(singleThreadThreshold), primrefarrayalloc(primrefarrayalloc)
+          travCost(travCost), intCost(intCost), singleThreadThreshold(singleThreadThreshold), primrefarrayalloc(primrefarrayalloc), buildStats(nullptr)
         {
           minLeafSize = min(minLeafSize,maxLeafSize);
         }
@@ -64,6 +64,7 @@ namespace embree
         float intCost;           //!< estimated cost of one primitive intersection
         size_t singleThreadThreshold; //!< threshold when we switch to single threaded build
         size_t primrefarrayalloc;  //!< builder uses prim ref array to allocate nodes and leaves when a subtree of that size is finished
+        BuildStatistics* buildStats; //!< receives the time spent in the build phases when not NULL
       };
 
       /*! recursive state of builder */
@@ -214,6 +215,20 @@ namespace embree
             return updateNode(current,children,node,values,numChildren);
           }
 
+          /*! finds the best split, and measures the binning time */
+          __forceinline const typename Heuristic::Split findSplit(Set& set)
+          {
+            BuildStatistics::Timer timer(cfg.buildStats,BuildStatistics::BINNING);
+            return heuristic.find(set,cfg.logBlockSize);
+          }
+
+          /*! partitions the primitives, and measures the partitioning time */
+          __forceinline void performSplit(const typename Heuristic::Split& split, const Set& set, Set& lset, Set& rset)
+          {
+            BuildStatistics::Timer timer(cfg.buildStats,BuildStatistics::PARTITIONING);
+            heuristic.split(split,set,lset,rset);
+          }
+
           const ReductionTy recurse(BuildRecord& current, Allocator alloc, bool toplevel)
           {
             /* get thread local allocator */
@@ -225,7 +240,7 @@ namespace embree
               progressMonitor(current.size());
 
             /*! find best split */
-            auto split = heuristic.find(current.prims,cfg.logBlockSize);
+            auto split = findSplit(current.prims);
 
             /*! compute leaf and split cost */
             const float leafSAH  = cfg.intCost*current.prims.leafSAH(cfg.logBlockSize);
@@ -234,13 +249,14 @@ namespace embree
 
             /*! create a leaf node when threshold reached or SAH tells us to stop */
             if (current.prims.size() <= cfg.minLeafSize || current.depth+MIN_LARGE_LEAF_LEVELS >= cfg.maxDepth || (current.prims.size() <= cfg.maxLeafSize && leafSAH <= splitSAH)) {
+              BuildStatistics::Timer timer(cfg.buildStats,BuildStatistics::LEAVES);
               heuristic.deterministic_order(current.prims);
               return createLargeLeaf(current,alloc);
             }
 
             /*! perform initial split */
             Set lprims,rprims;
-            heuristic.split(split,current.prims,lprims,rprims);
+            performSplit(split,current.prims,lprims,rprims);
 	    
             /*! initialize child list with initial split */
             ReductionTy values[MAX_BRANCHING_FACTOR];
@@ -272,8 +288,8 @@ namespace embree
               BuildRecord& brecord = children[bestChild];
               BuildRecord lrecord(current.depth+1);
               BuildRecord rrecord(current.depth+1);
-              auto split = heuristic.find(brecord.prims,cfg.logBlockSize);
-              heuristic.split(split,brecord.prims,lrecord.prims,rrecord.prims);
+              auto split = findSplit(brecord.prims);
+              performSplit(split,brecord.prims,lrecord.prims,rrecord.prims);
               children[bestChild  ] = lrecord;
               children[numChildren] = rrecord;
               numChildren++;
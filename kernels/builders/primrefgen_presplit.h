@@ -228,8 +228,9 @@ namespace embree
 #if !defined(RTHWIF_STANDALONE)
 
     template<typename Mesh, typename SplitterFactory>    
-      PrimInfo createPrimRefArray_presplit(Geometry* geometry, unsigned int geomID, size_t numPrimRefs, mvector<PrimRef>& prims, BuildProgressMonitor& progressMonitor)
+      PrimInfo createPrimRefArray_presplit(Geometry* geometry, unsigned int geomID, size_t numPrimRefs, mvector<PrimRef>& prims, BuildProgressMonitor& progressMonitor, BuildStatistics* buildStats = nullptr)
     {
+      BuildStatistics::Timer timer(buildStats,BuildStatistics::PRIMREFS);
       ParallelPrefixSumState<PrimInfo> pstate;
       
       /* first try */
@@ -421,26 +422,30 @@ namespace embree
 #if !defined(RTHWIF_STANDALONE)
     
      template<typename Mesh, typename SplitterFactory>    
-      PrimInfo createPrimRefArray_presplit(Scene* scene, Geometry::GTypeMask types, bool mblur, size_t numPrimRefs, mvector<PrimRef>& prims, BuildProgressMonitor& progressMonitor)
+      PrimInfo createPrimRefArray_presplit(Scene* scene, Geometry::GTypeMask types, bool mblur, size_t numPrimRefs, mvector<PrimRef>& prims, BuildProgressMonitor& progressMonitor, BuildStatistics* buildStats = nullptr)
     {
       ParallelForForPrefixSumState<PrimInfo> pstate;
       Scene::Iterator2 iter(scene,types,mblur);
+      PrimInfo pinfo(empty);
+      {
+        BuildStatistics::Timer timer(buildStats,BuildStatistics::PRIMREFS);
 
-      /* first try */
-      progressMonitor(0);
-      pstate.init(iter,size_t(1024));
-      PrimInfo pinfo = parallel_for_for_prefix_sum0( pstate, iter, PrimInfo(empty), [&](Geometry* mesh, const range<size_t>& r, size_t k, size_t geomID) -> PrimInfo {
-	  return mesh->createPrimRefArray(prims,r,k,(unsigned)geomID);
-	}, [](const PrimInfo& a, const PrimInfo& b) -> PrimInfo { return PrimInfo::merge(a,b); });
-      
-      /* if we need to filter out geometry, run again */
-      if (pinfo.size() != numPrimRefs)
-	{
-	  progressMonitor(0);
-	  pinfo = parallel_for_for_prefix_sum1( pstate, iter, PrimInfo(empty), [&](Geometry* mesh, const range<size_t>& r, size_t k, size_t geomID, const PrimInfo& base) -> PrimInfo {
-	      return mesh->createPrimRefArray(prims,r,base.size(),(unsigned)geomID);
-	    }, [](const PrimInfo& a, const PrimInfo& b) -> PrimInfo { return PrimInfo::merge(a,b); });
-	}
+        /* first try */
+        progressMonitor(0);
+        pstate.init(iter,size_t(1024));
+        pinfo = parallel_for_for_prefix_sum0( pstate, iter, PrimInfo(empty), [&](Geometry* mesh, const range<size_t>& r, size_t k, size_t geomID) -> PrimInfo {
+            return mesh->createPrimRefArray(prims,r,k,(unsigned)geomID);
+          }, [](const PrimInfo& a, const PrimInfo& b) -> PrimInfo { return PrimInfo::merge(a,b); });
+
+        /* if we need to filter out geometry, run again */
+        if (pinfo.size() != numPrimRefs)
+        {
+          progressMonitor(0);
+          pinfo = parallel_for_for_prefix_sum1( pstate, iter, PrimInfo(empty), [&](Geometry* mesh, const range<size_t>& r, size_t k, size_t geomID, const PrimInfo& base) -> PrimInfo {
+              return mesh->createPrimRefArray(prims,r,base.size(),(unsigned)geomID);
+            }, [](const PrimInfo& a, const PrimInfo& b) -> PrimInfo { return PrimInfo::merge(a,b); });
+        }
+      }
 
 
       SplitterFactory Splitter(scene);
@@ -461,6 +466,7 @@ namespace embree
         return ((Mesh*)scene->get(geomID))->projectedPrimitiveArea(primID);
       };
       
+      BuildStatistics::Timer timer(buildStats,BuildStatistics::PRESPLITS);
       return createPrimRefArray_presplit(numPrimRefs,prims,pinfo,split_primitive,primitiveArea);
     }
 #endif 
@@ -3,6 +3,7 @@
 
 #include "bvh.h"
 #include "bvh_statistics.h"
+#include "bvh_serializer.h"
 
 namespace embree
 {
@@ -10,7 +11,9 @@ namespace embree
   BVHN<N>::BVHN (const PrimitiveType& primTy, Scene* scene)
     : AccelData((N==4) ? AccelData::TY_BVH4 : (N==8) ? AccelData::TY_BVH8 : AccelData::TY_UNKNOWN),
       primTy(&primTy), device(scene->device), scene(scene),
-      root(emptyNode), alloc(scene->device,scene->isStaticAccel()), numPrimitives(0), numVertices(0)
+      root(emptyNode), alloc(scene->device,scene->isStaticAccel()), numPrimitives(0), numVertices(0),
+      compressed_nodes(scene->device,0),
+      numaReplicaBytes(0), numaReplicaHugePages(false), mappedPtr(nullptr), mappedBytes(0)
   {
   }
 
@@ -19,13 +22,30 @@ namespace embree
   {
     for (size_t i=0; i<objects.size(); i++) 
       delete objects[i];
+    clearReplicas();
+    os_unmap_file(mappedPtr,mappedBytes);
   }
 
   template<int N>
   void BVHN<N>::clear()
   {
     set(BVHN::emptyNode,empty,0);
+    clearReplicas();
     alloc.clear();
+    compressed_nodes.clear();
+    os_unmap_file(mappedPtr,mappedBytes);
+    mappedPtr = nullptr;
+    mappedBytes = 0;
+  }
+
+  template<int N>
+  void BVHN<N>::save(std::ostream& stream) {
+    BVHNSerializer<N>::save(this,stream);
+  }
+
+  template<int N>
+  void BVHN<N>::load(const std::string& fileName, size_t& offset) {
+    BVHNSerializer<N>::load(this,fileName,offset);
   }
 
   template<int N>
@@ -48,6 +68,77 @@ namespace embree
     }
   }
 
+  template<int N>
+  void BVHN<N>::replicate()
+  {
+    clearReplicas();
+
+    const size_t depth = device->numa_replicate_depth;
+    const size_t numNodes = getNumberOfNUMANodes();
+    if (depth == 0 || !root.isAABBNode())
+      return;
+
+    numaReplicaBytes = countReplicatedNodes(root,depth)*sizeof(AABBNode);
+    for (size_t n=0; n<numNodes; n++)
+    {
+      /* pages of the replica are placed on its node before they get touched by the copy */
+      device->memoryMonitor(numaReplicaBytes,false);
+      char* ptr = nullptr;
+      if (device->hasUserAllocator())
+        ptr = (char*) device->userMalloc(numaReplicaBytes,byteNodeAlignment);
+      else {
+        ptr = (char*) os_malloc(numaReplicaBytes,numaReplicaHugePages);
+        os_bind_numa_node(ptr,numaReplicaBytes,(unsigned int)n);
+      }
+      numaReplicas.push_back(ptr);
+
+      size_t ofs = 0;
+      numaRoots.push_back(replicateRecursion(root,depth,ptr,ofs));
+      assert(ofs == numaReplicaBytes);
+    }
+  }
+
+  template<int N>
+  typename BVHN<N>::NodeRef BVHN<N>::replicateRecursion(NodeRef node, size_t depth, char* ptr, size_t& ofs)
+  {
+    if (depth == 0 || !node.isAABBNode())
+      return node;
+
+    AABBNode* oldnode = node.getAABBNode();
+    AABBNode* newnode = (AABBNode*) &ptr[ofs];
+    ofs += sizeof(AABBNode);
+    *newnode = *oldnode;
+    for (size_t c=0; c<N; c++)
+      newnode->child(c) = replicateRecursion(oldnode->child(c),depth-1,ptr,ofs);
+    return encodeNode(newnode);
+  }
+
+  template<int N>
+  size_t BVHN<N>::countReplicatedNodes(NodeRef node, size_t depth)
+  {
+    if (depth == 0 || !node.isAABBNode())
+      return 0;
+
+    size_t num = 1;
+    AABBNode* n = node.getAABBNode();
+    for (size_t c=0; c<N; c++)
+      num += countReplicatedNodes(n->child(c),depth-1);
+    return num;
+  }
+
+  template<int N>
+  void BVHN<N>::clearReplicas()
+  {
+    for (size_t n=0; n<numaReplicas.size(); n++) {
+      if (device->hasUserAllocator()) device->userFree(numaReplicas[n]);
+      else os_free(numaReplicas[n],numaReplicaBytes,numaReplicaHugePages);
+      device->memoryMonitor(-ssize_t(numaReplicaBytes),true);
+    }
+    numaReplicas.clear();
+    numaRoots.clear();
+    numaReplicaBytes = 0;
+  }
+
   template<int N>
   void BVHN<N>::layoutLargeNodes(size_t num)
   {
@@ -109,9 +200,37 @@ namespace embree
     else return node;
   }
 
+  template<int N>
+  void BVHN<N>::statistics(std::vector<RTCBVHStatistics>& stats)
+  {
+    if (root == emptyNode)
+      return;
+
+    RTCBVHStatistics s;
+    BVHNStatistics<N>(this).get(s);
+    stats.push_back(s);
+  }
+
+  template<int N>
+  void BVHN<N>::buildStatistics(std::vector<RTCBuildStatistics>& stats)
+  {
+    if (root == emptyNode)
+      return;
+
+    RTCBuildStatistics s;
+    buildStats.get(s);
+    s.primitiveType = primTy->name();
+    s.numPrimitives = numPrimitives;
+    stats.push_back(s);
+  }
+
   template<int N>
   double BVHN<N>::preBuild(const std::string& builderName)
   {
+    buildStats.clear();
+    buildStats.builder = builderName;
+    alloc.setBuildStatistics(getBuildStats());
+
     if (builderName == "") 
       return inf;
 
@@ -122,7 +241,7 @@ namespace embree
     }
 
     double t0 = 0.0;
-    if (device->benchmark || device->verbosity(2)) t0 = getSeconds();
+    if (device->benchmark || device->verbosity(2) || device->build_statistics) t0 = getSeconds();
     return t0;
   }
 
@@ -133,9 +252,12 @@ namespace embree
       return;
     
     double dt = 0.0;
-    if (device->benchmark || device->verbosity(2)) 
+    if (device->benchmark || device->verbosity(2) || device->build_statistics) 
       dt = getSeconds()-t0;
 
+    if (device->build_statistics)
+      buildStats.add(BuildStatistics::TOTAL,dt);
+
     std::unique_ptr<BVHNStatistics<N>> stat;
 
     /* print statistics */
@@ -10,6 +10,7 @@
 #include "bvh_node_obb.h"
 #include "bvh_node_obb_mb.h"
 #include "bvh_node_qaabb.h"
+#include "bvh_node_compressed.h"
 
 namespace embree
 {
@@ -22,6 +23,7 @@ namespace embree
     BVH_FLAG_UNALIGNED_NODE_MB = 0x01000,
     BVH_FLAG_QUANTIZED_NODE = 0x100000,
     BVH_FLAG_ALIGNED_NODE_MB4D = 0x1000000,
+    BVH_FLAG_COMPRESSED_NODE = 0x10000000,
     
     /* short versions */
     BVH_AN1 = BVH_FLAG_ALIGNED_NODE,
@@ -33,7 +35,8 @@ namespace embree
     BVH_AN1_UN1 = BVH_FLAG_ALIGNED_NODE | BVH_FLAG_UNALIGNED_NODE,
     BVH_AN2_UN2 = BVH_FLAG_ALIGNED_NODE_MB | BVH_FLAG_UNALIGNED_NODE_MB,
     BVH_AN2_AN4D_UN2 = BVH_FLAG_ALIGNED_NODE_MB | BVH_FLAG_ALIGNED_NODE_MB4D | BVH_FLAG_UNALIGNED_NODE_MB,
-    BVH_QN1 = BVH_FLAG_QUANTIZED_NODE
+    BVH_QN1 = BVH_FLAG_QUANTIZED_NODE,
+    BVH_CN1 = BVH_FLAG_COMPRESSED_NODE
   };
   
   /*! Multi BVH with N children. Each node stores the bounding box of
@@ -55,6 +58,7 @@ namespace embree
     typedef QuantizedBaseNode_t<N> QuantizedBaseNode;
     typedef QuantizedBaseNodeMB_t<N> QuantizedBaseNodeMB;
     typedef QuantizedNode_t<NodeRef,N> QuantizedNode;
+    typedef CompressedNode_t<NodeRef,N> CompressedNode;
     
     /*! Number of bytes the nodes and primitives are minimally aligned to.*/
     static const size_t byteAlignment = 16;
@@ -96,6 +100,23 @@ namespace embree
     
     /*! clears the acceleration structure */
     void clear();
+
+    /*! writes the BVH into a relocatable file section */
+    void save(std::ostream& stream);
+
+    /*! maps a BVH section of some file into memory */
+    void load(const std::string& fileName, size_t& offset);
+
+    /*! appends the quality metrics of the BVH */
+    void statistics(std::vector<RTCBVHStatistics>& stats);
+
+    /*! appends the build phase timings of the last build */
+    void buildStatistics(std::vector<RTCBuildStatistics>& stats);
+
+    /*! returns the build phase timings when the device measures them, NULL otherwise */
+    __forceinline BuildStatistics* getBuildStats() {
+      return device->build_statistics ? &buildStats : nullptr;
+    }
     
     /*! sets BVH members after build */
     void set (NodeRef root, const LBBox3fa& bounds, size_t numPrimitives);
@@ -103,6 +124,20 @@ namespace embree
     /*! Clears the barrier bits of a subtree. */
     void clearBarrier(NodeRef& node);
     
+    /*! replicates the top levels of the BVH to all NUMA nodes */
+    void replicate();
+    NodeRef replicateRecursion(NodeRef node, size_t depth, char* ptr, size_t& ofs);
+    size_t countReplicatedNodes(NodeRef node, size_t depth);
+    void clearReplicas();
+
+    /*! returns the root to start traversal from on the NUMA node of the calling thread */
+    __forceinline NodeRef getRoot() const
+    {
+      if (likely(numaRoots.empty())) return root;
+      const size_t node = getThreadNUMANode();
+      return node < numaRoots.size() ? numaRoots[node] : root;
+    }
+    
     /*! lays out num large nodes of the BVH */
     void layoutLargeNodes(size_t num);
     NodeRef layoutLargeNodesRecursion(NodeRef& node, const FastAllocator::CachedAllocator& allocator);
@@ -144,7 +179,11 @@ namespace embree
     __forceinline static void prefetch(const NodeRef ref, int types=0)
     {
 #if defined(__AVX512PF__) // MIC
-      if (types != BVH_FLAG_QUANTIZED_NODE) {
+      if (types == BVH_FLAG_COMPRESSED_NODE) {
+        prefetchL2(((char*)ref.ptr)+0*64);
+        prefetchL2(((char*)ref.ptr)+1*64);
+      }
+      else if (types != BVH_FLAG_QUANTIZED_NODE) {
         prefetchL2(((char*)ref.ptr)+0*64);
         prefetchL2(((char*)ref.ptr)+1*64);
         if ((N >= 8) || (types > BVH_FLAG_ALIGNED_NODE)) {
@@ -167,7 +206,12 @@ namespace embree
         prefetchL2(((char*)ref.ptr)+2*64);
       }
 #else
-      if (types != BVH_FLAG_QUANTIZED_NODE) {
+      if (types == BVH_FLAG_COMPRESSED_NODE) {
+        /* compressed nodes span at most two cache lines */
+        prefetchL1(((char*)ref.ptr)+0*64);
+        prefetchL1(((char*)ref.ptr)+1*64);
+      }
+      else if (types != BVH_FLAG_QUANTIZED_NODE) {
         prefetchL1(((char*)ref.ptr)+0*64);
         prefetchL1(((char*)ref.ptr)+1*64);
         if ((N >= 8) || (types > BVH_FLAG_ALIGNED_NODE)) {
@@ -223,11 +267,25 @@ namespace embree
   public:
     size_t numPrimitives;              //!< number of primitives the BVH is build over
     size_t numVertices;                //!< number of vertices the BVH references
+    BuildStatistics buildStats;        //!< time spent in the phases of the last build
     
     /*! data arrays for special builders */
   public:
     std::vector<BVHN*> objects;
     vector_t<char,aligned_allocator<char,32>> subdiv_patches;
+    mvector<char> compressed_nodes;    //!< compressed nodes and primitive blocks in their implicit layout
+
+    /*! top levels replicated per NUMA node */
+  public:
+    std::vector<NodeRef> numaRoots;    //!< root of the replica of each NUMA node
+    std::vector<void*> numaReplicas;   //!< memory of the replica of each NUMA node
+    size_t numaReplicaBytes;           //!< size of each replica
+    bool numaReplicaHugePages;         //!< whether replicas use huge pages
+
+    /*! file mapping the BVH got loaded from */
+  public:
+    void* mappedPtr;                   //!< start of mapped file section
+    size_t mappedBytes;                //!< size of mapped file section
   };
   
   typedef BVHN<4> BVH4;
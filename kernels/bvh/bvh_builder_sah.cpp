@@ -11,6 +11,8 @@
 #include "../geometry/trianglev.h"
 #include "../geometry/trianglev_mb.h"
 #include "../geometry/trianglei.h"
+#include "../geometry/triangleq.h"
+#include "../geometry/trianglepairi.h"
 #include "../geometry/quadv.h"
 #include "../geometry/quadi.h"
 #include "../geometry/object.h"
@@ -77,6 +79,32 @@ namespace embree
       BVH* bvh;
     };
 
+    template<int N, typename Primitive>
+    struct CreateLeafTrianglePairs
+    {
+      typedef BVHN<N> BVH;
+      typedef typename BVH::NodeRef NodeRef;
+
+      __forceinline CreateLeafTrianglePairs (BVH* bvh, const std::vector<std::vector<uint16_t>>& quadification)
+        : bvh(bvh), quadification(quadification) {}
+
+      __forceinline NodeRef operator() (const PrimRef* prims, const range<size_t>& set, const FastAllocator::CachedAllocator& alloc) const
+      {
+        size_t n = set.size();
+        size_t items = Primitive::blocks(n);
+        size_t start = set.begin();
+        Primitive* accel = (Primitive*) alloc.malloc1(items*sizeof(Primitive),BVH::byteAlignment);
+        typename BVH::NodeRef node = BVH::encodeLeaf((char*)accel,items);
+        for (size_t i=0; i<items; i++) {
+          accel[i].fill(prims,start,set.end(),bvh->scene,quadification);
+        }
+        return node;
+      }
+
+      BVH* bvh;
+      const std::vector<std::vector<uint16_t>>& quadification;
+    };
+
     /************************************************************************************/
     /************************************************************************************/
     /************************************************************************************/
@@ -134,8 +162,8 @@ namespace embree
         profile(2,PROFILE_RUNS,numPrimitives,[&] (ProfileTimer& timer) {
 #endif
 
-            /* create primref array */
-            if (primrefarrayalloc) {
+            /* create primref array, kept primref arrays cannot double as allocation blocks */
+            if (primrefarrayalloc && !bvh->scene->hasPersistentBuildMemory()) {
               settings.primrefarrayalloc = numPrimitives/1000;
               if (settings.primrefarrayalloc < 1000)
                 settings.primrefarrayalloc = inf;
@@ -150,11 +178,17 @@ namespace embree
             const size_t leaf_bytes = size_t(1.2*Primitive::blocks(numPrimitives)*sizeof(Primitive));
             bvh->alloc.init_estimate(node_bytes+leaf_bytes);
             settings.singleThreadThreshold = bvh->alloc.fixSingleThreadThreshold(N,DEFAULT_SINGLE_THREAD_THRESHOLD,numPrimitives,node_bytes+leaf_bytes);
+            settings.buildStats = bvh->getBuildStats();
+            bvh->scene->acquireBuildScratch(prims,numPrimitives);
             prims.resize(numPrimitives); 
 
-            PrimInfo pinfo = mesh ?
-              createPrimRefArray(mesh,geomID_,numPrimitives,prims,bvh->scene->progressInterface) :
-              createPrimRefArray(scene,gtype_,false,numPrimitives,prims,bvh->scene->progressInterface);
+            PrimInfo pinfo(empty);
+            {
+              BuildStatistics::Timer timer(settings.buildStats,BuildStatistics::PRIMREFS);
+              pinfo = mesh ?
+                createPrimRefArray(mesh,geomID_,numPrimitives,prims,bvh->scene->progressInterface) :
+                createPrimRefArray(scene,gtype_,false,numPrimitives,prims,bvh->scene->progressInterface);
+            }
 
             /* pinfo might has zero size due to invalid geometry */
             if (unlikely(pinfo.size() == 0))
@@ -178,6 +212,8 @@ namespace embree
           bvh->alloc.share(prims);
 
         /* for static geometries we can do some cleanups */
+        else if (bvh->scene->isStaticAccel() && bvh->scene->hasPersistentBuildMemory())
+          bvh->scene->releaseBuildScratch(prims);
         else if (scene && scene->isStaticAccel()) {
           prims.clear();
         }
@@ -240,10 +276,16 @@ namespace embree
         profile(2,PROFILE_RUNS,numPrimitives,[&] (ProfileTimer& timer) {
 #endif
             /* create primref array */
+            settings.buildStats = bvh->getBuildStats();
+            bvh->scene->acquireBuildScratch(prims,numPrimitives);
             prims.resize(numPrimitives);
-            PrimInfo pinfo = mesh ?
-              createPrimRefArray(mesh,geomID_,numPrimitives,prims,bvh->scene->progressInterface) :
-	      createPrimRefArray(scene,gtype_,false,numPrimitives,prims,bvh->scene->progressInterface);
+            PrimInfo pinfo(empty);
+            {
+              BuildStatistics::Timer timer(settings.buildStats,BuildStatistics::PRIMREFS);
+              pinfo = mesh ?
+                createPrimRefArray(mesh,geomID_,numPrimitives,prims,bvh->scene->progressInterface) :
+                createPrimRefArray(scene,gtype_,false,numPrimitives,prims,bvh->scene->progressInterface);
+            }
 
             /* enable os_malloc for two level build */
             if (mesh)
@@ -262,7 +304,9 @@ namespace embree
 #endif
 
 	/* clear temporary data for static geometry */
-	if (scene && scene->isStaticAccel()) {
+        if (bvh->scene->isStaticAccel() && bvh->scene->hasPersistentBuildMemory())
+          bvh->scene->releaseBuildScratch(prims);
+	else if (scene && scene->isStaticAccel()) {
           prims.clear();
         }
 	bvh->cleanup();
@@ -279,6 +323,324 @@ namespace embree
     /************************************************************************************/
     /************************************************************************************/
 
+    template<int N, typename Primitive>
+    struct BVHNBuilderSAHTrianglePairs : public Builder
+    {
+      typedef BVHN<N> BVH;
+      typedef typename BVHN<N>::NodeRef NodeRef;
+
+      BVH* bvh;
+      Scene* scene;
+      mvector<PrimRef> prims;
+      GeneralBVHBuilder::Settings settings;
+      std::vector<std::vector<uint16_t>> quadification; //!< per triangle: offset to the paired triangle, QUADIFIER_TRIANGLE, or QUADIFIER_PAIRED
+
+      BVHNBuilderSAHTrianglePairs (BVH* bvh, Scene* scene, const size_t sahBlockSize, const float intCost, const size_t minLeafSize, const size_t maxLeafSize)
+        : bvh(bvh), scene(scene), prims(scene->device,0), settings(sahBlockSize, minLeafSize, min(maxLeafSize,Primitive::max_size()*BVH::maxLeafBlocks), travCost, intCost, DEFAULT_SINGLE_THREAD_THRESHOLD) {}
+
+      /* pairs triangles that share an edge and creates one primref per triangle pair */
+      PrimInfo createPrimRefArray(size_t numTriangles)
+      {
+        quadification.resize(scene->size());
+        for (size_t geomID=0; geomID<scene->size(); geomID++) {
+          TriangleMesh* mesh = scene->getSafe<TriangleMesh>(geomID);
+          if (mesh && mesh->isEnabled()) quadification[geomID].resize(mesh->size());
+          else quadification[geomID].clear();
+        }
+
+        ParallelForForPrefixSumState<PrimInfo> pstate;
+        Scene::Iterator2 iter(scene,TriangleMesh::geom_type,false);
+        pstate.init(iter,size_t(1024));
+
+        /* pair triangles inside each range and count the resulting primitives */
+        scene->progressInterface(0);
+        const PrimInfo ppairs = parallel_for_for_prefix_sum0( pstate, iter, PrimInfo(empty), [&](Geometry* geom, const range<size_t>& r, size_t k, size_t geomID) -> PrimInfo
+        {
+          const TriangleMesh* mesh = (const TriangleMesh*) geom;
+          const size_t numPairs = pair_triangles(unsigned(geomID),(QuadifierType*)quadification[geomID].data(),unsigned(r.begin()),unsigned(r.end()),[&](uint32_t, uint32_t primID) {
+              const TriangleMesh::Triangle& tri = mesh->triangle(primID);
+              return Vec3<uint32_t>(tri.v[0],tri.v[1],tri.v[2]);
+            });
+          return PrimInfo(numPairs);
+        }, [](const PrimInfo& a, const PrimInfo& b) -> PrimInfo { return PrimInfo::merge(a,b); });
+
+        /* creates one primref per valid triangle pair, pairs with one invalid triangle get split */
+        auto createPairPrimRefs = [&](Geometry* geom, const range<size_t>& r, size_t k, size_t geomID, const PrimInfo& base) -> PrimInfo
+        {
+          const TriangleMesh* mesh = (const TriangleMesh*) geom;
+          uint16_t* quads = quadification[geomID].data();
+          PrimInfo pinfo(empty);
+          k = base.size();
+          for (size_t j=r.begin(); j<r.end(); j++)
+          {
+            if (quads[j] == QUADIFIER_PAIRED) continue;
+            BBox3fa bounds = empty;
+            const bool valid0 = mesh->buildBounds(j,&bounds);
+            if (quads[j] != QUADIFIER_TRIANGLE)
+            {
+              BBox3fa bounds1 = empty;
+              if (valid0 && mesh->buildBounds(j+quads[j],&bounds1)) {
+                const PrimRef prim(merge(bounds,bounds1),unsigned(geomID),unsigned(j));
+                pinfo.add_center2(prim);
+                prims[k++] = prim;
+                continue;
+              }
+              /* the second triangle gets handled on its own when the loop reaches it */
+              quads[j+quads[j]] = QUADIFIER_TRIANGLE;
+              quads[j] = QUADIFIER_TRIANGLE;
+            }
+            if (!valid0) continue;
+            const PrimRef prim(bounds,unsigned(geomID),unsigned(j));
+            pinfo.add_center2(prim);
+            prims[k++] = prim;
+          }
+          return pinfo;
+        };
+
+        PrimInfo pinfo = parallel_for_for_prefix_sum1( pstate, iter, PrimInfo(empty), createPairPrimRefs,
+                                                       [](const PrimInfo& a, const PrimInfo& b) -> PrimInfo { return PrimInfo::merge(a,b); });
+
+        /* if we had to filter out invalid triangles, run again to compact the primref array */
+        if (pinfo.size() != ppairs.size())
+        {
+          scene->progressInterface(0);
+          pinfo = parallel_for_for_prefix_sum1( pstate, iter, PrimInfo(empty), createPairPrimRefs,
+                                                [](const PrimInfo& a, const PrimInfo& b) -> PrimInfo { return PrimInfo::merge(a,b); });
+        }
+        return pinfo;
+      }
+
+      void build()
+      {
+	/* skip build for empty scene */
+        const size_t numTriangles = scene->getNumPrimitives(TriangleMesh::geom_type,false);
+        if (numTriangles == 0) {
+          bvh->clear();
+          clear();
+          return;
+        }
+
+        double t0 = bvh->preBuild(TOSTRING(isa) "::BVH" + toString(N) + "BuilderSAHTrianglePairs");
+
+        /* initialize allocator, about two triangles end up in one pair */
+        const size_t numPrimitives = (numTriangles+1)/2;
+        const size_t node_bytes = numPrimitives*sizeof(typename BVH::AABBNodeMB)/(4*N);
+        const size_t leaf_bytes = size_t(1.2*Primitive::blocks(numPrimitives)*sizeof(Primitive));
+        bvh->alloc.init_estimate(node_bytes+leaf_bytes);
+        settings.singleThreadThreshold = bvh->alloc.fixSingleThreadThreshold(N,DEFAULT_SINGLE_THREAD_THRESHOLD,numPrimitives,node_bytes+leaf_bytes);
+        settings.buildStats = bvh->getBuildStats();
+
+        /* create primref array */
+        prims.resize(numTriangles);
+        PrimInfo pinfo(empty);
+        {
+          BuildStatistics::Timer timer(settings.buildStats,BuildStatistics::PRIMREFS);
+          pinfo = createPrimRefArray(numTriangles);
+        }
+
+        /* pinfo might has zero size due to invalid geometry */
+        if (unlikely(pinfo.size() == 0))
+        {
+          bvh->clear();
+          clear();
+          return;
+        }
+
+        /* call BVH builder */
+        NodeRef root = BVHNBuilderVirtual<N>::build(&bvh->alloc,CreateLeafTrianglePairs<N,Primitive>(bvh,quadification),bvh->scene->progressInterface,prims.data(),pinfo,settings);
+        bvh->set(root,LBBox3fa(pinfo.geomBounds),pinfo.size());
+        bvh->layoutLargeNodes(size_t(pinfo.size()*0.005f));
+
+        /* the pairing is only required to fill the leaves */
+        quadification.clear();
+
+        /* for static geometries we can do some cleanups */
+        if (scene->isStaticAccel()) {
+          prims.clear();
+        }
+	bvh->cleanup();
+        bvh->postBuild(t0);
+      }
+
+      void clear() {
+        prims.clear();
+        quadification.clear();
+      }
+    };
+
+    /************************************************************************************/
+    /************************************************************************************/
+    /************************************************************************************/
+    /************************************************************************************/
+
+
+    template<int N, typename Primitive>
+    struct BVHNBuilderSAHCompressed : public Builder
+    {
+      typedef BVHN<N> BVH;
+      typedef typename BVHN<N>::NodeRef NodeRef;
+      typedef typename BVHN<N>::AABBNode AABBNode;
+      typedef typename BVHN<N>::CompressedNode CompressedNode;
+      static_assert(N != 8 || sizeof(CompressedNode) == 80, "compressed node has to fill 80 bytes");
+
+      BVH* bvh;
+      Scene* scene;
+      mvector<PrimRef> prims;
+      GeneralBVHBuilder::Settings settings;
+      Geometry::GTypeMask gtype_;
+
+      BVHNBuilderSAHCompressed (BVH* bvh, Scene* scene, const size_t sahBlockSize, const float intCost, const size_t minLeafSize, const size_t maxLeafSize, const Geometry::GTypeMask gtype)
+        : bvh(bvh), scene(scene), prims(scene->device,0), settings(sahBlockSize, minLeafSize, min(maxLeafSize,Primitive::max_size()*CompressedNode::maxLeafBlocks), travCost, intCost, DEFAULT_SINGLE_THREAD_THRESHOLD), gtype_(gtype) {}
+
+      /* counts the compressed nodes and primitive blocks of a subtree */
+      void count(NodeRef node, size_t& numNodes, size_t& numBlocks)
+      {
+        if (node.isLeaf()) {
+          size_t num; node.leaf(num);
+          numBlocks += num;
+          return;
+        }
+        numNodes++;
+        AABBNode* n = node.getAABBNode();
+        for (size_t i=0; i<N; i++)
+          if (n->child(i) != BVH::emptyNode) count(n->child(i),numNodes,numBlocks);
+      }
+
+      /* writes a compressed node followed by the array of its children, then recurses into the inner children */
+      void compress(CompressedNode* dst, const BBox3fa* bounds, const NodeRef* children, size_t num, char* base, size_t& ofs)
+      {
+        dst->setBounds(bounds,num);
+
+        size_t numInner = 0;
+        for (size_t i=0; i<num; i++)
+          if (!children[i].isLeaf()) numInner++;
+
+        CompressedNode* nodes = (CompressedNode*) (base + ofs);
+        ofs += numInner*sizeof(CompressedNode);
+
+        unsigned int imask = 0;
+        size_t innerID = 0, blockID = 0;
+        for (size_t i=0; i<N; i++)
+        {
+          dst->meta[i] = 0;
+          if (i >= num) continue;
+          if (children[i].isLeaf())
+          {
+            size_t items; const char* prim = children[i].leaf(items);
+            if (items == 0) continue;
+            memcpy(base+ofs,prim,items*sizeof(Primitive));
+            ofs += items*sizeof(Primitive);
+            dst->setLeafChild(i,blockID,items);
+            blockID += items;
+          }
+          else
+          {
+            imask |= 1 << i;
+            dst->setInnerChild(i,innerID++);
+          }
+        }
+        dst->setChildren((char*)nodes-(char*)dst,imask,sizeof(Primitive));
+
+        for (size_t i=0, k=0; i<num; i++)
+        {
+          if (children[i].isLeaf()) continue;
+          const AABBNode* n = children[i].getAABBNode();
+          BBox3fa cbounds[N]; NodeRef cchildren[N]; size_t cnum = 0;
+          for (size_t j=0; j<N; j++) {
+            if (n->child(j) == BVH::emptyNode) continue;
+            cbounds[cnum] = n->bounds(j);
+            cchildren[cnum++] = n->child(j);
+          }
+          compress(&nodes[k++],cbounds,cchildren,cnum,base,ofs);
+        }
+      }
+
+      void build()
+      {
+	/* skip build for empty scene */
+        const size_t numPrimitives = scene->getNumPrimitives(gtype_,false);
+        if (numPrimitives == 0) {
+          prims.clear();
+          bvh->clear();
+          return;
+        }
+
+        double t0 = bvh->preBuild(TOSTRING(isa) "::CBVH" + toString(N) + "BuilderSAH");
+
+        /* create primref array */
+        settings.buildStats = bvh->getBuildStats();
+        bvh->scene->acquireBuildScratch(prims,numPrimitives);
+        prims.resize(numPrimitives);
+        PrimInfo pinfo(empty);
+        {
+          BuildStatistics::Timer timer(settings.buildStats,BuildStatistics::PRIMREFS);
+          pinfo = createPrimRefArray(scene,gtype_,false,numPrimitives,prims,bvh->scene->progressInterface);
+        }
+
+        /* pinfo might has zero size due to invalid geometry */
+        if (unlikely(pinfo.size() == 0))
+        {
+          bvh->clear();
+          prims.clear();
+          return;
+        }
+
+        /* build a regular BVH into a temporary allocator */
+        FastAllocator alloc(bvh->device,false);
+        alloc.setBuildStatistics(settings.buildStats);
+        const size_t node_bytes = numPrimitives*sizeof(AABBNode)/(4*N);
+        const size_t leaf_bytes = size_t(1.2*Primitive::blocks(numPrimitives)*sizeof(Primitive));
+        alloc.init_estimate(node_bytes+leaf_bytes);
+        settings.singleThreadThreshold = alloc.fixSingleThreadThreshold(N,DEFAULT_SINGLE_THREAD_THRESHOLD,numPrimitives,node_bytes+leaf_bytes);
+        NodeRef root = BVHNBuilderVirtual<N>::build(&alloc,CreateLeaf<N,Primitive>(bvh),bvh->scene->progressInterface,prims.data(),pinfo,settings);
+
+        /* the root has to be a compressed node, thus a leaf root gets wrapped into one */
+        BBox3fa bounds[N]; NodeRef children[N]; size_t num = 0;
+        if (root.isLeaf()) {
+          bounds[num] = pinfo.geomBounds;
+          children[num++] = root;
+        } else {
+          AABBNode* n = root.getAABBNode();
+          for (size_t i=0; i<N; i++) {
+            if (n->child(i) == BVH::emptyNode) continue;
+            bounds[num] = n->bounds(i);
+            children[num++] = n->child(i);
+          }
+        }
+
+        /* lay out all compressed nodes and primitive blocks into a single block of memory */
+        size_t numNodes = 1, numBlocks = 0;
+        for (size_t i=0; i<num; i++) count(children[i],numNodes,numBlocks);
+        const size_t bytes = numNodes*sizeof(CompressedNode) + numBlocks*sizeof(Primitive);
+        bvh->alloc.clear();
+        bvh->compressed_nodes.resize(bytes);
+        char* base = bvh->compressed_nodes.data();
+        size_t ofs = sizeof(CompressedNode);
+        compress((CompressedNode*)base,bounds,children,num,base,ofs);
+        assert(ofs == bytes);
+        alloc.clear();
+
+        bvh->set(NodeRef((size_t)base | NodeRef::tyCompressedNode),LBBox3fa(pinfo.geomBounds),pinfo.size());
+
+	/* clear temporary data for static geometry */
+        if (bvh->scene->isStaticAccel() && bvh->scene->hasPersistentBuildMemory())
+          bvh->scene->releaseBuildScratch(prims);
+	else if (scene->isStaticAccel()) {
+          prims.clear();
+        }
+	bvh->cleanup();
+        bvh->postBuild(t0);
+      }
+
+      void clear() {
+        prims.clear();
+      }
+    };
+
+    /************************************************************************************/
+    /************************************************************************************/
+    /************************************************************************************/
+    /************************************************************************************/
 
     template<int N, typename Primitive>
     struct CreateLeafGrid
@@ -391,6 +753,7 @@ namespace embree
         }
 
         double t0 = bvh->preBuild(mesh ? "" : TOSTRING(isa) "::BVH" + toString(N) + "BuilderSAH");
+        settings.buildStats = bvh->getBuildStats();
 
         /* create primref array */
         settings.primrefarrayalloc = numPrimitives/1000;
@@ -456,8 +819,10 @@ namespace embree
     Builder* BVH4Triangle4SceneBuilderSAH  (void* bvh, Scene* scene, size_t mode) { return new BVHNBuilderSAH<4,Triangle4>((BVH4*)bvh,scene,4,1.0f,4,inf,TriangleMesh::geom_type); }
     Builder* BVH4Triangle4vSceneBuilderSAH (void* bvh, Scene* scene, size_t mode) { return new BVHNBuilderSAH<4,Triangle4v>((BVH4*)bvh,scene,4,1.0f,4,inf,TriangleMesh::geom_type); }
     Builder* BVH4Triangle4iSceneBuilderSAH (void* bvh, Scene* scene, size_t mode) { return new BVHNBuilderSAH<4,Triangle4i>((BVH4*)bvh,scene,4,1.0f,4,inf,TriangleMesh::geom_type,true); }
+    Builder* BVH4Triangle4qSceneBuilderSAH (void* bvh, Scene* scene, size_t mode) { return new BVHNBuilderSAH<4,Triangle4q>((BVH4*)bvh,scene,4,1.0f,4,inf,TriangleMesh::geom_type); }
 
     Builder* BVH4QuantizedTriangle4iSceneBuilderSAH (void* bvh, Scene* scene, size_t mode) { return new BVHNBuilderSAHQuantized<4,Triangle4i>((BVH4*)bvh,scene,4,1.0f,4,inf,TriangleMesh::geom_type); }
+    Builder* BVH4TrianglePair4iSceneBuilderSAH (void* bvh, Scene* scene, size_t mode) { return new BVHNBuilderSAHTrianglePairs<4,TrianglePair4i>((BVH4*)bvh,scene,4,1.0f,4,inf); }
 #if defined(__AVX__)
     Builder* BVH8Triangle4MeshBuilderSAH  (void* bvh, TriangleMesh* mesh, unsigned int geomID, size_t mode) { return new BVHNBuilderSAH<8,Triangle4>((BVH8*)bvh,mesh,geomID,4,1.0f,4,inf,TriangleMesh::geom_type); }
     Builder* BVH8Triangle4vMeshBuilderSAH (void* bvh, TriangleMesh* mesh, unsigned int geomID, size_t mode) { return new BVHNBuilderSAH<8,Triangle4v>((BVH8*)bvh,mesh,geomID,4,1.0f,4,inf,TriangleMesh::geom_type); }
@@ -468,6 +833,8 @@ namespace embree
     Builder* BVH8Triangle4iSceneBuilderSAH     (void* bvh, Scene* scene, size_t mode) { return new BVHNBuilderSAH<8,Triangle4i>((BVH8*)bvh,scene,4,1.0f,4,inf,TriangleMesh::geom_type,true); }
     Builder* BVH8QuantizedTriangle4iSceneBuilderSAH  (void* bvh, Scene* scene, size_t mode) { return new BVHNBuilderSAHQuantized<8,Triangle4i>((BVH8*)bvh,scene,4,1.0f,4,inf,TriangleMesh::geom_type); }
     Builder* BVH8QuantizedTriangle4SceneBuilderSAH  (void* bvh, Scene* scene, size_t mode) { return new BVHNBuilderSAHQuantized<8,Triangle4>((BVH8*)bvh,scene,4,1.0f,4,inf,TriangleMesh::geom_type); }
+    Builder* BVH8CompressedTriangle4iSceneBuilderSAH (void* bvh, Scene* scene, size_t mode) { return new BVHNBuilderSAHCompressed<8,Triangle4i>((BVH8*)bvh,scene,4,1.0f,4,inf,TriangleMesh::geom_type); }
+    Builder* BVH8TrianglePair4iSceneBuilderSAH (void* bvh, Scene* scene, size_t mode) { return new BVHNBuilderSAHTrianglePairs<8,TrianglePair4i>((BVH8*)bvh,scene,4,1.0f,4,inf); }
 
     
 
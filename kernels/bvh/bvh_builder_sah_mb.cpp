@@ -174,11 +174,17 @@ namespace embree
       void buildMultiSegment(size_t numPrimitives)
       {
         /* create primref array */
-        mvector<PrimRefMB> prims(scene->device,numPrimitives);
-	PrimInfoMB pinfo = createPrimRefArrayMSMBlur(scene,gtype_,numPrimitives,prims,bvh->scene->progressInterface);
+        mvector<PrimRefMB> prims(scene->device,0);
+        scene->acquireBuildScratch(prims,numPrimitives);
+        prims.resize(numPrimitives);
+        PrimInfoMB pinfo(empty);
+        {
+          BuildStatistics::Timer timer(bvh->getBuildStats(),BuildStatistics::PRIMREFS);
+          pinfo = createPrimRefArrayMSMBlur(scene,gtype_,numPrimitives,prims,bvh->scene->progressInterface);
+        }
 
         /* early out if no valid primitives */
-        if (pinfo.size() == 0) { bvh->clear(); return; }
+        if (pinfo.size() == 0) { scene->releaseBuildScratch(prims); bvh->clear(); return; }
 
         /* estimate acceleration structure size */
         const size_t node_bytes = pinfo.num_time_segments*sizeof(AABBNodeMB)/(4*N);
@@ -209,6 +215,7 @@ namespace embree
                                             settings);
 
         bvh->set(root.ref,root.lbounds,pinfo.num_time_segments);
+        scene->releaseBuildScratch(prims);
       }
 
       void clear() {
@@ -92,9 +92,11 @@ namespace embree
         const unsigned int maxGeomID = mesh ? geomID_ : scene->getMaxGeomID<Mesh,false>();
         const bool usePreSplits = scene->device->useSpatialPreSplits || (maxGeomID >= ((unsigned int)1 << (32-RESERVED_NUM_SPATIAL_SPLITS_GEOMID_BITS)));
         double t0 = bvh->preBuild(mesh ? "" : TOSTRING(isa) "::BVH" + toString(N) + (usePreSplits ? "BuilderFastSpatialPresplitSAH" : "BuilderFastSpatialSAH"));
+        settings.buildStats = bvh->getBuildStats();
 
         /* create primref array */
         const size_t numSplitPrimitives = max(numOriginalPrimitives,size_t(splitFactor*numOriginalPrimitives));
+        bvh->scene->acquireBuildScratch(prims0,numSplitPrimitives);
         prims0.resize(numSplitPrimitives);
 
         /* enable os_malloc for two level build */
@@ -109,8 +111,8 @@ namespace embree
 	  {		     
             /* spatial presplit SAH BVH builder */
 	    pinfo = mesh ?
-	      createPrimRefArray_presplit<Mesh,Splitter>(mesh,maxGeomID,numOriginalPrimitives,prims0,bvh->scene->progressInterface) :
-	      createPrimRefArray_presplit<Mesh,Splitter>(scene,Mesh::geom_type,false,numOriginalPrimitives,prims0,bvh->scene->progressInterface);
+	      createPrimRefArray_presplit<Mesh,Splitter>(mesh,maxGeomID,numOriginalPrimitives,prims0,bvh->scene->progressInterface,settings.buildStats) :
+	      createPrimRefArray_presplit<Mesh,Splitter>(scene,Mesh::geom_type,false,numOriginalPrimitives,prims0,bvh->scene->progressInterface,settings.buildStats);
 
 	    const size_t node_bytes = pinfo.size()*sizeof(typename BVH::AABBNode)/(4*N);
 	    const size_t leaf_bytes = size_t(1.2*Primitive::blocks(pinfo.size())*sizeof(Primitive));
@@ -126,9 +128,12 @@ namespace embree
 	else
 	  {
             /* standard spatial split SAH BVH builder */
-	    pinfo = mesh ?
-	      createPrimRefArray(mesh,geomID_,numSplitPrimitives,prims0,bvh->scene->progressInterface) :
-	      createPrimRefArray(scene,Mesh::geom_type,false,numSplitPrimitives,prims0,bvh->scene->progressInterface);
+            {
+              BuildStatistics::Timer timer(settings.buildStats,BuildStatistics::PRIMREFS);
+              pinfo = mesh ?
+                createPrimRefArray(mesh,geomID_,numSplitPrimitives,prims0,bvh->scene->progressInterface) :
+                createPrimRefArray(scene,Mesh::geom_type,false,numSplitPrimitives,prims0,bvh->scene->progressInterface);
+            }
 	
 	    Splitter splitter(scene);
 
@@ -159,7 +164,9 @@ namespace embree
         bvh->layoutLargeNodes(size_t(pinfo.size()*0.005f));
 
 	/* clear temporary data for static geometry */
-	if (scene && scene->isStaticAccel()) {
+        if (bvh->scene->isStaticAccel() && bvh->scene->hasPersistentBuildMemory())
+          bvh->scene->releaseBuildScratch(prims0);
+	else if (scene && scene->isStaticAccel()) {
           prims0.clear();
         }
 	bvh->cleanup();
@@ -20,7 +20,8 @@ namespace embree
   {
     template<int N, typename Mesh, typename Primitive>
     BVHNBuilderTwoLevel<N,Mesh,Primitive>::BVHNBuilderTwoLevel (BVH* bvh, Scene* scene, Geometry::GTypeMask gtype, bool useMortonBuilder, const size_t singleThreadThreshold)
-      : bvh(bvh), scene(scene), refs(scene->device,0), prims(scene->device,0), singleThreadThreshold(singleThreadThreshold), gtype(gtype), useMortonBuilder_(useMortonBuilder) {}
+      : bvh(bvh), scene(scene), refs(scene->device,0), prims(scene->device,0), singleThreadThreshold(singleThreadThreshold), gtype(gtype), useMortonBuilder_(useMortonBuilder),
+        incremental(false), topLevelValid(false), topLevelArea(0.0f), topLevelCost(0.0f) {}
     
     template<int N, typename Mesh, typename Primitive>
     BVHNBuilderTwoLevel<N,Mesh,Primitive>::~BVHNBuilderTwoLevel () {
@@ -43,6 +44,12 @@ namespace embree
             }
           });
       }
+
+      /* update the top level hierarchy in place if possible */
+      incremental = scene->isIncrementalAccel();
+      if (updateTopLevel())
+        return;
+      topLevelValid = false;
       
 #if PROFILE
       while(1) 
@@ -111,11 +118,36 @@ namespace embree
 #if PROFILE
       double d0 = getSeconds();
 #endif
+      BuildStatistics* buildStats = bvh->getBuildStats();
+      const double t1 = buildStats ? getSeconds() : 0.0;
+
       /* fast path for single geometry scenes */
       if (nextRef == 1) { 
         bvh->set(refs[0].node,LBBox3fa(refs[0].bounds()),numPrimitives);
       }
 
+      /* incremental mode builds over the object roots such that each object occupies one top level slot */
+      else if (incremental)
+      {
+        refs.resize(nextRef);
+        prims.resize(refs.size());
+
+        const PrimInfo pinfo = parallel_reduce(size_t(0), refs.size(),  PrimInfo(empty), [&] (const range<size_t>& r) -> PrimInfo {
+
+            PrimInfo pinfo(empty);
+            for (size_t i=r.begin(); i<r.end(); i++) {
+              pinfo.add_center2(refs[i]);
+              prims[i] = PrimRef(refs[i].bounds(),(size_t)refs[i].node);
+            }
+            return pinfo;
+          }, [] (const PrimInfo& a, const PrimInfo& b) { return PrimInfo::merge(a,b); });
+
+        if (pinfo.size() == 0)
+          bvh->set(BVH::emptyNode,empty,0);
+        else
+          bvh->set(buildTopLevel(pinfo),LBBox3fa(pinfo.geomBounds),numPrimitives);
+      }
+
       else
       {     
         /* open all large nodes */
@@ -194,17 +226,7 @@ namespace embree
               [&] (size_t dn) { bvh->scene->progressMonitor(0); },
               refs.data(),extSize,pinfo,settings);
 #else
-            NodeRef root = BVHBuilderBinnedSAH::build<NodeRef>(
-              typename BVH::CreateAlloc(bvh),
-              typename BVH::AABBNode::Create2(),
-              typename BVH::AABBNode::Set2(),
-              
-              [&] (const PrimRef* prims, const range<size_t>& range, const FastAllocator::CachedAllocator& alloc) -> NodeRef {
-                assert(range.size() == 1);
-                return (NodeRef) prims[range.begin()].ID();
-              },
-              [&] (size_t dn) { bvh->scene->progressMonitor(0); },
-              prims.data(),pinfo,settings);
+            NodeRef root = buildTopLevel(pinfo);
 #endif
 
             
@@ -213,6 +235,12 @@ namespace embree
         }
       }  
         
+      if (incremental)
+        recordTopLevel();
+
+      if (buildStats)
+        buildStats->add(BuildStatistics::TOPLEVEL,getSeconds()-t1);
+
       bvh->alloc.cleanup();
       bvh->postBuild(t0);
 #if PROFILE
@@ -223,9 +251,399 @@ namespace embree
 
     }
     
+    template<int N, typename Mesh, typename Primitive>
+    typename BVHNBuilderTwoLevel<N,Mesh,Primitive>::NodeRef BVHNBuilderTwoLevel<N,Mesh,Primitive>::buildTopLevel(const PrimInfo& pinfo)
+    {
+      /* settings for BVH build */
+      GeneralBVHBuilder::Settings settings;
+      settings.branchingFactor = N;
+      settings.maxDepth = BVH::maxBuildDepthLeaf;
+      settings.logBlockSize = bsr(N);
+      settings.minLeafSize = 1;
+      settings.maxLeafSize = 1;
+      settings.travCost = 1.0f;
+      settings.intCost = 1.0f;
+      settings.singleThreadThreshold = singleThreadThreshold;
+
+      return BVHBuilderBinnedSAH::build<NodeRef>(
+        typename BVH::CreateAlloc(bvh),
+        typename BVH::AABBNode::Create2(),
+        typename BVH::AABBNode::Set2(),
+        
+        [&] (const PrimRef* prims, const range<size_t>& range, const FastAllocator::CachedAllocator& alloc) -> NodeRef {
+          assert(range.size() == 1);
+          return (NodeRef) prims[range.begin()].ID();
+        },
+        [&] (size_t dn) { bvh->scene->progressMonitor(0); },
+        prims.data(),pinfo,settings);
+    }
+
+    template<int N, typename Mesh, typename Primitive>
+    void BVHNBuilderTwoLevel<N,Mesh,Primitive>::recordTopLevel()
+    {
+      const size_t num = scene->size();
+      topLevelObjects.clear();
+      topLevelObjects.resize(num);
+      topLevelParents.clear();
+      topLevelObjectRefs.clear();
+      topLevelFreeNodes.clear();
+      topLevelFreeLeaves.clear();
+      topLevelArea = 0.0f;
+      topLevelCost = 0.0f;
+
+      /* map object roots back to objects */
+      for (size_t i=0; i<size_t(nextRef); i++) {
+        topLevelObjects[refs[i].geomID()].numRefs++;
+        topLevelObjectRefs[size_t(refs[i].node)] = refs[i].geomID();
+      }
+
+      /* remember all objects, including enabled objects that did not produce a build primitive */
+      for (size_t objectID=0; objectID<num; objectID++)
+      {
+        Mesh* mesh = scene->getSafe<Mesh>(objectID);
+        if (mesh == nullptr || !mesh->isEnabled() || mesh->numTimeSteps != 1)
+          continue;
+        topLevelObjects[objectID].mesh = mesh;
+        topLevelObjects[objectID].small = isSmallGeometry(mesh);
+      }
+
+      if (bvh->root != BVH::emptyNode)
+        recordTopLevel(bvh->root,TopLevelSlot(nullptr,0));
+
+      const float rootArea = halfArea(bvh->getBounds());
+      topLevelCost = rootArea > 0.0f ? topLevelArea/rootArea : 0.0f;
+      topLevelValid = true;
+    }
+
+    template<int N, typename Mesh, typename Primitive>
+    void BVHNBuilderTwoLevel<N,Mesh,Primitive>::recordTopLevel(NodeRef ref, const TopLevelSlot& slot)
+    {
+      auto object = topLevelObjectRefs.find(size_t(ref));
+      if (object != topLevelObjectRefs.end()) {
+        topLevelObjects[object->second].slot = slot;
+        return;
+      }
+
+      assert(ref.isAABBNode());
+      AABBNode* node = ref.getAABBNode();
+      topLevelParents[node] = slot;
+      topLevelArea += halfArea(node->bounds());
+      for (unsigned int i=0; i<N; i++)
+        if (node->child(i) != BVH::emptyNode)
+          recordTopLevel(node->child(i),TopLevelSlot(node,i));
+    }
+
+    template<int N, typename Mesh, typename Primitive>
+    bool BVHNBuilderTwoLevel<N,Mesh,Primitive>::updateTopLevel()
+    {
+      if (!incremental || !topLevelValid)
+        return false;
+
+      /* objects past the end of the scene got deleted and are removed below */
+      const size_t num = scene->size();
+      const size_t numObjects = max(num,topLevelObjects.size());
+      topLevelObjects.resize(numObjects);
+
+      /* classify objects, removed objects leave the hierarchy and new ones get inserted, modified objects stay in place */
+      std::vector<size_t> removed, inserted, modified;
+      SpinLock listMutex;
+      const bool updatable = parallel_reduce(size_t(0), numObjects, true, [&] (const range<size_t>& r) -> bool
+      {
+        std::vector<size_t> localRemoved, localInserted, localModified;
+        for (size_t objectID=r.begin(); objectID<r.end(); objectID++)
+        {
+          Mesh* mesh = objectID < num ? scene->getSafe<Mesh>(objectID) : nullptr;
+          if (mesh && (!mesh->isEnabled() || mesh->numTimeSteps != 1)) mesh = nullptr;
+
+          /* deleted geometries already have their mesh cleared, but may still occupy a slot */
+          TopLevelObject& object = topLevelObjects[objectID];
+          if (mesh == nullptr || mesh != object.mesh || isSmallGeometry(mesh) != object.small || builders[objectID]->meshQualityChanged(mesh->quality))
+          {
+            if (object.numRefs > 1) return false;
+            if (object.slot.valid()) localRemoved.push_back(objectID);
+            if (mesh) localInserted.push_back(objectID);
+            else object.mesh = nullptr;
+          }
+          else if (mesh && isGeometryModified(objectID))
+          {
+            if (object.numRefs > 1) return false;
+            localModified.push_back(objectID);
+          }
+        }
+        Lock<SpinLock> lock(listMutex);
+        removed .insert(removed .end(),localRemoved .begin(),localRemoved .end());
+        inserted.insert(inserted.end(),localInserted.begin(),localInserted.end());
+        modified.insert(modified.end(),localModified.begin(),localModified.end());
+        return true;
+      }, [] (bool a, bool b) { return a && b; });
+
+      if (!updatable)
+        return false;
+
+      double t0 = bvh->preBuild(TOSTRING(isa) "::BVH" + toString(N) + "BuilderTwoLevelUpdate");
+
+      /* removals first, such that inserted objects can reuse the freed memory */
+      for (size_t i=0; i<removed.size(); i++)
+        removeTopLevel(removed[i]);
+
+      /* setup builders of inserted objects */
+      if (bvh->objects.size() < num) bvh->objects.resize(num);
+      if (builders.size() < num) builders.resize(num);
+      parallel_for(size_t(0), inserted.size(), [&] (const range<size_t>& r)
+      {
+        for (size_t i=r.begin(); i<r.end(); i++)
+        {
+          const size_t objectID = inserted[i];
+          Mesh* mesh = scene->getSafe<Mesh>(objectID);
+          TopLevelObject& object = topLevelObjects[objectID];
+          object = TopLevelObject();
+          object.mesh = mesh;
+          object.small = isSmallGeometry(mesh);
+          if (object.small) setupSmallBuildRefBuilder (objectID, mesh);
+          else              setupLargeBuildRefBuilder (objectID, mesh);
+        }
+      });
+
+      /* build inserted and modified objects */
+      std::vector<size_t> updated(inserted);
+      updated.insert(updated.end(),modified.begin(),modified.end());
+      std::vector<NodeRef> nodes(updated.size());
+      std::vector<BBox3fa> bounds(updated.size());
+      std::atomic<bool> failed(false);
+      parallel_for(size_t(0), updated.size(), [&] (const range<size_t>& r)
+      {
+        for (size_t i=r.begin(); i<r.end(); i++)
+        {
+          const TopLevelSlot& slot = topLevelObjects[updated[i]].slot;
+          nodes[i] = slot.valid() ? getTopLevelRef(slot) : NodeRef(BVH::emptyNode);
+          bounds[i] = empty;
+          if (!builders[updated[i]]->updateBuildRef(this,nodes[i],bounds[i]))
+            failed = true;
+        }
+      });
+
+      /* the top level hierarchy has to get rebuilt when some object needs multiple build primitives */
+      if (failed) {
+        topLevelValid = false;
+        bvh->alloc.cleanup();
+        bvh->postBuild(t0);
+        return false;
+      }
+
+      /* write new object roots into the hierarchy */
+      for (size_t i=0; i<updated.size(); i++)
+      {
+        const size_t objectID = updated[i];
+        TopLevelObject& object = topLevelObjects[objectID];
+
+        if (!object.slot.valid()) {
+          if (!bounds[i].empty()) insertTopLevel(objectID,nodes[i],bounds[i]);
+        }
+        else if (bounds[i].empty()) {
+          removeTopLevel(objectID);
+        }
+        else
+        {
+          const NodeRef ref = getTopLevelRef(object.slot);
+          if (ref != nodes[i]) {
+            topLevelObjectRefs.erase(size_t(ref));
+            topLevelObjectRefs[size_t(nodes[i])] = (unsigned int) objectID;
+          }
+          setTopLevel(object.slot,nodes[i],bounds[i]);
+          refitTopLevel(object.slot.parent);
+        }
+      }
+      topLevelObjects.resize(num);
+
+      bvh->set(bvh->root,bvh->bounds,scene->getNumPrimitives(gtype,false));
+      bvh->alloc.cleanup();
+      bvh->postBuild(t0);
+
+      /* fall back to a full rebuild when the top level quality degraded too much */
+      const float rootArea = halfArea(bvh->getBounds());
+      const float cost = rootArea > 0.0f ? topLevelArea/rootArea : 0.0f;
+      if (cost > scene->device->toplevel_refit_max_sah_growth*topLevelCost) {
+        topLevelValid = false;
+        return false;
+      }
+      return true;
+    }
+
+    template<int N, typename Mesh, typename Primitive>
+    void BVHNBuilderTwoLevel<N,Mesh,Primitive>::removeTopLevel(size_t objectID)
+    {
+      TopLevelObject& object = topLevelObjects[objectID];
+      const TopLevelSlot slot = object.slot;
+      const NodeRef ref = getTopLevelRef(slot);
+      topLevelObjectRefs.erase(size_t(ref));
+      if (object.small) {
+        size_t num; topLevelFreeLeaves.push_back((Primitive*) ref.leaf(num));
+      }
+      object.slot = TopLevelSlot();
+      object.numRefs = 0;
+
+      /* the object was the only one */
+      if (slot.parent == nullptr) {
+        bvh->set(BVH::emptyNode,empty,0);
+        topLevelArea = 0.0f;
+        return;
+      }
+
+      AABBNode* parent = slot.parent;
+      parent->set(slot.slot,BVH::emptyNode,empty);
+
+      size_t numChildren = 0, last = 0;
+      for (size_t i=0; i<N; i++) {
+        if (parent->child(i) == BVH::emptyNode) continue;
+        numChildren++; last = i;
+      }
+      if (numChildren > 1) {
+        refitTopLevel(parent);
+        return;
+      }
+
+      /* replace the parent by its remaining child */
+      const TopLevelSlot parentSlot = topLevelParents[parent];
+      topLevelParents.erase(parent);
+      topLevelArea -= halfArea(getTopLevelBounds(parentSlot));
+      const NodeRef child = parent->child(last);
+      setTopLevel(parentSlot,child,parent->bounds(last));
+      moveTopLevel(child,parentSlot);
+      topLevelFreeNodes.push_back(parent);
+      refitTopLevel(parentSlot.parent);
+    }
+
+    template<int N, typename Mesh, typename Primitive>
+    void BVHNBuilderTwoLevel<N,Mesh,Primitive>::insertTopLevel(size_t objectID, NodeRef ref, const BBox3fa& bounds)
+    {
+      TopLevelObject& object = topLevelObjects[objectID];
+      object.numRefs = 1;
+      topLevelObjectRefs[size_t(ref)] = (unsigned int) objectID;
+
+      if (bvh->root == BVH::emptyNode) {
+        object.slot = TopLevelSlot(nullptr,0);
+        setTopLevel(object.slot,ref,bounds);
+        return;
+      }
+
+      /* descend towards the child whose bounds grow least, free slots are taken right away */
+      TopLevelSlot slot(nullptr,0);
+      NodeRef cur = bvh->root;
+      while (cur.isAABBNode() && topLevelParents.find(cur.getAABBNode()) != topLevelParents.end())
+      {
+        AABBNode* node = cur.getAABBNode();
+        unsigned int best = 0;
+        float bestCost = pos_inf;
+        for (unsigned int i=0; i<N; i++)
+        {
+          if (node->child(i) == BVH::emptyNode) {
+            object.slot = TopLevelSlot(node,i);
+            setTopLevel(object.slot,ref,bounds);
+            refitTopLevel(node);
+            return;
+          }
+          const float cost = halfArea(merge(node->bounds(i),bounds)) - halfArea(node->bounds(i));
+          if (cost < bestCost) { best = i; bestCost = cost; }
+        }
+        slot = TopLevelSlot(node,best);
+        cur = node->child(best);
+      }
+
+      /* pair the object with the reached object inside a new node */
+      const BBox3fa curBounds = getTopLevelBounds(slot);
+      AABBNode* node = allocTopLevelNode();
+      node->set(0,cur,curBounds);
+      node->set(1,ref,bounds);
+      topLevelParents[node] = slot;
+      moveTopLevel(cur,TopLevelSlot(node,0));
+      object.slot = TopLevelSlot(node,1);
+
+      setTopLevel(slot,BVH::encodeNode(node),curBounds);
+      topLevelArea += halfArea(curBounds);
+      refitTopLevel(node);
+    }
+
+    template<int N, typename Mesh, typename Primitive>
+    void BVHNBuilderTwoLevel<N,Mesh,Primitive>::refitTopLevel(AABBNode* node)
+    {
+      while (node)
+      {
+        const BBox3fa bounds = node->bounds();
+        const TopLevelSlot& slot = topLevelParents[node];
+        const BBox3fa oldBounds = getTopLevelBounds(slot);
+        if (bounds == oldBounds) break;
+
+        topLevelArea += halfArea(bounds) - halfArea(oldBounds);
+        setTopLevel(slot,BVH::encodeNode(node),bounds);
+        node = slot.parent;
+      }
+    }
+
+    template<int N, typename Mesh, typename Primitive>
+    typename BVHNBuilderTwoLevel<N,Mesh,Primitive>::NodeRef BVHNBuilderTwoLevel<N,Mesh,Primitive>::getTopLevelRef(const TopLevelSlot& slot) const {
+      return slot.parent ? slot.parent->child(slot.slot) : bvh->root;
+    }
+
+    template<int N, typename Mesh, typename Primitive>
+    BBox3fa BVHNBuilderTwoLevel<N,Mesh,Primitive>::getTopLevelBounds(const TopLevelSlot& slot) const {
+      return slot.parent ? slot.parent->bounds(slot.slot) : bvh->getBounds();
+    }
+
+    template<int N, typename Mesh, typename Primitive>
+    void BVHNBuilderTwoLevel<N,Mesh,Primitive>::setTopLevel(const TopLevelSlot& slot, NodeRef ref, const BBox3fa& bounds)
+    {
+      if (slot.parent) slot.parent->set(slot.slot,ref,bounds);
+      else bvh->set(ref,LBBox3fa(bounds),bvh->numPrimitives);
+    }
+
+    template<int N, typename Mesh, typename Primitive>
+    void BVHNBuilderTwoLevel<N,Mesh,Primitive>::moveTopLevel(NodeRef ref, const TopLevelSlot& slot)
+    {
+      if (ref.isAABBNode()) {
+        auto node = topLevelParents.find(ref.getAABBNode());
+        if (node != topLevelParents.end()) {
+          node->second = slot;
+          return;
+        }
+      }
+      auto object = topLevelObjectRefs.find(size_t(ref));
+      assert(object != topLevelObjectRefs.end());
+      topLevelObjects[object->second].slot = slot;
+    }
+
+    template<int N, typename Mesh, typename Primitive>
+    typename BVHNBuilderTwoLevel<N,Mesh,Primitive>::AABBNode* BVHNBuilderTwoLevel<N,Mesh,Primitive>::allocTopLevelNode()
+    {
+      AABBNode* node = nullptr;
+      if (topLevelFreeNodes.size()) {
+        node = topLevelFreeNodes.back();
+        topLevelFreeNodes.pop_back();
+      } else {
+        node = (AABBNode*) bvh->alloc.getCachedAllocator().malloc0(sizeof(AABBNode),BVH::byteNodeAlignment);
+      }
+      node->clear();
+      return node;
+    }
+
+    template<int N, typename Mesh, typename Primitive>
+    Primitive* BVHNBuilderTwoLevel<N,Mesh,Primitive>::allocTopLevelLeaf()
+    {
+      {
+        Lock<SpinLock> lock(topLevelFreeMutex);
+        if (topLevelFreeLeaves.size()) {
+          Primitive* leaf = topLevelFreeLeaves.back();
+          topLevelFreeLeaves.pop_back();
+          return leaf;
+        }
+      }
+      return (Primitive*) bvh->alloc.getCachedAllocator().malloc1(sizeof(Primitive),BVH::byteAlignment);
+    }
+
     template<int N, typename Mesh, typename Primitive>
     void BVHNBuilderTwoLevel<N,Mesh,Primitive>::deleteGeometry(size_t geomID)
     {
+      /* the object leaves the top level hierarchy at the next build */
+      if (geomID < topLevelObjects.size()) topLevelObjects[geomID].mesh = nullptr;
       if (geomID >= bvh->objects.size()) return;
       if (builders[geomID]) builders[geomID].reset();
       delete bvh->objects [geomID]; bvh->objects [geomID] = nullptr;
@@ -234,6 +652,13 @@ namespace embree
     template<int N, typename Mesh, typename Primitive>
     void BVHNBuilderTwoLevel<N,Mesh,Primitive>::clear()
     {
+      topLevelValid = false;
+      topLevelObjects.clear();
+      topLevelParents.clear();
+      topLevelObjectRefs.clear();
+      topLevelFreeNodes.clear();
+      topLevelFreeLeaves.clear();
+
       for (size_t i=0; i<bvh->objects.size(); i++) 
         if (bvh->objects[i]) bvh->objects[i]->clear();
 
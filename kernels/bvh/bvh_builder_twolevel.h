@@ -4,6 +4,7 @@
 #pragma once
 
 #include <type_traits>
+#include <unordered_map>
 
 #include "bvh_builder_twolevel_internal.h"
 #include "bvh.h"
@@ -116,10 +117,66 @@ namespace embree
       
     private:
 
+      /*! position of an object or node inside the top level hierarchy */
+      struct TopLevelSlot
+      {
+        __forceinline TopLevelSlot () : parent(nullptr), slot(-1) {}
+        __forceinline TopLevelSlot (AABBNode* parent, unsigned int slot) : parent(parent), slot(slot) {}
+
+        __forceinline bool valid() const { return slot != (unsigned int)(-1); }
+
+        AABBNode* parent;   //!< parent node, nullptr for the root
+        unsigned int slot;  //!< child slot inside the parent node
+      };
+
+      /*! state of an object inside the top level hierarchy */
+      struct TopLevelObject
+      {
+        __forceinline TopLevelObject () : mesh(nullptr), small(false), numRefs(0) {}
+
+        Mesh* mesh;            //!< mesh the object got built from
+        bool small;            //!< whether the object got built as small geometry
+        unsigned int numRefs;  //!< number of build primitives of the object
+        TopLevelSlot slot;  //!< position of the object inside the top level hierarchy
+      };
+
+      /*! builds the top level hierarchy without opening object BVHs */
+      NodeRef buildTopLevel(const PrimInfo& pinfo);
+
+      /*! records where each object got placed inside the top level hierarchy */
+      void recordTopLevel();
+      void recordTopLevel(NodeRef ref, const TopLevelSlot& slot);
+
+      /*! updates modified objects in place, removes and inserts objects, and refits their top level paths */
+      bool updateTopLevel();
+
+      /*! removes an object from the top level hierarchy, nodes left with a single child get replaced by that child */
+      void removeTopLevel(size_t objectID);
+
+      /*! inserts an object below the top level node whose bounds grow least */
+      void insertTopLevel(size_t objectID, NodeRef ref, const BBox3fa& bounds);
+
+      /*! refits the top level path from some node towards the root, stops at unchanged nodes */
+      void refitTopLevel(AABBNode* node);
+
+      /*! accessors for the reference and bounds stored at some top level slot */
+      NodeRef getTopLevelRef(const TopLevelSlot& slot) const;
+      BBox3fa getTopLevelBounds(const TopLevelSlot& slot) const;
+      void setTopLevel(const TopLevelSlot& slot, NodeRef ref, const BBox3fa& bounds);
+
+      /*! updates the recorded slot of an object or top level node that got moved */
+      void moveTopLevel(NodeRef ref, const TopLevelSlot& slot);
+
+      /*! allocates top level nodes and small object leaves, memory of removed ones gets reused */
+      AABBNode* allocTopLevelNode();
+      Primitive* allocTopLevelLeaf();
+
       class RefBuilderBase {
       public:
         virtual ~RefBuilderBase () {}
         virtual void attachBuildRefs (BVHNBuilderTwoLevel* builder) = 0;
+        /* returns empty bounds for empty objects and false if the object does not fit into a single top level slot */
+        virtual bool updateBuildRef (BVHNBuilderTwoLevel* builder, NodeRef& node, BBox3fa& bounds) = 0;
         virtual bool meshQualityChanged (RTCBuildQuality currQuality) = 0;
       };
 
@@ -136,7 +193,11 @@ namespace embree
           assert(isSmallGeometry(mesh));
           
           mvector<PrimRef> prefs(topBuilder->scene->device, meshSize);
-          auto pinfo = createPrimRefArray(mesh,objectID_,meshSize,prefs,topBuilder->bvh->scene->progressInterface);
+          PrimInfo pinfo(empty);
+          {
+            BuildStatistics::Timer timer(topBuilder->bvh->getBuildStats(),BuildStatistics::PRIMREFS);
+            pinfo = createPrimRefArray(mesh,objectID_,meshSize,prefs,topBuilder->bvh->scene->progressInterface);
+          }
 
           size_t begin=0;
           while (begin < pinfo.size())
@@ -155,6 +216,35 @@ namespace embree
           assert(begin == pinfo.size());
         }
 
+        /* refills the single leaf block of the object, objects not yet in the hierarchy get a new leaf */
+        bool updateBuildRef (BVHNBuilderTwoLevel* topBuilder, NodeRef& node, BBox3fa& bounds)
+        {
+          Mesh* mesh = topBuilder->scene->template getSafe<Mesh>(objectID_);
+          size_t meshSize = mesh->size();
+
+          mvector<PrimRef> prefs(topBuilder->scene->device, meshSize);
+          PrimInfo pinfo(empty);
+          {
+            BuildStatistics::Timer timer(topBuilder->bvh->getBuildStats(),BuildStatistics::PRIMREFS);
+            pinfo = createPrimRefArray(mesh,objectID_,meshSize,prefs,topBuilder->bvh->scene->progressInterface);
+          }
+          if (pinfo.size() == 0) {
+            bounds = empty;
+            return true;
+          }
+          if (Primitive::blocks(pinfo.size()) != 1)
+            return false;
+
+          if (node == BVH::emptyNode)
+            node = BVH::encodeLeaf((char*)topBuilder->allocTopLevelLeaf(),1);
+
+          size_t num; Primitive* accel = (Primitive*) node.leaf(num);
+          size_t begin=0;
+          accel->fill(prefs.data(),begin,pinfo.size(),topBuilder->bvh->scene);
+          bounds = pinfo.geomBounds;
+          return true;
+        }
+
         bool meshQualityChanged (RTCBuildQuality /*currQuality*/) {
           return false;
         }
@@ -166,7 +256,7 @@ namespace embree
       public:
         
         RefBuilderLarge (size_t objectID, const Ref<Builder>& builder, RTCBuildQuality quality)
-        : objectID_ (objectID), builder_ (builder), quality_ (quality) {}
+        : objectID_ (objectID), builder_ (builder), quality_ (quality), modCounter_ (0) {}
 
         void attachBuildRefs (BVHNBuilderTwoLevel* topBuilder)
         {
@@ -174,7 +264,7 @@ namespace embree
           
           /* build object if it got modified */
           if (topBuilder->isGeometryModified(objectID_))
-            builder_->build();
+            buildObject(topBuilder);
 
           /* create build primitive */
           if (!object->getBounds().empty())
@@ -188,14 +278,45 @@ namespace embree
           }
         }
 
+        /* rebuilds the object BVH, the new root replaces the old one in the top level hierarchy */
+        bool updateBuildRef (BVHNBuilderTwoLevel* topBuilder, NodeRef& node, BBox3fa& bounds)
+        {
+          BVH* object = topBuilder->getBVH(objectID_); assert(object);
+          buildObject(topBuilder);
+          if (object->getBounds().empty()) {
+            bounds = empty;
+            return true;
+          }
+
+          node = object->root;
+          bounds = object->getBounds();
+          return true;
+        }
+
         bool meshQualityChanged (RTCBuildQuality currQuality) {
           return currQuality != quality_;
         }
 
+      private:
+
+        /* skips the build if the current geometry version got already build by a failed incremental update */
+        void buildObject (BVHNBuilderTwoLevel* topBuilder)
+        {
+          const unsigned int modCounter = topBuilder->getMesh(objectID_)->getModCounter();
+          if (modCounter == modCounter_) return;
+          builder_->build();
+          modCounter_ = modCounter;
+
+          /* the object build is part of the build of the top level BVH */
+          if (BuildStatistics* buildStats = topBuilder->bvh->getBuildStats())
+            buildStats->add(topBuilder->getBVH(objectID_)->buildStats);
+        }
+
       private:
         size_t          objectID_;
         Ref<Builder>    builder_;
         RTCBuildQuality quality_;
+        unsigned int    modCounter_;
       };
 
       void setupLargeBuildRefBuilder (size_t objectID, Mesh const * const mesh);
@@ -248,6 +369,7 @@ namespace embree
 
       using BuilderList = std::vector<std::unique_ptr<RefBuilderBase>>;
 
+
       BuilderList         builders;
       BVH*                bvh;
       Scene*              scene;      
@@ -257,6 +379,18 @@ namespace embree
       const size_t        singleThreadThreshold;
       Geometry::GTypeMask gtype;
       bool                useMortonBuilder_ = false;
+
+      /* incremental top level updates */
+      bool                incremental;     //!< keep the top level hierarchy and update it for changed objects
+      bool                topLevelValid;   //!< true if the recorded top level state matches the BVH
+      std::vector<TopLevelObject> topLevelObjects;
+      std::unordered_map<AABBNode*,TopLevelSlot> topLevelParents;
+      std::unordered_map<size_t,unsigned int> topLevelObjectRefs; //!< maps object roots inside the top level hierarchy to objects
+      std::vector<AABBNode*> topLevelFreeNodes;  //!< nodes freed by removals
+      std::vector<Primitive*> topLevelFreeLeaves; //!< leaves of removed small objects
+      SpinLock            topLevelFreeMutex;
+      float               topLevelArea;    //!< sum of the surface areas of all top level nodes
+      float               topLevelCost;    //!< relative top level SAH cost after last full build
     };
   }
 }
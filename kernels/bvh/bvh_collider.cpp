@@ -12,30 +12,10 @@ namespace embree
   {
 #define CSTAT(x)
 
-    size_t parallel_depth_threshold = 3;
     CSTAT(std::atomic<size_t> bvh_collide_traversal_steps(0));
     CSTAT(std::atomic<size_t> bvh_collide_leaf_pairs(0));
-    CSTAT(std::atomic<size_t> bvh_collide_leaf_iterations(0));
-    CSTAT(std::atomic<size_t> bvh_collide_prim_intersections1(0));
-    CSTAT(std::atomic<size_t> bvh_collide_prim_intersections2(0));
-    CSTAT(std::atomic<size_t> bvh_collide_prim_intersections3(0));
-    CSTAT(std::atomic<size_t> bvh_collide_prim_intersections4(0));
-    CSTAT(std::atomic<size_t> bvh_collide_prim_intersections5(0));
     CSTAT(std::atomic<size_t> bvh_collide_prim_intersections(0));
 
-    struct Collision
-    {
-      __forceinline Collision() {}
-
-      __forceinline Collision (unsigned geomID0, unsigned primID0, unsigned geomID1, unsigned primID1)
-        : geomID0(geomID0), primID0(primID0), geomID1(geomID1), primID1(primID1) {}
-
-      unsigned geomID0;
-      unsigned primID0;
-      unsigned geomID1;
-      unsigned primID1;
-    };
-    
     template<int N>
     __forceinline size_t overlap(const BBox3fa& box0, const typename BVHN<N>::AABBNode& node1)
     {
@@ -48,245 +28,263 @@ namespace embree
       return movemask((lower_x <= upper_x) & (lower_y <= upper_y) & (lower_z <= upper_z));
     }
 
+    /*! calculates for each child i of node0 the mask of children of node1 that overlap child i, thus
+     *  the NxN overlap matrix of all child pairs, rows of children of node0 outside box1 stay zero */
     template<int N>
-    __forceinline size_t overlap(const BBox3fa& box0, const BBox<Vec3<vfloat<N>>>& box1)
+    __forceinline void overlap(const typename BVHN<N>::AABBNode& node0, const typename BVHN<N>::AABBNode& node1, const BBox3fa& box1, size_t matrix[N])
     {
-      const vfloat<N> lower_x = max(vfloat<N>(box0.lower.x),box1.lower.x);
-      const vfloat<N> lower_y = max(vfloat<N>(box0.lower.y),box1.lower.y);
-      const vfloat<N> lower_z = max(vfloat<N>(box0.lower.z),box1.lower.z);
-      const vfloat<N> upper_x = min(vfloat<N>(box0.upper.x),box1.upper.x);
-      const vfloat<N> upper_y = min(vfloat<N>(box0.upper.y),box1.upper.y);
-      const vfloat<N> upper_z = min(vfloat<N>(box0.upper.z),box1.upper.z);
-      return movemask((lower_x <= upper_x) & (lower_y <= upper_y) & (lower_z <= upper_z));
+      /* children of node0 outside the bounds of node1 cannot overlap any child of node1 */
+      const size_t mask0 = overlap<N>(box1,node0);
+      for (size_t i=0; i<N; i++)
+      {
+        matrix[i] = 0;
+        if (!(mask0 & (size_t(1) << i))) continue;
+        const vfloat<N> lower_x = max(vfloat<N>(node0.lower_x[i]),node1.lower_x);
+        const vfloat<N> lower_y = max(vfloat<N>(node0.lower_y[i]),node1.lower_y);
+        const vfloat<N> lower_z = max(vfloat<N>(node0.lower_z[i]),node1.lower_z);
+        const vfloat<N> upper_x = min(vfloat<N>(node0.upper_x[i]),node1.upper_x);
+        const vfloat<N> upper_y = min(vfloat<N>(node0.upper_y[i]),node1.upper_y);
+        const vfloat<N> upper_z = min(vfloat<N>(node0.upper_z[i]),node1.upper_z);
+        matrix[i] = movemask((lower_x <= upper_x) & (lower_y <= upper_y) & (lower_z <= upper_z));
+      }
     }
 
-    template<int N>
-    __forceinline size_t overlap(const BBox<Vec3<vfloat<N>>>& box0, size_t i, const BBox<Vec3<vfloat<N>>>& box1)
+    /*! returns the vertex indices and vertices of a triangle or quad, or 0 for other geometries */
+    __forceinline size_t getPolygon(const Geometry* geom, unsigned primID, unsigned v[4], Vec3fa p[4])
     {
-      const vfloat<N> lower_x = max(vfloat<N>(box0.lower.x[i]),box1.lower.x);
-      const vfloat<N> lower_y = max(vfloat<N>(box0.lower.y[i]),box1.lower.y);
-      const vfloat<N> lower_z = max(vfloat<N>(box0.lower.z[i]),box1.lower.z);
-      const vfloat<N> upper_x = min(vfloat<N>(box0.upper.x[i]),box1.upper.x);
-      const vfloat<N> upper_y = min(vfloat<N>(box0.upper.y[i]),box1.upper.y);
-      const vfloat<N> upper_z = min(vfloat<N>(box0.upper.z[i]),box1.upper.z);
-      return movemask((lower_x <= upper_x) & (lower_y <= upper_y) & (lower_z <= upper_z));
+      if (geom->getType() == Geometry::GTY_TRIANGLE_MESH)
+      {
+        const TriangleMesh* mesh = (const TriangleMesh*) geom;
+        const TriangleMesh::Triangle& tri = mesh->triangle(primID);
+        for (size_t i=0; i<3; i++) {
+          v[i] = tri.v[i];
+          p[i] = mesh->vertex(tri.v[i]);
+        }
+        return 3;
+      }
+      else if (geom->getType() == Geometry::GTY_QUAD_MESH)
+      {
+        const QuadMesh* mesh = (const QuadMesh*) geom;
+        const QuadMesh::Quad& quad = mesh->quad(primID);
+        for (size_t i=0; i<4; i++) {
+          v[i] = quad.v[i];
+          p[i] = mesh->vertex(quad.v[i]);
+        }
+        return 4;
+      }
+      return 0;
     }
 
-    bool intersect_triangle_triangle (Scene* scene0, unsigned geomID0, unsigned primID0, Scene* scene1, unsigned geomID1, unsigned primID1)
+    /*! tests two triangles or quads for intersection, pairs involving other geometries are
+     *  passed on to the user callback unfiltered */
+    bool intersect_primitives (Scene* scene0, unsigned geomID0, unsigned primID0, Scene* scene1, unsigned geomID1, unsigned primID1)
     {
-      CSTAT(bvh_collide_prim_intersections1++);
-      const TriangleMesh* mesh0 = scene0->get<TriangleMesh>(geomID0);
-      const TriangleMesh* mesh1 = scene1->get<TriangleMesh>(geomID1);
-      const TriangleMesh::Triangle& tri0 = mesh0->triangle(primID0);
-      const TriangleMesh::Triangle& tri1 = mesh1->triangle(primID1);
-      
-      /* special culling for scene intersection with itself */
+      CSTAT(bvh_collide_prim_intersections++);
+      unsigned va[4]; Vec3fa a[4];
+      unsigned vb[4]; Vec3fa b[4];
+      const size_t na = getPolygon(scene0->get(geomID0),primID0,va,a);
+      if (na == 0) return true;
+      const size_t nb = getPolygon(scene1->get(geomID1),primID1,vb,b);
+      if (nb == 0) return true;
+
+      /* ignore intersection with topological neighbors */
       if (scene0 == scene1 && geomID0 == geomID1)
       {
-        /* ignore self intersections */
-        if (primID0 == primID1)
-          return false;
+        const vint4 t0(va[0],va[1],va[2],va[na-1]);
+        for (size_t i=0; i<nb; i++)
+          if (any(vint4(vb[i]) == t0)) return false;
       }
-      CSTAT(bvh_collide_prim_intersections2++);
-      
-      if (scene0 == scene1 && geomID0 == geomID1)
+
+      /* quads get split into the triangles (v0,v1,v3) and (v2,v3,v1) */
+      const size_t ta = na == 4 ? 2 : 1;
+      const size_t tb = nb == 4 ? 2 : 1;
+      for (size_t i=0; i<ta; i++)
       {
-        /* ignore intersection with topological neighbors */
-        const vint4 t0(tri0.v[0],tri0.v[1],tri0.v[2],tri0.v[2]);
-        if (any(vint4(tri1.v[0]) == t0)) return false;
-        if (any(vint4(tri1.v[1]) == t0)) return false;
-        if (any(vint4(tri1.v[2]) == t0)) return false;
+        const Vec3fa& a0 = i == 0 ? a[0] : a[2];
+        const Vec3fa& a1 = i == 0 ? a[1] : a[3];
+        const Vec3fa& a2 = i == 0 ? a[na-1] : a[1];
+        for (size_t j=0; j<tb; j++)
+        {
+          const Vec3fa& b0 = j == 0 ? b[0] : b[2];
+          const Vec3fa& b1 = j == 0 ? b[1] : b[3];
+          const Vec3fa& b2 = j == 0 ? b[nb-1] : b[1];
+          if (TriangleTriangleIntersector::intersect_triangle_triangle(a0,a1,a2,b0,b1,b2))
+            return true;
+        }
       }
-      CSTAT(bvh_collide_prim_intersections3++);
-      
-      const Vec3fa a0 = mesh0->vertex(tri0.v[0]);
-      const Vec3fa a1 = mesh0->vertex(tri0.v[1]);
-      const Vec3fa a2 = mesh0->vertex(tri0.v[2]);
-      const Vec3fa b0 = mesh1->vertex(tri1.v[0]);
-      const Vec3fa b1 = mesh1->vertex(tri1.v[1]);
-      const Vec3fa b2 = mesh1->vertex(tri1.v[2]);
-      
-      return TriangleTriangleIntersector::intersect_triangle_triangle(a0,a1,a2,b0,b1,b2);
+      return false;
     }
-    
+
     template<int N>
-    __forceinline void BVHNColliderUserGeom<N>::processLeaf(NodeRef node0, NodeRef node1)
+    template<typename Primitive>
+    size_t BVHNCollider<N>::gatherLeaf(NodeRef ref, LeafPrim* prims)
     {
-      Collision collisions[16];
-      size_t num_collisions = 0;
+      size_t num; const Primitive* leaf = (const Primitive*) ref.leaf(num);
+      size_t n = 0;
+      for (size_t k=0; k<num; k++) {
+        for (size_t i=0; i<Primitive::max_size(); i++) {
+          if (!leaf[k].valid(i)) break;
+          prims[n].geomID = leaf[k].geomID(i);
+          prims[n].primID = leaf[k].primID(i);
+          n++;
+        }
+      }
+      return n;
+    }
 
-      size_t N0; Object* leaf0 = (Object*) node0.leaf(N0);
-      size_t N1; Object* leaf1 = (Object*) node1.leaf(N1);
+    template<int N>
+    size_t BVHNCollider<N>::gatherObjectLeaf(NodeRef ref, LeafPrim* prims)
+    {
+      size_t num; const Object* leaf = (const Object*) ref.leaf(num);
+      for (size_t k=0; k<num; k++) {
+        prims[k].geomID = leaf[k].geomID();
+        prims[k].primID = leaf[k].primID();
+      }
+      return num;
+    }
+
+    template<int N>
+    typename BVHNCollider<N>::GatherLeafFunc BVHNCollider<N>::selectGatherLeaf(const BVH* bvh)
+    {
+      if (bvh->primTy == &Object::type    ) return gatherObjectLeaf;
+      if (bvh->primTy == &Triangle4::type ) return gatherLeaf<Triangle4>;
+      if (bvh->primTy == &Triangle4v::type) return gatherLeaf<Triangle4v>;
+      if (bvh->primTy == &Triangle4i::type) return gatherLeaf<Triangle4i>;
+      if (bvh->primTy == &Triangle4q::type) return gatherLeaf<Triangle4q>;
+      if (bvh->primTy == &Quad4v::type    ) return gatherLeaf<Quad4v>;
+      if (bvh->primTy == &Quad4i::type    ) return gatherLeaf<Quad4i>;
+      throw_RTCError(RTC_ERROR_INVALID_OPERATION,"collision detection not supported for this scene");
+    }
+
+    template<int N>
+    BVHNCollider<N>::BVHNCollider (BVH* bvh0, BVH* bvh1, RTCCollideFunc callback, void* userPtr)
+      : scene0(bvh0->scene), scene1(bvh1->scene),
+        gatherLeaf0(selectGatherLeaf(bvh0)), gatherLeaf1(selectGatherLeaf(bvh1)),
+        callback(callback), userPtr(userPtr) {}
+
+    template<int N>
+    __forceinline void BVHNCollider<N>::processLeaf(NodeRef node0, NodeRef node1, CollisionBuffer& collisions)
+    {
+      LeafPrim prims0[MAX_LEAF_PRIMS];
+      LeafPrim prims1[MAX_LEAF_PRIMS];
+      const size_t N0 = gatherLeaf0(node0,prims0);
+      const size_t N1 = gatherLeaf1(node1,prims1);
       for (size_t i=0; i<N0; i++) {
         for (size_t j=0; j<N1; j++) {
-          const unsigned geomID0 = leaf0[i].geomID();
-          const unsigned primID0 = leaf0[i].primID();
-          const unsigned geomID1 = leaf1[j].geomID();
-          const unsigned primID1 = leaf1[j].primID();
+          const unsigned geomID0 = prims0[i].geomID;
+          const unsigned primID0 = prims0[i].primID;
+          const unsigned geomID1 = prims1[j].geomID;
+          const unsigned primID1 = prims1[j].primID;
           if (this->scene0 == this->scene1 && geomID0 == geomID1 && primID0 == primID1) continue;
-          collisions[num_collisions++] = Collision(geomID0,primID0,geomID1,primID1);
-          if (num_collisions == 16) {
-            this->callback(this->userPtr,(RTCCollision*)&collisions,num_collisions);
-            num_collisions = 0;
-          }
+          if (!intersect_primitives(this->scene0,geomID0,primID0,this->scene1,geomID1,primID1)) continue;
+          collisions.add(geomID0,primID0,geomID1,primID1);
         }
       }
-      if (num_collisions)
-        this->callback(this->userPtr,(RTCCollision*)&collisions,num_collisions);
     }
 
     template<int N>
-    void BVHNCollider<N>::collide_recurse(NodeRef ref0, const BBox3fa& bounds0, NodeRef ref1, const BBox3fa& bounds1, size_t depth0, size_t depth1)
+    void BVHNCollider<N>::collide_recurse(NodeRef ref0, const BBox3fa& bounds0, NodeRef ref1, const BBox3fa& bounds1, CollisionBuffer& collisions)
     {
       CSTAT(bvh_collide_traversal_steps++);
-      if (unlikely(ref0.isLeaf())) {
+      if (unlikely(ref0.isLeaf()))
+      {
         if (unlikely(ref1.isLeaf())) {
           CSTAT(bvh_collide_leaf_pairs++);
-          processLeaf(ref0,ref1);
+          processLeaf(ref0,ref1,collisions);
           return;
-        } else goto recurse_node1;
-        
-      } else {
-        if (unlikely(ref1.isLeaf())) {
-          goto recurse_node0;
-        } else {
-          if (area(bounds0) > area(bounds1)) {
-            goto recurse_node0;
-          }
-          else {
-            goto recurse_node1;
-          }
         }
-      }
 
-      {
-      recurse_node0:
-        AABBNode* node0 = ref0.getAABBNode();
-        size_t mask = overlap<N>(bounds1,*node0);
-        //for (size_t m=mask, i=bsf(m); m!=0; m=btc(m,i), i=bsf(m)) {
-        //for (size_t i=0; i<N; i++) {
-#if 0
-        if (depth0 < parallel_depth_threshold) 
-        {
-          parallel_for(size_t(N), [&] ( size_t i ) {
-              if (mask & ( 1 << i)) {
-                BVHN<N>::prefetch(node0->child(i),BVH_FLAG_ALIGNED_NODE);
-                collide_recurse(node0->child(i),node0->bounds(i),ref1,bounds1,depth0+1,depth1);
-              }
-            });
-        } 
-        else
-#endif
-        {
-          for (size_t m=mask, i=bsf(m); m!=0; m=btc(m,i), i=bsf(m)) {
-            BVHN<N>::prefetch(node0->child(i),BVH_FLAG_ALIGNED_NODE);
-            collide_recurse(node0->child(i),node0->bounds(i),ref1,bounds1,depth0+1,depth1);
-          }
+        const AABBNode* node1 = ref1.getAABBNode();
+        const size_t mask = overlap<N>(bounds0,*node1);
+        for (size_t m=mask, i=bsf(m); m!=0; m=btc(m,i), i=bsf(m)) {
+          BVHN<N>::prefetch(node1->child(i),BVH_FLAG_ALIGNED_NODE);
+          collide_recurse(ref0,bounds0,node1->child(i),node1->bounds(i),collisions);
         }
-        return;
       }
-      
+      else if (unlikely(ref1.isLeaf()))
       {
-      recurse_node1:
-        AABBNode* node1 = ref1.getAABBNode();
-        size_t mask = overlap<N>(bounds0,*node1);
-        //for (size_t m=mask, i=bsf(m); m!=0; m=btc(m,i), i=bsf(m)) {
-        //for (size_t i=0; i<N; i++) {
-#if 0
-        if (depth1 < parallel_depth_threshold) 
-        {
-          parallel_for(size_t(N), [&] ( size_t i ) {
-              if (mask & ( 1 << i)) {
-                BVHN<N>::prefetch(node1->child(i),BVH_FLAG_ALIGNED_NODE);
-                collide_recurse(ref0,bounds0,node1->child(i),node1->bounds(i),depth0,depth1+1);
-              }
-            });
+        const AABBNode* node0 = ref0.getAABBNode();
+        const size_t mask = overlap<N>(bounds1,*node0);
+        for (size_t m=mask, i=bsf(m); m!=0; m=btc(m,i), i=bsf(m)) {
+          BVHN<N>::prefetch(node0->child(i),BVH_FLAG_ALIGNED_NODE);
+          collide_recurse(node0->child(i),node0->bounds(i),ref1,bounds1,collisions);
         }
-        else
-#endif
-        {
-          for (size_t m=mask, i=bsf(m); m!=0; m=btc(m,i), i=bsf(m)) {
-            BVHN<N>::prefetch(node1->child(i),BVH_FLAG_ALIGNED_NODE);
-            collide_recurse(ref0,bounds0,node1->child(i),node1->bounds(i),depth0,depth1+1);
+      }
+
+      /* descend into both nodes at once using the overlap matrix of all child pairs */
+      else
+      {
+        const AABBNode* node0 = ref0.getAABBNode();
+        const AABBNode* node1 = ref1.getAABBNode();
+        size_t matrix[N];
+        overlap<N>(*node0,*node1,bounds1,matrix);
+        for (size_t i=0; i<N; i++) {
+          for (size_t m=matrix[i], j=bsf(m); m!=0; m=btc(m,j), j=bsf(m)) {
+            BVHN<N>::prefetch(node1->child(j),BVH_FLAG_ALIGNED_NODE);
+            collide_recurse(node0->child(i),node0->bounds(i),node1->child(j),node1->bounds(j),collisions);
           }
         }
-        return;
       }
     }
 
     template<int N>
     void BVHNCollider<N>::split(const CollideJob& job, jobvector& jobs)
     {
-      if (unlikely(job.ref0.isLeaf())) {
+      if (unlikely(job.ref0.isLeaf()))
+      {
         if (unlikely(job.ref1.isLeaf())) {
           jobs.push_back(job);
           return;
-        } else goto recurse_node1;
-      } else {
-        if (unlikely(job.ref1.isLeaf())) {
-          goto recurse_node0;
-        } else {
-          if (area(job.bounds0) > area(job.bounds1)) {
-            goto recurse_node0;
-          }
-          else {
-            goto recurse_node1;
-          }
         }
+
+        const AABBNode* node1 = job.ref1.getAABBNode();
+        const size_t mask = overlap<N>(job.bounds0,*node1);
+        for (size_t m=mask, i=bsf(m); m!=0; m=btc(m,i), i=bsf(m))
+          jobs.push_back(CollideJob(job.ref0,job.bounds0,node1->child(i),node1->bounds(i)));
       }
-      
+      else if (unlikely(job.ref1.isLeaf()))
       {
-      recurse_node0:
         const AABBNode* node0 = job.ref0.getAABBNode();
-        size_t mask = overlap<N>(job.bounds1,*node0);
-        for (size_t m=mask, i=bsf(m); m!=0; m=btc(m,i), i=bsf(m)) {
-          jobs.push_back(CollideJob(node0->child(i),node0->bounds(i),job.depth0+1,job.ref1,job.bounds1,job.depth1));
-        }
-        return;
+        const size_t mask = overlap<N>(job.bounds1,*node0);
+        for (size_t m=mask, i=bsf(m); m!=0; m=btc(m,i), i=bsf(m))
+          jobs.push_back(CollideJob(node0->child(i),node0->bounds(i),job.ref1,job.bounds1));
       }
-      
+      else
       {
-      recurse_node1:
+        const AABBNode* node0 = job.ref0.getAABBNode();
         const AABBNode* node1 = job.ref1.getAABBNode();
-        size_t mask = overlap<N>(job.bounds0,*node1);
-        for (size_t m=mask, i=bsf(m); m!=0; m=btc(m,i), i=bsf(m)) {
-          jobs.push_back(CollideJob(job.ref0,job.bounds0,job.depth0,node1->child(i),node1->bounds(i),job.depth1+1));
-        }
-        return;
+        size_t matrix[N];
+        overlap<N>(*node0,*node1,job.bounds1,matrix);
+        for (size_t i=0; i<N; i++)
+          for (size_t m=matrix[i], j=bsf(m); m!=0; m=btc(m,j), j=bsf(m))
+            jobs.push_back(CollideJob(node0->child(i),node0->bounds(i),node1->child(j),node1->bounds(j)));
       }
     }
-    
+
     template<int N>
     void BVHNCollider<N>::collide_recurse_entry(NodeRef ref0, const BBox3fa& bounds0, NodeRef ref1, const BBox3fa& bounds1)
     {
       CSTAT(bvh_collide_traversal_steps = 0);
       CSTAT(bvh_collide_leaf_pairs = 0);
-      CSTAT(bvh_collide_leaf_iterations = 0);
-      CSTAT(bvh_collide_prim_intersections1 = 0);
-      CSTAT(bvh_collide_prim_intersections2 = 0);
-      CSTAT(bvh_collide_prim_intersections3 = 0);
-      CSTAT(bvh_collide_prim_intersections4 = 0);
-      CSTAT(bvh_collide_prim_intersections5 = 0);
       CSTAT(bvh_collide_prim_intersections = 0);
-#if 0
-      collide_recurse(ref0,bounds0,ref1,bounds1,0,0);
-#else
-      const int M = 2048;
+
+      /* a single split step produces up to NxN jobs */
+      const size_t M = 2048;
       jobvector jobs[2];
       jobs[0].reserve(M);
       jobs[1].reserve(M);
-      jobs[0].push_back(CollideJob(ref0,bounds0,0,ref1,bounds1,0));
+      jobs[0].push_back(CollideJob(ref0,bounds0,ref1,bounds1));
       int source = 0;
       int target = 1;
 
       /* try to split job until job list is full */
-      while (jobs[source].size()+8 <= M)
+      while (jobs[source].size()+N*N <= M)
       {
         for (size_t i=0; i<jobs[source].size(); i++)
         {
           const CollideJob& job = jobs[source][i];
           size_t remaining = jobs[source].size()-i;
-          if (jobs[target].size()+remaining+8 > M) {
+          if (jobs[target].size()+remaining+N*N > M) {
             jobs[target].push_back(job);
           } else {
             split(job,jobs[target]);
@@ -301,29 +299,30 @@ namespace embree
         std::swap(source,target);
       }
 
-      /* parallel processing of all jobs */
-      parallel_for(size_t(jobs[source].size()), [&] ( size_t i ) {
-          CollideJob& j = jobs[source][i];
-          collide_recurse(j.ref0,j.bounds0,j.ref1,j.bounds1,j.depth0,j.depth1);
+      /* parallel processing of all jobs, each task gathers the collisions of several jobs to
+       * invoke the callback with large batches */
+      const size_t numJobs = jobs[source].size();
+      const size_t blockSize = max(size_t(1),numJobs/(4*TaskScheduler::threadCount()));
+      parallel_for(size_t(0), numJobs, blockSize, [&] (const range<size_t>& r) {
+          CollisionBuffer collisions(callback,userPtr);
+          for (size_t i=r.begin(); i<r.end(); i++) {
+            const CollideJob& j = jobs[source][i];
+            collide_recurse(j.ref0,j.bounds0,j.ref1,j.bounds1,collisions);
+          }
         });
-      
-      
-#endif
+
       CSTAT(PRINT(bvh_collide_traversal_steps));
       CSTAT(PRINT(bvh_collide_leaf_pairs));
-      CSTAT(PRINT(bvh_collide_leaf_iterations));
-      CSTAT(PRINT(bvh_collide_prim_intersections1));
-      CSTAT(PRINT(bvh_collide_prim_intersections2));
-      CSTAT(PRINT(bvh_collide_prim_intersections3));
-      CSTAT(PRINT(bvh_collide_prim_intersections4));
-      CSTAT(PRINT(bvh_collide_prim_intersections5));
       CSTAT(PRINT(bvh_collide_prim_intersections));
     }
-   
+
     template<int N>
-    void BVHNColliderUserGeom<N>::collide(BVH* __restrict__ bvh0, BVH* __restrict__ bvh1, RTCCollideFunc callback, void* userPtr)
-    { 
-      BVHNColliderUserGeom<N>(bvh0->scene,bvh1->scene,callback,userPtr).
+    void BVHNCollider<N>::collide(BVH* __restrict__ bvh0, BVH* __restrict__ bvh1, RTCCollideFunc callback, void* userPtr)
+    {
+      if (bvh0->root == BVH::emptyNode || bvh1->root == BVH::emptyNode)
+        return;
+
+      BVHNCollider<N>(bvh0,bvh1,callback,userPtr).
         collide_recurse_entry(bvh0->root,bvh0->bounds.bounds(),bvh1->root,bvh1->bounds.bounds());
     }
 
@@ -368,10 +367,10 @@ namespace embree
     /// Collider Definitions
     ////////////////////////////////////////////////////////////////////////////////
 
-    DEFINE_COLLIDER(BVH4ColliderUserGeom,BVHNColliderUserGeom<4>);
+    DEFINE_COLLIDER(BVH4Collider,BVHNCollider<4>);
 
 #if defined(__AVX__)
-    DEFINE_COLLIDER(BVH8ColliderUserGeom,BVHNColliderUserGeom<8>);
+    DEFINE_COLLIDER(BVH8Collider,BVHNCollider<8>);
 #endif
   }
 }
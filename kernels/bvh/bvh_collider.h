@@ -4,13 +4,62 @@
 #pragma once
 
 #include "bvh.h"
+#include "../geometry/triangle.h"
 #include "../geometry/trianglev.h"
+#include "../geometry/trianglei.h"
+#include "../geometry/triangleq.h"
+#include "../geometry/quadv.h"
+#include "../geometry/quadi.h"
 #include "../geometry/object.h"
 
 namespace embree
 {
   namespace isa
   {
+    /*! collisions are reported to the user in batches of this size */
+    static const size_t COLLISION_BUFFER_SIZE = 1024;
+
+    struct Collision
+    {
+      __forceinline Collision() {}
+
+      __forceinline Collision (unsigned geomID0, unsigned primID0, unsigned geomID1, unsigned primID1)
+        : geomID0(geomID0), primID0(primID0), geomID1(geomID1), primID1(primID1) {}
+
+      unsigned geomID0;
+      unsigned primID0;
+      unsigned geomID1;
+      unsigned primID1;
+    };
+
+    /*! gathers collisions of one task and passes them in large batches to the callback */
+    struct CollisionBuffer
+    {
+      __forceinline CollisionBuffer (RTCCollideFunc callback, void* userPtr)
+        : callback(callback), userPtr(userPtr), num(0) {}
+
+      __forceinline ~CollisionBuffer () {
+        flush();
+      }
+
+      __forceinline void add(unsigned geomID0, unsigned primID0, unsigned geomID1, unsigned primID1)
+      {
+        collisions[num++] = Collision(geomID0,primID0,geomID1,primID1);
+        if (unlikely(num == COLLISION_BUFFER_SIZE)) flush();
+      }
+
+      __forceinline void flush()
+      {
+        if (num) callback(userPtr,(RTCCollision*)collisions,(unsigned int)num);
+        num = 0;
+      }
+
+      RTCCollideFunc callback;
+      void* userPtr;
+      size_t num;
+      Collision collisions[COLLISION_BUFFER_SIZE];
+    };
+
     template<int N>
       class BVHNCollider
     {
@@ -18,55 +67,57 @@ namespace embree
       typedef typename BVH::NodeRef NodeRef;
       typedef typename BVH::AABBNode AABBNode;
 
+      /*! geometry and primitive ID of a primitive in a leaf */
+      struct LeafPrim
+      {
+        unsigned geomID;
+        unsigned primID;
+      };
+
+      /*! maximal number of primitives of a leaf */
+      static const size_t MAX_LEAF_PRIMS = BVH::maxLeafBlocks*4;
+
+      typedef size_t (*GatherLeafFunc)(NodeRef leaf, LeafPrim* prims);
+
+      template<typename Primitive>
+      static size_t gatherLeaf(NodeRef leaf, LeafPrim* prims);
+      static size_t gatherObjectLeaf(NodeRef leaf, LeafPrim* prims);
+      static GatherLeafFunc selectGatherLeaf(const BVH* bvh);
+
       struct CollideJob
       {
         CollideJob () {}
-        
-        CollideJob (NodeRef ref0, const BBox3fa& bounds0, size_t depth0,
-                    NodeRef ref1, const BBox3fa& bounds1, size_t depth1)
-        : ref0(ref0), bounds0(bounds0), depth0(depth0), ref1(ref1), bounds1(bounds1), depth1(depth1) {}
-        
+
+        CollideJob (NodeRef ref0, const BBox3fa& bounds0, NodeRef ref1, const BBox3fa& bounds1)
+        : ref0(ref0), bounds0(bounds0), ref1(ref1), bounds1(bounds1) {}
+
         NodeRef ref0;
         BBox3fa bounds0;
-        size_t depth0;
         NodeRef ref1;
         BBox3fa bounds1;
-        size_t depth1;
       };
 
       typedef vector_t<CollideJob, aligned_allocator<CollideJob,16>> jobvector;
 
       void split(const CollideJob& job, jobvector& jobs);
-      
+
     public:
-      __forceinline BVHNCollider (Scene* scene0, Scene* scene1, RTCCollideFunc callback, void* userPtr)
-        : scene0(scene0), scene1(scene1), callback(callback), userPtr(userPtr) {}
+      BVHNCollider (BVH* bvh0, BVH* bvh1, RTCCollideFunc callback, void* userPtr);
 
     public:
-      virtual void processLeaf(NodeRef leaf0, NodeRef leaf1) = 0;
-      void collide_recurse(NodeRef node0, const BBox3fa& bounds0, NodeRef node1, const BBox3fa& bounds1, size_t depth0, size_t depth1);
+      void processLeaf(NodeRef leaf0, NodeRef leaf1, CollisionBuffer& collisions);
+      void collide_recurse(NodeRef node0, const BBox3fa& bounds0, NodeRef node1, const BBox3fa& bounds1, CollisionBuffer& collisions);
       void collide_recurse_entry(NodeRef node0, const BBox3fa& bounds0, NodeRef node1, const BBox3fa& bounds1);
-    
+
+      static void collide(BVH* __restrict__ bvh0, BVH* __restrict__ bvh1, RTCCollideFunc callback, void* userPtr);
+
     protected:
       Scene* scene0;
       Scene* scene1;
+      GatherLeafFunc gatherLeaf0;
+      GatherLeafFunc gatherLeaf1;
       RTCCollideFunc callback;
       void* userPtr;
     };
-
-    template<int N>
-      class BVHNColliderUserGeom : public BVHNCollider<N>
-    {
-      typedef BVHN<N> BVH;
-      typedef typename BVH::NodeRef NodeRef;
-      typedef typename BVH::AABBNode AABBNode;
-
-      __forceinline BVHNColliderUserGeom (Scene* scene0, Scene* scene1, RTCCollideFunc callback, void* userPtr)
-        : BVHNCollider<N>(scene0,scene1,callback,userPtr) {}
-
-      virtual void processLeaf(NodeRef leaf0, NodeRef leaf1);
-    public:
-      static void collide(BVH* __restrict__ bvh0, BVH* __restrict__ bvh1, RTCCollideFunc callback, void* userPtr);
-    };
   }
 }
@@ -10,6 +10,8 @@
 #include "../geometry/trianglev_intersector.h"
 #include "../geometry/trianglev_mb_intersector.h"
 #include "../geometry/trianglei_intersector.h"
+#include "../geometry/triangleq_intersector.h"
+#include "../geometry/trianglepairi_intersector.h"
 #include "../geometry/quadv_intersector.h"
 #include "../geometry/quadi_intersector.h"
 #include "../geometry/curveNv_intersector.h"
@@ -45,7 +47,7 @@ namespace embree
       StackItemT<NodeRef> stack[stackSize];    // stack of nodes
       StackItemT<NodeRef>* stackPtr = stack+1; // current stack pointer
       StackItemT<NodeRef>* stackEnd = stack+stackSize;
-      stack[0].ptr  = bvh->root;
+      stack[0].ptr  = bvh->getRoot();
       stack[0].dist = neg_inf;
       
       if (bvh->root == BVH::emptyNode)
@@ -134,7 +136,7 @@ namespace embree
       NodeRef stack[stackSize];    // stack of nodes that still need to get traversed
       NodeRef* stackPtr = stack+1; // current stack pointer
       NodeRef* stackEnd = stack+stackSize;
-      stack[0] = bvh->root;
+      stack[0] = bvh->getRoot();
 
       /* filter out invalid rays */
 #if defined(EMBREE_IGNORE_INVALID_RAYS)
@@ -195,6 +197,281 @@ namespace embree
       }
     }
 
+    template<int N, int types, bool robust, typename PrimitiveIntersector1>
+    void BVHNIntersector1<N, types, robust, PrimitiveIntersector1>::intersectTreelet(const Accel::Intersectors* __restrict__ This,
+                                                                                     RayHit& __restrict__ ray,
+                                                                                     size_t rayID,
+                                                                                     NodeRef root,
+                                                                                     TreeletQueues<NodeRef>& queues,
+                                                                                     RayQueryContext* __restrict__ context)
+    {
+      const BVH* __restrict__ bvh = (const BVH*)This->ptr;
+
+      /* perform per ray precalculations required by the primitive intersector */
+      Precalculations pre(ray, bvh);
+
+      /* stack state, the depth of each stack item is stored relative to the treelet root */
+      StackItemT<NodeRef> stack[stackSize];    // stack of nodes
+      StackItemT<NodeRef>* stackPtr = stack+1; // current stack pointer
+      StackItemT<NodeRef>* stackEnd = stack+stackSize;
+      unsigned char depth[stackSize];
+      stack[0].ptr  = root;
+      stack[0].dist = neg_inf;
+      depth[0] = 0;
+
+      /* load the ray into SIMD registers */
+      TravRay<N,robust> tray(ray.org, ray.dir, max(ray.tnear(), 0.0f), max(ray.tfar, 0.0f));
+
+      /* initialize the node traverser */
+      BVHNNodeTraverser1Hit<N, types> nodeTraverser;
+
+      /* pop loop */
+      while (true) pop:
+      {
+        /* pop next node */
+        if (unlikely(stackPtr == stack)) break;
+        stackPtr--;
+        NodeRef cur = NodeRef(stackPtr->ptr);
+        size_t curDepth = depth[stackPtr-stack];
+
+        /* if popped node is too far, pop next one */
+        if (unlikely(*(float*)&stackPtr->dist > ray.tfar))
+          continue;
+
+        /* downtraversal loop */
+        while (true)
+        {
+          /* intersect node */
+          size_t mask; vfloat<N> tNear;
+          STAT3(normal.trav_nodes,1,1,1);
+          bool nodeIntersected = BVHNNodeIntersector1<N, types, robust>::intersect(cur, tray, ray.time(), tNear, mask);
+          if (unlikely(!nodeIntersected)) { STAT3(normal.trav_nodes,-1,-1,-1); break; }
+
+          /* if no child is hit, pop next node */
+          if (unlikely(mask == 0))
+            goto pop;
+
+          /* the hit children are roots of the next treelets, queue the ray there */
+          if (unlikely(curDepth+1 == treeletDepth))
+          {
+            const BaseNode* node = cur.baseNode();
+            for (size_t m=mask; m; ) {
+              const size_t r = bscf(m);
+              queues.push(rayID,node->child(r),tNear[r]);
+            }
+            goto pop;
+          }
+
+          /* select next child and push other children */
+          StackItemT<NodeRef>* stackBegin = stackPtr;
+          nodeTraverser.traverseClosestHit(cur, mask, tNear, stackPtr, stackEnd);
+          for (StackItemT<NodeRef>* s = stackBegin; s < stackPtr; s++)
+            depth[s-stack] = (unsigned char)(curDepth+1);
+          curDepth++;
+        }
+
+        /* this is a leaf node */
+        assert(cur != BVH::emptyNode);
+        STAT3(normal.trav_leaves,1,1,1);
+        size_t num; Primitive* prim = (Primitive*)cur.leaf(num);
+        size_t lazy_node = 0;
+        PrimitiveIntersector1::intersect(This, pre, ray, context, prim, num, tray, lazy_node);
+        tray.tfar = ray.tfar;
+
+        /* push lazy node onto stack */
+        if (unlikely(lazy_node)) {
+          stackPtr->ptr = lazy_node;
+          stackPtr->dist = neg_inf;
+          depth[stackPtr-stack] = 0;
+          stackPtr++;
+        }
+      }
+    }
+
+    template<int N, int types, bool robust, typename PrimitiveIntersector1>
+    void BVHNIntersector1<N, types, robust, PrimitiveIntersector1>::intersectBatch(const Accel::Intersectors* __restrict__ This,
+                                                                                   RayHit* __restrict__ rays,
+                                                                                   size_t numRays,
+                                                                                   RayQueryContext* __restrict__ context)
+    {
+      const BVH* __restrict__ bvh = (const BVH*)This->ptr;
+
+      /* we may traverse an empty BVH in case all geometry was invalid */
+      if (bvh->root == BVH::emptyNode)
+        return;
+
+      /* all rays start at the root treelet */
+      TreeletQueues<NodeRef> queues(numRays);
+      for (size_t i=0; i<numRays; i++)
+      {
+        /* filter out invalid rays */
+#if defined(EMBREE_IGNORE_INVALID_RAYS)
+        if (!rays[i].valid()) continue;
+#endif
+        /* verify correct input */
+        assert(rays[i].valid());
+        assert(rays[i].tnear() >= 0.0f);
+        queues.push(i,bvh->getRoot(),neg_inf);
+      }
+
+      /* in each round every ray traverses its closest pending treelet,
+       * rays entering the same treelet get traversed back to back such
+       * that the nodes of the treelet stay in cache */
+      std::vector<std::pair<size_t,size_t>> work; // (treelet root, ray)
+      work.reserve(numRays);
+      while (true)
+      {
+        work.clear();
+        for (size_t i=0; i<numRays; i++) {
+          NodeRef root;
+          if (queues.pop(i,rays[i].tfar,root))
+            work.push_back(std::make_pair((size_t)root,i));
+        }
+        if (work.empty()) break;
+
+        std::sort(work.begin(),work.end());
+        for (size_t i=0; i<work.size(); i++)
+          intersectTreelet(This,rays[work[i].second],work[i].second,NodeRef(work[i].first),queues,context);
+      }
+    }
+
+    template<int N, int types, bool robust, typename PrimitiveIntersector1>
+    void BVHNIntersector1<N, types, robust, PrimitiveIntersector1>::occludedTreelet(const Accel::Intersectors* __restrict__ This,
+                                                                                    Ray& __restrict__ ray,
+                                                                                    size_t rayID,
+                                                                                    NodeRef root,
+                                                                                    TreeletQueues<NodeRef>& queues,
+                                                                                    RayQueryContext* __restrict__ context)
+    {
+      const BVH* __restrict__ bvh = (const BVH*)This->ptr;
+
+      /* perform per ray precalculations required by the primitive intersector */
+      Precalculations pre(ray, bvh);
+
+      /* stack state, the depth of each stack item is stored relative to the treelet root */
+      NodeRef stack[stackSize];    // stack of nodes that still need to get traversed
+      NodeRef* stackPtr = stack+1; // current stack pointer
+      NodeRef* stackEnd = stack+stackSize;
+      unsigned char depth[stackSize];
+      stack[0] = root;
+      depth[0] = 0;
+
+      /* load the ray into SIMD registers */
+      TravRay<N,robust> tray(ray.org, ray.dir, max(ray.tnear(), 0.0f), max(ray.tfar, 0.0f));
+
+      /* initialize the node traverser */
+      BVHNNodeTraverser1Hit<N, types> nodeTraverser;
+
+      /* pop loop */
+      while (true) pop:
+      {
+        /* pop next node */
+        if (unlikely(stackPtr == stack)) break;
+        stackPtr--;
+        NodeRef cur = (NodeRef)*stackPtr;
+        size_t curDepth = depth[stackPtr-stack];
+
+        /* downtraversal loop */
+        while (true)
+        {
+          /* intersect node */
+          size_t mask; vfloat<N> tNear;
+          STAT3(shadow.trav_nodes,1,1,1);
+          bool nodeIntersected = BVHNNodeIntersector1<N, types, robust>::intersect(cur, tray, ray.time(), tNear, mask);
+          if (unlikely(!nodeIntersected)) { STAT3(shadow.trav_nodes,-1,-1,-1); break; }
+
+          /* if no child is hit, pop next node */
+          if (unlikely(mask == 0))
+            goto pop;
+
+          /* the hit children are roots of the next treelets, queue the ray there */
+          if (unlikely(curDepth+1 == treeletDepth))
+          {
+            const BaseNode* node = cur.baseNode();
+            for (size_t m=mask; m; ) {
+              const size_t r = bscf(m);
+              queues.push(rayID,node->child(r),tNear[r]);
+            }
+            goto pop;
+          }
+
+          /* select next child and push other children */
+          NodeRef* stackBegin = stackPtr;
+          nodeTraverser.traverseAnyHit(cur, mask, tNear, stackPtr, stackEnd);
+          for (NodeRef* s = stackBegin; s < stackPtr; s++)
+            depth[s-stack] = (unsigned char)(curDepth+1);
+          curDepth++;
+        }
+
+        /* this is a leaf node */
+        assert(cur != BVH::emptyNode);
+        STAT3(shadow.trav_leaves,1,1,1);
+        size_t num; Primitive* prim = (Primitive*)cur.leaf(num);
+        size_t lazy_node = 0;
+        if (PrimitiveIntersector1::occluded(This, pre, ray, context, prim, num, tray, lazy_node)) {
+          ray.tfar = neg_inf;
+          queues.clear(rayID);
+          break;
+        }
+
+        /* push lazy node onto stack */
+        if (unlikely(lazy_node)) {
+          *stackPtr = (NodeRef)lazy_node;
+          depth[stackPtr-stack] = 0;
+          stackPtr++;
+        }
+      }
+    }
+
+    template<int N, int types, bool robust, typename PrimitiveIntersector1>
+    void BVHNIntersector1<N, types, robust, PrimitiveIntersector1>::occludedBatch(const Accel::Intersectors* __restrict__ This,
+                                                                                  Ray* __restrict__ rays,
+                                                                                  size_t numRays,
+                                                                                  RayQueryContext* __restrict__ context)
+    {
+      const BVH* __restrict__ bvh = (const BVH*)This->ptr;
+
+      /* we may traverse an empty BVH in case all geometry was invalid */
+      if (bvh->root == BVH::emptyNode)
+        return;
+
+      /* all rays that are not yet occluded start at the root treelet */
+      TreeletQueues<NodeRef> queues(numRays);
+      for (size_t i=0; i<numRays; i++)
+      {
+        if (unlikely(rays[i].tfar < 0.0f))
+          continue;
+
+        /* filter out invalid rays */
+#if defined(EMBREE_IGNORE_INVALID_RAYS)
+        if (!rays[i].valid()) continue;
+#endif
+        /* verify correct input */
+        assert(rays[i].valid());
+        assert(rays[i].tnear() >= 0.0f);
+        queues.push(i,bvh->getRoot(),neg_inf);
+      }
+
+      /* in each round every ray traverses one pending treelet, rays
+       * entering the same treelet get traversed back to back */
+      std::vector<std::pair<size_t,size_t>> work; // (treelet root, ray)
+      work.reserve(numRays);
+      while (true)
+      {
+        work.clear();
+        for (size_t i=0; i<numRays; i++) {
+          NodeRef root;
+          if (queues.pop(i,rays[i].tfar,root))
+            work.push_back(std::make_pair((size_t)root,i));
+        }
+        if (work.empty()) break;
+
+        std::sort(work.begin(),work.end());
+        for (size_t i=0; i<work.size(); i++)
+          occludedTreelet(This,rays[work[i].second],work[i].second,NodeRef(work[i].first),queues,context);
+      }
+    }
+
     template<int N, int types, bool robust, typename PrimitiveIntersector1>
     struct PointQueryDispatch
     {
@@ -219,7 +496,7 @@ namespace embree
         StackItemT<NodeRef> stack[stackSize];    // stack of nodes
         StackItemT<NodeRef>* stackPtr = stack+1; // current stack pointer
         StackItemT<NodeRef>* stackEnd = stack+stackSize;
-        stack[0].ptr  = bvh->root;
+        stack[0].ptr  = bvh->getRoot();
         stack[0].dist = neg_inf;
         
         /* verify correct input */
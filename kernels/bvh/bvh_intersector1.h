@@ -11,6 +11,59 @@ namespace embree
 {
   namespace isa
   {
+    /*! Pending treelets of the rays of a batch. Each ray keeps the
+     *  roots of the treelets it still has to traverse in a heap
+     *  ordered by entry distance. */
+    template<typename NodeRef>
+    struct TreeletQueues
+    {
+      struct Entry
+      {
+        __forceinline Entry (NodeRef node, float dist)
+          : node(node), dist(dist) {}
+
+        __forceinline friend bool operator< (const Entry& a, const Entry& b) {
+          return a.dist > b.dist; // closest entry on top of the heap
+        }
+
+        NodeRef node;
+        float dist;
+      };
+
+      TreeletQueues (size_t numRays)
+        : heaps(numRays) {}
+
+      __forceinline void push(size_t ray, NodeRef node, float dist)
+      {
+        heaps[ray].push_back(Entry(node,dist));
+        std::push_heap(heaps[ray].begin(),heaps[ray].end());
+      }
+
+      /* pops the closest treelet of a ray that is not farther away than tfar */
+      __forceinline bool pop(size_t ray, float tfar, NodeRef& node)
+      {
+        std::vector<Entry>& heap = heaps[ray];
+        while (!heap.empty())
+        {
+          const Entry entry = heap.front();
+          std::pop_heap(heap.begin(),heap.end());
+          heap.pop_back();
+          if (entry.dist <= tfar) {
+            node = entry.node;
+            return true;
+          }
+        }
+        return false;
+      }
+
+      __forceinline void clear(size_t ray) {
+        heaps[ray].clear();
+      }
+
+    private:
+      std::vector<std::vector<Entry>> heaps;
+    };
+
     /*! BVH single ray intersector. */
     template<int N, int types, bool robust, typename PrimitiveIntersector1>
     class BVHNIntersector1
@@ -20,15 +73,27 @@ namespace embree
       typedef typename PrimitiveIntersector1::Primitive Primitive;
       typedef BVHN<N> BVH;
       typedef typename BVH::NodeRef NodeRef;
+      typedef typename BVH::BaseNode BaseNode;
       typedef typename BVH::AABBNode AABBNode;
       typedef typename BVH::AABBNodeMB4D AABBNodeMB4D;
 
       static const size_t stackSize = 1+(N-1)*BVH::maxDepth+3; // +3 due to 16-wide store
 
+      /* number of node levels of a treelet, a full treelet has about 150 KB of nodes */
+      static const size_t treeletDepth = N == 4 ? 6 : 4;
+
     public:
       static void intersect (const Accel::Intersectors* This, RayHit& ray, RayQueryContext* context);
       static void occluded  (const Accel::Intersectors* This, Ray& ray, RayQueryContext* context);
       static bool pointQuery(const Accel::Intersectors* This, PointQuery* query, PointQueryContext* context);
+
+      /* traces a batch of rays breadth first through the treelets of the BVH */
+      static void intersectBatch(const Accel::Intersectors* This, RayHit* rays, size_t numRays, RayQueryContext* context);
+      static void occludedBatch (const Accel::Intersectors* This, Ray* rays, size_t numRays, RayQueryContext* context);
+
+    private:
+      static void intersectTreelet(const Accel::Intersectors* This, RayHit& ray, size_t rayID, NodeRef root, TreeletQueues<NodeRef>& queues, RayQueryContext* context);
+      static void occludedTreelet (const Accel::Intersectors* This, Ray& ray, size_t rayID, NodeRef root, TreeletQueues<NodeRef>& queues, RayQueryContext* context);
     };
   }
 }
@@ -11,6 +11,8 @@
 #include "../geometry/trianglev_intersector.h"
 #include "../geometry/trianglev_mb_intersector.h"
 #include "../geometry/trianglei_intersector.h"
+#include "../geometry/triangleq_intersector.h"
+#include "../geometry/trianglepairi_intersector.h"
 #include "../geometry/quadv_intersector.h"
 #include "../geometry/quadi_intersector.h"
 #include "../geometry/curveNv_intersector.h"
@@ -155,7 +157,7 @@ namespace embree
         
         for (; valid_bits!=0; ) {
           const size_t i = bscf(valid_bits);
-          intersect1(This, bvh, bvh->root, i, pre, ray, tray, context);
+          intersect1(This, bvh, bvh->getRoot(), i, pre, ray, tray, context);
         }
         return;
       }
@@ -205,7 +207,7 @@ namespace embree
         NodeRef stack_node[stackSizeChunk];
         stack_node[0] = BVH::invalidNode;
         stack_near[0] = inf;
-        stack_node[1] = bvh->root;
+        stack_node[1] = bvh->getRoot();
         stack_near[1] = tray.tnear;
         NodeRef* stackEnd MAYBE_UNUSED = stack_node+stackSizeChunk;
         NodeRef* __restrict__ sptr_node = stack_node + 2;
@@ -415,7 +417,7 @@ namespace embree
 
         StackItemT<NodeRef> stack[stackSizeSingle];  // stack of nodes
         StackItemT<NodeRef>* stackPtr = stack + 1;   // current stack pointer
-        stack[0].ptr  = bvh->root;
+        stack[0].ptr  = bvh->getRoot();
         stack[0].dist = neg_inf;
 
         while (1) pop:
@@ -527,6 +529,244 @@ namespace embree
       } while(valid_bits);
     }
 
+    template<int N, int K, int types, bool robust, typename PrimitiveIntersectorK, bool single>
+    void BVHNIntersectorKHybrid<N, K, types, robust, PrimitiveIntersectorK, single>::intersectTile(vint<K>* __restrict__ valid_i,
+                                                                                                   Accel::Intersectors* __restrict__ This,
+                                                                                                   RayHitK<K>* __restrict__ rays,
+                                                                                                   size_t numPackets,
+                                                                                                   RayQueryContext* context)
+    {
+      BVH* __restrict__ bvh = (BVH*)This->ptr;
+      assert(numPackets <= maxTilePackets);
+
+      /* we may traverse an empty BVH in case all geometry was invalid */
+      if (bvh->root == BVH::emptyNode)
+        return;
+
+      /* the frustum test only supports AABB nodes */
+      if (types != BVH_AN1) {
+        for (size_t p=0; p<numPackets; p++)
+          intersect(&valid_i[p], This, rays[p], context);
+        return;
+      }
+
+      /* load all packets, the tile only contains the rays of the octant of the first valid ray */
+      vbool<K> valid[maxTilePackets];
+      TravRayK<K, robust> tray[maxTilePackets];
+      Vec3vf<K> min_org(pos_inf), max_org(neg_inf);
+      Vec3vf<K> min_rdir(pos_inf), max_rdir(neg_inf);
+      vfloat<K> min_dist(pos_inf), max_dist(neg_inf);
+      size_t first = numPackets, last = 0;
+      int octant = -1;
+
+      for (size_t p=0; p<numPackets; p++)
+      {
+        RayHitK<K>& ray = rays[p];
+        valid[p] = valid_i[p] == -1;
+#if defined(EMBREE_IGNORE_INVALID_RAYS)
+        valid[p] &= ray.valid();
+#endif
+        const size_t valid_bits = movemask(valid[p]);
+        if (valid_bits && octant == -1) octant = ray.octant()[bsf(valid_bits)];
+        valid[p] &= ray.octant() == vint<K>(octant);
+
+        /* verify correct input */
+        assert(all(valid[p], ray.valid()));
+        assert(all(valid[p], ray.tnear() >= 0.0f));
+
+        tray[p].init(ray.org, ray.dir, single ? N : 0);
+        tray[p].tnear = select(valid[p], max(ray.tnear(), 0.0f), vfloat<K>(pos_inf));
+        tray[p].tfar  = select(valid[p], max(ray.tfar , 0.0f), vfloat<K>(neg_inf));
+        if (none(valid[p])) continue;
+
+        first = min(first,p);
+        last = p;
+        min_org  = min(min_org , select(valid[p], tray[p].org , Vec3vf<K>(pos_inf)));
+        max_org  = max(max_org , select(valid[p], tray[p].org , Vec3vf<K>(neg_inf)));
+        min_rdir = min(min_rdir, select(valid[p], tray[p].rdir, Vec3vf<K>(pos_inf)));
+        max_rdir = max(max_rdir, select(valid[p], tray[p].rdir, Vec3vf<K>(neg_inf)));
+        min_dist = min(min_dist, tray[p].tnear);
+        max_dist = max(max_dist, tray[p].tfar);
+      }
+
+      if (first < numPackets)
+      {
+        /* a single frustum bounds all rays of the tile */
+        Frustum<robust> frustum;
+        frustum.init(Vec3fa(reduce_min(min_org.x), reduce_min(min_org.y), reduce_min(min_org.z)),
+                     Vec3fa(reduce_max(max_org.x), reduce_max(max_org.y), reduce_max(max_org.z)),
+                     Vec3fa(reduce_min(min_rdir.x), reduce_min(min_rdir.y), reduce_min(min_rdir.z)),
+                     Vec3fa(reduce_max(max_rdir.x), reduce_max(max_rdir.y), reduce_max(max_rdir.z)),
+                     reduce_min(min_dist), reduce_max(max_dist), N);
+
+        /* shrinks the frustum to the farthest hit of the tile */
+        auto updateMaxDist = [&] () {
+          vfloat<K> dist(neg_inf);
+          for (size_t p=first; p<=last; p++)
+            dist = max(dist, tray[p].tfar);
+          frustum.template updateMaxDist<K>(dist);
+        };
+
+        /* tests if any active ray of packet p hits the i'th child of the node */
+        auto hitChild = [&] (NodeRef nodeRef, size_t i, size_t p) -> bool {
+          vfloat<K> lnearP;
+          vbool<K> lhit = false; // motion blur is not supported, so the initial value will be ignored
+          STAT3(normal.trav_nodes, 1, 1, 1);
+          BVHNNodeIntersectorK<N, K, types, robust>::intersect(nodeRef, i, tray[p], rays[p].time(), lnearP, lhit);
+          return any(lhit);
+        };
+
+        /* stack items store the range of packets that may hit the node */
+        StackItemRangeT<NodeRef> stack[stackSizeSingle];  // stack of nodes
+        StackItemRangeT<NodeRef>* stackPtr = stack;       // current stack pointer
+        StackItemRangeT<NodeRef>* stackEnd MAYBE_UNUSED = stack + stackSizeSingle;
+        auto push = [&] (NodeRef node, float dist, size_t f, size_t l) {
+          assert(stackPtr < stackEnd);
+          stackPtr->ptr = node;
+          stackPtr->dist = dist;
+          stackPtr->first = (unsigned short) f;
+          stackPtr->last  = (unsigned short) l;
+          stackPtr++;
+        };
+        push(bvh->getRoot(), neg_inf, first, last);
+
+        while (1) pop:
+        {
+          /* pop next node from stack */
+          if (unlikely(stackPtr == stack)) break;
+
+          stackPtr--;
+          NodeRef cur = NodeRef(stackPtr->ptr);
+          float curDist = stackPtr->dist;
+          size_t curFirst = stackPtr->first;
+          size_t curLast  = stackPtr->last;
+
+          /* cull node if behind the farthest hit of the tile */
+          if (unlikely(curDist > frustum.max_dist)) continue;
+
+          while (true)
+          {
+            /* switch to single ray traversal if only a few rays of a single packet remain */
+            if (single && curFirst == curLast)
+            {
+              const vbool<K> active = tray[curFirst].tfar > curDist;
+              if (unlikely(popcnt(active) <= switchThresholdIncoherent))
+              {
+                size_t bits = movemask(active);
+                Precalculations pre(valid[curFirst], rays[curFirst]);
+                for (; bits!=0; ) {
+                  const size_t i = bscf(bits);
+                  intersect1(This, bvh, cur, i, pre, rays[curFirst], tray[curFirst], context);
+                }
+                tray[curFirst].tfar = min(tray[curFirst].tfar, rays[curFirst].tfar);
+                updateMaxDist();
+                goto pop;
+              }
+            }
+
+            if (unlikely(cur.isLeaf())) break;
+
+            /* process nodes */
+            const NodeRef nodeRef = cur;
+            const AABBNode* __restrict__ const node = nodeRef.getAABBNode();
+
+            vfloat<N> fmin;
+            size_t m_frustum_node = intersectNodeFrustum<N>(node, frustum, fmin);
+            if (unlikely(!m_frustum_node)) goto pop;
+
+            const size_t parentFirst = curFirst;
+            const size_t parentLast  = curLast;
+            cur = BVH::emptyNode;
+            curDist = pos_inf;
+
+            size_t num_child_hits = 0;
+            do {
+              const size_t i = bscf(m_frustum_node);
+
+              /* determine the first and last packet hitting the child */
+              size_t childFirst = parentFirst;
+              while (childFirst <= parentLast && !hitChild(nodeRef, i, childFirst)) childFirst++;
+              if (childFirst > parentLast) continue;
+              size_t childLast = parentLast;
+              while (childLast > childFirst && !hitChild(nodeRef, i, childLast)) childLast--;
+
+              const float childDist = fmin[i];
+              const NodeRef child = node->child(i);
+              BVHN<N>::prefetch(child);
+
+              /* continue with the closest child and push the other children onto the stack */
+              if (childDist < curDist)
+              {
+                if (likely(cur != BVH::emptyNode)) {
+                  num_child_hits++;
+                  push(cur, curDist, curFirst, curLast);
+                }
+                cur = child;
+                curDist = childDist;
+                curFirst = childFirst;
+                curLast = childLast;
+              }
+              else {
+                num_child_hits++;
+                push(child, childDist, childFirst, childLast);
+              }
+            } while(m_frustum_node);
+
+            if (unlikely(cur == BVH::emptyNode)) goto pop;
+
+            /* improved distance sorting for 3 or more hits */
+            if (unlikely(num_child_hits >= 2))
+            {
+              if (stackPtr[-2].dist < stackPtr[-1].dist)
+                std::swap(stackPtr[-2],stackPtr[-1]);
+              if (unlikely(num_child_hits >= 3))
+              {
+                if (stackPtr[-3].dist < stackPtr[-1].dist)
+                  std::swap(stackPtr[-3],stackPtr[-1]);
+                if (stackPtr[-3].dist < stackPtr[-2].dist)
+                  std::swap(stackPtr[-3],stackPtr[-2]);
+              }
+            }
+          }
+
+          /* intersect leaf with all packets of the range */
+          assert(cur != BVH::invalidNode);
+          assert(cur != BVH::emptyNode);
+          size_t items; const Primitive* prim = (Primitive*)cur.leaf(items);
+
+          bool hit = false;
+          size_t lazy_node = 0;
+          for (size_t p=curFirst; p<=curLast; p++)
+          {
+            const vbool<K> valid_leaf = tray[p].tfar > curDist;
+            if (none(valid_leaf)) continue;
+            STAT3(normal.trav_leaves, 1, popcnt(valid_leaf), K);
+
+            Precalculations pre(valid[p], rays[p]);
+            PrimitiveIntersectorK::intersect(valid_leaf, This, pre, rays[p], context, prim, items, tray[p], lazy_node);
+            hit |= any(valid_leaf & (rays[p].tfar < tray[p].tfar));
+            tray[p].tfar = select(valid_leaf, rays[p].tfar, tray[p].tfar);
+          }
+
+          /* reduce max distance interval on successful intersection */
+          if (hit) updateMaxDist();
+
+          if (unlikely(lazy_node))
+            push(lazy_node, neg_inf, curFirst, curLast);
+        }
+      }
+
+      /* rays of other octants are traced as regular packets */
+      for (size_t p=0; p<numPackets; p++)
+      {
+        const vbool<K> other = (valid_i[p] == -1) & !valid[p];
+        if (unlikely(any(other))) {
+          vint<K> mask = other.mask32();
+          intersect(&mask, This, rays[p], context);
+        }
+      }
+    }
+
     // ===================================================================================================================================================================
     // ===================================================================================================================================================================
     // ===================================================================================================================================================================
@@ -651,7 +891,7 @@ namespace embree
       NodeRef stack_node[stackSizeChunk];
       stack_node[0] = BVH::invalidNode;
       stack_near[0] = inf;
-      stack_node[1] = bvh->root;
+      stack_node[1] = bvh->getRoot();
       stack_near[1] = tray.tnear;
       NodeRef* stackEnd MAYBE_UNUSED = stack_node+stackSizeChunk;
       NodeRef* __restrict__ sptr_node = stack_node + 2;
@@ -828,7 +1068,7 @@ namespace embree
 
         StackItemMaskT<NodeRef> stack[stackSizeSingle];  // stack of nodes
         StackItemMaskT<NodeRef>* stackPtr = stack + 1;   // current stack pointer
-        stack[0].ptr  = bvh->root;
+        stack[0].ptr  = bvh->getRoot();
         stack[0].mask = movemask(octant_valid);
 
         while (1) pop:
@@ -913,5 +1153,209 @@ namespace embree
 
       vfloat<K>::store(valid & terminated, &ray.tfar, neg_inf);
     }
+
+    template<int N, int K, int types, bool robust, typename PrimitiveIntersectorK, bool single>
+    void BVHNIntersectorKHybrid<N, K, types, robust, PrimitiveIntersectorK, single>::occludedTile(vint<K>* __restrict__ valid_i,
+                                                                                                  Accel::Intersectors* __restrict__ This,
+                                                                                                  RayK<K>* __restrict__ rays,
+                                                                                                  size_t numPackets,
+                                                                                                  RayQueryContext* context)
+    {
+      BVH* __restrict__ bvh = (BVH*)This->ptr;
+      assert(numPackets <= maxTilePackets);
+
+      /* we may traverse an empty BVH in case all geometry was invalid */
+      if (bvh->root == BVH::emptyNode)
+        return;
+
+      /* the frustum test only supports AABB nodes */
+      if (types != BVH_AN1) {
+        for (size_t p=0; p<numPackets; p++)
+          occluded(&valid_i[p], This, rays[p], context);
+        return;
+      }
+
+      /* load all packets, the tile only contains the rays of the octant of the first valid ray */
+      vbool<K> valid[maxTilePackets];
+      vbool<K> terminated[maxTilePackets];
+      TravRayK<K, robust> tray[maxTilePackets];
+      Vec3vf<K> min_org(pos_inf), max_org(neg_inf);
+      Vec3vf<K> min_rdir(pos_inf), max_rdir(neg_inf);
+      vfloat<K> min_dist(pos_inf), max_dist(neg_inf);
+      size_t first = numPackets, last = 0;
+      int octant = -1;
+
+      for (size_t p=0; p<numPackets; p++)
+      {
+        RayK<K>& ray = rays[p];
+        valid[p] = (valid_i[p] == -1) & (ray.tfar >= 0.0f);
+#if defined(EMBREE_IGNORE_INVALID_RAYS)
+        valid[p] &= ray.valid();
+#endif
+        const size_t valid_bits = movemask(valid[p]);
+        if (valid_bits && octant == -1) octant = ray.octant()[bsf(valid_bits)];
+        valid[p] &= ray.octant() == vint<K>(octant);
+        terminated[p] = !valid[p];
+
+        /* verify correct input */
+        assert(all(valid[p], ray.valid()));
+        assert(all(valid[p], ray.tnear() >= 0.0f));
+
+        tray[p].init(ray.org, ray.dir, single ? N : 0);
+        tray[p].tnear = select(valid[p], max(ray.tnear(), 0.0f), vfloat<K>(pos_inf));
+        tray[p].tfar  = select(valid[p], max(ray.tfar , 0.0f), vfloat<K>(neg_inf));
+        if (none(valid[p])) continue;
+
+        first = min(first,p);
+        last = p;
+        min_org  = min(min_org , select(valid[p], tray[p].org , Vec3vf<K>(pos_inf)));
+        max_org  = max(max_org , select(valid[p], tray[p].org , Vec3vf<K>(neg_inf)));
+        min_rdir = min(min_rdir, select(valid[p], tray[p].rdir, Vec3vf<K>(pos_inf)));
+        max_rdir = max(max_rdir, select(valid[p], tray[p].rdir, Vec3vf<K>(neg_inf)));
+        min_dist = min(min_dist, tray[p].tnear);
+        max_dist = max(max_dist, tray[p].tfar);
+      }
+
+      if (first < numPackets)
+      {
+        /* a single frustum bounds all rays of the tile */
+        Frustum<robust> frustum;
+        frustum.init(Vec3fa(reduce_min(min_org.x), reduce_min(min_org.y), reduce_min(min_org.z)),
+                     Vec3fa(reduce_max(max_org.x), reduce_max(max_org.y), reduce_max(max_org.z)),
+                     Vec3fa(reduce_min(min_rdir.x), reduce_min(min_rdir.y), reduce_min(min_rdir.z)),
+                     Vec3fa(reduce_max(max_rdir.x), reduce_max(max_rdir.y), reduce_max(max_rdir.z)),
+                     reduce_min(min_dist), reduce_max(max_dist), N);
+
+        /* tests if any active ray of packet p hits the i'th child of the node */
+        auto hitChild = [&] (NodeRef nodeRef, size_t i, size_t p) -> bool {
+          vfloat<K> lnearP;
+          vbool<K> lhit = false; // motion blur is not supported, so the initial value will be ignored
+          STAT3(shadow.trav_nodes, 1, 1, 1);
+          BVHNNodeIntersectorK<N, K, types, robust>::intersect(nodeRef, i, tray[p], rays[p].time(), lnearP, lhit);
+          return any(lhit);
+        };
+
+        /* stack items store the range of packets that may hit the node */
+        StackItemRangeT<NodeRef> stack[stackSizeSingle];  // stack of nodes
+        StackItemRangeT<NodeRef>* stackPtr = stack;       // current stack pointer
+        StackItemRangeT<NodeRef>* stackEnd MAYBE_UNUSED = stack + stackSizeSingle;
+        auto push = [&] (NodeRef node, size_t f, size_t l) {
+          assert(stackPtr < stackEnd);
+          stackPtr->ptr = node;
+          stackPtr->dist = neg_inf;
+          stackPtr->first = (unsigned short) f;
+          stackPtr->last  = (unsigned short) l;
+          stackPtr++;
+        };
+        push(bvh->getRoot(), first, last);
+
+        while (1) pop:
+        {
+          /* pop next node from stack */
+          if (unlikely(stackPtr == stack)) break;
+
+          stackPtr--;
+          NodeRef cur = NodeRef(stackPtr->ptr);
+          size_t curFirst = stackPtr->first;
+          size_t curLast  = stackPtr->last;
+
+          /* shrink the range to packets that have active rays */
+          while (curFirst <= curLast && all(terminated[curFirst])) curFirst++;
+          while (curLast > curFirst && all(terminated[curLast])) curLast--;
+          if (unlikely(curFirst > curLast)) continue;
+
+          while (true)
+          {
+            /* switch to single ray traversal if only a few rays of a single packet remain */
+            if (single && curFirst == curLast)
+            {
+              const vbool<K> active = !terminated[curFirst];
+              if (unlikely(popcnt(active) <= switchThresholdIncoherent))
+              {
+                size_t bits = movemask(active);
+                Precalculations pre(valid[curFirst], rays[curFirst]);
+                for (; bits!=0; ) {
+                  const size_t i = bscf(bits);
+                  if (occluded1(This, bvh, cur, i, pre, rays[curFirst], tray[curFirst], context))
+                    set(terminated[curFirst], i);
+                }
+                tray[curFirst].tfar = select(terminated[curFirst], vfloat<K>(neg_inf), tray[curFirst].tfar);
+                goto pop;
+              }
+            }
+
+            if (unlikely(cur.isLeaf())) break;
+
+            /* process nodes */
+            const NodeRef nodeRef = cur;
+            const AABBNode* __restrict__ const node = nodeRef.getAABBNode();
+
+            vfloat<N> fmin;
+            size_t m_frustum_node = intersectNodeFrustum<N>(node, frustum, fmin);
+            if (unlikely(!m_frustum_node)) goto pop;
+
+            const size_t parentFirst = curFirst;
+            const size_t parentLast  = curLast;
+            cur = BVH::emptyNode;
+
+            do {
+              const size_t i = bscf(m_frustum_node);
+
+              /* determine the first and last packet hitting the child */
+              size_t childFirst = parentFirst;
+              while (childFirst <= parentLast && !hitChild(nodeRef, i, childFirst)) childFirst++;
+              if (childFirst > parentLast) continue;
+              size_t childLast = parentLast;
+              while (childLast > childFirst && !hitChild(nodeRef, i, childLast)) childLast--;
+
+              const NodeRef child = node->child(i);
+              assert(child != BVH::emptyNode);
+              BVHN<N>::prefetch(child);
+              if (likely(cur != BVH::emptyNode))
+                push(cur, curFirst, curLast);
+
+              cur = child;
+              curFirst = childFirst;
+              curLast = childLast;
+            } while(m_frustum_node);
+
+            if (unlikely(cur == BVH::emptyNode)) goto pop;
+          }
+
+          /* intersect leaf with all packets of the range */
+          assert(cur != BVH::invalidNode);
+          assert(cur != BVH::emptyNode);
+          size_t items; const Primitive* prim = (Primitive*)cur.leaf(items);
+
+          size_t lazy_node = 0;
+          for (size_t p=curFirst; p<=curLast; p++)
+          {
+            const vbool<K> valid_leaf = !terminated[p];
+            if (none(valid_leaf)) continue;
+            STAT3(shadow.trav_leaves, 1, popcnt(valid_leaf), K);
+
+            Precalculations pre(valid[p], rays[p]);
+            terminated[p] |= PrimitiveIntersectorK::occluded(valid_leaf, This, pre, rays[p], context, prim, items, tray[p], lazy_node);
+            tray[p].tfar = select(terminated[p], vfloat<K>(neg_inf), tray[p].tfar); // ignore node intersections for terminated rays
+          }
+
+          if (unlikely(lazy_node))
+            push(lazy_node, curFirst, curLast);
+        }
+
+        for (size_t p=first; p<=last; p++)
+          vfloat<K>::store(valid[p] & terminated[p], &rays[p].tfar, neg_inf);
+      }
+
+      /* rays of other octants are traced as regular packets */
+      for (size_t p=0; p<numPackets; p++)
+      {
+        const vbool<K> other = (valid_i[p] == -1) & !valid[p];
+        if (unlikely(any(other))) {
+          vint<K> mask = other.mask32();
+          occluded(&mask, This, rays[p], context);
+        }
+      }
+    }
   }
 }
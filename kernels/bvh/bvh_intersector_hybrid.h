@@ -36,6 +36,8 @@ namespace embree
       (K==16) ? 14 : // 14 seems to work best for KNL due to better ordered chunk traversal
       0;
 
+      static const size_t maxTilePackets = Accel::maxTileRays/K;
+
     private:
       static void intersect1(Accel::Intersectors* This, const BVH* bvh, NodeRef root, size_t k, Precalculations& pre,
                              RayHitK<K>& ray, const TravRayK<K, robust>& tray, RayQueryContext* context);
@@ -49,6 +51,10 @@ namespace embree
       static void intersectCoherent(vint<K>* valid, Accel::Intersectors* This, RayHitK<K>& ray, RayQueryContext* context);
       static void occludedCoherent (vint<K>* valid, Accel::Intersectors* This, RayK<K>& ray, RayQueryContext* context);
 
+      /*! traverses a tile of coherent ray packets using a frustum around all rays of the tile */
+      static void intersectTile(vint<K>* valid, Accel::Intersectors* This, RayHitK<K>* rays, size_t numPackets, RayQueryContext* context);
+      static void occludedTile (vint<K>* valid, Accel::Intersectors* This, RayK<K>* rays, size_t numPackets, RayQueryContext* context);
+
     };
 
     /*! BVH packet intersector. */
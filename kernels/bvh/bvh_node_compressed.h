@@ -0,0 +1,196 @@
+// Copyright 2009-2021 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include "bvh_node_base.h"
+
+namespace embree
+{
+  /*! BVHN Compressed Node. Stores the bounds of the children quantized
+   *  to 8 bits on a grid with a power of two spacing per dimension, thus
+   *  decoding is exact. The children are referenced implicitly: all
+   *  inner children are stored consecutively, followed by the primitive
+   *  blocks of all leaf children, and the node only stores the offset to
+   *  this child array. */
+  template<typename NodeRef, int N>
+    struct __aligned(16) CompressedNode_t
+  {
+    typedef unsigned char T;
+    static const T MIN_QUAN = 0;
+    static const T MAX_QUAN = 255;
+
+    /*! Maximum number of primitive blocks of a leaf child. */
+    static const size_t maxLeafBlocks = 4;
+
+    /*! Returns the power of two with the specified exponent. */
+    static __forceinline float exp2i(int e) {
+      return cast_i2f((e+127) << 23);
+    }
+
+    /*! Returns the spacing of the quantization grid. */
+    __forceinline Vec3f decodeScale() const {
+      return Vec3f(exp2i(exp[0]),exp2i(exp[1]),exp2i(exp[2]));
+    }
+
+    /*! Quantizes the bounds of the num first children conservatively and marks the remaining children as empty. */
+    __forceinline void setBounds(const BBox3fa* bounds, size_t num)
+    {
+      assert(num <= N);
+      BBox3fa box = empty;
+      for (size_t i=0; i<num; i++) box.extend(bounds[i]);
+      start = Vec3f(box.lower.x,box.lower.y,box.lower.z);
+
+      for (size_t dim=0; dim<3; dim++)
+      {
+        /* smallest power of two grid spacing that covers the bounds with MAX_QUAN steps */
+        const float minF = box.lower[dim];
+        const float diff = (1.0f+2.0f*float(ulp))*(box.upper[dim]-minF);
+        int e = -126;
+        if (diff > 0.0f) {
+          if (std::isfinite(diff/float(MAX_QUAN))) std::frexp(diff/float(MAX_QUAN),&e);
+          else e = 127;
+          e = max(e,-126);
+        }
+        while (e < 127 && float(MAX_QUAN)*exp2i(e) < diff) e++;
+        exp[dim] = (signed char) e;
+        const float scale = exp2i(e);
+
+        T* lower = &all_planes[(2*dim+0)*N];
+        T* upper = &all_planes[(2*dim+1)*N];
+        for (size_t i=0; i<N; i++)
+        {
+          if (i >= num) {
+            lower[i] = MAX_QUAN;
+            upper[i] = MIN_QUAN;
+            continue;
+          }
+
+          /* the grid spacing is a power of two, thus the decoding below matches the decoding during traversal exactly */
+          const float l = bounds[i].lower[dim];
+          const float u = bounds[i].upper[dim];
+          int ilower = max((int)floorf((l-minF)/scale),(int)MIN_QUAN);
+          int iupper = min((int)ceilf ((u-minF)/scale),(int)MAX_QUAN);
+          while (ilower > MIN_QUAN && madd(float(ilower),scale,minF) > l) ilower--;
+          while (iupper < MAX_QUAN && madd(float(iupper),scale,minF) < u) iupper++;
+          lower[i] = (T) ilower;
+          upper[i] = (T) iupper;
+        }
+      }
+    }
+
+    /*! Sets the offset of the child array in bytes, the mask of inner children, and the size of the primitive blocks of the leaf children. */
+    __forceinline void setChildren(size_t childBytes, unsigned int innerMask, size_t primBlockBytes)
+    {
+      assert((childBytes % 16) == 0 && childBytes/16 <= std::numeric_limits<unsigned int>::max());
+      assert((primBlockBytes % 16) == 0 && primBlockBytes/16 <= 255);
+      childOffset = (unsigned int) (childBytes/16);
+      imask = (T) innerMask;
+      leafBlockSize = (T) (primBlockBytes/16);
+    }
+
+    /*! Encodes an inner child by its index in the child array. */
+    __forceinline void setInnerChild(size_t i, size_t index) {
+      assert(i < N && index < N);
+      meta[i] = (T) index;
+    }
+
+    /*! Encodes a leaf child by the index of its first primitive block in the child array and its number of blocks. */
+    __forceinline void setLeafChild(size_t i, size_t block, size_t num) {
+      assert(i < N && block < 32 && num <= maxLeafBlocks);
+      meta[i] = (T) ((num << 5) | block);
+    }
+
+    /*! Returns true if the specified child is valid. */
+    __forceinline bool valid(size_t i) const {
+      assert(i < N);
+      return lower_x[i] <= upper_x[i];
+    }
+
+    /*! Returns reference to specified child */
+    __forceinline NodeRef child(size_t i) const
+    {
+      assert(i < N);
+      const char* base = (const char*)this + 16*size_t(childOffset);
+      if (imask & (1 << i))
+        return NodeRef((size_t)(base + size_t(meta[i])*sizeof(CompressedNode_t)) | NodeRef::tyCompressedNode);
+      if (meta[i] == 0)
+        return NodeRef(NodeRef::emptyNode);
+      const char* leaves = base + size_t(popcnt((unsigned int)imask))*sizeof(CompressedNode_t);
+      return NodeRef::encodeLeaf((void*)(leaves + 16*size_t(leafBlockSize)*(meta[i] & 0x1f)),meta[i] >> 5);
+    }
+
+    /*! Returns bounds of specified child. */
+    __forceinline BBox3fa bounds(size_t i) const
+    {
+      assert(i < N);
+      const Vec3f scale = decodeScale();
+      const Vec3fa lower(madd(scale.x,(float)lower_x[i],start.x),
+                         madd(scale.y,(float)lower_y[i],start.y),
+                         madd(scale.z,(float)lower_z[i],start.z));
+      const Vec3fa upper(madd(scale.x,(float)upper_x[i],start.x),
+                         madd(scale.y,(float)upper_y[i],start.y),
+                         madd(scale.z,(float)upper_z[i],start.z));
+      return BBox3fa(lower,upper);
+    }
+
+    /*! Returns extent of bounds of specified child. */
+    __forceinline Vec3fa extent(size_t i) const {
+      return bounds(i).size();
+    }
+
+    __forceinline vbool<N> validMask() const { return vint<N>::loadu(lower_x) <= vint<N>::loadu(upper_x); }
+
+    __forceinline vfloat<N> dequantizeLowerX() const { return madd(vfloat<N>(vint<N>::loadu(lower_x)),exp2i(exp[0]),vfloat<N>(start.x)); }
+
+    __forceinline vfloat<N> dequantizeUpperX() const { return madd(vfloat<N>(vint<N>::loadu(upper_x)),exp2i(exp[0]),vfloat<N>(start.x)); }
+
+    __forceinline vfloat<N> dequantizeLowerY() const { return madd(vfloat<N>(vint<N>::loadu(lower_y)),exp2i(exp[1]),vfloat<N>(start.y)); }
+
+    __forceinline vfloat<N> dequantizeUpperY() const { return madd(vfloat<N>(vint<N>::loadu(upper_y)),exp2i(exp[1]),vfloat<N>(start.y)); }
+
+    __forceinline vfloat<N> dequantizeLowerZ() const { return madd(vfloat<N>(vint<N>::loadu(lower_z)),exp2i(exp[2]),vfloat<N>(start.z)); }
+
+    __forceinline vfloat<N> dequantizeUpperZ() const { return madd(vfloat<N>(vint<N>::loadu(upper_z)),exp2i(exp[2]),vfloat<N>(start.z)); }
+
+    template <int M>
+      __forceinline vfloat<M> dequantize(const size_t offset) const { return vfloat<M>(vint<M>::loadu(all_planes+offset)); }
+
+    friend embree_ostream operator<<(embree_ostream o, const CompressedNode_t& n)
+    {
+      o << "CompressedNode { " << embree_endl;
+      o << "  start   " << n.start << embree_endl;
+      o << "  scale   " << n.decodeScale() << embree_endl;
+      o << "  imask   " << (unsigned int) n.imask << embree_endl;
+      o << "  lower_x " << vuint<N>::loadu(n.lower_x) << embree_endl;
+      o << "  upper_x " << vuint<N>::loadu(n.upper_x) << embree_endl;
+      o << "  lower_y " << vuint<N>::loadu(n.lower_y) << embree_endl;
+      o << "  upper_y " << vuint<N>::loadu(n.upper_y) << embree_endl;
+      o << "  lower_z " << vuint<N>::loadu(n.lower_z) << embree_endl;
+      o << "  upper_z " << vuint<N>::loadu(n.upper_z) << embree_endl;
+      o << "}" << embree_endl;
+      return o;
+    }
+
+  public:
+    Vec3f start;              //!< origin of the quantization grid
+    signed char exp[3];       //!< power of two exponents of the grid spacing
+    T imask;                  //!< bit i is set if child i is an inner node
+    unsigned int childOffset; //!< offset of the child array from this node in 16 byte units
+    T meta[N];                //!< index of inner children, or first block (low 5 bits) and number of blocks (high 3 bits) of leaf children
+    T leafBlockSize;          //!< size of a primitive block in 16 byte units
+    T reserved[3];
+
+    union {
+      struct {
+        T lower_x[N]; //!< 8bit discretized X dimension of lower bounds of all N children
+        T upper_x[N]; //!< 8bit discretized X dimension of upper bounds of all N children
+        T lower_y[N]; //!< 8bit discretized Y dimension of lower bounds of all N children
+        T upper_y[N]; //!< 8bit discretized Y dimension of upper bounds of all N children
+        T lower_z[N]; //!< 8bit discretized Z dimension of lower bounds of all N children
+        T upper_z[N]; //!< 8bit discretized Z dimension of upper bounds of all N children
+      };
+      T all_planes[6*N];
+    };
+  };
+}
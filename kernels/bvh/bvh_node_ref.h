@@ -54,6 +54,7 @@ namespace embree
   template<typename NodeRef, int N> struct OBBNodeMB_t;
   template<typename NodeRef, int N> struct QuantizedNode_t;
   template<typename NodeRef, int N> struct QuantizedNodeMB_t;
+  template<typename NodeRef, int N> struct CompressedNode_t;
   
   /*! Pointer that points to a node or a list of primitives */
   template<int N>
@@ -78,6 +79,7 @@ namespace embree
     static const size_t tyAABBNodeMB4D = 6;
     static const size_t tyOBBNode = 2;
     static const size_t tyOBBNodeMB = 3;
+    static const size_t tyCompressedNode = 4;
     static const size_t tyQuantizedNode = 5;
     static const size_t tyLeaf = 8;
 
@@ -146,6 +148,9 @@ namespace embree
     /*! checks if this is a quantized node */
     __forceinline int isQuantizedNode() const { return (ptr & (size_t)align_mask) == tyQuantizedNode; }
 
+    /*! checks if this is a compressed node */
+    __forceinline int isCompressedNode() const { return (ptr & (size_t)align_mask) == tyCompressedNode; }
+
     /*! Encodes a node */
     static __forceinline NodeRefPtr encodeNode(AABBNode_t<NodeRefPtr,N>* node) {
       assert(!((size_t)node & align_mask));
@@ -220,6 +225,9 @@ namespace embree
     /*! returns quantized node pointer */
     __forceinline       QuantizedNode_t<NodeRefPtr,N>* quantizedNode()       { assert(isQuantizedNode()); return (      QuantizedNode_t<NodeRefPtr,N>*)(ptr  & ~(size_t)align_mask ); }
     __forceinline const QuantizedNode_t<NodeRefPtr,N>* quantizedNode() const { assert(isQuantizedNode()); return (const QuantizedNode_t<NodeRefPtr,N>*)(ptr  & ~(size_t)align_mask ); }
+
+    /*! returns compressed node pointer */
+    __forceinline const CompressedNode_t<NodeRefPtr,N>* compressedNode() const { assert(isCompressedNode()); return (const CompressedNode_t<NodeRefPtr,N>*)(ptr  & ~(size_t)align_mask ); }
     
     /*! returns leaf pointer */
     __forceinline char* leaf(size_t& num) const {
@@ -30,7 +30,7 @@ namespace embree
 
     template<int N>
     BVHNRefitter<N>::BVHNRefitter (BVH* bvh, const LeafBoundsInterface& leafBounds)
-      : bvh(bvh), leafBounds(leafBounds), numSubTrees(0)
+      : bvh(bvh), leafBounds(leafBounds), numSubTrees(0), rotateStart(0)
     {
     }
 
@@ -168,6 +168,191 @@ namespace embree
       return merge<N>(bounds);
     }
 
+    // =========================================================
+    // =========================================================
+    // =========================================================
+
+    template<int N>
+    size_t BVHNRefitter<N>::rotate(double maxTime)
+    {
+      const double deadline = getSeconds() + maxTime;
+      size_t rotations = 0;
+
+      /* rotate repeatedly as a rotation may enable further rotations */
+      while (getSeconds() < deadline)
+      {
+        size_t passRotations = 0;
+        if (bvh->numPrimitives <= SINGLE_THREAD_THRESHOLD) {
+          rotate_bottom(bvh->root,0,deadline,passRotations);
+        }
+        else
+        {
+          size_t subTreeHeights[MAX_NUM_SUB_TREES];
+          std::atomic<size_t> subTreeRotations(0);
+          std::atomic<size_t> finished(0);
+          numSubTrees = 0;
+          gather_subtree_refs(bvh->root,numSubTrees,0);
+          if (numSubTrees)
+            parallel_for(size_t(0), numSubTrees, size_t(1), [&](const range<size_t>& r) {
+                for (size_t j=r.begin(); j<r.end(); j++) {
+                  const size_t i = (rotateStart+j) % numSubTrees;
+                  size_t n = 0;
+                  subTreeHeights[i] = rotate_bottom(subTrees[i],MAX_SUB_TREE_EXTRACTION_DEPTH,deadline,n);
+                  subTreeRotations += n;
+                  if (getSeconds() < deadline) finished++;
+                }
+              });
+          passRotations += subTreeRotations;
+          rotateStart = numSubTrees ? (rotateStart+finished) % numSubTrees : 0;
+
+          numSubTrees = 0;
+          rotate_toplevel(bvh->root,numSubTrees,subTreeHeights,passRotations,0);
+        }
+        rotations += passRotations;
+        if (passRotations == 0) break;
+      }
+      return rotations;
+    }
+
+    template<int N>
+    size_t BVHNRefitter<N>::rotate_toplevel(NodeRef& ref,
+                                            size_t &subtrees,
+                                            const size_t *const subTreeHeights,
+                                            size_t& rotations,
+                                            const size_t depth)
+    {
+      if (depth >= MAX_SUB_TREE_EXTRACTION_DEPTH)
+      {
+        assert(subtrees < MAX_NUM_SUB_TREES);
+        assert(subTrees[subtrees] == ref);
+        return subTreeHeights[subtrees++];
+      }
+
+      if (!ref.isAABBNode())
+        return 0;
+
+      AABBNode* node = ref.getAABBNode();
+      size_t height[N];
+      for (size_t i=0; i<N; i++)
+      {
+        NodeRef& child = node->child(i);
+        if (unlikely(child == BVH::emptyNode))
+          height[i] = 0;
+        else
+          height[i] = rotate_toplevel(child,subtrees,subTreeHeights,rotations,depth+1);
+      }
+
+      /* the top of the tree is small, thus always gets rotated */
+      rotations += rotate_node(node,height,depth);
+
+      size_t maxHeight = 0;
+      for (size_t i=0; i<N; i++) maxHeight = max(maxHeight,height[i]);
+      return 1+maxHeight;
+    }
+
+    template<int N>
+    size_t BVHNRefitter<N>::rotate_bottom(NodeRef& ref, const size_t depth, const double deadline, size_t& rotations)
+    {
+      if (!ref.isAABBNode())
+        return 0;
+
+      AABBNode* node = ref.getAABBNode();
+      size_t height[N];
+      for (size_t i=0; i<N; i++)
+      {
+        NodeRef& child = node->child(i);
+        if (unlikely(child == BVH::emptyNode))
+          height[i] = 0;
+        else
+          height[i] = rotate_bottom(child,depth+1,deadline,rotations);
+      }
+
+      /* only heights get computed once we ran out of time */
+      if (getSeconds() < deadline)
+        rotations += rotate_node(node,height,depth);
+
+      size_t maxHeight = 0;
+      for (size_t i=0; i<N; i++) maxHeight = max(maxHeight,height[i]);
+      return 1+maxHeight;
+    }
+
+    template<int N>
+    bool BVHNRefitter<N>::rotate_node(AABBNode* node, size_t height[N], const size_t depth)
+    {
+      /*! Find best rotation. We pick a first child (child1) and a
+        sub-child (child2child) of a different second child (child2),
+        and swap child1 and child2child. Only the bounds of child2
+        change, thus the SAH changes by the area difference of
+        child2. */
+      float bestArea = 0.0f;
+      size_t bestChild1 = -1, bestChild2 = -1, bestChild2Child = -1;
+      BBox3fa bestBounds = empty;
+
+      for (size_t c2=0; c2<N; c2++)
+      {
+        /*! ignore leaf nodes as we cannot descent into them */
+        if (!node->child(c2).isAABBNode()) continue;
+        AABBNode* child2 = node->child(c2).getAABBNode();
+
+        /*! bounds of child2 without each of its children */
+        BBox3fa others[N];
+        vbool<N> valid = false;
+        BBox3fa prefix = empty;
+        for (size_t k=0; k<N; k++) {
+          others[k] = prefix;
+          prefix.extend(child2->bounds(k));
+          if (child2->child(k) != BVH::emptyNode) set(valid,k);
+        }
+        BBox3fa suffix = empty;
+        for (ssize_t k=N-1; k>=0; k--) {
+          others[k].extend(suffix);
+          suffix.extend(child2->bounds(k));
+        }
+        if (none(valid)) continue;
+        const BBox3vf<N> othersT = transpose<N>(others);
+        const float area2 = halfArea(node->bounds(c2));
+
+        for (size_t c1=0; c1<N; c1++)
+        {
+          if (c1 == c2 || node->child(c1) == BVH::emptyNode) continue;
+
+          /*! only select swaps that fulfill depth constraints */
+          if (depth+2+height[c1] > BVH::maxBuildDepth) continue;
+
+          /*! put child1 at each child2 position */
+          const BBox3fa bounds1 = node->bounds(c1);
+          const Vec3vf<N> lower = min(othersT.lower,Vec3vf<N>(bounds1.lower.x,bounds1.lower.y,bounds1.lower.z));
+          const Vec3vf<N> upper = max(othersT.upper,Vec3vf<N>(bounds1.upper.x,bounds1.upper.y,bounds1.upper.z));
+          const Vec3vf<N> d = upper-lower;
+          const vfloat<N> area = madd(d.x,d.y+d.z,d.y*d.z) - vfloat<N>(area2);
+          const size_t k = select_min(valid,area);
+          if (!(area[k] < bestArea)) continue; // also rejects NaN bounds
+
+          bestArea = area[k];
+          bestChild1 = c1;
+          bestChild2 = c2;
+          bestChild2Child = k;
+          bestBounds = merge(others[k],bounds1);
+        }
+      }
+
+      /*! skip rotations that improve the SAH only marginally */
+      if (bestChild1 == size_t(-1) || bestArea > -0.001f*halfArea(node->bounds()))
+        return false;
+
+      /*! perform the best found tree rotation */
+      AABBNode* child2 = node->child(bestChild2).getAABBNode();
+      AABBNode::swap(node,bestChild1,child2,bestChild2Child);
+      node->setBounds(bestChild2,bestBounds);
+
+      /*! the new heights are conservative as the child that got
+       *  pulled up could have been on the critical path */
+      const size_t height1 = height[bestChild1], height2 = height[bestChild2];
+      height[bestChild1] = height2;
+      height[bestChild2] = max(height2,height1+2);
+      return true;
+    }
+
     template<int N, typename Mesh, typename Primitive>
     BVHNRefitT<N,Mesh,Primitive>::BVHNRefitT (BVH* bvh, Builder* builder, Mesh* mesh, size_t mode)
       : bvh(bvh), builder(builder), refitter(new BVHNRefitter<N>(bvh,*(typename BVHNRefitter<N>::LeafBoundsInterface*)this)), mesh(mesh), topologyVersion(0) {}
@@ -187,7 +372,29 @@ namespace embree
         builder->build();
       }
       else
+      {
         refitter->refit();
+
+        /* recover SAH quality lost through deformation */
+        const double maxTime = 0.001*bvh->device->refit_rotation_max_time;
+        if (maxTime > 0.0)
+        {
+          double sah0 = 0.0, t0 = 0.0;
+          if (bvh->device->verbosity(2)) {
+            sah0 = BVHNStatistics<N>(bvh).sah();
+            t0 = getSeconds();
+          }
+
+          const size_t rotations = refitter->rotate(maxTime);
+
+          if (bvh->device->verbosity(2)) {
+            const double dt = getSeconds()-t0;
+            Lock<MutexSys> lock(g_printMutex);
+            std::cout << "rotated refitted BVH" << N << "<" << bvh->primTy->name() << "> : " << rotations << " rotations in " << 1000.0*dt << "ms, "
+                      << "sah = " << sah0 << " -> " << BVHNStatistics<N>(bvh).sah() << std::endl;
+          }
+        }
+      }
     }
 
     template class BVHNRefitter<4>;
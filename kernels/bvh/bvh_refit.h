@@ -31,6 +31,10 @@ namespace embree
       /*! refits the BVH */
       void refit();
 
+      /*! improves the SAH of the refitted BVH through tree rotations
+       *  until maxTime seconds passed, returns number of rotations */
+      size_t rotate(double maxTime);
+
     private:
       /* single-threaded subtree extraction based on BVH depth */
       void gather_subtree_refs(NodeRef& ref, 
@@ -45,6 +49,19 @@ namespace embree
 
       /* single-threaded subtree refit */
       BBox3fa recurse_bottom(NodeRef& ref);
+
+      /* single-threaded top-level rotations, returns height of subtree */
+      size_t rotate_toplevel(NodeRef& ref,
+                             size_t &subtrees,
+                             const size_t *const subTreeHeights,
+                             size_t& rotations,
+                             const size_t depth = 0);
+
+      /* single-threaded subtree rotations, returns height of subtree */
+      size_t rotate_bottom(NodeRef& ref, const size_t depth, const double deadline, size_t& rotations);
+
+      /* performs the best SAH improving swap of a child with a grandchild */
+      bool rotate_node(AABBNode* node, size_t height[N], const size_t depth);
       
     public:
       BVH* bvh;                              //!< BVH to refit
@@ -54,6 +71,7 @@ namespace embree
       static const size_t MAX_NUM_SUB_TREES             = (N==4) ? 256 : (N==8) ? 512 : N*N*N; // N ^ MAX_SUB_TREE_EXTRACTION_DEPTH
       size_t numSubTrees;
       NodeRef subTrees[MAX_NUM_SUB_TREES];
+      size_t rotateStart;                    //!< first subtree to rotate, subtrees that ran out of time get rotated first next time
     };
 
     template<int N, typename Mesh, typename Primitive>
@@ -0,0 +1,232 @@
+// Copyright 2009-2021 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include "bvh_serializer.h"
+#include "../../common/algorithms/parallel_for.h"
+#include <fstream>
+
+namespace embree
+{
+  /* nodes are placed at cache line boundaries, leaves at the primitive alignment */
+  static const size_t serializedNodeAlignment = 64;
+
+  __forceinline size_t alignBytes(size_t bytes, size_t alignment) {
+    return (bytes+alignment-1) & ~(alignment-1);
+  }
+
+  template<int N>
+  struct BVHNSerializer<N>::Writer
+  {
+    Writer (BVH* bvh, std::ostream& stream, size_t numLeafBytes, size_t numNodeBytes)
+      : bvh(bvh), stream(stream), nodes(numNodeBytes), leafOffset(0), nodeOffset(0), nodeBase(numLeafBytes) {}
+
+    /* leaves are streamed out in traversal order, nodes are gathered
+     * in memory until all child offsets are known */
+    NodeRef encode(NodeRef ref)
+    {
+      if (ref == BVH::emptyNode)
+        return ref;
+
+      const size_t ty = size_t(ref) & NodeRef::align_mask;
+      const char* ptr = (const char*)(size_t(ref) & ~NodeRef::align_mask);
+
+      if (ref.isLeaf())
+      {
+        const size_t bytes = leafBytes(bvh,ref);
+        const size_t offset = leafOffset;
+        stream.write(ptr,bytes);
+        for (size_t i=bytes; i<alignBytes(bytes,BVH::byteAlignment); i++) stream.put(0);
+        leafOffset += alignBytes(bytes,BVH::byteAlignment);
+        return NodeRef(offset | ty);
+      }
+
+      const size_t bytes = nodeBytes(ref);
+      const size_t offset = nodeOffset;
+      nodeOffset += alignBytes(bytes,serializedNodeAlignment);
+      memcpy(&nodes[offset],ptr,bytes);
+
+      BaseNode* node = (BaseNode*) &nodes[offset];
+      for (size_t i=0; i<N; i++)
+        node->child(i) = encode(node->child(i));
+
+      return NodeRef((nodeBase+offset) | ty);
+    }
+
+    BVH* bvh;
+    std::ostream& stream;
+    std::vector<char> nodes;
+    size_t leafOffset;
+    size_t nodeOffset;
+    size_t nodeBase;
+  };
+
+  template<int N>
+  bool BVHNSerializer<N>::isRelocatable(const PrimitiveType* primTy)
+  {
+    /* primitive types that only store vertex data, indices, or offsets into geometry buffers */
+    static const char* relocatable[] = {
+      "triangle4", "triangle4v", "triangle4i", "triangle4vmb", "quad4v", "quad4i", "line4i", "object"
+    };
+    for (size_t i=0; i<sizeof(relocatable)/sizeof(relocatable[0]); i++)
+      if (strcmp(primTy->name(),relocatable[i]) == 0) return true;
+    return false;
+  }
+
+  template<int N>
+  size_t BVHNSerializer<N>::nodeBytes(NodeRef ref)
+  {
+    switch (ref.type())
+    {
+    case NodeRef::tyAABBNode     : return sizeof(AABBNode);
+    case NodeRef::tyAABBNodeMB   : return sizeof(AABBNodeMB);
+    case NodeRef::tyAABBNodeMB4D : return sizeof(AABBNodeMB4D);
+    case NodeRef::tyOBBNode      : return sizeof(OBBNode);
+    case NodeRef::tyOBBNodeMB    : return sizeof(OBBNodeMB);
+    case NodeRef::tyQuantizedNode: return sizeof(QuantizedNode);
+    default: throw_RTCError(RTC_ERROR_INVALID_OPERATION,"BVH node type does not support serialization");
+    }
+  }
+
+  template<int N>
+  size_t BVHNSerializer<N>::leafBytes(BVH* bvh, NodeRef ref)
+  {
+    size_t num; const char* prim = ref.leaf(num);
+    size_t bytes = 0;
+    for (size_t i=0; i<num; i++)
+      bytes += bvh->primTy->getBytes(prim+bytes);
+    return bytes;
+  }
+
+  template<int N>
+  void BVHNSerializer<N>::count(BVH* bvh, NodeRef ref, size_t& numNodeBytes, size_t& numLeafBytes)
+  {
+    if (ref == BVH::emptyNode)
+      return;
+
+    if (ref.isLeaf()) {
+      numLeafBytes += alignBytes(leafBytes(bvh,ref),BVH::byteAlignment);
+      return;
+    }
+
+    numNodeBytes += alignBytes(nodeBytes(ref),serializedNodeAlignment);
+    const BaseNode* node = ref.baseNode();
+    for (size_t i=0; i<N; i++)
+      count(bvh,node->child(i),numNodeBytes,numLeafBytes);
+  }
+
+  template<int N>
+  void BVHNSerializer<N>::relocate(NodeRef& ref, size_t base, size_t depth)
+  {
+    if (ref == BVH::emptyNode)
+      return;
+
+    ref = NodeRef(base + size_t(ref));
+    if (ref.isLeaf())
+      return;
+
+    BaseNode* node = ref.baseNode();
+    if (depth < 2) {
+      parallel_for(size_t(0), size_t(N), size_t(1), [&](const range<size_t>& r) {
+          for (size_t i=r.begin(); i<r.end(); i++)
+            relocate(node->child(i),base,depth+1);
+        });
+    } else {
+      for (size_t i=0; i<N; i++)
+        relocate(node->child(i),base,depth+1);
+    }
+  }
+
+  template<int N>
+  void BVHNSerializer<N>::save(BVH* bvh, std::ostream& stream)
+  {
+    if (!isRelocatable(bvh->primTy))
+      throw_RTCError(RTC_ERROR_INVALID_OPERATION,std::string("serialization not supported for BVH over ") + bvh->primTy->name() + " primitives");
+
+    size_t numNodeBytes = 0, numLeafBytes = 0;
+    count(bvh,bvh->root,numNodeBytes,numLeafBytes);
+
+    /* wide nodes require aligned loads, thus node region starts at node alignment */
+    numLeafBytes = alignBytes(numLeafBytes,serializedNodeAlignment);
+
+    Header header;
+    memset(&header,0,sizeof(header));
+    strncpy(header.magic,"EMBVHN",sizeof(header.magic)-1);
+    strncpy(header.primTy,bvh->primTy->name(),sizeof(header.primTy)-1);
+    header.version = version;
+    header.branchingFactor = N;
+    const LBBox3fa bounds = bvh->getLinearBounds();
+    const Vec3fa b[4] = { bounds.bounds0.lower, bounds.bounds0.upper, bounds.bounds1.lower, bounds.bounds1.upper };
+    for (size_t i=0; i<4; i++) {
+      header.bounds[i][0] = b[i].x; header.bounds[i][1] = b[i].y; header.bounds[i][2] = b[i].z;
+    }
+    header.numPrimitives = bvh->numPrimitives;
+    header.numVertices = bvh->numVertices;
+    header.headerBytes = alignBytes(sizeof(Header),serializedNodeAlignment);
+    header.leafBytes = numLeafBytes;
+    header.nodeBytes = numNodeBytes;
+
+    /* the header gets rewritten once the root reference is known */
+    const std::streampos start = stream.tellp();
+    stream.write((const char*)&header,sizeof(header));
+    for (size_t i=sizeof(header); i<header.headerBytes; i++) stream.put(0);
+
+    Writer writer(bvh,stream,numLeafBytes,numNodeBytes);
+    header.root = writer.encode(bvh->root);
+    for (size_t i=writer.leafOffset; i<numLeafBytes; i++) stream.put(0);
+    assert(writer.nodeOffset == numNodeBytes);
+    stream.write(writer.nodes.data(),writer.nodes.size());
+    const std::streampos end = stream.tellp();
+
+    stream.seekp(start);
+    stream.write((const char*)&header,sizeof(header));
+    stream.seekp(end);
+
+    if (!stream)
+      throw_RTCError(RTC_ERROR_UNKNOWN,"error writing BVH to file");
+  }
+
+  template<int N>
+  void BVHNSerializer<N>::load(BVH* bvh, const std::string& fileName, size_t& offset)
+  {
+    Header header;
+    std::ifstream stream(fileName.c_str(),std::ios::binary);
+    stream.seekg(offset);
+    stream.read((char*)&header,sizeof(header));
+    if (!stream || strncmp(header.magic,"EMBVHN",sizeof(header.magic)) != 0)
+      throw_RTCError(RTC_ERROR_INVALID_OPERATION,"invalid BVH section in scene file");
+    if (header.version != version)
+      throw_RTCError(RTC_ERROR_INVALID_OPERATION,"unsupported BVH section version in scene file");
+    if (header.branchingFactor != N || strncmp(header.primTy,bvh->primTy->name(),sizeof(header.primTy)) != 0)
+      throw_RTCError(RTC_ERROR_INVALID_OPERATION,std::string("scene file stores BVH over ") + header.primTy + " primitives but scene requires BVH" + toString(N) + " over " + bvh->primTy->name());
+
+    const size_t bytes = header.headerBytes + header.leafBytes + header.nodeBytes;
+    char* ptr = (char*) os_map_file(fileName.c_str(),offset,bytes);
+    if (ptr == nullptr)
+      throw_RTCError(RTC_ERROR_INVALID_OPERATION,"cannot map scene file " + fileName);
+
+    bvh->clear();
+    bvh->mappedPtr = ptr;
+    bvh->mappedBytes = bytes;
+
+    /* fix up node references, this only touches the node pages */
+    NodeRef root = NodeRef(header.root);
+    relocate(root,size_t(ptr+header.headerBytes),0);
+
+    const Vec3fa lower0(header.bounds[0][0],header.bounds[0][1],header.bounds[0][2]);
+    const Vec3fa upper0(header.bounds[1][0],header.bounds[1][1],header.bounds[1][2]);
+    const Vec3fa lower1(header.bounds[2][0],header.bounds[2][1],header.bounds[2][2]);
+    const Vec3fa upper1(header.bounds[3][0],header.bounds[3][1],header.bounds[3][2]);
+    bvh->set(root,LBBox3fa(BBox3fa(lower0,upper0),BBox3fa(lower1,upper1)),header.numPrimitives);
+    bvh->numVertices = header.numVertices;
+
+    offset += bytes;
+  }
+
+#if defined(__AVX__)
+  template class BVHNSerializer<8>;
+#endif
+
+#if !defined(__AVX__) || !defined(EMBREE_TARGET_SSE2) && !defined(EMBREE_TARGET_SSE42) || defined(__aarch64__)
+  template class BVHNSerializer<4>;
+#endif
+}
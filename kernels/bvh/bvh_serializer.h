@@ -0,0 +1,68 @@
+// Copyright 2009-2021 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include "bvh.h"
+#include <iostream>
+
+namespace embree
+{
+  /*! Writes a BVH into a relocatable file section and maps such a
+   *  section back into memory. Node and leaf references are stored
+   *  as offsets relative to the start of the section data, thus only
+   *  the node pages have to be fixed up after mapping the file. */
+  template<int N>
+  class BVHNSerializer
+  {
+    typedef BVHN<N> BVH;
+    typedef typename BVH::AABBNode AABBNode;
+    typedef typename BVH::OBBNode OBBNode;
+    typedef typename BVH::AABBNodeMB AABBNodeMB;
+    typedef typename BVH::AABBNodeMB4D AABBNodeMB4D;
+    typedef typename BVH::OBBNodeMB OBBNodeMB;
+    typedef typename BVH::QuantizedNode QuantizedNode;
+    typedef typename BVH::BaseNode BaseNode;
+    typedef typename BVH::NodeRef NodeRef;
+
+  public:
+
+    /*! version of the section layout, increase when changing the format */
+    static const unsigned int version = 1;
+
+    /*! header stored in front of each BVH section */
+    struct Header
+    {
+      char magic[8];             //!< section marker "EMBVHN"
+      unsigned int version;      //!< version of section layout
+      unsigned int branchingFactor; //!< branching factor of the BVH
+      char primTy[48];           //!< name of the stored primitive type
+      float bounds[4][3];        //!< linear bounds of the BVH
+      uint64_t numPrimitives;    //!< number of primitives the BVH got build over
+      uint64_t numVertices;      //!< number of vertices the BVH references
+      uint64_t root;             //!< root reference relative to section data
+      uint64_t headerBytes;      //!< bytes reserved for this header
+      uint64_t leafBytes;        //!< size of leaf region, leaves are stored first
+      uint64_t nodeBytes;        //!< size of node region, nodes follow the leaves
+    };
+
+  public:
+
+    /*! checks if the leaves of some primitive type contain no pointers */
+    static bool isRelocatable(const PrimitiveType* primTy);
+
+    /*! writes the BVH to the stream */
+    static void save(BVH* bvh, std::ostream& stream);
+
+    /*! maps the BVH section at offset and advances offset past that section */
+    static void load(BVH* bvh, const std::string& fileName, size_t& offset);
+
+  private:
+    static size_t nodeBytes(NodeRef ref);
+    static size_t leafBytes(BVH* bvh, NodeRef ref);
+    static void count(BVH* bvh, NodeRef ref, size_t& numNodeBytes, size_t& numLeafBytes);
+    static void relocate(NodeRef& ref, size_t base, size_t depth);
+
+    struct Writer;
+  };
+}
@@ -31,6 +31,7 @@ namespace embree
     if (stat.statAABBNodesMB4D.numNodes) stream << "  getAABBNodesMB4D : "  << stat.statAABBNodesMB4D.toString(bvh,totalSAH,totalBytes) << std::endl;
     if (stat.statOBBNodesMB.numNodes) stream << "  ungetAABBNodesMB : "  << stat.statOBBNodesMB.toString(bvh,totalSAH,totalBytes) << std::endl;
     if (stat.statQuantizedNodes.numNodes  ) stream << "  quantizedNodes   : "  << stat.statQuantizedNodes.toString(bvh,totalSAH,totalBytes) << std::endl;
+    if (stat.statCompressedNodes.numNodes ) stream << "  compressedNodes  : "  << stat.statCompressedNodes.toString(bvh,totalSAH,totalBytes) << std::endl;
     if (true)                               stream << "  leaves           : "  << stat.statLeaf.toString(bvh,totalSAH,totalBytes) << std::endl;
     if (true)                               stream << "    histogram      : "  << stat.statLeaf.histToString() << std::endl;
     return stream.str();
@@ -52,6 +53,9 @@ namespace embree
           s.statAABBNodes.numChildren++;
           return s;
         }, Statistics::add);
+      BBox3fa bounds[N];
+      for (size_t i=0; i<N; i++) bounds[i] = n->bounds(i);
+      s.leafOverlap += dt*leafOverlap(n->children,bounds);
       s.statAABBNodes.numNodes++;
       s.statAABBNodes.nodeSAH += dt*A;
       s.depth++;
@@ -80,6 +84,9 @@ namespace embree
           s.statAABBNodesMB.numChildren++;
           return s;
         }, Statistics::add);
+      BBox3fa bounds[N];
+      for (size_t i=0; i<N; i++) bounds[i] = n->bounds(i);
+      s.leafOverlap += dt*leafOverlap(n->children,bounds);
       s.statAABBNodesMB.numNodes++;
       s.statAABBNodesMB.nodeSAH += dt*A;
       s.depth++;
@@ -96,6 +103,9 @@ namespace embree
           s.statAABBNodesMB4D.numChildren++;
           return s;
         }, Statistics::add);
+      BBox3fa bounds[N];
+      for (size_t i=0; i<N; i++) bounds[i] = n->bounds(i);
+      s.leafOverlap += dt*leafOverlap(n->children,bounds);
       s.statAABBNodesMB4D.numNodes++;
       s.statAABBNodesMB4D.nodeSAH += dt*A;
       s.depth++;
@@ -124,10 +134,34 @@ namespace embree
           s.statQuantizedNodes.numChildren++;
           return s;
         }, Statistics::add);
+      BBox3fa bounds[N];
+      for (size_t i=0; i<N; i++) bounds[i] = n->bounds(i);
+      s.leafOverlap += dt*leafOverlap(n->children,bounds);
       s.statQuantizedNodes.numNodes++;
       s.statQuantizedNodes.nodeSAH += dt*A;
       s.depth++;
     }
+    else if (node.isCompressedNode())
+    {
+      const CompressedNode* n = node.compressedNode();
+      s = s + parallel_reduce(0,N,Statistics(),[&] ( const int i ) {
+          if (n->child(i) == BVH::emptyNode) return Statistics();
+          const double Ai = max(0.0f,halfArea(n->extent(i)));
+          Statistics s = statistics(n->child(i),Ai,t0t1); 
+          s.statCompressedNodes.numChildren++;
+          return s;
+        }, Statistics::add);
+      NodeRef children[N];
+      BBox3fa bounds[N];
+      for (size_t i=0; i<N; i++) {
+        children[i] = n->child(i);
+        bounds[i] = n->bounds(i);
+      }
+      s.leafOverlap += dt*leafOverlap(children,bounds);
+      s.statCompressedNodes.numNodes++;
+      s.statCompressedNodes.nodeSAH += dt*A;
+      s.depth++;
+    }
     else if (node.isLeaf())
     {
       size_t num; const char* tri = node.leaf(num);
@@ -136,6 +170,7 @@ namespace embree
         for (size_t i=0; i<num; i++)
         {
           const size_t bytes = bvh->primTy->getBytes(tri);
+          s.statLeaf.primSAH += dt*A*bvh->primTy->sizeActive(tri);
           s.statLeaf.numPrimsActive += bvh->primTy->sizeActive(tri);
           s.statLeaf.numPrimsTotal += bvh->primTy->sizeTotal(tri);
           s.statLeaf.numBytes += bytes;
@@ -155,6 +190,46 @@ namespace embree
     return s;
   } 
 
+  template<int N>
+  double BVHNStatistics<N>::leafOverlap(const NodeRef* children, const BBox3fa* bounds)
+  {
+    double overlap = 0.0;
+    for (size_t i=0; i<N; i++)
+    {
+      if (children[i] == BVH::emptyNode || !children[i].isLeaf()) continue;
+      for (size_t j=i+1; j<N; j++)
+      {
+        if (children[j] == BVH::emptyNode || !children[j].isLeaf()) continue;
+        const BBox3fa o = intersect(bounds[i],bounds[j]);
+        if (!o.empty()) overlap += halfArea(o);
+      }
+    }
+    return overlap;
+  }
+
+  template<int N>
+  void BVHNStatistics<N>::get(RTCBVHStatistics& stats) const
+  {
+    const double A = bvh->getLinearBounds().expectedHalfArea();
+    stats.branchingFactor = N;
+    stats.primitiveType = bvh->primTy->name();
+    stats.numPrimitives = bvh->numPrimitives;
+    stats.depth = stat.depth;
+    stats.bytes = stat.bytes(bvh);
+    stats.sah = float(stat.sah(bvh));
+    stats.fillRate = float(stat.fillRate(bvh));
+    stats.leafOverlap = A > 0.0 ? float(stat.leafOverlap/A) : 0.0f;
+    stats.traversalCost = A > 0.0 ? float(stat.innerSAH(bvh) + stat.statLeaf.primSAH/A) : 0.0f;
+    stat.statAABBNodes.get(stats.aabbNodes,bvh);
+    stat.statOBBNodes.get(stats.obbNodes,bvh);
+    stat.statAABBNodesMB.get(stats.aabbNodesMB,bvh);
+    stat.statAABBNodesMB4D.get(stats.aabbNodesMB4D,bvh);
+    stat.statOBBNodesMB.get(stats.obbNodesMB,bvh);
+    stat.statQuantizedNodes.get(stats.quantizedNodes,bvh);
+    stat.statCompressedNodes.get(stats.compressedNodes,bvh);
+    stat.statLeaf.get(stats.leaves,bvh);
+  }
+
 #if defined(__AVX__)
   template class BVHNStatistics<8>;
 #endif
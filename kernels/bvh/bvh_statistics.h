@@ -18,6 +18,7 @@ namespace embree
     typedef typename BVH::AABBNodeMB4D AABBNodeMB4D;
     typedef typename BVH::OBBNodeMB OBBNodeMB;
     typedef typename BVH::QuantizedNode QuantizedNode;
+    typedef typename BVH::CompressedNode CompressedNode;
 
     typedef typename BVH::NodeRef NodeRef;
 
@@ -49,6 +50,14 @@ namespace embree
         double fillRateDen () const { return double(numNodes*N);  }
         double fillRate    () const { return fillRateNom()/fillRateDen(); }
 
+        void get(RTCBVHNodeStatistics& stats, BVH* bvh) const
+        {
+          stats.numNodes = numNodes;
+          stats.bytes = bytes();
+          stats.sah = numNodes ? float(sah(bvh)) : 0.0f;
+          stats.fillRate = numNodes ? float(fillRate()) : 0.0f;
+        }
+
         __forceinline friend NodeStat operator+ ( const NodeStat& a, const NodeStat& b)
         {
           return NodeStat(a.nodeSAH + b.nodeSAH,
@@ -84,13 +93,15 @@ namespace embree
                    size_t numPrimsActive = 0,
                    size_t numPrimsTotal = 0,
                    size_t numPrimBlocks = 0,
-                   size_t numBytes = 0)
+                   size_t numBytes = 0,
+                   double primSAH = 0.0f)
         : leafSAH(leafSAH),
           numLeaves(numLeaves),
           numPrimsActive(numPrimsActive),
           numPrimsTotal(numPrimsTotal),
           numPrimBlocks(numPrimBlocks),
-          numBytes(numBytes)
+          numBytes(numBytes),
+          primSAH(primSAH)
         {
           for (size_t i=0; i<NHIST; i++)
             numPrimBlocksHistogram[i] = 0;
@@ -112,6 +123,14 @@ namespace embree
         double fillRateDen (BVH* bvh) const { return double(numPrimsTotal);  }
         double fillRate    (BVH* bvh) const { return fillRateNom(bvh)/fillRateDen(bvh); }
 
+        void get(RTCBVHNodeStatistics& stats, BVH* bvh) const
+        {
+          stats.numNodes = numLeaves;
+          stats.bytes = bytes(bvh);
+          stats.sah = numLeaves ? float(sah(bvh)) : 0.0f;
+          stats.fillRate = numLeaves ? float(fillRate(bvh)) : 0.0f;
+        }
+
         __forceinline friend LeafStat operator+ ( const LeafStat& a, const LeafStat& b)
         {
           LeafStat stat(a.leafSAH + b.leafSAH,
@@ -119,7 +138,8 @@ namespace embree
                         a.numPrimsActive+b.numPrimsActive,
                         a.numPrimsTotal+b.numPrimsTotal,
                         a.numPrimBlocks+b.numPrimBlocks,
-                        a.numBytes+b.numBytes);
+                        a.numBytes+b.numBytes,
+                        a.primSAH+b.primSAH);
           for (size_t i=0; i<NHIST; i++) {
             stat.numPrimBlocksHistogram[i] += a.numPrimBlocksHistogram[i];
             stat.numPrimBlocksHistogram[i] += b.numPrimBlocksHistogram[i];
@@ -157,6 +177,7 @@ namespace embree
         size_t numPrimBlocks;              //!< Number of primitive blocks.
         size_t numBytes;                   //!< Number of bytes of leaves.
         size_t numPrimBlocksHistogram[8];
+        double primSAH;                    //!< SAH of the primitive intersections
       };
 
     public:
@@ -167,7 +188,9 @@ namespace embree
                   NodeStat<AABBNodeMB> statAABBNodesMB = NodeStat<AABBNodeMB>(),
                   NodeStat<AABBNodeMB4D> statAABBNodesMB4D = NodeStat<AABBNodeMB4D>(),
                   NodeStat<OBBNodeMB> statOBBNodesMB = NodeStat<OBBNodeMB>(),
-                  NodeStat<QuantizedNode> statQuantizedNodes = NodeStat<QuantizedNode>())
+                  NodeStat<QuantizedNode> statQuantizedNodes = NodeStat<QuantizedNode>(),
+                  NodeStat<CompressedNode> statCompressedNodes = NodeStat<CompressedNode>(),
+                  double leafOverlap = 0.0)
 
       : depth(depth), 
         statLeaf(statLeaf),
@@ -176,7 +199,9 @@ namespace embree
         statAABBNodesMB(statAABBNodesMB),
         statAABBNodesMB4D(statAABBNodesMB4D),
         statOBBNodesMB(statOBBNodesMB),
-        statQuantizedNodes(statQuantizedNodes) {}
+        statQuantizedNodes(statQuantizedNodes),
+        statCompressedNodes(statCompressedNodes),
+        leafOverlap(leafOverlap) {}
 
       double sah(BVH* bvh) const 
       {
@@ -186,9 +211,21 @@ namespace embree
           statAABBNodesMB.sah(bvh) + 
           statAABBNodesMB4D.sah(bvh) + 
           statOBBNodesMB.sah(bvh) + 
-          statQuantizedNodes.sah(bvh);
+          statQuantizedNodes.sah(bvh) + 
+          statCompressedNodes.sah(bvh);
       }
       
+      double innerSAH(BVH* bvh) const
+      {
+        return statAABBNodes.sah(bvh) + 
+          statOBBNodes.sah(bvh) + 
+          statAABBNodesMB.sah(bvh) + 
+          statAABBNodesMB4D.sah(bvh) + 
+          statOBBNodesMB.sah(bvh) + 
+          statQuantizedNodes.sah(bvh) + 
+          statCompressedNodes.sah(bvh);
+      }
+
       size_t bytes(BVH* bvh) const {
         return statLeaf.bytes(bvh) +
           statAABBNodes.bytes() + 
@@ -196,7 +233,8 @@ namespace embree
           statAABBNodesMB.bytes() + 
           statAABBNodesMB4D.bytes() + 
           statOBBNodesMB.bytes() + 
-          statQuantizedNodes.bytes();
+          statQuantizedNodes.bytes() + 
+          statCompressedNodes.bytes();
       }
 
       size_t size() const 
@@ -207,7 +245,8 @@ namespace embree
           statAABBNodesMB.size() + 
           statAABBNodesMB4D.size() + 
           statOBBNodesMB.size() + 
-          statQuantizedNodes.size();
+          statQuantizedNodes.size() + 
+          statCompressedNodes.size();
       }
 
       double fillRate (BVH* bvh) const 
@@ -218,14 +257,16 @@ namespace embree
           statAABBNodesMB.fillRateNom() + 
           statAABBNodesMB4D.fillRateNom() + 
           statOBBNodesMB.fillRateNom() + 
-          statQuantizedNodes.fillRateNom();
+          statQuantizedNodes.fillRateNom() + 
+          statCompressedNodes.fillRateNom();
         double den = statLeaf.fillRateDen(bvh) +
           statAABBNodes.fillRateDen() + 
           statOBBNodes.fillRateDen() + 
           statAABBNodesMB.fillRateDen() + 
           statAABBNodesMB4D.fillRateDen() + 
           statOBBNodesMB.fillRateDen() + 
-          statQuantizedNodes.fillRateDen();
+          statQuantizedNodes.fillRateDen() + 
+          statCompressedNodes.fillRateDen();
         return nom/den;
       }
 
@@ -238,7 +279,9 @@ namespace embree
                           a.statAABBNodesMB + b.statAABBNodesMB,
                           a.statAABBNodesMB4D + b.statAABBNodesMB4D,
                           a.statOBBNodesMB + b.statOBBNodesMB,
-                          a.statQuantizedNodes + b.statQuantizedNodes);
+                          a.statQuantizedNodes + b.statQuantizedNodes,
+                          a.statCompressedNodes + b.statCompressedNodes,
+                          a.leafOverlap + b.leafOverlap);
       }
 
       static Statistics add ( const Statistics& a, const Statistics& b ) {
@@ -254,6 +297,8 @@ namespace embree
       NodeStat<AABBNodeMB4D> statAABBNodesMB4D;
       NodeStat<OBBNodeMB> statOBBNodesMB;
       NodeStat<QuantizedNode> statQuantizedNodes;
+      NodeStat<CompressedNode> statCompressedNodes;
+      double leafOverlap;              //!< area of the pairwise overlap of sibling leaves
     };
 
   public:
@@ -272,8 +317,12 @@ namespace embree
       return stat.bytes(bvh);
     }
 
+    /*! returns the quality metrics of the BVH */
+    void get(RTCBVHStatistics& stats) const;
+
   private:
     Statistics statistics(NodeRef node, const double A, const BBox1f dt);
+    static double leafOverlap(const NodeRef* children, const BBox3fa* bounds);
 
   private:
     BVH* bvh;
@@ -286,6 +286,18 @@ namespace embree
       return pointQuerySphereDistAndMask(query, dist, minX, maxX, minY, maxY, minZ, maxZ) & movemask(node->validMask());
     }
     
+    template<int N>
+    __forceinline size_t pointQueryNodeSphere(const typename BVHN<N>::CompressedNode* node, const TravPointQuery<N>& query, vfloat<N>& dist)
+    {
+      const vfloat<N> minX = node->dequantizeLowerX();
+      const vfloat<N> maxX = node->dequantizeUpperX();
+      const vfloat<N> minY = node->dequantizeLowerY();
+      const vfloat<N> maxY = node->dequantizeUpperY();
+      const vfloat<N> minZ = node->dequantizeLowerZ();
+      const vfloat<N> maxZ = node->dequantizeUpperZ();
+      return pointQuerySphereDistAndMask(query, dist, minX, maxX, minY, maxY, minZ, maxZ) & movemask(node->validMask());
+    }
+    
     template<int N>
     __forceinline size_t pointQueryNodeSphere(const typename BVHN<N>::OBBNode* node, const TravPointQuery<N>& query, vfloat<N>& dist)
     {
@@ -399,6 +411,19 @@ namespace embree
       return pointQueryAABBDistAndMask(query, dist, minX, maxX, minY, maxY, minZ, maxZ) & mvalid;
     }
     
+    template<int N>
+    __forceinline size_t pointQueryNodeAABB(const typename BVHN<N>::CompressedNode* node, const TravPointQuery<N>& query, vfloat<N>& dist)
+    {
+      const size_t mvalid  = movemask(node->validMask());
+      const vfloat<N> minX = node->dequantizeLowerX();
+      const vfloat<N> maxX = node->dequantizeUpperX();
+      const vfloat<N> minY = node->dequantizeLowerY();
+      const vfloat<N> maxY = node->dequantizeUpperY();
+      const vfloat<N> minZ = node->dequantizeLowerZ();
+      const vfloat<N> maxZ = node->dequantizeUpperZ();
+      return pointQueryAABBDistAndMask(query, dist, minX, maxX, minY, maxY, minZ, maxZ) & mvalid;
+    }
+    
     template<int N>
     __forceinline size_t pointQueryNodeAABB(const typename BVHN<N>::OBBNode* node, const TravPointQuery<N>& query, vfloat<N>& dist)
     {
@@ -927,6 +952,93 @@ namespace embree
 
 #endif
 
+    //////////////////////////////////////////////////////////////////////////////////////
+    // Fast CompressedNode intersection
+    //////////////////////////////////////////////////////////////////////////////////////
+
+    template<int N>
+      __forceinline size_t intersectNode(const typename BVHN<N>::CompressedNode* node, const TravRay<N,false>& ray, vfloat<N>& dist)
+    {
+      /* the grid spacing is a power of two, thus the decoded bounds match the conservative bounds of the builder exactly */
+      const size_t mvalid  = movemask(node->validMask());
+      const Vec3f scale = node->decodeScale();
+      const vfloat<N> start_x(node->start.x);
+      const vfloat<N> scale_x(scale.x);
+      const vfloat<N> lower_x = madd(node->template dequantize<N>(ray.nearX >> 2),scale_x,start_x);
+      const vfloat<N> upper_x = madd(node->template dequantize<N>(ray.farX  >> 2),scale_x,start_x);
+      const vfloat<N> start_y(node->start.y);
+      const vfloat<N> scale_y(scale.y);
+      const vfloat<N> lower_y = madd(node->template dequantize<N>(ray.nearY >> 2),scale_y,start_y);
+      const vfloat<N> upper_y = madd(node->template dequantize<N>(ray.farY  >> 2),scale_y,start_y);
+      const vfloat<N> start_z(node->start.z);
+      const vfloat<N> scale_z(scale.z);
+      const vfloat<N> lower_z = madd(node->template dequantize<N>(ray.nearZ >> 2),scale_z,start_z);
+      const vfloat<N> upper_z = madd(node->template dequantize<N>(ray.farZ  >> 2),scale_z,start_z);
+
+#if defined(__AVX2__) && !defined(__aarch64__)
+      const vfloat<N> tNearX = msub(lower_x, ray.rdir.x, ray.org_rdir.x);
+      const vfloat<N> tNearY = msub(lower_y, ray.rdir.y, ray.org_rdir.y);
+      const vfloat<N> tNearZ = msub(lower_z, ray.rdir.z, ray.org_rdir.z);
+      const vfloat<N> tFarX  = msub(upper_x, ray.rdir.x, ray.org_rdir.x);
+      const vfloat<N> tFarY  = msub(upper_y, ray.rdir.y, ray.org_rdir.y);
+      const vfloat<N> tFarZ  = msub(upper_z, ray.rdir.z, ray.org_rdir.z);
+#else
+      const vfloat<N> tNearX = (lower_x - ray.org.x) * ray.rdir.x;
+      const vfloat<N> tNearY = (lower_y - ray.org.y) * ray.rdir.y;
+      const vfloat<N> tNearZ = (lower_z - ray.org.z) * ray.rdir.z;
+      const vfloat<N> tFarX  = (upper_x - ray.org.x) * ray.rdir.x;
+      const vfloat<N> tFarY  = (upper_y - ray.org.y) * ray.rdir.y;
+      const vfloat<N> tFarZ  = (upper_z - ray.org.z) * ray.rdir.z;
+#endif
+
+#if defined(__AVX2__) && !defined(__AVX512F__) // HSW
+      const vfloat<N> tNear = maxi(tNearX,tNearY,tNearZ,ray.tnear);
+      const vfloat<N> tFar  = mini(tFarX ,tFarY ,tFarZ ,ray.tfar);
+      const vbool<N> vmask = asInt(tNear) > asInt(tFar);
+      const size_t mask = movemask(vmask) ^ ((1<<N)-1);
+#else
+      const vfloat<N> tNear = max(tNearX,tNearY,tNearZ,ray.tnear);
+      const vfloat<N> tFar  = min(tFarX ,tFarY ,tFarZ ,ray.tfar);
+      const vbool<N> vmask = tNear <= tFar;
+      const size_t mask = movemask(vmask);
+#endif
+      dist = tNear;
+      return mask & mvalid;
+    }
+
+    template<int N>
+      __forceinline size_t intersectNode(const typename BVHN<N>::CompressedNode* node, const TravRay<N,true>& ray, vfloat<N>& dist)
+    {
+      const size_t mvalid  = movemask(node->validMask());
+      const Vec3f scale = node->decodeScale();
+      const vfloat<N> start_x(node->start.x);
+      const vfloat<N> scale_x(scale.x);
+      const vfloat<N> lower_x = madd(node->template dequantize<N>(ray.nearX >> 2),scale_x,start_x);
+      const vfloat<N> upper_x = madd(node->template dequantize<N>(ray.farX  >> 2),scale_x,start_x);
+      const vfloat<N> start_y(node->start.y);
+      const vfloat<N> scale_y(scale.y);
+      const vfloat<N> lower_y = madd(node->template dequantize<N>(ray.nearY >> 2),scale_y,start_y);
+      const vfloat<N> upper_y = madd(node->template dequantize<N>(ray.farY  >> 2),scale_y,start_y);
+      const vfloat<N> start_z(node->start.z);
+      const vfloat<N> scale_z(scale.z);
+      const vfloat<N> lower_z = madd(node->template dequantize<N>(ray.nearZ >> 2),scale_z,start_z);
+      const vfloat<N> upper_z = madd(node->template dequantize<N>(ray.farZ  >> 2),scale_z,start_z);
+
+      const vfloat<N> tNearX = (lower_x - ray.org.x) * ray.rdir_near.x;
+      const vfloat<N> tNearY = (lower_y - ray.org.y) * ray.rdir_near.y;
+      const vfloat<N> tNearZ = (lower_z - ray.org.z) * ray.rdir_near.z;
+      const vfloat<N> tFarX  = (upper_x - ray.org.x) * ray.rdir_far.x;
+      const vfloat<N> tFarY  = (upper_y - ray.org.y) * ray.rdir_far.y;
+      const vfloat<N> tFarZ  = (upper_z - ray.org.z) * ray.rdir_far.z;
+
+      const vfloat<N> tNear = max(tNearX,tNearY,tNearZ,ray.tnear);
+      const vfloat<N> tFar  = min(tFarX ,tFarY ,tFarZ ,ray.tfar);
+      const vbool<N> vmask = tNear <= tFar;
+      const size_t mask = movemask(vmask);
+      dist = tNear;
+      return mask & mvalid;
+    }
+
     template<int N>
       __forceinline size_t intersectNode(const typename BVHN<N>::QuantizedBaseNodeMB* node, const TravRay<N,false>& ray, const float time, vfloat<N>& dist)
     {
@@ -1172,6 +1284,17 @@ namespace embree
       }
     };
     
+    template<int N>
+    struct BVHNNodePointQuerySphere1<N, BVH_CN1>
+    {
+      static __forceinline bool pointQuery(const typename BVHN<N>::NodeRef& node, const TravPointQuery<N>& query, float time, vfloat<N>& dist, size_t& mask)
+      {
+        if (unlikely(node.isLeaf())) return false;
+        mask = pointQueryNodeSphere(node.compressedNode(), query, dist);
+        return true;
+      }
+    };
+    
     template<int N>
     struct BVHNQuantizedBaseNodePointQuerySphere1
     {
@@ -1270,6 +1393,17 @@ namespace embree
       }
     };
     
+    template<int N>
+    struct BVHNNodePointQueryAABB1<N, BVH_CN1>
+    {
+      static __forceinline bool pointQuery(const typename BVHN<N>::NodeRef& node, const TravPointQuery<N>& query, float time, vfloat<N>& dist, size_t& mask)
+      {
+        if (unlikely(node.isLeaf())) return false;
+        mask = pointQueryNodeAABB(node.compressedNode(), query, dist);
+        return true;
+      }
+    };
+    
     template<int N>
     struct BVHNQuantizedBaseNodePointQueryAABB1
     {
@@ -1453,6 +1587,17 @@ namespace embree
       }
     };
 
+    template<int N, bool robust>
+    struct BVHNNodeIntersector1<N, BVH_CN1, robust>
+    {
+      static __forceinline bool intersect(const typename BVHN<N>::NodeRef& node, const TravRay<N,robust>& ray, float time, vfloat<N>& dist, size_t& mask)
+      {
+        if (unlikely(node.isLeaf())) return false;
+        mask = intersectNode(node.compressedNode(), ray, dist);
+        return true;
+      }
+    };
+
     /*! Intersects N nodes with K rays */
     template<int N, bool robust>
       struct BVHNQuantizedBaseNodeIntersector1;
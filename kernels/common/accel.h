@@ -29,6 +29,25 @@ namespace embree
     /*! clears the acceleration structure data */
     virtual void clear() = 0;
 
+    /*! writes the acceleration structure into a relocatable file section */
+    virtual void save(std::ostream& stream) {
+      throw_RTCError(RTC_ERROR_INVALID_OPERATION,"acceleration structure does not support serialization");
+    }
+
+    /*! maps the file section at offset and advances offset to the end of the section */
+    virtual void load(const std::string& fileName, size_t& offset) {
+      throw_RTCError(RTC_ERROR_INVALID_OPERATION,"acceleration structure does not support serialization");
+    }
+
+    /*! replicates read-only parts of the acceleration structure per NUMA node */
+    virtual void replicate() {}
+
+    /*! appends quality metrics of all BVHs of the acceleration structure */
+    virtual void statistics(std::vector<RTCBVHStatistics>& stats) {}
+
+    /*! appends build phase timings of all BVHs of the acceleration structure */
+    virtual void buildStatistics(std::vector<RTCBuildStatistics>& stats) {}
+
     /*! returns normal bounds */
     __forceinline BBox3fa getBounds() const {
       return bounds.bounds();
@@ -75,6 +94,12 @@ namespace embree
                                   RTCRayHit& ray,      /*!< ray to intersect */
                                   RayQueryContext* context);
     
+    /*! Type of intersect function pointer for batches of single rays. */
+    typedef void (*IntersectBatchFunc)(Intersectors* This, /*!< this pointer to accel */
+                                       RTCRayHit* rays,    /*!< rays to intersect */
+                                       size_t numRays,     /*!< number of rays */
+                                       RayQueryContext* context);
+    
     /*! Type of intersect function pointer for ray packets of size 4. */
     typedef void (*IntersectFunc4)(const void* valid,  /*!< pointer to valid mask */
                                    Intersectors* This, /*!< this pointer to accel */
@@ -98,6 +123,12 @@ namespace embree
                                   RTCRay& ray,        /*!< ray to test occlusion */
                                   RayQueryContext* context);
     
+    /*! Type of occlusion function pointer for batches of single rays. */
+    typedef void (*OccludedBatchFunc) (Intersectors* This, /*!< this pointer to accel */
+                                       RTCRay* rays,       /*!< rays to test occlusion */
+                                       size_t numRays,     /*!< number of rays */
+                                       RayQueryContext* context);
+    
     /*! Type of occlusion function pointer for ray packets of size 4. */
     typedef void (*OccludedFunc4) (const void* valid,  /*!< pointer to valid mask */
                                    Intersectors* This, /*!< this pointer to accel */
@@ -116,6 +147,51 @@ namespace embree
                                     RTCRay16& ray,      /*!< ray packet to test occlusion. */
                                     RayQueryContext* context);
 
+    /*! Type of intersect function pointer for tiles of ray packets of size 4. */
+    typedef void (*IntersectTileFunc4)(const void* valid,  /*!< pointer to valid masks of all packets */
+                                       Intersectors* This, /*!< this pointer to accel */
+                                       RTCRayHit4* rays,   /*!< ray packets to intersect */
+                                       size_t numPackets,  /*!< number of ray packets */
+                                       RayQueryContext* context);
+
+    /*! Type of intersect function pointer for tiles of ray packets of size 8. */
+    typedef void (*IntersectTileFunc8)(const void* valid,  /*!< pointer to valid masks of all packets */
+                                       Intersectors* This, /*!< this pointer to accel */
+                                       RTCRayHit8* rays,   /*!< ray packets to intersect */
+                                       size_t numPackets,  /*!< number of ray packets */
+                                       RayQueryContext* context);
+
+    /*! Type of intersect function pointer for tiles of ray packets of size 16. */
+    typedef void (*IntersectTileFunc16)(const void* valid,  /*!< pointer to valid masks of all packets */
+                                        Intersectors* This, /*!< this pointer to accel */
+                                        RTCRayHit16* rays,  /*!< ray packets to intersect */
+                                        size_t numPackets,  /*!< number of ray packets */
+                                        RayQueryContext* context);
+
+    /*! Type of occlusion function pointer for tiles of ray packets of size 4. */
+    typedef void (*OccludedTileFunc4)(const void* valid,  /*!< pointer to valid masks of all packets */
+                                      Intersectors* This, /*!< this pointer to accel */
+                                      RTCRay4* rays,      /*!< ray packets to test occlusion */
+                                      size_t numPackets,  /*!< number of ray packets */
+                                      RayQueryContext* context);
+
+    /*! Type of occlusion function pointer for tiles of ray packets of size 8. */
+    typedef void (*OccludedTileFunc8)(const void* valid,  /*!< pointer to valid masks of all packets */
+                                      Intersectors* This, /*!< this pointer to accel */
+                                      RTCRay8* rays,      /*!< ray packets to test occlusion */
+                                      size_t numPackets,  /*!< number of ray packets */
+                                      RayQueryContext* context);
+
+    /*! Type of occlusion function pointer for tiles of ray packets of size 16. */
+    typedef void (*OccludedTileFunc16)(const void* valid,  /*!< pointer to valid masks of all packets */
+                                       Intersectors* This, /*!< this pointer to accel */
+                                       RTCRay16* rays,     /*!< ray packets to test occlusion */
+                                       size_t numPackets,  /*!< number of ray packets */
+                                       RayQueryContext* context);
+
+    /*! maximal number of rays of a tile */
+    static const size_t maxTileRays = 256;
+
     typedef void (*ErrorFunc) ();
 
     struct Collider
@@ -136,13 +212,16 @@ namespace embree
     struct Intersector1
     {
       Intersector1 (ErrorFunc error = nullptr)
-      : intersect((IntersectFunc)error), occluded((OccludedFunc)error), name(nullptr) {}
+      : intersect((IntersectFunc)error), occluded((OccludedFunc)error), intersectBatch(nullptr), occludedBatch(nullptr), name(nullptr) {}
       
       Intersector1 (IntersectFunc intersect, OccludedFunc occluded, const char* name)
-      : intersect(intersect), occluded(occluded), pointQuery(nullptr), name(name) {}
+      : intersect(intersect), occluded(occluded), pointQuery(nullptr), intersectBatch(nullptr), occludedBatch(nullptr), name(name) {}
       
       Intersector1 (IntersectFunc intersect, OccludedFunc occluded, PointQueryFunc pointQuery, const char* name)
-      : intersect(intersect), occluded(occluded), pointQuery(pointQuery), name(name) {}
+      : intersect(intersect), occluded(occluded), pointQuery(pointQuery), intersectBatch(nullptr), occludedBatch(nullptr), name(name) {}
+
+      Intersector1 (IntersectFunc intersect, OccludedFunc occluded, PointQueryFunc pointQuery, IntersectBatchFunc intersectBatch, OccludedBatchFunc occludedBatch, const char* name)
+      : intersect(intersect), occluded(occluded), pointQuery(pointQuery), intersectBatch(intersectBatch), occludedBatch(occludedBatch), name(name) {}
 
       operator bool() const { return name; }
 
@@ -151,16 +230,21 @@ namespace embree
       IntersectFunc intersect;
       OccludedFunc occluded;
       PointQueryFunc pointQuery;
+      IntersectBatchFunc intersectBatch; // optional
+      OccludedBatchFunc occludedBatch;   // optional
       const char* name;
     };
     
     struct Intersector4 
     {
       Intersector4 (ErrorFunc error = nullptr)
-      : intersect((IntersectFunc4)error), occluded((OccludedFunc4)error), name(nullptr) {}
+      : intersect((IntersectFunc4)error), occluded((OccludedFunc4)error), intersectTile(nullptr), occludedTile(nullptr), name(nullptr) {}
 
       Intersector4 (IntersectFunc4 intersect, OccludedFunc4 occluded, const char* name)
-      : intersect(intersect), occluded(occluded), name(name) {}
+      : intersect(intersect), occluded(occluded), intersectTile(nullptr), occludedTile(nullptr), name(name) {}
+
+      Intersector4 (IntersectFunc4 intersect, OccludedFunc4 occluded, IntersectTileFunc4 intersectTile, OccludedTileFunc4 occludedTile, const char* name)
+      : intersect(intersect), occluded(occluded), intersectTile(intersectTile), occludedTile(occludedTile), name(name) {}
 
       operator bool() const { return name; }
       
@@ -168,16 +252,21 @@ namespace embree
       static const char* type;
       IntersectFunc4 intersect;
       OccludedFunc4 occluded;
+      IntersectTileFunc4 intersectTile; // optional
+      OccludedTileFunc4 occludedTile;   // optional
       const char* name;
     };
     
     struct Intersector8 
     {
       Intersector8 (ErrorFunc error = nullptr)
-      : intersect((IntersectFunc8)error), occluded((OccludedFunc8)error), name(nullptr) {}
+      : intersect((IntersectFunc8)error), occluded((OccludedFunc8)error), intersectTile(nullptr), occludedTile(nullptr), name(nullptr) {}
 
       Intersector8 (IntersectFunc8 intersect, OccludedFunc8 occluded, const char* name)
-      : intersect(intersect), occluded(occluded), name(name) {}
+      : intersect(intersect), occluded(occluded), intersectTile(nullptr), occludedTile(nullptr), name(name) {}
+
+      Intersector8 (IntersectFunc8 intersect, OccludedFunc8 occluded, IntersectTileFunc8 intersectTile, OccludedTileFunc8 occludedTile, const char* name)
+      : intersect(intersect), occluded(occluded), intersectTile(intersectTile), occludedTile(occludedTile), name(name) {}
 
       operator bool() const { return name; }
       
@@ -185,16 +274,21 @@ namespace embree
       static const char* type;
       IntersectFunc8 intersect;
       OccludedFunc8 occluded;
+      IntersectTileFunc8 intersectTile; // optional
+      OccludedTileFunc8 occludedTile;   // optional
       const char* name;
     };
     
     struct Intersector16 
     {
       Intersector16 (ErrorFunc error = nullptr)
-      : intersect((IntersectFunc16)error), occluded((OccludedFunc16)error), name(nullptr) {}
+      : intersect((IntersectFunc16)error), occluded((OccludedFunc16)error), intersectTile(nullptr), occludedTile(nullptr), name(nullptr) {}
 
       Intersector16 (IntersectFunc16 intersect, OccludedFunc16 occluded, const char* name)
-      : intersect(intersect), occluded(occluded), name(name) {}
+      : intersect(intersect), occluded(occluded), intersectTile(nullptr), occludedTile(nullptr), name(name) {}
+
+      Intersector16 (IntersectFunc16 intersect, OccludedFunc16 occluded, IntersectTileFunc16 intersectTile, OccludedTileFunc16 occludedTile, const char* name)
+      : intersect(intersect), occluded(occluded), intersectTile(intersectTile), occludedTile(occludedTile), name(name) {}
 
       operator bool() const { return name; }
       
@@ -202,16 +296,18 @@ namespace embree
       static const char* type;
       IntersectFunc16 intersect;
       OccludedFunc16 occluded;
+      IntersectTileFunc16 intersectTile; // optional
+      OccludedTileFunc16 occludedTile;   // optional
       const char* name;
     };
 
     struct Intersectors 
     {
       Intersectors() 
-      : ptr(nullptr), leafIntersector(nullptr), collider(nullptr), intersector1(nullptr), intersector4(nullptr), intersector8(nullptr), intersector16(nullptr) {}
+      : ptr(nullptr), leafIntersector(nullptr), filter(true), collider(nullptr), intersector1(nullptr), intersector4(nullptr), intersector8(nullptr), intersector16(nullptr) {}
 
       Intersectors (ErrorFunc error) 
-      : ptr(nullptr), leafIntersector(nullptr), collider(error), intersector1(error), intersector4(error), intersector8(error), intersector16(error) {}
+      : ptr(nullptr), leafIntersector(nullptr), filter(true), collider(error), intersector1(error), intersector4(error), intersector8(error), intersector16(error) {}
 
       void print(size_t ident) 
       {
@@ -239,6 +335,7 @@ namespace embree
 
       void select(bool filter)
       {
+        this->filter = filter;
         if (intersector4_filter) {
           if (filter) intersector4 = intersector4_filter;
           else        intersector4 = intersector4_nofilter;
@@ -253,6 +350,28 @@ namespace embree
         }
       }
 
+      /*! checks if a ray query has to invoke intersection filter functions, multi-hit queries record their hits through the filter path */
+      __forceinline bool useFilter(RayQueryContext* context) const {
+        return context->isMultiHit() || (filter && context->hasFeature(RTC_FEATURE_FLAG_FILTER_FUNCTION));
+      }
+
+      /*! selects the kernels specialized for ray queries without filter functions if possible */
+      __forceinline Intersector1& getIntersector1(RayQueryContext* context) {
+        return (intersector1_nofilter && !useFilter(context)) ? intersector1_nofilter : intersector1;
+      }
+
+      __forceinline Intersector4& getIntersector4(RayQueryContext* context) {
+        return (filter && intersector4_nofilter && !useFilter(context)) ? intersector4_nofilter : intersector4;
+      }
+
+      __forceinline Intersector8& getIntersector8(RayQueryContext* context) {
+        return (filter && intersector8_nofilter && !useFilter(context)) ? intersector8_nofilter : intersector8;
+      }
+
+      __forceinline Intersector16& getIntersector16(RayQueryContext* context) {
+        return (filter && intersector16_nofilter && !useFilter(context)) ? intersector16_nofilter : intersector16;
+      }
+
       __forceinline bool pointQuery (PointQuery* query, PointQueryContext* context) {
         assert(intersector1.pointQuery);
         return intersector1.pointQuery(this,query,context);
@@ -267,43 +386,55 @@ namespace embree
       /*! Intersects a single ray with the scene. */
       __forceinline void intersect (RTCRayHit& ray, RayQueryContext* context) {
         assert(intersector1.intersect);
-        intersector1.intersect(this,ray,context);
+        getIntersector1(context).intersect(this,ray,context);
+      }
+
+      /*! Intersects a batch of single rays with the scene, falls back to single ray traversal. */
+      __forceinline void intersectBatch (RTCRayHit* rays, size_t numRays, RayQueryContext* context)
+      {
+        Intersector1& intersector = getIntersector1(context);
+        if (intersector.intersectBatch) {
+          intersector.intersectBatch(this,rays,numRays,context);
+          return;
+        }
+        for (size_t i=0; i<numRays; i++)
+          intersect(rays[i],context);
       }
 
       /*! Intersects a packet of 4 rays with the scene. */
       __forceinline void intersect4 (const void* valid, RTCRayHit4& ray, RayQueryContext* context) {
         assert(intersector4.intersect);
-        intersector4.intersect(valid,this,ray,context);
+        getIntersector4(context).intersect(valid,this,ray,context);
       }
       
       /*! Intersects a packet of 8 rays with the scene. */
       __forceinline void intersect8 (const void* valid, RTCRayHit8& ray, RayQueryContext* context) {
         assert(intersector8.intersect);
-        intersector8.intersect(valid,this,ray,context);
+        getIntersector8(context).intersect(valid,this,ray,context);
       }
       
       /*! Intersects a packet of 16 rays with the scene. */
       __forceinline void intersect16 (const void* valid, RTCRayHit16& ray, RayQueryContext* context) {
         assert(intersector16.intersect);
-        intersector16.intersect(valid,this,ray,context);
+        getIntersector16(context).intersect(valid,this,ray,context);
       }
 
       /*! Intersects a packet of 4 rays with the scene. */
       __forceinline void intersect (const void* valid, RTCRayHit4& ray, RayQueryContext* context) {
         assert(intersector4.intersect);
-        intersector4.intersect(valid,this,ray,context);
+        getIntersector4(context).intersect(valid,this,ray,context);
       }
       
       /*! Intersects a packet of 8 rays with the scene. */
       __forceinline void intersect (const void* valid, RTCRayHit8& ray, RayQueryContext* context) {
         assert(intersector8.intersect);
-        intersector8.intersect(valid,this,ray,context);
+        getIntersector8(context).intersect(valid,this,ray,context);
       }
       
       /*! Intersects a packet of 16 rays with the scene. */
       __forceinline void intersect (const void* valid, RTCRayHit16& ray, RayQueryContext* context) {
         assert(intersector16.intersect);
-        intersector16.intersect(valid,this,ray,context);
+        getIntersector16(context).intersect(valid,this,ray,context);
       }
       
 #if defined(__SSE__) || defined(__ARM_NEON)
@@ -324,47 +455,95 @@ namespace embree
         intersect16(&mask,(RTCRayHit16&)ray,context);
       }
 #endif
+
+      /*! Intersects a tile of ray packets of size 4 with the scene, falls back to packet traversal. */
+      __forceinline void intersectTile (const void* valid, RTCRayHit4* rays, size_t numPackets, RayQueryContext* context)
+      {
+        Intersector4& intersector = getIntersector4(context);
+        if (intersector.intersectTile) {
+          intersector.intersectTile(valid,this,rays,numPackets,context);
+          return;
+        }
+        for (size_t i=0; i<numPackets; i++)
+          intersect4((const int*)valid+4*i,rays[i],context);
+      }
+
+      /*! Intersects a tile of ray packets of size 8 with the scene, falls back to packet traversal. */
+      __forceinline void intersectTile (const void* valid, RTCRayHit8* rays, size_t numPackets, RayQueryContext* context)
+      {
+        Intersector8& intersector = getIntersector8(context);
+        if (intersector.intersectTile) {
+          intersector.intersectTile(valid,this,rays,numPackets,context);
+          return;
+        }
+        for (size_t i=0; i<numPackets; i++)
+          intersect8((const int*)valid+8*i,rays[i],context);
+      }
+
+      /*! Intersects a tile of ray packets of size 16 with the scene, falls back to packet traversal. */
+      __forceinline void intersectTile (const void* valid, RTCRayHit16* rays, size_t numPackets, RayQueryContext* context)
+      {
+        Intersector16& intersector = getIntersector16(context);
+        if (intersector.intersectTile) {
+          intersector.intersectTile(valid,this,rays,numPackets,context);
+          return;
+        }
+        for (size_t i=0; i<numPackets; i++)
+          intersect16((const int*)valid+16*i,rays[i],context);
+      }
       
       /*! Tests if single ray is occluded by the scene. */
       __forceinline void occluded (RTCRay& ray, RayQueryContext* context) {
         assert(intersector1.occluded);
-        intersector1.occluded(this,ray,context);
+        getIntersector1(context).occluded(this,ray,context);
       }
       
+      /*! Tests if a batch of single rays is occluded by the scene, falls back to single ray traversal. */
+      __forceinline void occludedBatch (RTCRay* rays, size_t numRays, RayQueryContext* context)
+      {
+        Intersector1& intersector = getIntersector1(context);
+        if (intersector.occludedBatch) {
+          intersector.occludedBatch(this,rays,numRays,context);
+          return;
+        }
+        for (size_t i=0; i<numRays; i++)
+          occluded(rays[i],context);
+      }
+
       /*! Tests if a packet of 4 rays is occluded by the scene. */
       __forceinline void occluded4 (const void* valid, RTCRay4& ray, RayQueryContext* context) {
         assert(intersector4.occluded);
-        intersector4.occluded(valid,this,ray,context);
+        getIntersector4(context).occluded(valid,this,ray,context);
       }
       
       /*! Tests if a packet of 8 rays is occluded by the scene. */
       __forceinline void occluded8 (const void* valid, RTCRay8& ray, RayQueryContext* context) {
         assert(intersector8.occluded);
-        intersector8.occluded(valid,this,ray,context);
+        getIntersector8(context).occluded(valid,this,ray,context);
       }
       
       /*! Tests if a packet of 16 rays is occluded by the scene. */
       __forceinline void occluded16 (const void* valid, RTCRay16& ray, RayQueryContext* context) {
         assert(intersector16.occluded);
-        intersector16.occluded(valid,this,ray,context);
+        getIntersector16(context).occluded(valid,this,ray,context);
       }
 
       /*! Tests if a packet of 4 rays is occluded by the scene. */
       __forceinline void occluded (const void* valid, RTCRay4& ray, RayQueryContext* context) {
         assert(intersector4.occluded);
-        intersector4.occluded(valid,this,ray,context);
+        getIntersector4(context).occluded(valid,this,ray,context);
       }
       
       /*! Tests if a packet of 8 rays is occluded by the scene. */
       __forceinline void occluded (const void* valid, RTCRay8& ray, RayQueryContext* context) {
         assert(intersector8.occluded);
-        intersector8.occluded(valid,this,ray,context);
+        getIntersector8(context).occluded(valid,this,ray,context);
       }
       
       /*! Tests if a packet of 16 rays is occluded by the scene. */
       __forceinline void occluded (const void* valid, RTCRay16& ray, RayQueryContext* context) {
         assert(intersector16.occluded);
-        intersector16.occluded(valid,this,ray,context);
+        getIntersector16(context).occluded(valid,this,ray,context);
       }
       
 #if defined(__SSE__) || defined(__ARM_NEON)
@@ -386,6 +565,42 @@ namespace embree
       }
 #endif
 
+      /*! Tests if a tile of ray packets of size 4 is occluded by the scene, falls back to packet traversal. */
+      __forceinline void occludedTile (const void* valid, RTCRay4* rays, size_t numPackets, RayQueryContext* context)
+      {
+        Intersector4& intersector = getIntersector4(context);
+        if (intersector.occludedTile) {
+          intersector.occludedTile(valid,this,rays,numPackets,context);
+          return;
+        }
+        for (size_t i=0; i<numPackets; i++)
+          occluded4((const int*)valid+4*i,rays[i],context);
+      }
+
+      /*! Tests if a tile of ray packets of size 8 is occluded by the scene, falls back to packet traversal. */
+      __forceinline void occludedTile (const void* valid, RTCRay8* rays, size_t numPackets, RayQueryContext* context)
+      {
+        Intersector8& intersector = getIntersector8(context);
+        if (intersector.occludedTile) {
+          intersector.occludedTile(valid,this,rays,numPackets,context);
+          return;
+        }
+        for (size_t i=0; i<numPackets; i++)
+          occluded8((const int*)valid+8*i,rays[i],context);
+      }
+
+      /*! Tests if a tile of ray packets of size 16 is occluded by the scene, falls back to packet traversal. */
+      __forceinline void occludedTile (const void* valid, RTCRay16* rays, size_t numPackets, RayQueryContext* context)
+      {
+        Intersector16& intersector = getIntersector16(context);
+        if (intersector.occludedTile) {
+          intersector.occludedTile(valid,this,rays,numPackets,context);
+          return;
+        }
+        for (size_t i=0; i<numPackets; i++)
+          occluded16((const int*)valid+16*i,rays[i],context);
+      }
+
       /*! Tests if single ray is occluded by the scene. */
       __forceinline void intersect(RTCRay& ray, RayQueryContext* context) {
         occluded(ray, context);
@@ -401,8 +616,10 @@ namespace embree
     public:
       AccelData* ptr;
       void* leafIntersector;
+      bool filter;         //!< true if the scene of this accel has filter functions
       Collider collider;
       Intersector1 intersector1;
+      Intersector1 intersector1_nofilter; // optional
       Intersector4 intersector4;
       Intersector4 intersector4_filter;
       Intersector4 intersector4_nofilter;
@@ -451,6 +668,16 @@ namespace embree
                                TOSTRING(isa) "::" TOSTRING(symbol));          \
   }
   
+#define DEFINE_INTERSECTOR1_BATCH(symbol,intersector)                                  \
+  Accel::Intersector1 symbol() {                                                       \
+    return Accel::Intersector1((Accel::IntersectFunc     )intersector::intersect,      \
+                               (Accel::OccludedFunc      )intersector::occluded,       \
+                               (Accel::PointQueryFunc    )intersector::pointQuery,     \
+                               (Accel::IntersectBatchFunc)intersector::intersectBatch, \
+                               (Accel::OccludedBatchFunc )intersector::occludedBatch,  \
+                               TOSTRING(isa) "::" TOSTRING(symbol));                   \
+  }
+
 #define DEFINE_INTERSECTOR4(symbol,intersector)                               \
   Accel::Intersector4 symbol() {                                              \
     return Accel::Intersector4((Accel::IntersectFunc4)intersector::intersect, \
@@ -471,4 +698,31 @@ namespace embree
                                 (Accel::OccludedFunc16)intersector::occluded,   \
                                 TOSTRING(isa) "::" TOSTRING(symbol));           \
   }
+
+#define DEFINE_INTERSECTOR4_TILE(symbol,intersector)                                  \
+  Accel::Intersector4 symbol() {                                                      \
+    return Accel::Intersector4((Accel::IntersectFunc4)intersector::intersect,         \
+                               (Accel::OccludedFunc4)intersector::occluded,           \
+                               (Accel::IntersectTileFunc4)intersector::intersectTile, \
+                               (Accel::OccludedTileFunc4)intersector::occludedTile,   \
+                               TOSTRING(isa) "::" TOSTRING(symbol));                  \
+  }
+
+#define DEFINE_INTERSECTOR8_TILE(symbol,intersector)                                  \
+  Accel::Intersector8 symbol() {                                                      \
+    return Accel::Intersector8((Accel::IntersectFunc8)intersector::intersect,         \
+                               (Accel::OccludedFunc8)intersector::occluded,           \
+                               (Accel::IntersectTileFunc8)intersector::intersectTile, \
+                               (Accel::OccludedTileFunc8)intersector::occludedTile,   \
+                               TOSTRING(isa) "::" TOSTRING(symbol));                  \
+  }
+
+#define DEFINE_INTERSECTOR16_TILE(symbol,intersector)                                   \
+  Accel::Intersector16 symbol() {                                                       \
+    return Accel::Intersector16((Accel::IntersectFunc16)intersector::intersect,         \
+                                (Accel::OccludedFunc16)intersector::occluded,           \
+                                (Accel::IntersectTileFunc16)intersector::intersectTile, \
+                                (Accel::OccludedTileFunc16)intersector::occludedTile,   \
+                                TOSTRING(isa) "::" TOSTRING(symbol));                   \
+  }
 }
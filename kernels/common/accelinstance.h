@@ -20,7 +20,10 @@ namespace embree
 
   public:
     void build () {
-      if (builder) builder->build();
+      if (builder) {
+        builder->build();
+        accel->replicate();
+      }
       bounds = accel->bounds;
     }
 
@@ -34,6 +37,24 @@ namespace embree
       if (builder) builder->clear();
     }
 
+    void save(std::ostream& stream) {
+      accel->save(stream);
+    }
+
+    void statistics(std::vector<RTCBVHStatistics>& stats) {
+      if (accel) accel->statistics(stats);
+    }
+
+    void buildStatistics(std::vector<RTCBuildStatistics>& stats) {
+      if (accel) accel->buildStatistics(stats);
+    }
+
+    void load(const std::string& fileName, size_t& offset) {
+      accel->load(fileName,offset);
+      accel->replicate();
+      bounds = accel->bounds;
+    }
+
   private:
     std::unique_ptr<AccelData> accel;
     std::unique_ptr<Builder> builder;
@@ -21,6 +21,13 @@ namespace embree
   {
     assert(accel);
     accels.push_back(accel);
+    features.push_back(RTCFeatureFlags(RTC_FEATURE_FLAG_ALL & ~RTC_FEATURE_FLAG_MOTION_BLUR));
+  }
+
+  void AccelN::accels_set_features(size_t begin, RTCFeatureFlags accelFeatures)
+  {
+    for (size_t i=begin; i<features.size(); i++)
+      features[i] = accelFeatures;
   }
 
   void AccelN::accels_init() 
@@ -29,6 +36,7 @@ namespace embree
       delete accels[i];
     
     accels.clear();
+    features.clear();
   }
 
   bool AccelN::pointQuery (Accel::Intersectors* This_in, PointQuery* query, PointQueryContext* context)
@@ -45,7 +53,7 @@ namespace embree
   {
     AccelN* This = (AccelN*)This_in->ptr;
     for (size_t i=0; i<This->accels.size(); i++)
-      if (!This->accels[i]->isEmpty())
+      if (This->accels_enabled(i,context))
         This->accels[i]->intersectors.intersect(ray,context);
   }
 
@@ -53,7 +61,7 @@ namespace embree
   {
     AccelN* This = (AccelN*)This_in->ptr;
     for (size_t i=0; i<This->accels.size(); i++)
-      if (!This->accels[i]->isEmpty())
+      if (This->accels_enabled(i,context))
         This->accels[i]->intersectors.intersect4(valid,ray,context);
   }
 
@@ -61,7 +69,7 @@ namespace embree
   {
     AccelN* This = (AccelN*)This_in->ptr;
     for (size_t i=0; i<This->accels.size(); i++)
-      if (!This->accels[i]->isEmpty())
+      if (This->accels_enabled(i,context))
         This->accels[i]->intersectors.intersect8(valid,ray,context);
   }
 
@@ -69,7 +77,7 @@ namespace embree
   {
     AccelN* This = (AccelN*)This_in->ptr;
     for (size_t i=0; i<This->accels.size(); i++)
-      if (!This->accels[i]->isEmpty())
+      if (This->accels_enabled(i,context))
         This->accels[i]->intersectors.intersect16(valid,ray,context);
   }
 
@@ -77,7 +85,7 @@ namespace embree
   {
     AccelN* This = (AccelN*)This_in->ptr;
     for (size_t i=0; i<This->accels.size(); i++) {
-      if (This->accels[i]->isEmpty()) continue;
+      if (!This->accels_enabled(i,context)) continue;
       This->accels[i]->intersectors.occluded(ray,context); 
       if (ray.tfar < 0.0f) break; 
     }
@@ -87,7 +95,7 @@ namespace embree
   {
     AccelN* This = (AccelN*)This_in->ptr;
     for (size_t i=0; i<This->accels.size(); i++) {
-      if (This->accels[i]->isEmpty()) continue;
+      if (!This->accels_enabled(i,context)) continue;
       This->accels[i]->intersectors.occluded4(valid,ray,context);
 #if defined(__SSE2__) || defined(__ARM_NEON)
       vbool4 valid0 = asBool(((vint4*)valid)[0]);
@@ -101,7 +109,7 @@ namespace embree
   {
     AccelN* This = (AccelN*)This_in->ptr;
     for (size_t i=0; i<This->accels.size(); i++) {
-      if (This->accels[i]->isEmpty()) continue;
+      if (!This->accels_enabled(i,context)) continue;
       This->accels[i]->intersectors.occluded8(valid,ray,context);
 #if defined(__SSE2__) || defined(__ARM_NEON) // FIXME: use higher ISA
       vbool4 valid0 = asBool(((vint4*)valid)[0]);
@@ -117,7 +125,7 @@ namespace embree
   {
     AccelN* This = (AccelN*)This_in->ptr;
     for (size_t i=0; i<This->accels.size(); i++) {
-      if (This->accels[i]->isEmpty()) continue;
+      if (!This->accels_enabled(i,context)) continue;
       This->accels[i]->intersectors.occluded16(valid,ray,context);
 #if defined(__SSE2__) || defined(__ARM_NEON) // FIXME: use higher ISA
       vbool4 valid0 = asBool(((vint4*)valid)[0]);
@@ -133,6 +141,70 @@ namespace embree
     }
   }
 
+  void AccelN::intersectTile4 (const void* valid, Accel::Intersectors* This_in, RTCRayHit4* rays, size_t numPackets, RayQueryContext* context)
+  {
+    AccelN* This = (AccelN*)This_in->ptr;
+    for (size_t i=0; i<This->accels.size(); i++)
+      if (This->accels_enabled(i,context))
+        This->accels[i]->intersectors.intersectTile(valid,rays,numPackets,context);
+  }
+
+  void AccelN::intersectTile8 (const void* valid, Accel::Intersectors* This_in, RTCRayHit8* rays, size_t numPackets, RayQueryContext* context)
+  {
+    AccelN* This = (AccelN*)This_in->ptr;
+    for (size_t i=0; i<This->accels.size(); i++)
+      if (This->accels_enabled(i,context))
+        This->accels[i]->intersectors.intersectTile(valid,rays,numPackets,context);
+  }
+
+  void AccelN::intersectTile16 (const void* valid, Accel::Intersectors* This_in, RTCRayHit16* rays, size_t numPackets, RayQueryContext* context)
+  {
+    AccelN* This = (AccelN*)This_in->ptr;
+    for (size_t i=0; i<This->accels.size(); i++)
+      if (This->accels_enabled(i,context))
+        This->accels[i]->intersectors.intersectTile(valid,rays,numPackets,context);
+  }
+
+  void AccelN::occludedTile4 (const void* valid, Accel::Intersectors* This_in, RTCRay4* rays, size_t numPackets, RayQueryContext* context)
+  {
+    AccelN* This = (AccelN*)This_in->ptr;
+    for (size_t i=0; i<This->accels.size(); i++)
+      if (This->accels_enabled(i,context))
+        This->accels[i]->intersectors.occludedTile(valid,rays,numPackets,context);
+  }
+
+  void AccelN::occludedTile8 (const void* valid, Accel::Intersectors* This_in, RTCRay8* rays, size_t numPackets, RayQueryContext* context)
+  {
+    AccelN* This = (AccelN*)This_in->ptr;
+    for (size_t i=0; i<This->accels.size(); i++)
+      if (This->accels_enabled(i,context))
+        This->accels[i]->intersectors.occludedTile(valid,rays,numPackets,context);
+  }
+
+  void AccelN::occludedTile16 (const void* valid, Accel::Intersectors* This_in, RTCRay16* rays, size_t numPackets, RayQueryContext* context)
+  {
+    AccelN* This = (AccelN*)This_in->ptr;
+    for (size_t i=0; i<This->accels.size(); i++)
+      if (This->accels_enabled(i,context))
+        This->accels[i]->intersectors.occludedTile(valid,rays,numPackets,context);
+  }
+
+  void AccelN::intersectBatch (Accel::Intersectors* This_in, RTCRayHit* rays, size_t numRays, RayQueryContext* context)
+  {
+    AccelN* This = (AccelN*)This_in->ptr;
+    for (size_t i=0; i<This->accels.size(); i++)
+      if (This->accels_enabled(i,context))
+        This->accels[i]->intersectors.intersectBatch(rays,numRays,context);
+  }
+
+  void AccelN::occludedBatch (Accel::Intersectors* This_in, RTCRay* rays, size_t numRays, RayQueryContext* context)
+  {
+    AccelN* This = (AccelN*)This_in->ptr;
+    for (size_t i=0; i<This->accels.size(); i++)
+      if (This->accels_enabled(i,context))
+        This->accels[i]->intersectors.occludedBatch(rays,numRays,context);
+  }
+
   void AccelN::accels_print(size_t ident)
   {
     for (size_t i=0; i<accels.size(); i++)
@@ -159,6 +231,46 @@ namespace embree
         accels[i]->build();
       });
 
+    accels_combine();
+  }
+
+  void AccelN::accels_save (std::ostream& stream)
+  {
+    /* every acceleration structure starts at a mappable file offset */
+    for (size_t i=0; i<accels.size(); i++) {
+      const size_t pos = (size_t) stream.tellp();
+      const size_t padding = ((pos+os_map_file_alignment-1) & ~(os_map_file_alignment-1))-pos;
+      for (size_t j=0; j<padding; j++) stream.put(0);
+      accels[i]->save(stream);
+    }
+  }
+
+  void AccelN::accels_load (const std::string& fileName, size_t offset)
+  {
+    accels.shrink_to_fit();
+    
+    for (size_t i=0; i<accels.size(); i++) {
+      offset = (offset+os_map_file_alignment-1) & ~(os_map_file_alignment-1);
+      accels[i]->load(fileName,offset);
+    }
+
+    accels_combine();
+  }
+
+  void AccelN::accels_statistics (std::vector<RTCBVHStatistics>& stats)
+  {
+    for (size_t i=0; i<accels.size(); i++)
+      accels[i]->statistics(stats);
+  }
+
+  void AccelN::accels_buildStatistics (std::vector<RTCBuildStatistics>& stats)
+  {
+    for (size_t i=0; i<accels.size(); i++)
+      accels[i]->buildStatistics(stats);
+  }
+
+  void AccelN::accels_combine ()
+  {
     /* create list of non-empty acceleration structures */
     bool valid1 = true;
     bool valid4 = true;
@@ -180,10 +292,14 @@ namespace embree
     {
       type = AccelData::TY_ACCELN;
       intersectors.ptr = this;
-      intersectors.intersector1  = Intersector1(&intersect,&occluded,&pointQuery,valid1 ? "AccelN::intersector1": nullptr);
-      intersectors.intersector4  = Intersector4(&intersect4,&occluded4,valid4 ? "AccelN::intersector4" : nullptr);
-      intersectors.intersector8  = Intersector8(&intersect8,&occluded8,valid8 ? "AccelN::intersector8" : nullptr);
-      intersectors.intersector16 = Intersector16(&intersect16,&occluded16,valid16 ? "AccelN::intersector16": nullptr);
+      intersectors.intersector1_nofilter  = Intersector1();
+      intersectors.intersector4_nofilter  = Intersector4();
+      intersectors.intersector8_nofilter  = Intersector8();
+      intersectors.intersector16_nofilter = Intersector16();
+      intersectors.intersector1  = Intersector1(&intersect,&occluded,&pointQuery,&intersectBatch,&occludedBatch,valid1 ? "AccelN::intersector1": nullptr);
+      intersectors.intersector4  = Intersector4(&intersect4,&occluded4,&intersectTile4,&occludedTile4,valid4 ? "AccelN::intersector4" : nullptr);
+      intersectors.intersector8  = Intersector8(&intersect8,&occluded8,&intersectTile8,&occludedTile8,valid8 ? "AccelN::intersector8" : nullptr);
+      intersectors.intersector16 = Intersector16(&intersect16,&occluded16,&intersectTile16,&occludedTile16,valid16 ? "AccelN::intersector16": nullptr);
 
       /*! calculate bounds */
       bounds = empty;
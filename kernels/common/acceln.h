@@ -18,6 +18,21 @@ namespace embree
     void accels_add(Accel* accel);
     void accels_init();
 
+    /*! sets the ray query features required to traverse the accels added since index begin */
+    void accels_set_features(size_t begin, RTCFeatureFlags accelFeatures);
+
+    /*! checks if an accel has to get traversed by a ray query, accels
+     *  whose geometry types are disabled in the feature mask of the ray
+     *  query get skipped, motion blurred accels additionally require
+     *  the motion blur feature */
+    __forceinline bool accels_enabled(size_t i, RayQueryContext* context) const
+    {
+      if (accels[i]->isEmpty()) return false;
+      const RTCFeatureFlags f = features[i];
+      if ((f & RTC_FEATURE_FLAG_MOTION_BLUR) && !context->hasFeature(RTC_FEATURE_FLAG_MOTION_BLUR)) return false;
+      return context->hasFeature(RTCFeatureFlags(f & ~RTC_FEATURE_FLAG_MOTION_BLUR));
+    }
+
   public:
     static bool pointQuery (Accel::Intersectors* This, PointQuery* query, PointQueryContext* context);
 
@@ -33,15 +48,35 @@ namespace embree
     static void occluded8 (const void* valid, Accel::Intersectors* This, RTCRay8& ray, RayQueryContext* context);
     static void occluded16 (const void* valid, Accel::Intersectors* This, RTCRay16& ray, RayQueryContext* context);
 
+  public:
+    static void intersectTile4 (const void* valid, Accel::Intersectors* This, RTCRayHit4* rays, size_t numPackets, RayQueryContext* context);
+    static void intersectTile8 (const void* valid, Accel::Intersectors* This, RTCRayHit8* rays, size_t numPackets, RayQueryContext* context);
+    static void intersectTile16 (const void* valid, Accel::Intersectors* This, RTCRayHit16* rays, size_t numPackets, RayQueryContext* context);
+    static void occludedTile4 (const void* valid, Accel::Intersectors* This, RTCRay4* rays, size_t numPackets, RayQueryContext* context);
+    static void occludedTile8 (const void* valid, Accel::Intersectors* This, RTCRay8* rays, size_t numPackets, RayQueryContext* context);
+    static void occludedTile16 (const void* valid, Accel::Intersectors* This, RTCRay16* rays, size_t numPackets, RayQueryContext* context);
+
+  public:
+    static void intersectBatch (Accel::Intersectors* This, RTCRayHit* rays, size_t numRays, RayQueryContext* context);
+    static void occludedBatch (Accel::Intersectors* This, RTCRay* rays, size_t numRays, RayQueryContext* context);
+
   public:
     void accels_print(size_t ident);
     void accels_immutable();
     void accels_build ();
+    void accels_save (std::ostream& stream);
+    void accels_load (const std::string& fileName, size_t offset);
+    void accels_statistics (std::vector<RTCBVHStatistics>& stats);
+    void accels_buildStatistics (std::vector<RTCBuildStatistics>& stats);
     void accels_select(bool filter);
     void accels_deleteGeometry(size_t geomID);
     void accels_clear ();
 
+  private:
+    void accels_combine ();
+
   public:
     std::vector<Accel*> accels;
+    std::vector<RTCFeatureFlags> features; //!< ray query features required to traverse each accel
   };
 }
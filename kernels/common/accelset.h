@@ -165,9 +165,19 @@ namespace embree
         if (context->getIntersectFunction())
           intersectFunc = context->getIntersectFunction();
 
+        MultiHitList* list = context->getMultiHitList();
+        const float old_t = ray.tfar;
+        const size_t updates = list ? list->updates : 0;
+
         assert(intersectFunc);
         intersectFunc(&args);
 
+        /* user geometries report their hit by shrinking the ray, hits forwarded to scenes got already recorded */
+        if (unlikely(list != nullptr) && list->updates == updates && ray.tfar < old_t) {
+          list->insert(ray.tfar,((RTCRayHit&)ray).hit);
+          ray.tfar = list->tfar();
+        }
+
         return mask != 0;
       }
 
@@ -198,6 +198,8 @@ namespace embree
       , useUSM(useUSM)
       , blockAllocation(blockAllocation)
       , use_single_mode(false)
+      , numaNodes(1)
+      , numaSlotsPerNode(MAX_THREAD_USED_BLOCK_SLOTS)
       , log2_grow_size_scale(0)
       , bytesUsed(0)
       , bytesFree(0)
@@ -208,6 +210,13 @@ namespace embree
       if (osAllocation && useUSM)
         throw std::runtime_error("USM allocation cannot be combined with OS allocation.");
 
+      /* each NUMA node gets its own set of main block slots */
+      if (device && device->numa_alloc && !useUSM)
+      {
+        numaNodes = min(size_t(getNumberOfNUMANodes()),MAX_THREAD_USED_BLOCK_SLOTS);
+        while (numaSlotsPerNode*numaNodes > MAX_THREAD_USED_BLOCK_SLOTS) numaSlotsPerNode /= 2;
+      }
+
       for (size_t i=0; i<MAX_THREAD_USED_BLOCK_SLOTS; i++)
       {
         threadUsedBlocks[i] = nullptr;
@@ -245,6 +254,11 @@ namespace embree
       atype = flag ? EMBREE_OS_MALLOC : ALIGNED_MALLOC;
     }
 
+    /*! measures the time spent allocating blocks when not NULL */
+    void setBuildStatistics(BuildStatistics* stats) {
+      buildStats = stats;
+    }
+
   private:
 
     /*! returns both fast thread local allocators */
@@ -517,12 +531,18 @@ namespace embree
     void* malloc(size_t& bytes, size_t align, bool partial)
     {
       assert(align <= maxAlignment);
+      BuildStatistics::Timer timer(buildStats,BuildStatistics::ALLOCATOR);
 
       while (true)
       {
         /* allocate using current block */
         size_t threadID = TaskScheduler::threadID();
         size_t slot = threadID & slotMask;
+        int numaNode = -1;
+        if (numaNodes > 1) {
+          numaNode = int(getThreadNUMANode() % numaNodes);
+          slot = numaNode*numaSlotsPerNode + (slot & (numaSlotsPerNode-1));
+        }
         Block* myUsedBlocks = threadUsedBlocks[slot];
         if (myUsedBlocks) {
           void* ptr = myUsedBlocks->malloc(device,bytes,align,partial);
@@ -547,7 +567,7 @@ namespace embree
             const size_t alignedBytes = (bytes+(align-1)) & ~(align-1);
             const size_t allocSize = max(min(growSize,maxGrowSize),alignedBytes);
             assert(allocSize >= bytes);
-            threadBlocks[slot] = threadUsedBlocks[slot] = Block::create(device,useUSM,allocSize,allocSize,threadBlocks[slot],atype); // FIXME: a large allocation might throw away a block here!
+            threadBlocks[slot] = threadUsedBlocks[slot] = Block::create(device,useUSM,allocSize,allocSize,threadBlocks[slot],atype,numaNode); // FIXME: a large allocation might throw away a block here!
             // FIXME: a direct allocation should allocate inside the block here, and not in the next loop! a different thread could do some allocation and make the large allocation fail.
           }
           continue;
@@ -563,15 +583,24 @@ namespace embree
           if (myUsedBlocks == threadUsedBlocks[slot])
           {
             if (freeBlocks.load() != nullptr) {
-              Block* nextFreeBlock = freeBlocks.load()->next;
-              freeBlocks.load()->next = usedBlocks;
+              /* prefer free blocks that reside on the NUMA node of this thread */
+              Block* freeBlock = freeBlocks.load();
+              Block* prevBlock = nullptr;
+              if (numaNode >= 0) {
+                for (Block* block = freeBlock, *prev = nullptr; block; prev = block, block = block->next) {
+                  if (block->numaNode == numaNode) { freeBlock = block; prevBlock = prev; break; }
+                }
+              }
+              Block* nextFreeBlock = freeBlock->next;
+              freeBlock->next = usedBlocks;
               __memory_barrier();
-              usedBlocks = freeBlocks.load();
-              threadUsedBlocks[slot] = freeBlocks.load();
-              freeBlocks = nextFreeBlock;
+              usedBlocks = freeBlock;
+              threadUsedBlocks[slot] = freeBlock;
+              if (prevBlock) prevBlock->next = nextFreeBlock;
+              else           freeBlocks = nextFreeBlock;
             } else {
               const size_t allocSize = min(growSize*incGrowSizeScale(),maxGrowSize);
-              usedBlocks = threadUsedBlocks[slot] = Block::create(device,useUSM,allocSize,allocSize,usedBlocks,atype); // FIXME: a large allocation should get delivered directly, like above!
+              usedBlocks = threadUsedBlocks[slot] = Block::create(device,useUSM,allocSize,allocSize,usedBlocks,atype,numaNode); // FIXME: a large allocation should get delivered directly, like above!
             }
           }
         }
@@ -586,6 +615,9 @@ namespace embree
 #else
       Lock<SpinLock> lock(mutex);
 #endif
+      /* the pages of shared blocks got placed by the threads that wrote the primitive references */
+      if (numaNodes > 1) return;
+      
       const size_t sizeof_Header = offsetof(Block,data[0]);
       void* aptr = (void*) ((((size_t)ptr)+maxAlignment-1) & ~(maxAlignment-1));
       size_t ofs = (size_t) aptr - (size_t) ptr;
@@ -750,6 +782,7 @@ namespace embree
                 << ", use_single_mode = " << use_single_mode
                 << ", maxGrowSize = " << maxGrowSize
                 << ", defaultBlockSize = " << defaultBlockSize
+                << ", numaNodes = " << numaNodes
                 << std::endl;
 
       std::cout << "  used blocks = ";
@@ -768,16 +801,18 @@ namespace embree
       __forceinline static void* blockAlignedMalloc(Device* device, bool useUSM, size_t bytesAllocate, size_t bytesAlignment)
       {
         if (useUSM) return device->malloc(bytesAllocate, bytesAlignment);
+        else if (device && device->hasUserAllocator()) return device->userMalloc(bytesAllocate, bytesAlignment);
 	else        return alignedMalloc (bytesAllocate, bytesAlignment);
       }
 
       __forceinline static void blockAlignedFree(Device* device, bool useUSM, void* ptr)
       {
         if (useUSM) return device->free(ptr);
+        else if (device && device->hasUserAllocator()) return device->userFree(ptr);
 	else        return alignedFree(ptr);
       }
 
-      static Block* create(Device* device, bool useUSM, size_t bytesAllocate, size_t bytesReserve, Block* next, AllocationType atype)
+      static Block* create(Device* device, bool useUSM, size_t bytesAllocate, size_t bytesReserve, Block* next, AllocationType atype, int numaNode = -1)
       {
         /* We avoid using os_malloc for small blocks as this could
          * cause a risk of fragmenting the virtual address space and
@@ -785,6 +820,10 @@ namespace embree
         if (atype == EMBREE_OS_MALLOC && bytesAllocate < maxAllocationSize)
           atype = ALIGNED_MALLOC;
 
+        /* a user allocator serves all blocks */
+        if (atype == EMBREE_OS_MALLOC && device && device->hasUserAllocator())
+          atype = ALIGNED_MALLOC;
+
         /* we need to additionally allocate some header */
         const size_t sizeof_Header = offsetof(Block,data[0]);
         bytesAllocate = sizeof_Header+bytesAllocate;
@@ -813,21 +852,26 @@ namespace embree
             os_advise((void*)(ptr_aligned_begin + 1*PAGE_SIZE_2M),PAGE_SIZE_2M);
             os_advise((void*)(ptr_aligned_begin + 2*PAGE_SIZE_2M),PAGE_SIZE_2M); // may fail if no memory mapped after block
 
-            return new (ptr) Block(ALIGNED_MALLOC,bytesAllocate-sizeof_Header,bytesAllocate-sizeof_Header,next,alignment);
+            /* pages are not touched yet, thus we can place them on the NUMA node of the allocating thread */
+            if (numaNode >= 0 && !useUSM && !(device && device->hasUserAllocator()))
+              os_bind_numa_node(ptr,bytesAllocate,numaNode);
+
+            return new (ptr) Block(ALIGNED_MALLOC,bytesAllocate-sizeof_Header,bytesAllocate-sizeof_Header,next,alignment,false,numaNode);
           }
           else
           {
             const size_t alignment = maxAlignment;
             if (device) device->memoryMonitor(bytesAllocate+alignment,false);
             ptr = blockAlignedMalloc(device,useUSM,bytesAllocate,alignment);
-            return new (ptr) Block(ALIGNED_MALLOC,bytesAllocate-sizeof_Header,bytesAllocate-sizeof_Header,next,alignment);
+            return new (ptr) Block(ALIGNED_MALLOC,bytesAllocate-sizeof_Header,bytesAllocate-sizeof_Header,next,alignment,false,numaNode);
           }
         }
         else if (atype == EMBREE_OS_MALLOC)
         {
           if (device) device->memoryMonitor(bytesAllocate,false);
           bool huge_pages; ptr = os_malloc(bytesReserve,huge_pages);
-          return new (ptr) Block(EMBREE_OS_MALLOC,bytesAllocate-sizeof_Header,bytesReserve-sizeof_Header,next,0,huge_pages);
+          if (numaNode >= 0) os_bind_numa_node(ptr,bytesReserve,numaNode);
+          return new (ptr) Block(EMBREE_OS_MALLOC,bytesAllocate-sizeof_Header,bytesReserve-sizeof_Header,next,0,huge_pages,numaNode);
         }
         else
           assert(false);
@@ -835,8 +879,8 @@ namespace embree
         return NULL;
       }
 
-      Block (AllocationType atype, size_t bytesAllocate, size_t bytesReserve, Block* next, size_t wasted, bool huge_pages = false)
-      : cur(0), allocEnd(bytesAllocate), reserveEnd(bytesReserve), next(next), wasted(wasted), atype(atype), huge_pages(huge_pages)
+      Block (AllocationType atype, size_t bytesAllocate, size_t bytesReserve, Block* next, size_t wasted, bool huge_pages = false, int numaNode = -1)
+      : cur(0), allocEnd(bytesAllocate), reserveEnd(bytesReserve), next(next), wasted(wasted), atype(atype), numaNode(numaNode), huge_pages(huge_pages)
       {
         assert((((size_t)&data[0]) & (maxAlignment-1)) == 0);
       }
@@ -984,6 +1028,7 @@ namespace embree
         else if (atype == EMBREE_OS_MALLOC) std::cout << "O";
         else if (atype == SHARED) std::cout << "S";
         if (huge_pages) std::cout << "H";
+        if (numaNode >= 0) std::cout << "N" << numaNode;
         size_t bytesUsed = getBlockUsedBytes();
         size_t bytesFree = getBlockFreeBytes();
         size_t bytesWasted = getBlockWastedBytes();
@@ -997,8 +1042,9 @@ namespace embree
       Block* next;               //!< pointer to next block in list
       size_t wasted;             //!< amount of memory wasted through block alignment
       AllocationType atype;      //!< allocation mode of the block
+      int numaNode;              //!< NUMA node the block got allocated for, or -1
       bool huge_pages;           //!< whether the block uses huge pages
-      char align[maxAlignment-5*sizeof(size_t)-sizeof(AllocationType)-sizeof(bool)]; //!< align data to maxAlignment
+      char align[maxAlignment-5*sizeof(size_t)-sizeof(AllocationType)-sizeof(int)-sizeof(bool)]; //!< align data to maxAlignment
       char data[1];              //!< here starts memory to use for allocations
     };
 
@@ -1027,6 +1073,9 @@ namespace embree
     bool useUSM;
     bool blockAllocation = true;
     bool use_single_mode;
+    BuildStatistics* buildStats = nullptr; //!< receives the time spent allocating blocks
+    size_t numaNodes;        //!< number of NUMA nodes with separate main block slots
+    size_t numaSlotsPerNode; //!< number of main block slots per NUMA node
 
     std::atomic<size_t> log2_grow_size_scale; //!< log2 of scaling factor for grow size // FIXME: remove
     std::atomic<size_t> bytesUsed;
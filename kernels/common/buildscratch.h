@@ -0,0 +1,96 @@
+// Copyright 2009-2021 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include "default.h"
+#include "../builders/primref.h"
+#include "../builders/primref_mb.h"
+
+#include <list>
+
+namespace embree
+{
+  /*! Pool of temporary builder arrays a scene keeps alive between
+   *  commits. Pooled arrays keep the capacity of the largest build they
+   *  were used for, thus rebuilding a scene of similar size neither
+   *  allocates nor touches fresh pages. */
+  template<typename T>
+  class BuildScratchPool
+  {
+  public:
+
+    /*! moves a pooled array into the empty array passed, preferring the
+     *  smallest one that can hold numItems items */
+    void acquire(mvector<T>& array, size_t numItems)
+    {
+      if (array.capacity() != 0) return;
+      Lock<SpinLock> lock(mutex);
+      if (arrays.empty()) return;
+
+      auto best = arrays.begin();
+      for (auto i = arrays.begin(); i != arrays.end(); i++)
+      {
+        const bool fits = i->capacity() >= numItems;
+        const bool bestFits = best->capacity() >= numItems;
+        if (fits && (!bestFits || i->capacity() < best->capacity())) best = i;
+        else if (!fits && !bestFits && i->capacity() > best->capacity()) best = i;
+      }
+      array = std::move(*best);
+      arrays.erase(best);
+    }
+
+    /*! returns an array to the pool, the array is empty afterwards */
+    void release(mvector<T>& array)
+    {
+      if (array.capacity() == 0) return;
+      array.resize(0);
+      Lock<SpinLock> lock(mutex);
+      arrays.emplace_back(std::move(array));
+    }
+
+    /*! frees all pooled arrays */
+    void clear()
+    {
+      Lock<SpinLock> lock(mutex);
+      arrays.clear();
+    }
+
+    /*! returns the number of bytes held by the pool */
+    size_t bytes()
+    {
+      Lock<SpinLock> lock(mutex);
+      size_t bytes = 0;
+      for (auto& array : arrays) bytes += array.capacity()*sizeof(T);
+      return bytes;
+    }
+
+  private:
+    SpinLock mutex;
+    std::list<mvector<T>> arrays;
+  };
+
+  /*! Scratch memory of the builders of a scene that is kept between
+   *  commits when the scene has RTC_SCENE_FLAG_PERSISTENT_BUILD_MEMORY set. */
+  struct BuildScratch
+  {
+    void acquire(mvector<PrimRef>& array, size_t numItems) { prims.acquire(array,numItems); }
+    void acquire(mvector<PrimRefMB>& array, size_t numItems) { primsMB.acquire(array,numItems); }
+
+    void release(mvector<PrimRef>& array) { prims.release(array); }
+    void release(mvector<PrimRefMB>& array) { primsMB.release(array); }
+
+    void clear()
+    {
+      prims.clear();
+      primsMB.clear();
+    }
+
+    size_t bytes() {
+      return prims.bytes() + primsMB.bytes();
+    }
+
+    BuildScratchPool<PrimRef> prims;
+    BuildScratchPool<PrimRefMB> primsMB;
+  };
+}
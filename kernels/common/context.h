@@ -11,6 +11,59 @@ namespace embree
 {
   class Scene;
 
+  /* Sorted list of the closest hits of a multi-hit query */
+  struct MultiHitList
+  {
+    __forceinline MultiHitList(RTCMultiHit* hits, unsigned int capacity, float tfar)
+      : hits(hits), capacity(capacity), size(0), tfar0(tfar), updates(0) {}
+
+    __forceinline bool full() const {
+      return size == capacity;
+    }
+
+    /* hits have to be closer than this distance to enter the list */
+    __forceinline float tfar() const {
+      return full() ? hits[size-1].tfar : tfar0;
+    }
+
+    /* inserts a hit sorted by distance, drops the farthest hit if the list is full */
+    __forceinline void insert(float t, const RTCHit& hit)
+    {
+      updates++;
+      if (full() && t >= hits[size-1].tfar)
+        return;
+
+      /* ignore duplicated hits that can occur for tessellated primitives */
+      for (unsigned int i=0; i<size; i++) {
+        if (hits[i].tfar == t && hits[i].hit.geomID == hit.geomID && hits[i].hit.primID == hit.primID &&
+            std::equal(hit.instID,hit.instID+RTC_MAX_INSTANCE_LEVEL_COUNT,hits[i].hit.instID))
+          return;
+      }
+
+      unsigned int i = full() ? size-1 : size++;
+      for (; i>0 && hits[i-1].tfar > t; i--)
+        hits[i] = hits[i-1];
+      hits[i].hit = hit;
+      hits[i].tfar = t;
+    }
+
+  public:
+    RTCMultiHit* hits;
+    unsigned int capacity;
+    unsigned int size;
+    float tfar0;          //!< original end of the ray segment
+    size_t updates;       //!< counts insertions, used to detect hits reported by user geometries
+  };
+
+  /* internal ray query flag that marks the arguments of a multi-hit query */
+  static const unsigned int RAY_QUERY_FLAG_MULTI_HIT = 1u << 30;
+
+  /* Arguments of a multi-hit query, they get passed through instances and user geometries like the user arguments */
+  struct MultiHitArguments : public RTCIntersectArguments
+  {
+    MultiHitList* list;
+  };
+
   struct RayQueryContext
   {
   public:
@@ -21,8 +74,17 @@ namespace embree
     __forceinline RayQueryContext(Scene* scene, RTCRayQueryContext* user_context, RTCOccludedArguments* args)
       : scene(scene), user(user_context), args((RTCIntersectArguments*)args) {}
 
+    /* multi-hit queries take the filter path to record each hit */
     __forceinline bool hasContextFilter() const {
-      return args->filter != nullptr;
+      return args->filter != nullptr || isMultiHit();
+    }
+
+    __forceinline bool isMultiHit() const {
+      return args->flags & RAY_QUERY_FLAG_MULTI_HIT;
+    }
+
+    __forceinline MultiHitList* getMultiHitList() const {
+      return isMultiHit() ? ((MultiHitArguments*)args)->list : nullptr;
     }
 
     RTCFilterFunctionN getFilter() const {
@@ -45,6 +107,14 @@ namespace embree
       return embree::isIncoherent(args->flags);
     }
 
+    __forceinline bool useTreelets() const {
+      return args->flags & RTC_RAY_QUERY_FLAG_TREELETS;
+    }
+
+    __forceinline bool hasFeature(RTCFeatureFlags features) const {
+      return args->feature_mask & features;
+    }
+
     __forceinline bool enforceArgumentFilterFunction() const {
       return args->flags & RTC_RAY_QUERY_FLAG_INVOKE_ARGUMENT_FILTER;
     }
@@ -33,7 +33,6 @@ namespace embree
   ssize_t Device::debug_int3 = 0;
 
   static MutexSys g_mutex;
-  static std::map<Device*,size_t> g_cache_size_map;
   static std::map<Device*,size_t> g_num_threads_map;
   
   struct TaskArena
@@ -99,6 +98,9 @@ namespace embree
     State::hugepages_success &= os_init(State::hugepages,State::verbosity(3));
     
     /*! set tessellation cache size */
+#if defined(EMBREE_GEOMETRY_SUBDIVISION)
+    tessellationCache = make_unique(new SharedLazyTessellationCache);
+#endif
     setCacheSize( State::tessellation_cache_size );
 
     /*! enable some floating point exceptions to catch bugs */
@@ -129,11 +131,16 @@ namespace embree
 
     /* setup tasking system */
     initTaskingSystem(numThreads);
+
+    /* enable sampling of traversal statistics */
+    if (State::traversal_statistics_sample_rate)
+      TraversalStatistics::enable();
   }
 
   Device::~Device ()
   {
-    setCacheSize(0);
+    if (State::traversal_statistics_sample_rate)
+      TraversalStatistics::disable();
     exitTaskingSystem();
   }
 
@@ -329,23 +336,31 @@ namespace embree
     return maxNumThreads;
   }
 
-  size_t getMaxCacheSize()
+  void Device::setCacheSize(size_t bytes) 
   {
-    size_t maxCacheSize = 0;
-    for (std::map<Device*,size_t>::iterator i=g_cache_size_map.begin(); i!= g_cache_size_map.end(); i++)
-      maxCacheSize = max(maxCacheSize, (*i).second);
-    return maxCacheSize;
+#if defined(EMBREE_GEOMETRY_SUBDIVISION)
+    if (bytes > SharedLazyTessellationCache::MAX_TESSELLATION_CACHE_SIZE)
+      bytes = SharedLazyTessellationCache::MAX_TESSELLATION_CACHE_SIZE;
+    if (tessellationCache->getSize() != bytes)
+      tessellationCache->realloc(bytes);
+#endif
   }
- 
-  void Device::setCacheSize(size_t bytes) 
+
+  void Device::getTessellationCacheStatistics(RTCTessellationCacheStatistics& stats)
   {
+    memset(&stats,0,sizeof(stats));
 #if defined(EMBREE_GEOMETRY_SUBDIVISION)
-    Lock<MutexSys> lock(g_mutex);
-    if (bytes == 0) g_cache_size_map.erase(this);
-    else            g_cache_size_map[this] = bytes;
-    
-    size_t maxCacheSize = getMaxCacheSize();
-    resizeTessellationCache(maxCacheSize);
+    stats.size    = tessellationCache->getSize();
+    stats.hits    = tessellationCache->stats.getHits();
+    stats.misses  = tessellationCache->stats.misses.load();
+    stats.flushes = tessellationCache->stats.flushes.load();
+#endif
+  }
+
+  void Device::resetTessellationCacheStatistics()
+  {
+#if defined(EMBREE_GEOMETRY_SUBDIVISION)
+    tessellationCache->stats.clear();
 #endif
   }
 
@@ -410,6 +425,17 @@ namespace embree
     case 1000003: debug_int3 = val; return;
     }
 
+    /* documented properties */
+    switch (prop)
+    {
+    case RTC_DEVICE_PROPERTY_TESSELLATION_CACHE_SIZE:
+      if (val < 0) throw_RTCError(RTC_ERROR_INVALID_ARGUMENT, "invalid tessellation cache size");
+      setCacheSize(size_t(val));
+      return;
+
+    default: break;
+    }
+
     throw_RTCError(RTC_ERROR_INVALID_ARGUMENT, "unknown writable property");
   }
 
@@ -557,15 +583,39 @@ namespace embree
     case RTC_DEVICE_PROPERTY_PARALLEL_COMMIT_SUPPORTED: return 0;
 #endif
 
+#if defined(EMBREE_GEOMETRY_SUBDIVISION)
+    case RTC_DEVICE_PROPERTY_TESSELLATION_CACHE_SIZE: return tessellationCache->getSize();
+#else
+    case RTC_DEVICE_PROPERTY_TESSELLATION_CACHE_SIZE: return 0;
+#endif
+
     default: throw_RTCError(RTC_ERROR_INVALID_ARGUMENT, "unknown readable property"); break;
     };
   }
 
-  void* Device::malloc(size_t size, size_t align) {
+  void* Device::userMalloc(size_t bytes, size_t align)
+  {
+    if (bytes == 0) return nullptr;
+    void* ptr = alloc_function(allocator_userptr,bytes,align);
+    if (ptr == nullptr)
+      throw_RTCError(RTC_ERROR_OUT_OF_MEMORY,"user allocator failed");
+    assert((((size_t)ptr) & (align-1)) == 0);
+    return ptr;
+  }
+
+  void Device::userFree(void* ptr) {
+    if (ptr) free_function(allocator_userptr,ptr);
+  }
+
+  void* Device::malloc(size_t size, size_t align)
+  {
+    if (hasUserAllocator()) return userMalloc(size,align);
     return alignedMalloc(size,align);
   }
 
-  void Device::free(void* ptr) {
+  void Device::free(void* ptr)
+  {
+    if (hasUserAllocator()) return userFree(ptr);
     alignedFree(ptr);
   }
 
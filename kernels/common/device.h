@@ -6,6 +6,7 @@
 #include "default.h"
 #include "state.h"
 #include "accel.h"
+#include "../subdiv/tessellation_cache.h"
 
 namespace embree
 {
@@ -92,9 +93,24 @@ namespace embree
     /*! invokes the memory monitor callback */
     void memoryMonitor(ssize_t bytes, bool post);
 
+    /*! returns true if a user allocator is set */
+    bool hasUserAllocator() const {
+      return alloc_function != nullptr;
+    }
+
+    /*! allocates and frees memory through the user allocator */
+    void* userMalloc(size_t bytes, size_t align);
+    void userFree(void* ptr);
+
     /*! sets the size of the software cache. */
     void setCacheSize(size_t bytes);
 
+    /*! returns the statistics of the tessellation cache */
+    void getTessellationCacheStatistics(RTCTessellationCacheStatistics& stats);
+
+    /*! resets the statistics of the tessellation cache */
+    void resetTessellationCacheStatistics();
+
     /*! sets a property */
     void setProperty(const RTCDeviceProperty prop, ssize_t val);
 
@@ -140,6 +156,11 @@ namespace embree
 #if defined(EMBREE_TARGET_SIMD8)
     std::unique_ptr<BVH8Factory> bvh8_factory;
 #endif
+
+#if defined(EMBREE_GEOMETRY_SUBDIVISION)
+    /*! tessellation cache used by the subdivision meshes of this device */
+    std::unique_ptr<SharedLazyTessellationCache> tessellationCache;
+#endif
   };
 
 #if defined(EMBREE_SYCL_SUPPORT)
@@ -376,6 +376,11 @@ namespace embree
       throw_RTCError(RTC_ERROR_INVALID_OPERATION,"operation not supported for this geometry"); 
     }
 
+    /*! sets the camera used to adapt the tessellation rate to the ray footprint */
+    virtual void setTessellationCamera(const Vec3fa* position, float spreadAngle) {
+      throw_RTCError(RTC_ERROR_INVALID_OPERATION,"operation not supported for this geometry"); 
+    }
+
     /*! Sets the maximal curve radius scale allowed by min-width feature. */
     virtual void setMaxRadiusScale(float s) {
       throw_RTCError(RTC_ERROR_INVALID_OPERATION,"operation not supported for this geometry"); 
@@ -0,0 +1,393 @@
+// Copyright 2009-2021 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include "raystream.h"
+
+#include <algorithm>
+
+namespace embree
+{
+  /* access to rays stored as array of structures */
+  struct IntersectStreamAOS
+  {
+    __forceinline IntersectStreamAOS (RTCRayHit* rays, size_t stride)
+      : rays((char*)rays), stride(stride) {}
+
+    __forceinline RTCRayHit& at(size_t i) const {
+      return *(RTCRayHit*)(rays + i*stride);
+    }
+
+    __forceinline void get(size_t i, RTCRayHit& ray) const {
+      ray = at(i);
+    }
+
+    __forceinline void set(size_t i, const RTCRayHit& ray) const
+    {
+      if (ray.hit.geomID == RTC_INVALID_GEOMETRY_ID) return;
+      at(i).ray.tfar = ray.ray.tfar;
+      at(i).hit = ray.hit;
+    }
+
+    char* rays;
+    size_t stride;
+  };
+
+  struct OccludedStreamAOS
+  {
+    __forceinline OccludedStreamAOS (RTCRay* rays, size_t stride)
+      : rays((char*)rays), stride(stride) {}
+
+    __forceinline RTCRay& at(size_t i) const {
+      return *(RTCRay*)(rays + i*stride);
+    }
+
+    __forceinline void get(size_t i, RTCRay& ray) const {
+      ray = at(i);
+    }
+
+    __forceinline void set(size_t i, const RTCRay& ray) const {
+      if (ray.tfar < 0.0f) at(i).tfar = ray.tfar;
+    }
+
+    char* rays;
+    size_t stride;
+  };
+
+  /* access to rays stored as structure of pointers, some pointers are optional */
+  __forceinline void getRaySOP(const RTCRayNp& rays, size_t i, RTCRay& ray)
+  {
+    ray.org_x = rays.org_x[i];
+    ray.org_y = rays.org_y[i];
+    ray.org_z = rays.org_z[i];
+    ray.tnear = rays.tnear ? rays.tnear[i] : 0.0f;
+    ray.dir_x = rays.dir_x[i];
+    ray.dir_y = rays.dir_y[i];
+    ray.dir_z = rays.dir_z[i];
+    ray.time  = rays.time ? rays.time[i] : 0.0f;
+    ray.tfar  = rays.tfar[i];
+    ray.mask  = rays.mask ? rays.mask[i] : -1;
+    ray.id    = rays.id ? rays.id[i] : 0;
+    ray.flags = rays.flags ? rays.flags[i] : 0;
+  }
+
+  struct IntersectStreamSOP
+  {
+    __forceinline IntersectStreamSOP (const RTCRayHitNp& rays)
+      : rays(rays) {}
+
+    __forceinline void get(size_t i, RTCRayHit& ray) const
+    {
+      getRaySOP(rays.ray,i,ray.ray);
+      ray.hit.geomID = RTC_INVALID_GEOMETRY_ID;
+      for (unsigned l = 0; l < RTC_MAX_INSTANCE_LEVEL_COUNT; ++l)
+        ray.hit.instID[l] = RTC_INVALID_GEOMETRY_ID;
+    }
+
+    __forceinline void set(size_t i, const RTCRayHit& ray) const
+    {
+      if (ray.hit.geomID == RTC_INVALID_GEOMETRY_ID) return;
+      rays.ray.tfar[i] = ray.ray.tfar;
+      if (rays.hit.Ng_x) rays.hit.Ng_x[i] = ray.hit.Ng_x;
+      if (rays.hit.Ng_y) rays.hit.Ng_y[i] = ray.hit.Ng_y;
+      if (rays.hit.Ng_z) rays.hit.Ng_z[i] = ray.hit.Ng_z;
+      rays.hit.u[i] = ray.hit.u;
+      rays.hit.v[i] = ray.hit.v;
+      rays.hit.primID[i] = ray.hit.primID;
+      rays.hit.geomID[i] = ray.hit.geomID;
+      for (unsigned l = 0; l < RTC_MAX_INSTANCE_LEVEL_COUNT; ++l)
+        if (rays.hit.instID[l]) rays.hit.instID[l][i] = ray.hit.instID[l];
+    }
+
+    const RTCRayHitNp& rays;
+  };
+
+  struct OccludedStreamSOP
+  {
+    __forceinline OccludedStreamSOP (const RTCRayNp& rays)
+      : rays(rays) {}
+
+    __forceinline void get(size_t i, RTCRay& ray) const {
+      getRaySOP(rays,i,ray);
+    }
+
+    __forceinline void set(size_t i, const RTCRay& ray) const {
+      if (ray.tfar < 0.0f) rays.tfar[i] = ray.tfar;
+    }
+
+    const RTCRayNp& rays;
+  };
+
+  /* copies rays into and out of a lane of a ray packet */
+  template<typename RTCRayK>
+  __forceinline void setLane(RTCRayK& dst, size_t k, const RTCRay& src)
+  {
+    dst.org_x[k] = src.org_x;
+    dst.org_y[k] = src.org_y;
+    dst.org_z[k] = src.org_z;
+    dst.tnear[k] = src.tnear;
+    dst.dir_x[k] = src.dir_x;
+    dst.dir_y[k] = src.dir_y;
+    dst.dir_z[k] = src.dir_z;
+    dst.time[k]  = src.time;
+    dst.tfar[k]  = src.tfar;
+    dst.mask[k]  = src.mask;
+    dst.id[k]    = src.id;
+    dst.flags[k] = src.flags;
+  }
+
+  template<typename RTCRayHitK>
+  __forceinline void setLane(RTCRayHitK& dst, size_t k, const RTCRayHit& src)
+  {
+    setLane(dst.ray,k,src.ray);
+    dst.hit.geomID[k] = src.hit.geomID;
+    for (unsigned l = 0; l < RTC_MAX_INSTANCE_LEVEL_COUNT; ++l)
+      dst.hit.instID[l][k] = src.hit.instID[l];
+  }
+
+  template<typename RTCRayK>
+  __forceinline void getLane(const RTCRayK& src, size_t k, RTCRay& dst) {
+    dst.tfar = src.tfar[k];
+  }
+
+  template<typename RTCRayHitK>
+  __forceinline void getLane(const RTCRayHitK& src, size_t k, RTCRayHit& dst)
+  {
+    dst.ray.tfar = src.ray.tfar[k];
+    dst.hit.Ng_x = src.hit.Ng_x[k];
+    dst.hit.Ng_y = src.hit.Ng_y[k];
+    dst.hit.Ng_z = src.hit.Ng_z[k];
+    dst.hit.u = src.hit.u[k];
+    dst.hit.v = src.hit.v[k];
+    dst.hit.primID = src.hit.primID[k];
+    dst.hit.geomID = src.hit.geomID[k];
+    for (unsigned l = 0; l < RTC_MAX_INSTANCE_LEVEL_COUNT; ++l)
+      dst.hit.instID[l] = src.hit.instID[l][k];
+  }
+
+  __forceinline RTCRay& getRay(RTCRay& ray) { return ray; }
+  __forceinline RTCRay& getRay(RTCRayHit& ray) { return ray.ray; }
+
+  __forceinline void trace(Scene* scene, RTCRayHit& ray, RayQueryContext* context) {
+    scene->intersectors.intersect(ray,context);
+  }
+
+  __forceinline void trace(Scene* scene, RTCRay& ray, RayQueryContext* context) {
+    scene->intersectors.occluded(ray,context);
+  }
+
+  __forceinline void traceBatch(Scene* scene, RTCRayHit* rays, size_t numRays, RayQueryContext* context) {
+    scene->intersectors.intersectBatch(rays,numRays,context);
+  }
+
+  __forceinline void traceBatch(Scene* scene, RTCRay* rays, size_t numRays, RayQueryContext* context) {
+    scene->intersectors.occludedBatch(rays,numRays,context);
+  }
+
+  template<typename RTCRayK>
+  __forceinline void trace(Scene* scene, const int* valid, RTCRayK& ray, RayQueryContext* context) {
+    scene->intersectors.intersect(valid,ray,context);
+  }
+
+  template<> __forceinline void trace(Scene* scene, const int* valid, RTCRay4& ray, RayQueryContext* context) {
+    scene->intersectors.occluded(valid,ray,context);
+  }
+
+  template<> __forceinline void trace(Scene* scene, const int* valid, RTCRay8& ray, RayQueryContext* context) {
+    scene->intersectors.occluded(valid,ray,context);
+  }
+
+  template<> __forceinline void trace(Scene* scene, const int* valid, RTCRay16& ray, RayQueryContext* context) {
+    scene->intersectors.occluded(valid,ray,context);
+  }
+
+  template<typename RTCRayK>
+  __forceinline void traceTile(Scene* scene, const int* valid, RTCRayK* rays, size_t numPackets, RayQueryContext* context) {
+    scene->intersectors.intersectTile(valid,rays,numPackets,context);
+  }
+
+  template<> __forceinline void traceTile(Scene* scene, const int* valid, RTCRay4* rays, size_t numPackets, RayQueryContext* context) {
+    scene->intersectors.occludedTile(valid,rays,numPackets,context);
+  }
+
+  template<> __forceinline void traceTile(Scene* scene, const int* valid, RTCRay8* rays, size_t numPackets, RayQueryContext* context) {
+    scene->intersectors.occludedTile(valid,rays,numPackets,context);
+  }
+
+  template<> __forceinline void traceTile(Scene* scene, const int* valid, RTCRay16* rays, size_t numPackets, RayQueryContext* context) {
+    scene->intersectors.occludedTile(valid,rays,numPackets,context);
+  }
+
+  /* quantizes a coordinate to 9 bits, robust against NaNs and rays starting outside the scene */
+  __forceinline unsigned int quantize(float x)
+  {
+    if (!(x > 0.0f)) return 0;
+    return (unsigned int) std::min(x,511.0f);
+  }
+
+  /* sorts the rays of a block by direction octant first and origin second */
+  template<typename Ray, typename Stream>
+  static void sortBlock(Scene* scene, const Stream& stream, size_t begin, size_t end, uint64_t* keys)
+  {
+    const BBox3fa bounds = scene->bounds.bounds();
+    const Vec3fa size = bounds.size();
+    const Vec3fa scale(size.x > 0.0f ? 511.0f/size.x : 0.0f,
+                       size.y > 0.0f ? 511.0f/size.y : 0.0f,
+                       size.z > 0.0f ? 511.0f/size.z : 0.0f);
+
+    for (size_t i=begin; i<end; i++)
+    {
+      Ray ray; stream.get(i,ray);
+      const RTCRay& r = getRay(ray);
+      const unsigned int octant = (r.dir_x < 0.0f ? 1 : 0) | (r.dir_y < 0.0f ? 2 : 0) | (r.dir_z < 0.0f ? 4 : 0);
+      const unsigned int x = quantize((r.org_x-bounds.lower.x)*scale.x);
+      const unsigned int y = quantize((r.org_y-bounds.lower.y)*scale.y);
+      const unsigned int z = quantize((r.org_z-bounds.lower.z)*scale.z);
+      const uint64_t key = (octant << 27) | bitInterleave(x,y,z);
+      keys[i-begin] = (key << 32) | uint64_t(i-begin);
+    }
+    std::sort(keys,keys+(end-begin));
+  }
+
+  /* traces sorted rays in packets of K rays */
+  template<int K, typename RayK, typename Ray, typename Stream>
+  static void tracePackets(Scene* scene, const Stream& stream, size_t begin, const uint64_t* keys, size_t numRays, RayQueryContext* context)
+  {
+    for (size_t i=0; i<numRays; i+=K)
+    {
+      const size_t n = min(numRays-i,size_t(K));
+      RayK packet;
+      __aligned(64) int valid[K];
+
+      /* fill unused lanes with a copy of the first ray to not trace uninitialized data */
+      for (size_t k=0; k<K; k++)
+      {
+        const size_t index = begin + size_t(unsigned(keys[i+(k<n ? k : 0)]));
+        Ray ray; stream.get(index,ray);
+        setLane(packet,k,ray);
+        valid[k] = k < n ? -1 : 0;
+      }
+
+      trace(scene,valid,packet,context);
+
+      for (size_t k=0; k<n; k++)
+      {
+        const size_t index = begin + size_t(unsigned(keys[i+k]));
+        Ray ray; getLane(packet,k,ray);
+        stream.set(index,ray);
+      }
+    }
+  }
+
+  /* traces sorted coherent rays in tiles of packets of K rays, a tile never crosses a direction octant */
+  template<int K, typename RayK, typename Ray, typename Stream>
+  static void traceTiles(Scene* scene, const Stream& stream, size_t begin, const uint64_t* keys, size_t numRays, RayQueryContext* context)
+  {
+    for (size_t i=0; i<numRays; )
+    {
+      /* the direction octant is stored in the topmost bits of the sort key */
+      const uint64_t octant = keys[i] >> 59;
+      size_t n = 1;
+      while (n < Accel::maxTileRays && i+n < numRays && (keys[i+n] >> 59) == octant) n++;
+
+      const size_t numPackets = (n+K-1)/K;
+      RayK packets[Accel::maxTileRays/K];
+      __aligned(64) int valid[Accel::maxTileRays];
+
+      /* fill unused lanes with a copy of the first ray to not trace uninitialized data */
+      for (size_t j=0; j<numPackets*K; j++)
+      {
+        const size_t index = begin + size_t(unsigned(keys[i+(j<n ? j : 0)]));
+        Ray ray; stream.get(index,ray);
+        setLane(packets[j/K],j%K,ray);
+        valid[j] = j < n ? -1 : 0;
+      }
+
+      traceTile(scene,valid,packets,numPackets,context);
+
+      for (size_t j=0; j<n; j++)
+      {
+        const size_t index = begin + size_t(unsigned(keys[i+j]));
+        Ray ray; getLane(packets[j/K],j%K,ray);
+        stream.set(index,ray);
+      }
+      i += n;
+    }
+  }
+
+  /* traces sorted rays as one batch of single rays that gets queued at the treelets of the BVH */
+  template<typename Ray, typename Stream>
+  static void traceBatch(Scene* scene, const Stream& stream, size_t begin, const uint64_t* keys, size_t numRays, Ray* rays, RayQueryContext* context)
+  {
+    for (size_t i=0; i<numRays; i++)
+      stream.get(begin + size_t(unsigned(keys[i])),rays[i]);
+
+    traceBatch(scene,rays,numRays,context);
+
+    for (size_t i=0; i<numRays; i++)
+      stream.set(begin + size_t(unsigned(keys[i])),rays[i]);
+  }
+
+  template<typename RayK4, typename RayK8, typename RayK16, typename Ray, typename Stream>
+  static void traceStream(Scene* scene, const Stream& stream, size_t N, RayQueryContext* context)
+  {
+    const bool packet16 = scene->device->hasISA(AVX512) && scene->intersectors.intersector16;
+    const bool packet8  = scene->device->hasISA(AVX) && scene->intersectors.intersector8;
+    const bool packet4  = scene->intersectors.intersector4;
+    const bool coherent = context->isCoherent();
+    const bool treelets = context->useTreelets();
+
+    uint64_t keys[RayStream::BLOCK_SIZE];
+    std::vector<Ray> batch(treelets ? min(N,RayStream::BLOCK_SIZE) : 0);
+    for (size_t begin=0; begin<N; begin+=RayStream::BLOCK_SIZE)
+    {
+      const size_t end = min(N,begin+RayStream::BLOCK_SIZE);
+      sortBlock<Ray>(scene,stream,begin,end,keys);
+
+      /* incoherent rays of large scenes get traced breadth first through the treelets of the BVH */
+      if (treelets)
+        traceBatch<Ray>(scene,stream,begin,keys,end-begin,batch.data(),context);
+
+      /* coherent rays get traced in tiles of multiple packets */
+      else if (packet16 && coherent)
+        traceTiles<16,RayK16,Ray>(scene,stream,begin,keys,end-begin,context);
+      else if (packet16)
+        tracePackets<16,RayK16,Ray>(scene,stream,begin,keys,end-begin,context);
+      else if (packet8 && coherent)
+        traceTiles<8,RayK8,Ray>(scene,stream,begin,keys,end-begin,context);
+      else if (packet8)
+        tracePackets<8,RayK8,Ray>(scene,stream,begin,keys,end-begin,context);
+      else if (packet4 && coherent)
+        traceTiles<4,RayK4,Ray>(scene,stream,begin,keys,end-begin,context);
+      else if (packet4)
+        tracePackets<4,RayK4,Ray>(scene,stream,begin,keys,end-begin,context);
+
+      /* without packet support we still benefit from the coherent ray order */
+      else
+      {
+        for (size_t i=0; i<end-begin; i++)
+        {
+          const size_t index = begin + size_t(unsigned(keys[i]));
+          Ray ray; stream.get(index,ray);
+          trace(scene,ray,context);
+          stream.set(index,ray);
+        }
+      }
+    }
+  }
+
+  void RayStream::intersectAOS(Scene* scene, RTCRayHit* rays, size_t N, size_t stride, RayQueryContext* context) {
+    traceStream<RTCRayHit4,RTCRayHit8,RTCRayHit16,RTCRayHit>(scene,IntersectStreamAOS(rays,stride),N,context);
+  }
+
+  void RayStream::occludedAOS(Scene* scene, RTCRay* rays, size_t N, size_t stride, RayQueryContext* context) {
+    traceStream<RTCRay4,RTCRay8,RTCRay16,RTCRay>(scene,OccludedStreamAOS(rays,stride),N,context);
+  }
+
+  void RayStream::intersectSOP(Scene* scene, const RTCRayHitNp& rays, size_t N, RayQueryContext* context) {
+    traceStream<RTCRayHit4,RTCRayHit8,RTCRayHit16,RTCRayHit>(scene,IntersectStreamSOP(rays),N,context);
+  }
+
+  void RayStream::occludedSOP(Scene* scene, const RTCRayNp& rays, size_t N, RayQueryContext* context) {
+    traceStream<RTCRay4,RTCRay8,RTCRay16,RTCRay>(scene,OccludedStreamSOP(rays),N,context);
+  }
+}
@@ -0,0 +1,28 @@
+// Copyright 2009-2021 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include "default.h"
+#include "scene.h"
+#include "context.h"
+
+namespace embree
+{
+  /*! Traces streams of rays. The rays of a stream are sorted by
+   *  direction octant and origin and then re-packed into coherent
+   *  packets for the packet intersectors of the scene. */
+  struct RayStream
+  {
+    /*! number of rays sorted together */
+    static const size_t BLOCK_SIZE = 4096;
+
+    /*! traces a stream of rays stored as array of structures */
+    static void intersectAOS(Scene* scene, RTCRayHit* rays, size_t N, size_t stride, RayQueryContext* context);
+    static void occludedAOS(Scene* scene, RTCRay* rays, size_t N, size_t stride, RayQueryContext* context);
+
+    /*! traces a stream of rays stored as structure of pointers */
+    static void intersectSOP(Scene* scene, const RTCRayHitNp& rays, size_t N, RayQueryContext* context);
+    static void occludedSOP(Scene* scene, const RTCRayNp& rays, size_t N, RayQueryContext* context);
+  };
+}
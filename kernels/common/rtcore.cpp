@@ -7,6 +7,8 @@
 #include "device.h"
 #include "scene.h"
 #include "context.h"
+#include "raystream.h"
+#include "../../common/algorithms/parallel_sort.h"
 #include "../geometry/filter.h"
 #include "../../include/embree4/rtcore_ray.h"
 using namespace embree;
@@ -138,6 +140,27 @@ RTC_NAMESPACE_BEGIN;
     RTC_CATCH_END(device);
   }
 
+  RTC_API void rtcGetDeviceTessellationCacheStatistics(RTCDevice hdevice, RTCTessellationCacheStatistics* stats)
+  {
+    Device* device = (Device*) hdevice;
+    RTC_CATCH_BEGIN;
+    RTC_TRACE(rtcGetDeviceTessellationCacheStatistics);
+    RTC_VERIFY_HANDLE(hdevice);
+    RTC_VERIFY_HANDLE(stats);
+    device->getTessellationCacheStatistics(*stats);
+    RTC_CATCH_END(device);
+  }
+
+  RTC_API void rtcResetDeviceTessellationCacheStatistics(RTCDevice hdevice)
+  {
+    Device* device = (Device*) hdevice;
+    RTC_CATCH_BEGIN;
+    RTC_TRACE(rtcResetDeviceTessellationCacheStatistics);
+    RTC_VERIFY_HANDLE(hdevice);
+    device->resetTessellationCacheStatistics();
+    RTC_CATCH_END(device);
+  }
+
   RTC_API RTCError rtcGetDeviceError(RTCDevice hdevice)
   {
     Device* device = (Device*) hdevice;
@@ -168,6 +191,25 @@ RTC_NAMESPACE_BEGIN;
     RTC_CATCH_END(device);
   }
 
+  RTC_API void rtcSetDeviceAllocator(RTCDevice hdevice, RTCAllocFunction alloc, RTCFreeFunction free, void* userPtr)
+  {
+    Device* device = (Device*) hdevice;
+    RTC_CATCH_BEGIN;
+    RTC_TRACE(rtcSetDeviceAllocator);
+    RTC_VERIFY_HANDLE(hdevice);
+    if ((alloc == nullptr) != (free == nullptr))
+      throw_RTCError(RTC_ERROR_INVALID_ARGUMENT,"alloc and free function have to be set together");
+#if defined(EMBREE_SYCL_SUPPORT)
+    if (dynamic_cast<DeviceGPU*>(device))
+      throw_RTCError(RTC_ERROR_INVALID_OPERATION,"user allocator not supported for SYCL devices");
+#endif
+    /* memory of existing objects would get freed through the wrong allocator */
+    if (device->refCount() > 1)
+      throw_RTCError(RTC_ERROR_INVALID_OPERATION,"allocator has to be set before objects get created on the device");
+    device->setAllocatorFunctions(alloc, free, userPtr);
+    RTC_CATCH_END(device);
+  }
+
   RTC_API RTCBuffer rtcNewBuffer(RTCDevice hdevice, size_t byteSize)
   {
     RTC_CATCH_BEGIN;
@@ -270,7 +312,8 @@ RTC_NAMESPACE_BEGIN;
     RTC_ENTER_DEVICE(hscene);
     if (quality != RTC_BUILD_QUALITY_LOW &&
         quality != RTC_BUILD_QUALITY_MEDIUM &&
-        quality != RTC_BUILD_QUALITY_HIGH)
+        quality != RTC_BUILD_QUALITY_HIGH &&
+        quality != RTC_BUILD_QUALITY_REFIT)
       throw std::runtime_error("invalid build quality");
     scene->setBuildQuality(quality);
     RTC_CATCH_END2(scene);
@@ -321,6 +364,30 @@ RTC_NAMESPACE_BEGIN;
     RTC_CATCH_END2(scene);
   }
 
+  RTC_API void rtcSaveScene (RTCScene hscene, const char* filename) 
+  {
+    Scene* scene = (Scene*) hscene;
+    RTC_CATCH_BEGIN;
+    RTC_TRACE(rtcSaveScene);
+    RTC_VERIFY_HANDLE(hscene);
+    RTC_VERIFY_HANDLE(filename);
+    RTC_ENTER_DEVICE(hscene);
+    scene->save(filename);
+    RTC_CATCH_END2(scene);
+  }
+
+  RTC_API void rtcLoadScene (RTCScene hscene, const char* filename) 
+  {
+    Scene* scene = (Scene*) hscene;
+    RTC_CATCH_BEGIN;
+    RTC_TRACE(rtcLoadScene);
+    RTC_VERIFY_HANDLE(hscene);
+    RTC_VERIFY_HANDLE(filename);
+    RTC_ENTER_DEVICE(hscene);
+    scene->load(filename);
+    RTC_CATCH_END2(scene);
+  }
+
   RTC_API void rtcGetSceneBounds(RTCScene hscene, RTCBounds* bounds_o)
   {
     Scene* scene = (Scene*) hscene;
@@ -372,6 +439,71 @@ RTC_NAMESPACE_BEGIN;
     RTC_CATCH_END2(scene);
   }
 
+  RTC_API void rtcGetSceneStatistics(RTCScene hscene, RTCSceneStatistics* stats)
+  {
+    Scene* scene = (Scene*) hscene;
+    RTC_CATCH_BEGIN;
+    RTC_TRACE(rtcGetSceneStatistics);
+    RTC_VERIFY_HANDLE(hscene);
+    RTC_VERIFY_HANDLE(stats);
+    RTC_ENTER_DEVICE(hscene);
+    scene->traversalStatistics.get(*stats);
+    RTC_CATCH_END2(scene);
+  }
+
+  RTC_API void rtcResetSceneStatistics(RTCScene hscene)
+  {
+    Scene* scene = (Scene*) hscene;
+    RTC_CATCH_BEGIN;
+    RTC_TRACE(rtcResetSceneStatistics);
+    RTC_VERIFY_HANDLE(hscene);
+    RTC_ENTER_DEVICE(hscene);
+    scene->traversalStatistics.clear();
+    RTC_CATCH_END2(scene);
+  }
+
+  RTC_API unsigned int rtcGetSceneBVHStatistics(RTCScene hscene, RTCBVHStatistics* stats, unsigned int maxCount)
+  {
+    Scene* scene = (Scene*) hscene;
+    RTC_CATCH_BEGIN;
+    RTC_TRACE(rtcGetSceneBVHStatistics);
+    RTC_VERIFY_HANDLE(hscene);
+    RTC_ENTER_DEVICE(hscene);
+    if (scene->isModified())
+      throw_RTCError(RTC_ERROR_INVALID_OPERATION,"scene not committed");
+    if (stats == nullptr && maxCount != 0)
+      throw_RTCError(RTC_ERROR_INVALID_ARGUMENT,"invalid destination pointer");
+
+    std::vector<RTCBVHStatistics> bvhs;
+    scene->accels_statistics(bvhs);
+    for (size_t i=0; i<min(bvhs.size(),size_t(maxCount)); i++)
+      stats[i] = bvhs[i];
+    return (unsigned int) bvhs.size();
+    RTC_CATCH_END2(scene);
+    return 0;
+  }
+
+  RTC_API unsigned int rtcGetSceneBuildStatistics(RTCScene hscene, RTCBuildStatistics* stats, unsigned int maxCount)
+  {
+    Scene* scene = (Scene*) hscene;
+    RTC_CATCH_BEGIN;
+    RTC_TRACE(rtcGetSceneBuildStatistics);
+    RTC_VERIFY_HANDLE(hscene);
+    RTC_ENTER_DEVICE(hscene);
+    if (scene->isModified())
+      throw_RTCError(RTC_ERROR_INVALID_OPERATION,"scene not committed");
+    if (stats == nullptr && maxCount != 0)
+      throw_RTCError(RTC_ERROR_INVALID_ARGUMENT,"invalid destination pointer");
+
+    std::vector<RTCBuildStatistics> bvhs;
+    scene->accels_buildStatistics(bvhs);
+    for (size_t i=0; i<min(bvhs.size(),size_t(maxCount)); i++)
+      stats[i] = bvhs[i];
+    return (unsigned int) bvhs.size();
+    RTC_CATCH_END2(scene);
+    return 0;
+  }
+
   RTC_API void rtcCollide (RTCScene hscene0, RTCScene hscene1, RTCCollideFunc callback, void* userPtr)
   {
     Scene* scene0 = (Scene*) hscene0;
@@ -384,10 +516,15 @@ RTC_NAMESPACE_BEGIN;
     if (scene0->isModified()) throw_RTCError(RTC_ERROR_INVALID_OPERATION,"scene got not committed");
     if (scene1->isModified()) throw_RTCError(RTC_ERROR_INVALID_OPERATION,"scene got not committed");
     if (scene0->device != scene1->device) throw_RTCError(RTC_ERROR_INVALID_OPERATION,"scenes are from different devices");
-    auto nUserPrims0 = scene0->getNumPrimitives (Geometry::MTY_USER_GEOMETRY, false);
-    auto nUserPrims1 = scene1->getNumPrimitives (Geometry::MTY_USER_GEOMETRY, false);
-    if (scene0->numPrimitives() != nUserPrims0 && scene1->numPrimitives() != nUserPrims1) throw_RTCError(RTC_ERROR_INVALID_OPERATION,"scenes must only contain user geometries with a single timestep");
+    const Geometry::GTypeMask mask = Geometry::GTypeMask(Geometry::MTY_USER_GEOMETRY | Geometry::MTY_TRIANGLE_MESH | Geometry::MTY_QUAD_MESH);
+    if (scene0->numPrimitives() != scene0->getNumPrimitives(mask,false) || scene1->numPrimitives() != scene1->getNumPrimitives(mask,false))
+      throw_RTCError(RTC_ERROR_INVALID_OPERATION,"scenes must only contain user geometries, triangle meshes, or quad meshes with a single timestep");
 #endif
+    if (scene0->numPrimitives() == 0 || scene1->numPrimitives() == 0) return;
+
+    /* both scenes have to use the same BVH layout, which is e.g. not the case for scenes mixing triangles and quads */
+    if (!scene0->intersectors.collider || scene0->intersectors.collider.collide != scene1->intersectors.collider.collide)
+      throw_RTCError(RTC_ERROR_INVALID_OPERATION,"collision detection not supported for these scenes");
     scene0->intersectors.collide(scene0,scene1,callback,userPtr);
     RTC_CATCH_END(scene0->device);
   }
@@ -434,6 +571,8 @@ RTC_NAMESPACE_BEGIN;
     if (((size_t)query) & 0x0F) throw_RTCError(RTC_ERROR_INVALID_ARGUMENT, "query not aligned to 16 bytes");   
     if (((size_t)userContext) & 0x0F) throw_RTCError(RTC_ERROR_INVALID_ARGUMENT, "context not aligned to 16 bytes");   
 #endif
+    STAT(STAT3(point_query.travs,1,1,1));
+    TraversalStatistics::Sample sample(scene,TraversalStatistics::POINT_QUERY,1);
 
     return pointQuery(scene, query, userContext, queryFunc, userPtr);
     RTC_CATCH_END2_FALSE(scene);
@@ -452,7 +591,8 @@ RTC_NAMESPACE_BEGIN;
     if (((size_t)query) & 0x0F) throw_RTCError(RTC_ERROR_INVALID_ARGUMENT, "query not aligned to 16 bytes");   
 #endif
     STAT(size_t cnt=0; for (size_t i=0; i<4; i++) cnt += ((int*)valid)[i] == -1;);
-    STAT3(point_query.travs,cnt,cnt,cnt);
+    STAT(STAT3(point_query.travs,cnt,cnt,cnt));
+    TraversalStatistics::Sample sample(scene,TraversalStatistics::POINT_QUERY,valid,4);
 
     bool changed = false;
     PointQuery4* query4 = (PointQuery4*)query;
@@ -480,7 +620,8 @@ RTC_NAMESPACE_BEGIN;
     if (((size_t)query) & 0x0F) throw_RTCError(RTC_ERROR_INVALID_ARGUMENT, "query not aligned to 16 bytes");   
 #endif
     STAT(size_t cnt=0; for (size_t i=0; i<4; i++) cnt += ((int*)valid)[i] == -1;);
-    STAT3(point_query.travs,cnt,cnt,cnt);
+    STAT(STAT3(point_query.travs,cnt,cnt,cnt));
+    TraversalStatistics::Sample sample(scene,TraversalStatistics::POINT_QUERY,valid,8);
 
     bool changed = false;
     PointQuery8* query8 = (PointQuery8*)query;
@@ -508,7 +649,8 @@ RTC_NAMESPACE_BEGIN;
     if (((size_t)query) & 0x0F) throw_RTCError(RTC_ERROR_INVALID_ARGUMENT, "query not aligned to 16 bytes");   
 #endif
     STAT(size_t cnt=0; for (size_t i=0; i<4; i++) cnt += ((int*)valid)[i] == -1;);
-    STAT3(point_query.travs,cnt,cnt,cnt);
+    STAT(STAT3(point_query.travs,cnt,cnt,cnt));
+    TraversalStatistics::Sample sample(scene,TraversalStatistics::POINT_QUERY,valid,16);
 
     bool changed = false;
     PointQuery16* query16 = (PointQuery16*)query;
@@ -523,6 +665,92 @@ RTC_NAMESPACE_BEGIN;
     RTC_CATCH_END2_FALSE(scene);
   }
 
+  /* sorts the query points of a batch along a Morton curve through the scene bounds */
+  static void sortPointQueries(Scene* scene, const RTCPointQueryNp& query, unsigned int N, uint64_t* keys, uint64_t* tmp)
+  {
+    const BBox3fa bounds = scene->bounds.bounds();
+    const Vec3fa size = bounds.size();
+    const Vec3fa scale(size.x > 0.0f ? 1023.0f/size.x : 0.0f,
+                       size.y > 0.0f ? 1023.0f/size.y : 0.0f,
+                       size.z > 0.0f ? 1023.0f/size.z : 0.0f);
+
+    /* points outside the scene bounds and NaNs get clamped to the border cells */
+    auto quantize = [] (float x) -> unsigned int {
+      if (!(x > 0.0f)) return 0;
+      return (unsigned int) min(x,1023.0f);
+    };
+
+    parallel_for(size_t(0), size_t(N), size_t(4096), [&](const range<size_t>& r)
+    {
+      for (size_t i=r.begin(); i<r.end(); i++)
+      {
+        const unsigned int x = quantize((query.x[i]-bounds.lower.x)*scale.x);
+        const unsigned int y = quantize((query.y[i]-bounds.lower.y)*scale.y);
+        const unsigned int z = quantize((query.z[i]-bounds.lower.z)*scale.z);
+        keys[i] = (uint64_t(bitInterleave(x,y,z)) << 32) | uint64_t(i);
+      }
+    });
+
+    radix_sort_u64(keys,tmp,N);
+  }
+
+  RTC_API bool rtcPointQueryBatch (RTCScene hscene, const RTCPointQueryNp* query, unsigned int N, struct RTCPointQueryContext* userContext, RTCPointQueryFunction queryFunc, void** userPtrN)
+  {
+    Scene* scene = (Scene*) hscene;
+    RTC_CATCH_BEGIN;
+    RTC_TRACE(rtcPointQueryBatch);
+
+#if defined(DEBUG)
+    RTC_VERIFY_HANDLE(hscene);
+    RTC_VERIFY_HANDLE(query);
+    RTC_VERIFY_HANDLE(userContext);
+    if (scene->isModified()) throw_RTCError(RTC_ERROR_INVALID_OPERATION,"scene got not committed");
+    if (((size_t)userContext) & 0x0F) throw_RTCError(RTC_ERROR_INVALID_ARGUMENT, "context not aligned to 16 bytes");
+#endif
+    STAT(STAT3(point_query.travs,N,N,N));
+
+    if (N == 0) return false;
+    if (!query->x || !query->y || !query->z || !query->radius)
+      throw_RTCError(RTC_ERROR_INVALID_ARGUMENT, "query coordinates and radius are required");
+
+    /* queries close in space visit the same BVH nodes, thus we process them in Morton order */
+    mvector<uint64_t> keys(scene->device,N);
+    {
+      mvector<uint64_t> tmp(scene->device,N);
+      sortPointQueries(scene,*query,N,keys.data(),tmp.data());
+    }
+
+    std::atomic<bool> changed(false);
+    scene->device->execute(true, [&]()
+    {
+      parallel_for(size_t(0), size_t(N), size_t(256), [&](const range<size_t>& r)
+      {
+        /* instance traversal modifies the context, thus each task works on its own copy */
+        RTCPointQueryContext context;
+        TraversalStatistics::Sample sample(scene,TraversalStatistics::POINT_QUERY,r.size());
+        bool taskChanged = false;
+        for (size_t k=r.begin(); k<r.end(); k++)
+        {
+          const size_t i = size_t(unsigned(keys[k]));
+          RTCPointQuery query1;
+          query1.x = query->x[i];
+          query1.y = query->y[i];
+          query1.z = query->z[i];
+          query1.time = query->time ? query->time[i] : 0.0f;
+          query1.radius = query->radius[i];
+          context = *userContext;
+          if (pointQuery(scene, &query1, &context, queryFunc, userPtrN?userPtrN[i]:NULL)) {
+            query->radius[i] = query1.radius;
+            taskChanged = true;
+          }
+        }
+        if (taskChanged) changed = true;
+      });
+    });
+    return changed;
+    RTC_CATCH_END2_FALSE(scene);
+  }
+
   RTC_API void rtcIntersect1 (RTCScene hscene, RTCRayHit* rayhit, RTCIntersectArguments* args) 
   {
     Scene* scene = (Scene*) hscene;
@@ -533,7 +761,8 @@ RTC_NAMESPACE_BEGIN;
     if (scene->isModified()) throw_RTCError(RTC_ERROR_INVALID_OPERATION,"scene not committed");
     if (((size_t)rayhit) & 0x0F) throw_RTCError(RTC_ERROR_INVALID_ARGUMENT, "ray not aligned to 16 bytes");   
 #endif
-    STAT3(normal.travs,1,1,1);
+    STAT(STAT3(normal.travs,1,1,1));
+    TraversalStatistics::Sample sample(scene,TraversalStatistics::INTERSECT,1);
 
     RTCIntersectArguments defaultArgs;
     if (unlikely(args == nullptr)) {
@@ -574,7 +803,7 @@ RTC_NAMESPACE_BEGIN;
     const Vec3ff ray_dir_time = oray->dir;
     oray->org = iray->org;
     oray->dir = iray->dir;
-    STAT3(normal.travs,1,1,1);
+    STAT(STAT3(normal.travs,1,1,1));
 
     RTCIntersectArguments* iargs = ((IntersectFunctionNArguments*) args)->args;
     RayQueryContext context(scene,user_context,iargs);
@@ -602,7 +831,8 @@ RTC_NAMESPACE_BEGIN;
     if (((size_t)rayhit)   & 0x0F) throw_RTCError(RTC_ERROR_INVALID_ARGUMENT, "rayhit not aligned to 16 bytes");   
 #endif
     STAT(size_t cnt=0; for (size_t i=0; i<4; i++) cnt += ((int*)valid)[i] == -1;);
-    STAT3(normal.travs,cnt,cnt,cnt);
+    STAT(STAT3(normal.travs,cnt,cnt,cnt));
+    TraversalStatistics::Sample sample(scene,TraversalStatistics::INTERSECT,valid,4);
 
     RTCIntersectArguments defaultArgs;
     if (unlikely(args == nullptr)) {
@@ -684,7 +914,7 @@ RTC_NAMESPACE_BEGIN;
     copy<N>(oray->ray.dir_z,iray->dir_z);
     
     STAT(size_t cnt=0; for (size_t i=0; i<N; i++) cnt += ((int*)valid)[i] == -1;);
-    STAT3(normal.travs,cnt,cnt,cnt);
+    STAT(STAT3(normal.travs,cnt,cnt,cnt));
 
     RTCIntersectArguments* iargs = ((IntersectFunctionNArguments*) args)->args;
     RayQueryContext context(scene,user_context,iargs);
@@ -723,7 +953,8 @@ RTC_NAMESPACE_BEGIN;
     if (((size_t)rayhit)   & 0x1F) throw_RTCError(RTC_ERROR_INVALID_ARGUMENT, "rayhit not aligned to 32 bytes");   
 #endif
     STAT(size_t cnt=0; for (size_t i=0; i<8; i++) cnt += ((int*)valid)[i] == -1;);
-    STAT3(normal.travs,cnt,cnt,cnt);
+    STAT(STAT3(normal.travs,cnt,cnt,cnt));
+    TraversalStatistics::Sample sample(scene,TraversalStatistics::INTERSECT,valid,8);
 
     RTCIntersectArguments defaultArgs;
     if (unlikely(args == nullptr)) {
@@ -778,7 +1009,8 @@ RTC_NAMESPACE_BEGIN;
     if (((size_t)rayhit)   & 0x3F) throw_RTCError(RTC_ERROR_INVALID_ARGUMENT, "rayhit not aligned to 64 bytes");   
 #endif
     STAT(size_t cnt=0; for (size_t i=0; i<16; i++) cnt += ((int*)valid)[i] == -1;);
-    STAT3(normal.travs,cnt,cnt,cnt);
+    STAT(STAT3(normal.travs,cnt,cnt,cnt));
+    TraversalStatistics::Sample sample(scene,TraversalStatistics::INTERSECT,valid,16);
 
     RTCIntersectArguments defaultArgs;
     if (unlikely(args == nullptr)) {
@@ -810,6 +1042,122 @@ RTC_NAMESPACE_BEGIN;
     RTC_CATCH_END2(scene);
   }
 
+  RTC_API void rtcIntersect1M (RTCScene hscene, RTCRayHit* rayhit, unsigned int M, size_t byteStride, RTCIntersectArguments* args) 
+  {
+    Scene* scene = (Scene*) hscene;
+    RTC_CATCH_BEGIN;
+    RTC_TRACE(rtcIntersect1M);
+
+#if defined(DEBUG)
+    RTC_VERIFY_HANDLE(hscene);
+    if (scene->isModified()) throw_RTCError(RTC_ERROR_INVALID_OPERATION,"scene not committed");
+    if (((size_t)rayhit) & 0x0F) throw_RTCError(RTC_ERROR_INVALID_ARGUMENT, "rayhit not aligned to 16 bytes");   
+    if (byteStride & 0x0F) throw_RTCError(RTC_ERROR_INVALID_ARGUMENT, "stride not a multiple of 16 bytes");   
+#endif
+    STAT(STAT3(normal.travs,M,M,M));
+    TraversalStatistics::Sample sample(scene,TraversalStatistics::INTERSECT,M);
+
+    RTCIntersectArguments defaultArgs;
+    if (unlikely(args == nullptr)) {
+      rtcInitIntersectArguments(&defaultArgs);
+      args = &defaultArgs;
+    }
+    RTCRayQueryContext* user_context = args->context;
+    
+    RTCRayQueryContext defaultContext;
+    if (unlikely(user_context == nullptr)) {
+      rtcInitRayQueryContext(&defaultContext);
+      user_context = &defaultContext;
+    }
+    RayQueryContext context(scene,user_context,args);
+
+    RayStream::intersectAOS(scene,rayhit,M,byteStride,&context);
+    RTC_CATCH_END2(scene);
+  }
+
+  RTC_API void rtcIntersectNp (RTCScene hscene, const RTCRayHitNp* rayhit, unsigned int N, RTCIntersectArguments* args) 
+  {
+    Scene* scene = (Scene*) hscene;
+    RTC_CATCH_BEGIN;
+    RTC_TRACE(rtcIntersectNp);
+
+#if defined(DEBUG)
+    RTC_VERIFY_HANDLE(hscene);
+    if (scene->isModified()) throw_RTCError(RTC_ERROR_INVALID_OPERATION,"scene not committed");
+#endif
+    STAT(STAT3(normal.travs,N,N,N));
+    TraversalStatistics::Sample sample(scene,TraversalStatistics::INTERSECT,N);
+
+    RTCIntersectArguments defaultArgs;
+    if (unlikely(args == nullptr)) {
+      rtcInitIntersectArguments(&defaultArgs);
+      args = &defaultArgs;
+    }
+    RTCRayQueryContext* user_context = args->context;
+    
+    RTCRayQueryContext defaultContext;
+    if (unlikely(user_context == nullptr)) {
+      rtcInitRayQueryContext(&defaultContext);
+      user_context = &defaultContext;
+    }
+    RayQueryContext context(scene,user_context,args);
+
+    RayStream::intersectSOP(scene,*rayhit,N,&context);
+    RTC_CATCH_END2(scene);
+  }
+
+  RTC_API unsigned int rtcIntersect1Multi (RTCScene hscene, RTCRayHit* rayhit, RTCMultiHit* hits, unsigned int capacity, RTCIntersectArguments* args)
+  {
+    Scene* scene = (Scene*) hscene;
+    RTC_CATCH_BEGIN;
+    RTC_TRACE(rtcIntersect1Multi);
+#if defined(DEBUG)
+    RTC_VERIFY_HANDLE(hscene);
+    if (scene->isModified()) throw_RTCError(RTC_ERROR_INVALID_OPERATION,"scene not committed");
+    if (((size_t)rayhit) & 0x0F) throw_RTCError(RTC_ERROR_INVALID_ARGUMENT, "ray not aligned to 16 bytes");
+#endif
+#if !defined(EMBREE_FILTER_FUNCTION)
+    throw_RTCError(RTC_ERROR_INVALID_OPERATION,"multi-hit queries require EMBREE_FILTER_FUNCTION");
+#else
+    if (capacity == 0) throw_RTCError(RTC_ERROR_INVALID_ARGUMENT,"capacity has to be at least one");
+    if (hits == nullptr) throw_RTCError(RTC_ERROR_INVALID_ARGUMENT,"invalid hit array");
+    STAT(STAT3(normal.travs,1,1,1));
+    TraversalStatistics::Sample sample(scene,TraversalStatistics::INTERSECT,1);
+
+    /* the hit list gets passed to all hit recording places through the arguments */
+    MultiHitArguments margs;
+    if (unlikely(args == nullptr)) rtcInitIntersectArguments(&margs);
+    else (RTCIntersectArguments&) margs = *args;
+    margs.flags = (RTCRayQueryFlags) (margs.flags | RAY_QUERY_FLAG_MULTI_HIT);
+
+    RTCRayQueryContext* user_context = margs.context;
+
+    RTCRayQueryContext defaultContext;
+    if (unlikely(user_context == nullptr)) {
+      rtcInitRayQueryContext(&defaultContext);
+      user_context = &defaultContext;
+    }
+
+    MultiHitList list(hits,capacity,rayhit->ray.tfar);
+    margs.list = &list;
+    RayQueryContext context(scene,user_context,&margs);
+    scene->intersectors.intersect(*rayhit,&context);
+
+    /* the ray reports the closest hit */
+    rayhit->ray.tfar = list.tfar0;
+    if (list.size) {
+      rayhit->hit = hits[0].hit;
+      rayhit->ray.tfar = hits[0].tfar;
+    }
+#if defined(DEBUG)
+    ((RayHit*)rayhit)->verifyHit();
+#endif
+    return list.size;
+#endif
+    RTC_CATCH_END2(scene);
+    return 0;
+  }
+
   RTC_API void rtcForwardIntersect16 (const int* valid, const RTCIntersectFunctionNArguments* args, RTCScene hscene, RTCRay16* iray, unsigned int instID)
   {
     Scene* scene = (Scene*) hscene;
@@ -819,12 +1167,36 @@ RTC_NAMESPACE_BEGIN;
     RTC_CATCH_END2(scene);
   }
 
+  /* counts the rays of a packet that found an occluder */
+  static size_t countOccluded(const int* valid, const float* tfar, size_t K)
+  {
+    size_t cnt = 0;
+    for (size_t i=0; i<K; i++) cnt += valid[i] == -1 && tfar[i] == float(neg_inf);
+    return cnt;
+  }
+
+  /* counts the rays of a stream that found an occluder */
+  static size_t countOccluded(const RTCRay* ray, size_t M, size_t byteStride)
+  {
+    size_t cnt = 0;
+    for (size_t i=0; i<M; i++) cnt += ((const RTCRay*)((const char*)ray + i*byteStride))->tfar == float(neg_inf);
+    return cnt;
+  }
+
+  static size_t countOccluded(const float* tfar, size_t N)
+  {
+    size_t cnt = 0;
+    for (size_t i=0; i<N; i++) cnt += tfar[i] == float(neg_inf);
+    return cnt;
+  }
+
   RTC_API void rtcOccluded1 (RTCScene hscene, RTCRay* ray, RTCOccludedArguments* args) 
   {
     Scene* scene = (Scene*) hscene;
     RTC_CATCH_BEGIN;
     RTC_TRACE(rtcOccluded1);
-    STAT3(shadow.travs,1,1,1);
+    STAT(STAT3(shadow.travs,1,1,1));
+    TraversalStatistics::Sample sample(scene,TraversalStatistics::OCCLUDED,1);
 #if defined(DEBUG)
     RTC_VERIFY_HANDLE(hscene);
     if (scene->isModified()) throw_RTCError(RTC_ERROR_INVALID_OPERATION,"scene not committed");
@@ -846,6 +1218,7 @@ RTC_NAMESPACE_BEGIN;
     RayQueryContext context(scene,user_context,args);
     
     scene->intersectors.occluded(*ray,&context);
+    RSTAT(shadow.trav_early_outs,size_t(ray->tfar == float(neg_inf)));
     RTC_CATCH_END2(scene);
   }
 
@@ -854,7 +1227,7 @@ RTC_NAMESPACE_BEGIN;
     Scene* scene = (Scene*) hscene;
     RTC_CATCH_BEGIN;
     RTC_TRACE(rtcForwardOccluded1);
-    STAT3(shadow.travs,1,1,1);
+    STAT(STAT3(shadow.travs,1,1,1));
 #if defined(DEBUG)
     RTC_VERIFY_HANDLE(hscene);
     if (scene->isModified()) throw_RTCError(RTC_ERROR_INVALID_OPERATION,"scene not committed");
@@ -895,7 +1268,8 @@ RTC_NAMESPACE_BEGIN;
     if (((size_t)ray)   & 0x0F) throw_RTCError(RTC_ERROR_INVALID_ARGUMENT, "ray not aligned to 16 bytes");   
 #endif
     STAT(size_t cnt=0; for (size_t i=0; i<4; i++) cnt += ((int*)valid)[i] == -1;);
-    STAT3(shadow.travs,cnt,cnt,cnt);
+    STAT(STAT3(shadow.travs,cnt,cnt,cnt));
+    TraversalStatistics::Sample sample(scene,TraversalStatistics::OCCLUDED,valid,4);
 
     RTCOccludedArguments defaultArgs;
     if (unlikely(args == nullptr)) {
@@ -924,6 +1298,7 @@ RTC_NAMESPACE_BEGIN;
       }
     }
     
+    RSTAT(shadow.trav_early_outs,countOccluded(valid,ray->tfar,4));
     RTC_CATCH_END2(scene);
   }
 
@@ -956,7 +1331,7 @@ RTC_NAMESPACE_BEGIN;
     copy<N>(oray->dir_z,iray->dir_z);
     
     STAT(size_t cnt=0; for (size_t i=0; i<N; i++) cnt += ((int*)valid)[i] == -1;);
-    STAT3(normal.travs,cnt,cnt,cnt);
+    STAT(STAT3(normal.travs,cnt,cnt,cnt));
 
     RTCIntersectArguments* iargs = ((IntersectFunctionNArguments*) args)->args;
     RayQueryContext context(scene,user_context,iargs);
@@ -995,7 +1370,8 @@ RTC_NAMESPACE_BEGIN;
     if (((size_t)ray)   & 0x1F) throw_RTCError(RTC_ERROR_INVALID_ARGUMENT, "ray not aligned to 32 bytes");   
 #endif
     STAT(size_t cnt=0; for (size_t i=0; i<8; i++) cnt += ((int*)valid)[i] == -1;);
-    STAT3(shadow.travs,cnt,cnt,cnt);
+    STAT(STAT3(shadow.travs,cnt,cnt,cnt));
+    TraversalStatistics::Sample sample(scene,TraversalStatistics::OCCLUDED,valid,8);
 
     RTCOccludedArguments defaultArgs;
     if (unlikely(args == nullptr)) {
@@ -1024,6 +1400,7 @@ RTC_NAMESPACE_BEGIN;
       }
     }
 
+    RSTAT(shadow.trav_early_outs,countOccluded(valid,ray->tfar,8));
     RTC_CATCH_END2(scene);
   }
 
@@ -1049,7 +1426,8 @@ RTC_NAMESPACE_BEGIN;
     if (((size_t)ray)   & 0x3F) throw_RTCError(RTC_ERROR_INVALID_ARGUMENT, "ray not aligned to 64 bytes");   
 #endif
     STAT(size_t cnt=0; for (size_t i=0; i<16; i++) cnt += ((int*)valid)[i] == -1;);
-    STAT3(shadow.travs,cnt,cnt,cnt);
+    STAT(STAT3(shadow.travs,cnt,cnt,cnt));
+    TraversalStatistics::Sample sample(scene,TraversalStatistics::OCCLUDED,valid,16);
 
     RTCOccludedArguments defaultArgs;
     if (unlikely(args == nullptr)) {
@@ -1078,6 +1456,73 @@ RTC_NAMESPACE_BEGIN;
       }
     }
 
+    RSTAT(shadow.trav_early_outs,countOccluded(valid,ray->tfar,16));
+    RTC_CATCH_END2(scene);
+  }
+
+  RTC_API void rtcOccluded1M (RTCScene hscene, RTCRay* ray, unsigned int M, size_t byteStride, RTCOccludedArguments* args) 
+  {
+    Scene* scene = (Scene*) hscene;
+    RTC_CATCH_BEGIN;
+    RTC_TRACE(rtcOccluded1M);
+
+#if defined(DEBUG)
+    RTC_VERIFY_HANDLE(hscene);
+    if (scene->isModified()) throw_RTCError(RTC_ERROR_INVALID_OPERATION,"scene not committed");
+    if (((size_t)ray) & 0x0F) throw_RTCError(RTC_ERROR_INVALID_ARGUMENT, "ray not aligned to 16 bytes");   
+    if (byteStride & 0x0F) throw_RTCError(RTC_ERROR_INVALID_ARGUMENT, "stride not a multiple of 16 bytes");   
+#endif
+    STAT(STAT3(shadow.travs,M,M,M));
+    TraversalStatistics::Sample sample(scene,TraversalStatistics::OCCLUDED,M);
+
+    RTCOccludedArguments defaultArgs;
+    if (unlikely(args == nullptr)) {
+      rtcInitOccludedArguments(&defaultArgs);
+      args = &defaultArgs;
+    }
+    RTCRayQueryContext* user_context = args->context;
+    
+    RTCRayQueryContext defaultContext;
+    if (unlikely(user_context == nullptr)) {
+      rtcInitRayQueryContext(&defaultContext);
+      user_context = &defaultContext;
+    }
+    RayQueryContext context(scene,user_context,args);
+
+    RayStream::occludedAOS(scene,ray,M,byteStride,&context);
+    RSTAT(shadow.trav_early_outs,countOccluded(ray,M,byteStride));
+    RTC_CATCH_END2(scene);
+  }
+
+  RTC_API void rtcOccludedNp (RTCScene hscene, const RTCRayNp* ray, unsigned int N, RTCOccludedArguments* args) 
+  {
+    Scene* scene = (Scene*) hscene;
+    RTC_CATCH_BEGIN;
+    RTC_TRACE(rtcOccludedNp);
+
+#if defined(DEBUG)
+    RTC_VERIFY_HANDLE(hscene);
+    if (scene->isModified()) throw_RTCError(RTC_ERROR_INVALID_OPERATION,"scene not committed");
+#endif
+    STAT(STAT3(shadow.travs,N,N,N));
+    TraversalStatistics::Sample sample(scene,TraversalStatistics::OCCLUDED,N);
+
+    RTCOccludedArguments defaultArgs;
+    if (unlikely(args == nullptr)) {
+      rtcInitOccludedArguments(&defaultArgs);
+      args = &defaultArgs;
+    }
+    RTCRayQueryContext* user_context = args->context;
+    
+    RTCRayQueryContext defaultContext;
+    if (unlikely(user_context == nullptr)) {
+      rtcInitRayQueryContext(&defaultContext);
+      user_context = &defaultContext;
+    }
+    RayQueryContext context(scene,user_context,args);
+
+    RayStream::occludedSOP(scene,*ray,N,&context);
+    RSTAT(shadow.trav_early_outs,countOccluded(ray->tfar,N));
     RTC_CATCH_END2(scene);
   }
 
@@ -1683,6 +2128,22 @@ RTC_NAMESPACE_BEGIN;
     RTC_CATCH_END2(geometry);
   }
 
+  RTC_API void rtcSetGeometryTessellationCamera (RTCGeometry hgeometry, const float* position, float spreadAngle)
+  {
+    Geometry* geometry = (Geometry*) hgeometry;
+    RTC_CATCH_BEGIN;
+    RTC_TRACE(rtcSetGeometryTessellationCamera);
+    RTC_VERIFY_HANDLE(hgeometry);
+    RTC_ENTER_DEVICE(hgeometry);
+    if (position) {
+      const Vec3fa P(position[0],position[1],position[2]);
+      geometry->setTessellationCamera(&P,spreadAngle);
+    }
+    else
+      geometry->setTessellationCamera(nullptr,spreadAngle);
+    RTC_CATCH_END2(geometry);
+  }
+
   RTC_API void rtcSetGeometryUserData (RTCGeometry hgeometry, void* ptr) 
   {
     Geometry* geometry = (Geometry*) hgeometry;
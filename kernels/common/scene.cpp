@@ -10,6 +10,8 @@
 
 #include "../../common/algorithms/parallel_reduce.h"
 
+#include <fstream>
+
 #if defined(EMBREE_SYCL_SUPPORT)
 #  include "../sycl/rthwif_embree_builder.h"
 #endif
@@ -68,6 +70,7 @@ namespace embree
 
   Scene::~Scene() noexcept
   {
+    buildScratch.clear();
     device->refDec();
   }
   
@@ -123,13 +126,15 @@ namespace embree
 
     if (device->tri_accel == "default") 
     {
-      if (quality_flags != RTC_BUILD_QUALITY_LOW)
+      if (!isTwoLevelAccel())
       {	
         int mode =  2*(int)isCompactAccel() + 1*(int)isRobustAccel(); 
         switch (mode) {
         case /*0b00*/ 0: 
 #if defined (EMBREE_TARGET_SIMD8)
-          if (device->canUseAVX())
+          if (device->triangle_pairs && device->canUseAVX())
+            accels_add(device->bvh8_factory->BVH8TrianglePair4i(this));
+          else if (device->canUseAVX())
 	  {
             if (quality_flags == RTC_BUILD_QUALITY_HIGH) 
               accels_add(device->bvh8_factory->BVH8Triangle4(this,BVHFactory::BuildVariant::HIGH_QUALITY,BVHFactory::IntersectVariant::FAST));
@@ -138,6 +143,9 @@ namespace embree
           }
           else 
 #endif
+          if (device->triangle_pairs)
+            accels_add(device->bvh4_factory->BVH4TrianglePair4i(this));
+          else
           { 
             if (quality_flags == RTC_BUILD_QUALITY_HIGH) 
               accels_add(device->bvh4_factory->BVH4Triangle4(this,BVHFactory::BuildVariant::HIGH_QUALITY,BVHFactory::IntersectVariant::FAST));
@@ -155,8 +163,15 @@ namespace embree
             accels_add(device->bvh4_factory->BVH4Triangle4v(this,BVHFactory::BuildVariant::STATIC,BVHFactory::IntersectVariant::ROBUST));
 
           break;
-        case /*0b10*/ 2: accels_add(device->bvh4_factory->BVH4Triangle4i(this,BVHFactory::BuildVariant::STATIC,BVHFactory::IntersectVariant::FAST  )); break;
-        case /*0b11*/ 3: accels_add(device->bvh4_factory->BVH4Triangle4i(this,BVHFactory::BuildVariant::STATIC,BVHFactory::IntersectVariant::ROBUST)); break;
+        case /*0b10*/ 2:
+          if (device->quantized_leaves) accels_add(device->bvh4_factory->BVH4Triangle4q(this));
+          else if (device->triangle_pairs) accels_add(device->bvh4_factory->BVH4TrianglePair4i(this));
+          else accels_add(device->bvh4_factory->BVH4Triangle4i(this,BVHFactory::BuildVariant::STATIC,BVHFactory::IntersectVariant::FAST  ));
+          break;
+        case /*0b11*/ 3:
+          if (device->quantized_leaves) accels_add(device->bvh4_factory->BVH4Triangle4q(this));
+          else accels_add(device->bvh4_factory->BVH4Triangle4i(this,BVHFactory::BuildVariant::STATIC,BVHFactory::IntersectVariant::ROBUST));
+          break;
         }
       }
       else /* dynamic */
@@ -188,7 +203,9 @@ namespace embree
     else if (device->tri_accel == "bvh4.triangle4")       accels_add(device->bvh4_factory->BVH4Triangle4 (this));
     else if (device->tri_accel == "bvh4.triangle4v")      accels_add(device->bvh4_factory->BVH4Triangle4v(this));
     else if (device->tri_accel == "bvh4.triangle4i")      accels_add(device->bvh4_factory->BVH4Triangle4i(this));
+    else if (device->tri_accel == "bvh4.triangle4q")      accels_add(device->bvh4_factory->BVH4Triangle4q(this));
     else if (device->tri_accel == "qbvh4.triangle4i")     accels_add(device->bvh4_factory->BVH4QuantizedTriangle4i(this));
+    else if (device->tri_accel == "bvh4.trianglepair4i")  accels_add(device->bvh4_factory->BVH4TrianglePair4i(this));
 
 #if defined (EMBREE_TARGET_SIMD8)
     else if (device->tri_accel == "bvh8.triangle4")       accels_add(device->bvh8_factory->BVH8Triangle4 (this));
@@ -196,6 +213,8 @@ namespace embree
     else if (device->tri_accel == "bvh8.triangle4i")      accels_add(device->bvh8_factory->BVH8Triangle4i(this));
     else if (device->tri_accel == "qbvh8.triangle4i")     accels_add(device->bvh8_factory->BVH8QuantizedTriangle4i(this));
     else if (device->tri_accel == "qbvh8.triangle4")      accels_add(device->bvh8_factory->BVH8QuantizedTriangle4(this));
+    else if (device->tri_accel == "cbvh8.triangle4i")     accels_add(device->bvh8_factory->BVH8CompressedTriangle4i(this));
+    else if (device->tri_accel == "bvh8.trianglepair4i")  accels_add(device->bvh8_factory->BVH8TrianglePair4i(this));
 #endif
     else throw_RTCError(RTC_ERROR_INVALID_ARGUMENT,"unknown triangle acceleration structure "+device->tri_accel);
 #endif
@@ -247,7 +266,7 @@ namespace embree
     
     if (device->quad_accel == "default") 
     {
-      if (quality_flags != RTC_BUILD_QUALITY_LOW)
+      if (!isTwoLevelAccel())
       {
         /* static */
         int mode =  2*(int)isCompactAccel() + 1*(int)isRobustAccel(); 
@@ -459,7 +478,7 @@ namespace embree
 #if defined (EMBREE_TARGET_SIMD8)
       if (device->canUseAVX() && !isCompactAccel())
       {
-        if (quality_flags != RTC_BUILD_QUALITY_LOW) {
+        if (!isTwoLevelAccel()) {
           accels_add(device->bvh8_factory->BVH8UserGeometry(this,BVHFactory::BuildVariant::STATIC));
         } else {
           accels_add(device->bvh8_factory->BVH8UserGeometry(this,BVHFactory::BuildVariant::DYNAMIC));
@@ -468,7 +487,7 @@ namespace embree
       else
 #endif
       {
-        if (quality_flags != RTC_BUILD_QUALITY_LOW) {
+        if (!isTwoLevelAccel()) {
           accels_add(device->bvh4_factory->BVH4UserGeometry(this,BVHFactory::BuildVariant::STATIC));
         } else {
           accels_add(device->bvh4_factory->BVH4UserGeometry(this,BVHFactory::BuildVariant::DYNAMIC));
@@ -511,7 +530,7 @@ namespace embree
     {
 #if defined (EMBREE_TARGET_SIMD8)
       if (device->canUseAVX() && !isCompactAccel()) {
-        if (quality_flags != RTC_BUILD_QUALITY_LOW) {
+        if (!isTwoLevelAccel()) {
           accels_add(device->bvh8_factory->BVH8Instance(this, false, BVHFactory::BuildVariant::STATIC));
         } else {
           accels_add(device->bvh8_factory->BVH8Instance(this, false, BVHFactory::BuildVariant::DYNAMIC));
@@ -520,7 +539,7 @@ namespace embree
       else
 #endif
       {
-        if (quality_flags != RTC_BUILD_QUALITY_LOW) {
+        if (!isTwoLevelAccel()) {
           accels_add(device->bvh4_factory->BVH4Instance(this, false, BVHFactory::BuildVariant::STATIC));
         } else {
           accels_add(device->bvh4_factory->BVH4Instance(this, false, BVHFactory::BuildVariant::DYNAMIC));
@@ -555,7 +574,7 @@ namespace embree
     {
 #if defined (EMBREE_TARGET_SIMD8)
       if (device->canUseAVX() && !isCompactAccel()) {
-        if (quality_flags != RTC_BUILD_QUALITY_LOW) {
+        if (!isTwoLevelAccel()) {
           accels_add(device->bvh8_factory->BVH8Instance(this, true, BVHFactory::BuildVariant::STATIC));
         } else {
           accels_add(device->bvh8_factory->BVH8Instance(this, true, BVHFactory::BuildVariant::DYNAMIC));
@@ -564,7 +583,7 @@ namespace embree
       else
 #endif
       {
-        if (quality_flags != RTC_BUILD_QUALITY_LOW) {
+        if (!isTwoLevelAccel()) {
           accels_add(device->bvh4_factory->BVH4Instance(this, true, BVHFactory::BuildVariant::STATIC));
         } else {
           accels_add(device->bvh4_factory->BVH4Instance(this, true, BVHFactory::BuildVariant::DYNAMIC));
@@ -696,22 +715,29 @@ namespace embree
           geometryModCounters_[i] = 0;
         });
 
-      if (getNumPrimitives(TriangleMesh::geom_type,false)) createTriangleAccel();
-      if (getNumPrimitives(TriangleMesh::geom_type,true)) createTriangleMBAccel();
-      if (getNumPrimitives(QuadMesh::geom_type,false)) createQuadAccel();
-      if (getNumPrimitives(QuadMesh::geom_type,true)) createQuadMBAccel();
-      if (getNumPrimitives(GridMesh::geom_type,false)) createGridAccel();
-      if (getNumPrimitives(GridMesh::geom_type,true)) createGridMBAccel();
-      if (getNumPrimitives(SubdivMesh::geom_type,false)) createSubdivAccel();
-      if (getNumPrimitives(SubdivMesh::geom_type,true)) createSubdivMBAccel();
-      if (getNumPrimitives(Geometry::MTY_CURVES,false)) createHairAccel();
-      if (getNumPrimitives(Geometry::MTY_CURVES,true)) createHairMBAccel();
-      if (getNumPrimitives(UserGeometry::geom_type,false)) createUserGeometryAccel();
-      if (getNumPrimitives(UserGeometry::geom_type,true)) createUserGeometryMBAccel();      
-      if (getNumPrimitives(Geometry::MTY_INSTANCE_CHEAP,false)) createInstanceAccel();
-      if (getNumPrimitives(Geometry::MTY_INSTANCE_CHEAP,true)) createInstanceMBAccel();
-      if (getNumPrimitives(Geometry::MTY_INSTANCE_EXPENSIVE,false)) createInstanceExpensiveAccel();
-      if (getNumPrimitives(Geometry::MTY_INSTANCE_EXPENSIVE,true)) createInstanceExpensiveMBAccel();
+      /* the ray query features required to traverse an accel let ray queries skip accels of disabled features */
+      auto create = [&] (void (Scene::*createAccel)(), int accelFeatures) {
+        const size_t begin = accels.size();
+        (this->*createAccel)();
+        accels_set_features(begin,RTCFeatureFlags(accelFeatures));
+      };
+
+      if (getNumPrimitives(TriangleMesh::geom_type,false)) create(&Scene::createTriangleAccel, RTC_FEATURE_FLAG_TRIANGLE);
+      if (getNumPrimitives(TriangleMesh::geom_type,true)) create(&Scene::createTriangleMBAccel, RTC_FEATURE_FLAG_TRIANGLE | RTC_FEATURE_FLAG_MOTION_BLUR);
+      if (getNumPrimitives(QuadMesh::geom_type,false)) create(&Scene::createQuadAccel, RTC_FEATURE_FLAG_QUAD);
+      if (getNumPrimitives(QuadMesh::geom_type,true)) create(&Scene::createQuadMBAccel, RTC_FEATURE_FLAG_QUAD | RTC_FEATURE_FLAG_MOTION_BLUR);
+      if (getNumPrimitives(GridMesh::geom_type,false)) create(&Scene::createGridAccel, RTC_FEATURE_FLAG_GRID);
+      if (getNumPrimitives(GridMesh::geom_type,true)) create(&Scene::createGridMBAccel, RTC_FEATURE_FLAG_GRID | RTC_FEATURE_FLAG_MOTION_BLUR);
+      if (getNumPrimitives(SubdivMesh::geom_type,false)) create(&Scene::createSubdivAccel, RTC_FEATURE_FLAG_SUBDIVISION);
+      if (getNumPrimitives(SubdivMesh::geom_type,true)) create(&Scene::createSubdivMBAccel, RTC_FEATURE_FLAG_SUBDIVISION | RTC_FEATURE_FLAG_MOTION_BLUR);
+      if (getNumPrimitives(Geometry::MTY_CURVES,false)) create(&Scene::createHairAccel, RTC_FEATURE_FLAG_CURVES | RTC_FEATURE_FLAG_POINT);
+      if (getNumPrimitives(Geometry::MTY_CURVES,true)) create(&Scene::createHairMBAccel, RTC_FEATURE_FLAG_CURVES | RTC_FEATURE_FLAG_POINT | RTC_FEATURE_FLAG_MOTION_BLUR);
+      if (getNumPrimitives(UserGeometry::geom_type,false)) create(&Scene::createUserGeometryAccel, RTC_FEATURE_FLAG_USER_GEOMETRY);
+      if (getNumPrimitives(UserGeometry::geom_type,true)) create(&Scene::createUserGeometryMBAccel, RTC_FEATURE_FLAG_USER_GEOMETRY | RTC_FEATURE_FLAG_MOTION_BLUR);
+      if (getNumPrimitives(Geometry::MTY_INSTANCE_CHEAP,false)) create(&Scene::createInstanceAccel, RTC_FEATURE_FLAG_INSTANCE);
+      if (getNumPrimitives(Geometry::MTY_INSTANCE_CHEAP,true)) create(&Scene::createInstanceMBAccel, RTC_FEATURE_FLAG_INSTANCE | RTC_FEATURE_FLAG_MOTION_BLUR);
+      if (getNumPrimitives(Geometry::MTY_INSTANCE_EXPENSIVE,false)) create(&Scene::createInstanceExpensiveAccel, RTC_FEATURE_FLAG_INSTANCE);
+      if (getNumPrimitives(Geometry::MTY_INSTANCE_EXPENSIVE,true)) create(&Scene::createInstanceExpensiveMBAccel, RTC_FEATURE_FLAG_INSTANCE | RTC_FEATURE_FLAG_MOTION_BLUR);
 
       flags_modified = false;
       enabled_geometry_types = new_enabled_geometry_types;
@@ -720,8 +746,11 @@ namespace embree
     /* select fast code path if no filter function is present */
     accels_select(hasFilterFunction());
   
-    /* build all hierarchies of this scene */
-    accels_build();
+    /* build all hierarchies of this scene, or map them from a scene file */
+    if (load_filename.empty())
+      accels_build();
+    else
+      load_cpu_accels(load_filename);
 
     /* make static geometry immutable */
     if (!isDynamicAccel()) {
@@ -796,6 +825,110 @@ namespace embree
     setModified(false);
   }
 
+  /*! header of scene files written by rtcSaveScene */
+  struct SceneFileHeader
+  {
+    char magic[8];          //!< file marker "EMBSCN"
+    unsigned int version;   //!< version of file layout
+    unsigned int numAccels; //!< number of acceleration structures stored
+    uint64_t signature;     //!< signature of the geometries the file got created for
+  };
+  
+  static const unsigned int sceneFileVersion = 1;
+  
+  size_t Scene::signature() const
+  {
+    /* FNV-1a hash over all properties that influence acceleration structure layout */
+    uint64_t hash = 0xcbf29ce484222325ull;
+    auto add = [&] (uint64_t v) {
+      for (size_t i=0; i<8; i++) {
+        hash ^= (v >> (8*i)) & 0xFF;
+        hash *= 0x100000001b3ull;
+      }
+    };
+    add(scene_flags);
+    add(quality_flags);
+    add(geometries.size());
+    for (size_t i=0; i<geometries.size(); i++)
+    {
+      const Geometry* geom = geometries[i].ptr;
+      if (geom == nullptr) { add(-1); continue; }
+      add(geom->getType());
+      add(geom->isEnabled());
+      add(geom->size());
+      add(geom->numTimeSteps);
+    }
+    return size_t(hash);
+  }
+
+  void Scene::save(const std::string& fileName)
+  {
+    Lock<MutexSys> lock(buildMutex);
+    
+#if defined(EMBREE_SYCL_SUPPORT)
+    if (dynamic_cast<DeviceGPU*>(device))
+      throw_RTCError(RTC_ERROR_INVALID_OPERATION,"scene serialization not supported on GPU devices");
+#endif
+
+    if (isModified())
+      throw_RTCError(RTC_ERROR_INVALID_OPERATION,"scene not committed");
+    
+    std::ofstream stream(fileName.c_str(),std::ios::binary);
+    if (!stream)
+      throw_RTCError(RTC_ERROR_INVALID_OPERATION,"cannot open file " + fileName);
+
+    SceneFileHeader header;
+    memset(&header,0,sizeof(header));
+    strncpy(header.magic,"EMBSCN",sizeof(header.magic)-1);
+    header.version = sceneFileVersion;
+    header.numAccels = (unsigned int) accels.size();
+    header.signature = signature();
+    stream.write((const char*)&header,sizeof(header));
+    
+    accels_save(stream);
+    
+    if (!stream)
+      throw_RTCError(RTC_ERROR_UNKNOWN,"error writing file " + fileName);
+  }
+
+  void Scene::load(const std::string& fileName)
+  {
+#if defined(EMBREE_SYCL_SUPPORT)
+    if (dynamic_cast<DeviceGPU*>(device))
+      throw_RTCError(RTC_ERROR_INVALID_OPERATION,"scene serialization not supported on GPU devices");
+#endif
+
+    /* loading always commits, even if the scene did not change */
+    load_filename = fileName;
+    setModified();
+    try {
+      commit(false);
+    }
+    catch (...) {
+      load_filename.clear();
+      throw;
+    }
+    load_filename.clear();
+  }
+
+  void Scene::load_cpu_accels(const std::string& fileName)
+  {
+    std::ifstream stream(fileName.c_str(),std::ios::binary);
+    if (!stream)
+      throw_RTCError(RTC_ERROR_INVALID_OPERATION,"cannot open file " + fileName);
+
+    SceneFileHeader header;
+    stream.read((char*)&header,sizeof(header));
+    if (!stream || strncmp(header.magic,"EMBSCN",sizeof(header.magic)) != 0)
+      throw_RTCError(RTC_ERROR_INVALID_OPERATION,"invalid scene file " + fileName);
+    if (header.version != sceneFileVersion)
+      throw_RTCError(RTC_ERROR_INVALID_OPERATION,"unsupported scene file version");
+    if (header.numAccels != accels.size() || header.signature != signature())
+      throw_RTCError(RTC_ERROR_INVALID_OPERATION,"scene file does not match geometries of scene");
+
+    accels_load(fileName,sizeof(header));
+  }
+
   void Scene::setBuildQuality(RTCBuildQuality quality_flags_i)
   {
     if (quality_flags == quality_flags_i) return;
@@ -812,6 +945,10 @@ namespace embree
     if (scene_flags == scene_flags_i) return;
     scene_flags = scene_flags_i;
     flags_modified = true;
+
+    /* release the kept builder arrays as soon as the application no longer wants them */
+    if (!hasPersistentBuildMemory())
+      buildScratch.clear();
   }
 
   RTCSceneFlags Scene::getSceneFlags() const {
@@ -19,6 +19,7 @@
 
 #include "acceln.h"
 #include "geometry.h"
+#include "buildscratch.h"
 
 #if defined(EMBREE_SYCL_SUPPORT)
 #include "../sycl/rthwif_embree_builder.h"
@@ -189,6 +190,18 @@ namespace embree
     void commit_task ();
     void build () {}
 
+    /*! writes the acceleration structures of the committed scene to a file */
+    void save (const std::string& fileName);
+
+    /*! commits the scene by mapping previously saved acceleration structures */
+    void load (const std::string& fileName);
+
+  private:
+    size_t signature() const;
+    void load_cpu_accels (const std::string& fileName);
+
+  public:
+
     /* return number of geometries */
     __forceinline size_t size() const { return geometries.size(); }
     
@@ -253,6 +266,11 @@ namespace embree
     __forceinline bool isRobustAccel()  const { return scene_flags & RTC_SCENE_FLAG_ROBUST; }
     __forceinline bool isStaticAccel()  const { return !(scene_flags & RTC_SCENE_FLAG_DYNAMIC); }
     __forceinline bool isDynamicAccel() const { return scene_flags & RTC_SCENE_FLAG_DYNAMIC; }
+    __forceinline bool hasPersistentBuildMemory() const { return scene_flags & RTC_SCENE_FLAG_PERSISTENT_BUILD_MEMORY; }
+
+    /* quality decoding, low and refit quality use two level acceleration structures */
+    __forceinline bool isTwoLevelAccel() const { return quality_flags == RTC_BUILD_QUALITY_LOW || quality_flags == RTC_BUILD_QUALITY_REFIT; }
+    __forceinline bool isIncrementalAccel() const { return quality_flags == RTC_BUILD_QUALITY_REFIT && isDynamicAccel(); }
     
     __forceinline bool hasArgumentFilterFunction() const {
       return scene_flags & RTC_SCENE_FLAG_FILTER_FUNCTION_IN_ARGUMENTS;
@@ -295,6 +313,7 @@ namespace embree
     
   private:
     bool modified;                   //!< true if scene got modified
+    std::string load_filename;       //!< file to load acceleration structures from during commit
 
   public:
 
@@ -315,6 +334,23 @@ namespace embree
     void progressMonitor(double nprims);
     void setProgressMonitorFunction(RTCProgressMonitorFunction func, void* ptr);
 
+  public:
+    /*! fetches a builder array kept from a previous commit */
+    template<typename T>
+    __forceinline void acquireBuildScratch(mvector<T>& array, size_t numItems) {
+      if (hasPersistentBuildMemory()) buildScratch.acquire(array,numItems);
+    }
+
+    /*! keeps a builder array for the next commit or frees it */
+    template<typename T>
+    __forceinline void releaseBuildScratch(mvector<T>& array) {
+      if (hasPersistentBuildMemory()) buildScratch.release(array);
+      else array.clear();
+    }
+
+    BuildScratch buildScratch;          //!< builder arrays kept between commits
+    TraversalStatistics traversalStatistics; //!< statistics of sampled queries
+
   private:
     GeometryCounts world;               //!< counts for geometry
 
@@ -33,6 +33,9 @@ namespace embree
     : Geometry(device,GTY_SUBDIV_MESH,0,1), 
       displFunc(nullptr),
       tessellationRate(2.0f),
+      adaptiveTessellation(false),
+      tessellationCamera(zero),
+      tessellationSpreadAngle(0.0f),
       numHalfEdges(0),
       faceStartEdge(device,0),
       halfEdgeFace(device,0),
@@ -376,6 +379,43 @@ namespace embree
     levels.setModified();
   }
 
+  void SubdivMesh::setTessellationCamera(const Vec3fa* position, float spreadAngle)
+  {
+    if (position && !(spreadAngle > 0.0f))
+      throw_RTCError(RTC_ERROR_INVALID_ARGUMENT,"invalid spread angle");
+
+    adaptiveTessellation = position != nullptr;
+    tessellationCamera = position ? *position : Vec3fa(zero);
+    tessellationSpreadAngle = position ? spreadAngle : 0.0f;
+    levels.setModified();
+  }
+
+  float SubdivMesh::getAdaptiveEdgeLevel(const size_t i) const
+  {
+    /* find end vertex of the edge */
+    const unsigned int f = halfEdgeFace[i];
+    const size_t e0 = faceStartEdge[f];
+    const size_t j = i+1 < e0+faceVertices[f] ? i+1 : e0;
+    const unsigned int v0 = topology[0].vertexIndices[i];
+    const unsigned int v1 = topology[0].vertexIndices[j];
+    if (v0 >= numVertices() || v1 >= numVertices())
+      return float(inf);
+
+    /* both half edges of an edge get the same level as the level
+     * only depends on the edge end points, thus no cracks occur */
+    const Vec3fa p0 = vertices[0][v0];
+    const Vec3fa p1 = vertices[0][v1];
+    const float len = distance(p0,p1);
+    const float dist = distance(0.5f*(p0+p1),tessellationCamera);
+    const float footprint = max(tessellationSpreadAngle*dist,1E-6f*len);
+    const float level = len/footprint;
+
+    /* round up to powers of two, such that small camera movements keep the levels */
+    float level2 = 1.0f;
+    while (level2 < level && level2 < 4096.0f) level2 *= 2.0f;
+    return level2;
+  }
+
   __forceinline uint64_t pair64(unsigned int x, unsigned int y) 
   {
     if (x<y) std::swap(x,y);
@@ -579,7 +619,7 @@ namespace embree
     /* calculate which data to update */
     const bool updateEdgeCreases   = mesh->topology[0].vertexIndices.isLocalModified() || mesh->edge_creases.isLocalModified()   || mesh->edge_crease_weights.isLocalModified();
     const bool updateVertexCreases = mesh->topology[0].vertexIndices.isLocalModified() || mesh->vertex_creases.isLocalModified() || mesh->vertex_crease_weights.isLocalModified(); 
-    const bool updateLevels = mesh->levels.isLocalModified();
+    const bool updateLevels = mesh->levels.isLocalModified() || (mesh->adaptiveTessellation && mesh->vertices[0].isLocalModified());
 
     /* parallel loop over all half edges */
     parallel_for( size_t(0), mesh->numHalfEdges, size_t(4096), [&](const range<size_t>& r) 
@@ -647,6 +687,7 @@ namespace embree
     update |= mesh->vertex_creases.isLocalModified();
     update |= mesh->vertex_crease_weights.isLocalModified(); 
     update |= mesh->levels.isLocalModified();
+    update |= mesh->adaptiveTessellation && mesh->vertices[0].isLocalModified();
 
     /* now either recalculate or update the half edges */
     if (recalculate) calculateHalfEdges();
@@ -882,7 +923,7 @@ namespace embree
       for (unsigned int i=0; i<valueCount; i+=4)
       {
         vfloat4 Pt, dPdut, dPdvt, ddPdudut, ddPdvdvt, ddPdudvt;
-        isa::PatchEval<vfloat4,vfloat4>(baseEntry->at(interpolationSlot(primID,i/4,stride)),commitCounter,
+        isa::PatchEval<vfloat4,vfloat4>(*device->tessellationCache,baseEntry->at(interpolationSlot(primID,i/4,stride)),commitCounter,
                                         topo->getHalfEdge(primID),src+i*sizeof(float),stride,u,v,
                                         has_P ? &Pt : nullptr, 
                                         has_dP ? &dPdut : nullptr, 
@@ -969,7 +1010,7 @@ namespace embree
                          for (unsigned int j=0; j<valueCount; j+=4) 
                          {
                            const size_t M = min(4u,valueCount-j);
-                           isa::PatchEvalSimd<vbool4,vint4,vfloat4,vfloat4>(baseEntry->at(interpolationSlot(primID,j/4,stride)),commitCounter,
+                           isa::PatchEvalSimd<vbool4,vint4,vfloat4,vfloat4>(*device->tessellationCache,baseEntry->at(interpolationSlot(primID,j/4,stride)),commitCounter,
                                                                             topo->getHalfEdge(primID),src+j*sizeof(float),stride,valid1,uu,vv,
                                                                             P ? P+j*N+i : nullptr,
                                                                             dPdu ? dPdu+j*N+i : nullptr,
@@ -64,6 +64,7 @@ namespace embree
     void* getBuffer(RTCBufferType type, unsigned int slot);
     void updateBuffer(RTCBufferType type, unsigned int slot);
     void setTessellationRate(float N);
+    void setTessellationCamera(const Vec3fa* position, float spreadAngle);
     bool verify();
     void commit();
     void addElementsToCount (GeometryCounts & counts) const;
@@ -122,10 +123,14 @@ namespace embree
     /* returns tessellation level of edge */
     __forceinline float getEdgeLevel(const size_t i) const
     {
-      if (levels) return clamp(levels[i],1.0f,4096.0f); // FIXME: do we want to limit edge level?
-      else return clamp(tessellationRate,1.0f,4096.0f); // FIXME: do we want to limit edge level?
+      float level = levels ? levels[i] : tessellationRate;
+      if (adaptiveTessellation) level = min(level,getAdaptiveEdgeLevel(i));
+      return clamp(level,1.0f,4096.0f); // FIXME: do we want to limit edge level?
     }
 
+    /* returns the tessellation level of an edge that matches the ray footprint at the edge */
+    float getAdaptiveEdgeLevel(const size_t i) const;
+
   public:
     RTCDisplacementFunctionN displFunc;    //!< displacement function
 
@@ -259,6 +264,11 @@ namespace embree
     BufferView<float> levels;
     float tessellationRate;  // constant rate that is used when levels is not set
 
+    /*! camera used to reduce the tessellation level of edges with a large ray footprint */
+    bool adaptiveTessellation;
+    Vec3fa tessellationCamera;      // camera position in the space of the vertices
+    float tessellationSpreadAngle;  // ray footprint per unit distance from the camera
+
     /*! buffer that marks specific faces as holes */
     BufferView<unsigned> holes;
 
@@ -116,6 +116,16 @@ namespace embree
     size_t mask;
   };
 
+  /*! An item on the stack holds the node ID, distance and range of active ray packets. */
+  template<typename T>
+  struct __aligned(16) StackItemRangeT
+  {
+    T ptr;
+    float dist;
+    unsigned short first;
+    unsigned short last;
+  };
+
   struct __aligned(8) StackItemMaskCoherent
   {
     size_t mask;
@@ -2,6 +2,7 @@
 // SPDX-License-Identifier: Apache-2.0
 
 #include "stat.h"
+#include "scene.h"
 
 namespace embree
 {
@@ -125,4 +126,133 @@ namespace embree
     cout << "#user7/user3 " << 100.0f*float(cntrs.user[7])/float(cntrs.user[3]) << "%" << std::endl;
     cout << std::endl;
   }
+
+  std::atomic<size_t> TraversalStatistics::numEnabled(0);
+
+  /* counters of the API call currently sampled by this thread */
+  static __thread TraversalStatistics::Counters thread_traversal_counters_data;
+  static __thread TraversalStatistics::Counters* thread_traversal_counters = nullptr;
+
+  /* number of API calls this thread made since its last sample */
+  static __thread size_t thread_traversal_calls = 0;
+
+  TraversalStatistics::Counters* TraversalStatistics::current() {
+    return thread_traversal_counters;
+  }
+
+  void TraversalStatistics::enable() {
+    numEnabled++;
+  }
+
+  void TraversalStatistics::disable() {
+    numEnabled--;
+  }
+
+  void TraversalStatistics::Sample::begin(Scene* scene, QueryType type, size_t numQueries)
+  {
+    const size_t rate = scene->device->traversal_statistics_sample_rate;
+    if (rate == 0) return;
+
+    /* queries issued from inside a sampled call, e.g. from a user geometry, belong to that call */
+    if (thread_traversal_counters) return;
+    
+    if (++thread_traversal_calls < rate) return;
+    thread_traversal_calls = 0;
+
+    memset(&thread_traversal_counters_data,0,sizeof(TraversalStatistics::Counters));
+    this->scene = scene;
+    this->type = type;
+    this->numQueries = numQueries;
+    thread_traversal_counters = &thread_traversal_counters_data;
+  }
+
+  void TraversalStatistics::Sample::end()
+  {
+    const Counters& counters = thread_traversal_counters_data;
+    thread_traversal_counters = nullptr;
+    TraversalStatistics& stats = scene->traversalStatistics;
+    switch (type) {
+    case INTERSECT  : stats.intersect  .add(numQueries,counters.normal); break;
+    case OCCLUDED   : stats.occluded   .add(numQueries,counters.shadow); break;
+    case POINT_QUERY: stats.point_query.add(numQueries,counters.point_query); break;
+    }
+  }
+
+  void TraversalStatistics::Totals::clear()
+  {
+    queries.store(0);
+    nodes.store(0);
+    leaves.store(0);
+    primitives.store(0);
+    filters.store(0);
+    instances.store(0);
+    early_outs.store(0);
+  }
+
+  void TraversalStatistics::Totals::add(size_t numQueries, const Counters::Data& data)
+  {
+    queries    += numQueries;
+    nodes      += data.trav_nodes;
+    leaves     += data.trav_leaves;
+    primitives += data.trav_prims;
+    filters    += data.trav_filters;
+    instances  += data.trav_xfm_nodes;
+    early_outs += data.trav_early_outs;
+  }
+
+  void TraversalStatistics::Totals::get(RTCTraversalStatistics& stats) const
+  {
+    stats.queries    = queries;
+    stats.nodes      = nodes;
+    stats.leaves     = leaves;
+    stats.primitives = primitives;
+    stats.filters    = filters;
+    stats.instances  = instances;
+    stats.earlyOuts  = early_outs;
+  }
+
+  void TraversalStatistics::clear()
+  {
+    intersect.clear();
+    occluded.clear();
+    point_query.clear();
+  }
+
+  void TraversalStatistics::get(RTCSceneStatistics& stats) const
+  {
+    intersect.get(stats.intersect);
+    occluded.get(stats.occluded);
+    point_query.get(stats.pointQuery);
+  }
+
+  void BuildStatistics::clear()
+  {
+    builder = "";
+    for (size_t i=0; i<NUM_PHASES; i++)
+      nanoseconds[i] = 0;
+  }
+
+  void BuildStatistics::add(const BuildStatistics& other)
+  {
+    /* the total time of the other build is part of our total time */
+    for (size_t i=0; i<TOTAL; i++)
+      nanoseconds[i] += other.nanoseconds[i].load();
+  }
+
+  double BuildStatistics::get(Phase phase) const {
+    return 1E-9*double(nanoseconds[phase].load());
+  }
+
+  void BuildStatistics::get(RTCBuildStatistics& stats) const
+  {
+    stats.builder = builder.c_str();
+    stats.total = get(TOTAL);
+    stats.primRefs = get(PRIMREFS);
+    stats.presplits = get(PRESPLITS);
+    stats.binning = get(BINNING);
+    stats.partitioning = get(PARTITIONING);
+    stats.leaves = get(LEAVES);
+    stats.allocator = get(ALLOCATOR);
+    stats.topLevel = get(TOPLEVEL);
+  }
 }
@@ -4,6 +4,19 @@
 #pragma once
 
 #include "default.h"
+#include "rtcore.h"
+
+/* Macro to gather the traversal statistics of sampled queries at runtime */
+#if defined(__SYCL_DEVICE_ONLY__)
+#  define RSTAT(s,x)
+#else
+#  define RSTAT(s,x) {                                                  \
+    if (unlikely(TraversalStatistics::enabled())) {                     \
+      TraversalStatistics::Counters* rstat_cntrs = TraversalStatistics::current(); \
+      if (rstat_cntrs) rstat_cntrs->s += (x);                            \
+    }                                                                   \
+  }
+#endif
 
 /* Macros to gather statistics */
 #ifdef EMBREE_STAT_COUNTERS
@@ -11,11 +24,12 @@
 #  define STAT3(s,x,y,z) \
   STAT(Stat::get().code  .s+=x);               \
   STAT(Stat::get().active.s+=y);               \
-  STAT(Stat::get().all   .s+=z);
+  STAT(Stat::get().all   .s+=z);               \
+  RSTAT(s,x);
 #  define STAT_USER(i,x) Stat::get().user[i]+=x;
 #else
 #  define STAT(x)
-#  define STAT3(s,x,y,z)
+#  define STAT3(s,x,y,z) RSTAT(s,x)
 #  define STAT_USER(i,x) 
 #endif
 
@@ -76,6 +90,7 @@ namespace embree
               trav_stack_pop.store(0);
               trav_stack_nodes.store(0); 
               trav_xfm_nodes.store(0); 
+              trav_filters.store(0);
             }
 
           public:
@@ -88,6 +103,7 @@ namespace embree
 	    std::atomic<size_t> trav_stack_pop;
 	    std::atomic<size_t> trav_stack_nodes; 
             std::atomic<size_t> trav_xfm_nodes; 
+            std::atomic<size_t> trav_filters;
             
 	  } normal, shadow, point_query;
 	} all, active, code; 
@@ -113,4 +129,173 @@ namespace embree
   private:
     static Stat instance;
   };
+
+  class Scene;
+
+  /*! Gathers the traversal statistics of a sampled subset of all
+   *  queries at runtime. The traversal kernels count into per thread
+   *  counters through the STAT3 macro, which costs a single well
+   *  predicted branch while no device samples queries. At the end of
+   *  a sampled API call the counters get accumulated into the scene. */
+  class TraversalStatistics
+  {
+  public:
+
+    enum QueryType { INTERSECT = 0, OCCLUDED = 1, POINT_QUERY = 2 };
+
+    /*! per thread counters of the currently sampled API call */
+    struct Counters
+    {
+      struct Data
+      {
+        size_t travs;
+        size_t trav_nodes;
+        size_t trav_leaves;
+        size_t trav_prims;
+        size_t trav_xfm_nodes;
+        size_t trav_filters;
+        size_t trav_early_outs;
+        size_t trav_hit_boxes[Stat::SIZE_HISTOGRAM+1];
+      } normal, shadow, point_query;
+    };
+
+    /*! samples the traversal statistics of one API call */
+    class Sample
+    {
+    public:
+      __forceinline Sample (Scene* scene, QueryType type, size_t numQueries)
+        : scene(nullptr)
+      {
+        if (unlikely(enabled()))
+          begin(scene,type,numQueries);
+      }
+
+      __forceinline Sample (Scene* scene, QueryType type, const int* valid, size_t K)
+        : scene(nullptr)
+      {
+        if (unlikely(enabled())) {
+          size_t numQueries = 0;
+          for (size_t i=0; i<K; i++) numQueries += valid[i] == -1;
+          begin(scene,type,numQueries);
+        }
+      }
+
+      __forceinline ~Sample () {
+        if (unlikely(scene)) end();
+      }
+
+    private:
+      void begin(Scene* scene, QueryType type, size_t numQueries);
+      void end();
+
+    private:
+      Scene* scene;
+      QueryType type;
+      size_t numQueries;
+    };
+
+    /*! accumulated statistics of one query type */
+    struct Totals
+    {
+      void clear();
+      void add(size_t numQueries, const Counters::Data& data);
+      void get(RTCTraversalStatistics& stats) const;
+
+      std::atomic<size_t> queries;
+      std::atomic<size_t> nodes;
+      std::atomic<size_t> leaves;
+      std::atomic<size_t> primitives;
+      std::atomic<size_t> filters;
+      std::atomic<size_t> instances;
+      std::atomic<size_t> early_outs;
+    };
+
+  public:
+
+    TraversalStatistics () {
+      clear();
+    }
+
+    /*! resets the statistics of the scene */
+    void clear();
+
+    /*! returns the statistics of the scene */
+    void get(RTCSceneStatistics& stats) const;
+
+    /*! returns true if any device samples queries */
+    static __forceinline bool enabled() {
+      return numEnabled.load(std::memory_order_relaxed) != 0;
+    }
+
+    /*! counters of the API call sampled by this thread, or NULL */
+    static Counters* current();
+
+    /*! called by devices that sample queries */
+    static void enable();
+    static void disable();
+
+  public:
+    Totals intersect;
+    Totals occluded;
+    Totals point_query;
+
+  private:
+    static std::atomic<size_t> numEnabled;
+  };
+
+  /*! Time BVH builders spend in the phases of a build. Builders
+   *  only measure phases while the device enables build statistics,
+   *  otherwise they get passed NULL and do not read any timer. */
+  class BuildStatistics
+  {
+  public:
+
+    enum Phase { PRIMREFS, PRESPLITS, BINNING, PARTITIONING, LEAVES, ALLOCATOR, TOPLEVEL, TOTAL, NUM_PHASES };
+
+    /*! adds the lifetime of the timer to a phase */
+    class Timer
+    {
+    public:
+      __forceinline Timer (BuildStatistics* stats, Phase phase)
+        : stats(stats), phase(phase), t0(stats ? getSeconds() : 0.0) {}
+
+      __forceinline ~Timer () {
+        if (stats) stats->add(phase,getSeconds()-t0);
+      }
+
+    private:
+      BuildStatistics* stats;
+      Phase phase;
+      double t0;
+    };
+
+  public:
+
+    BuildStatistics () {
+      clear();
+    }
+
+    /*! resets the timings of all phases */
+    void clear();
+
+    /*! adds dt seconds to a phase */
+    __forceinline void add(Phase phase, double dt) {
+      nanoseconds[phase].fetch_add(int64_t(1E9*dt),std::memory_order_relaxed);
+    }
+
+    /*! adds the phase timings of another build, e.g. of an object of a two level build */
+    void add(const BuildStatistics& other);
+
+    /*! returns the time of a phase in seconds */
+    double get(Phase phase) const;
+
+    /*! returns the timings of all phases */
+    void get(RTCBuildStatistics& stats) const;
+
+  public:
+    std::string builder; //!< name of the builder of the last build
+
+  private:
+    std::atomic<int64_t> nanoseconds[NUM_PHASES];
+  };
 }
@@ -42,6 +42,8 @@ namespace embree
     tri_accel = "default";
     tri_builder = "default";
     tri_traverser = "default";
+    quantized_leaves = false;
+    triangle_pairs = false;
     
     tri_accel_mb = "default";
     tri_builder_mb = "default";
@@ -85,6 +87,8 @@ namespace embree
     useSpatialPreSplits = false;
 
     tessellation_cache_size = 128*1024*1024;
+    toplevel_refit_max_sah_growth = 1.5f;
+    refit_rotation_max_time = 1.0f;
 
     subdiv_accel = "default";
     subdiv_accel_mb = "default";
@@ -128,12 +132,20 @@ namespace embree
     alloc_num_main_slots = 0;
     alloc_thread_block_size = 0;
     alloc_single_thread_alloc = -1;
+    numa_alloc = true;
+    numa_replicate_depth = 0;
+    traversal_statistics_sample_rate = 0;
+    build_statistics = false;
 
     error_function = nullptr;
     error_function_userptr = nullptr;
 
     memory_monitor_function = nullptr;
     memory_monitor_userptr = nullptr;
+
+    alloc_function = nullptr;
+    free_function = nullptr;
+    allocator_userptr = nullptr;
   }
 
   State::~State() {
@@ -301,6 +313,10 @@ namespace embree
         tri_builder = cin->get().Identifier();
       else if ((tok == Token::Id("tri_traverser") || tok == Token::Id("traverser")) && cin->trySymbol("="))
         tri_traverser = cin->get().Identifier();
+      else if (tok == Token::Id("quantized_leaves") && cin->trySymbol("="))
+        quantized_leaves = cin->get().Int();
+      else if (tok == Token::Id("triangle_pairs") && cin->trySymbol("="))
+        triangle_pairs = cin->get().Int();
      
       else if ((tok == Token::Id("tri_accel_mb") || tok == Token::Id("accel_mb")) && cin->trySymbol("="))
         tri_accel_mb = cin->get().Identifier();
@@ -405,6 +421,7 @@ namespace embree
           if      (flag == Token::Id("low"))    quality_flags = RTC_BUILD_QUALITY_LOW;
           else if (flag == Token::Id("medium")) quality_flags = RTC_BUILD_QUALITY_MEDIUM;
           else if (flag == Token::Id("high"))   quality_flags = RTC_BUILD_QUALITY_HIGH;
+          else if (flag == Token::Id("refit"))  quality_flags = RTC_BUILD_QUALITY_REFIT;
         }
       }
 
@@ -422,6 +439,10 @@ namespace embree
 
       else if (tok == Token::Id("max_spatial_split_replications") && cin->trySymbol("="))
         max_spatial_split_replications = cin->get().Float();
+      else if (tok == Token::Id("toplevel_refit_max_sah_growth") && cin->trySymbol("="))
+        toplevel_refit_max_sah_growth = cin->get().Float();
+      else if (tok == Token::Id("refit_rotation_max_time") && cin->trySymbol("="))
+        refit_rotation_max_time = cin->get().Float();
 
       else if (tok == Token::Id("presplits") && cin->trySymbol("="))
         useSpatialPreSplits = cin->get().Int() != 0 ? true : false;
@@ -439,6 +460,14 @@ namespace embree
          alloc_thread_block_size = cin->get().Int();
        else if (tok == Token::Id("alloc_single_thread_alloc") && cin->trySymbol("="))
          alloc_single_thread_alloc = cin->get().Int();
+       else if (tok == Token::Id("numa_alloc") && cin->trySymbol("="))
+         numa_alloc = cin->get().Int();
+       else if (tok == Token::Id("numa_replicate_depth") && cin->trySymbol("="))
+         numa_replicate_depth = cin->get().Int();
+       else if (tok == Token::Id("traversal_statistics_sample_rate") && cin->trySymbol("="))
+         traversal_statistics_sample_rate = cin->get().Int();
+       else if (tok == Token::Id("build_statistics") && cin->trySymbol("="))
+         build_statistics = cin->get().Int();
 
       cin->trySymbol(","); // optional , separator
     }
@@ -455,6 +484,11 @@ namespace embree
     std::cout << "  build user threads = " << numUserThreads   << std::endl;
     std::cout << "  start_threads      = " << start_threads << std::endl;
     std::cout << "  affinity           = " << set_affinity << std::endl;
+    std::cout << "  numa nodes         = " << getNumberOfNUMANodes() << std::endl;
+    std::cout << "  numa_alloc         = " << numa_alloc << std::endl;
+    std::cout << "  numa_replicate_depth = " << numa_replicate_depth << std::endl;
+    std::cout << "  traversal_statistics_sample_rate = " << traversal_statistics_sample_rate << std::endl;
+    std::cout << "  build_statistics   = " << build_statistics << std::endl;
     std::cout << "  frequency_level    = ";
     switch (frequency_level) {
     case FREQUENCY_SIMD128: std::cout << "simd128" << std::endl; break;
@@ -471,11 +505,15 @@ namespace embree
     std::cout << "  verbosity          = " << verbose << std::endl;
     std::cout << "  cache_size         = " << float(tessellation_cache_size)*1E-6 << " MB" << std::endl;
     std::cout << "  max_spatial_split_replications = " << max_spatial_split_replications << std::endl;
+    std::cout << "  toplevel_refit_max_sah_growth = " << toplevel_refit_max_sah_growth << std::endl;
+    std::cout << "  refit_rotation_max_time = " << refit_rotation_max_time << " ms" << std::endl;
     
     std::cout << "triangles:" << std::endl;
     std::cout << "  accel              = " << tri_accel << std::endl;
     std::cout << "  builder            = " << tri_builder << std::endl;
     std::cout << "  traverser          = " << tri_traverser << std::endl;
+    std::cout << "  quantized_leaves   = " << quantized_leaves << std::endl;
+    std::cout << "  triangle_pairs     = " << triangle_pairs << std::endl;
         
     std::cout << "motion blur triangles:" << std::endl;
     std::cout << "  accel              = " << tri_accel_mb << std::endl;
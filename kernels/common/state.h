@@ -47,6 +47,8 @@ namespace embree
     std::string tri_accel;                 //!< acceleration structure to use for triangles
     std::string tri_builder;               //!< builder to use for triangles
     std::string tri_traverser;             //!< traverser to use for triangles
+    bool quantized_leaves;                 //!< compact scenes store triangles with quantized vertices
+    bool triangle_pairs;                   //!< static scenes store pairs of triangles that share an edge
     
   public:
     std::string tri_accel_mb;              //!< acceleration structure to use for motion blur triangles
@@ -109,6 +111,8 @@ namespace embree
     float max_spatial_split_replications;  //!< maximally replications*N many primitives in accel for spatial splits
     bool useSpatialPreSplits;              //!< use spatial pre-splits instead of the full spatial split builder
     size_t tessellation_cache_size;        //!< size of the shared tessellation cache 
+    float toplevel_refit_max_sah_growth;   //!< relative SAH growth of a refitted top level BVH that triggers a full rebuild
+    float refit_rotation_max_time;         //!< time in milliseconds spent on tree rotations after refitting a BVH
 
   public:
     size_t instancing_open_min;            //!< instancing opens tree to minimally that number of subtrees
@@ -145,6 +149,10 @@ namespace embree
     int alloc_num_main_slots;              //!< number of such shared blocks to be used to allocate
     size_t alloc_thread_block_size;        //!< size of thread local allocator block size
     int alloc_single_thread_alloc;         //!< in single mode nodes and leaves use same thread local allocator
+    bool numa_alloc;                       //!< allocates BVH nodes from main blocks local to the NUMA node of the building thread
+    size_t numa_replicate_depth;           //!< number of top BVH levels replicated per NUMA node
+    size_t traversal_statistics_sample_rate; //!< gathers traversal statistics for every n-th API call of a thread, 0 disables
+    bool build_statistics;                 //!< measures the time BVH builders spend in their build phases
 
   public:
 
@@ -192,5 +200,17 @@ namespace embree
       
     RTCMemoryMonitorFunction memory_monitor_function;
     void* memory_monitor_userptr;
+
+  public:
+    void setAllocatorFunctions(RTCAllocFunction alloc, RTCFreeFunction free, void* uptr)
+    {
+      alloc_function = alloc;
+      free_function = free;
+      allocator_userptr = uptr;
+    }
+
+    RTCAllocFunction alloc_function;
+    RTCFreeFunction free_function;
+    void* allocator_userptr;
   };
 }
@@ -5,9 +5,16 @@
 
 namespace embree
 {
-  /*! invokes the memory monitor callback */
+  /*! invokes the memory monitor callback and user allocator */
   struct MemoryMonitorInterface {
     virtual void memoryMonitor(ssize_t bytes, bool post) = 0;
+
+    /*! returns true if memory has to get allocated through the user allocator */
+    virtual bool hasUserAllocator() const { return false; }
+
+    /*! allocates and frees memory through the user allocator */
+    virtual void* userMalloc(size_t bytes, size_t align) { return nullptr; }
+    virtual void userFree(void* ptr) {}
   };
 
   /*! allocator that performs aligned monitored allocations */
@@ -31,6 +38,8 @@ namespace embree
           assert(device);
           device->memoryMonitor(n*sizeof(T),false);
         }
+        if (device && device->hasUserAllocator())
+          return (pointer) device->userMalloc(n*sizeof(value_type),alignment);
         if (n*sizeof(value_type) >= 14 * PAGE_SIZE_2M)
         {
           pointer p =  (pointer) os_malloc(n*sizeof(value_type),hugepages);
@@ -44,7 +53,9 @@ namespace embree
       {
         if (p)
         {
-          if (n*sizeof(value_type) >= 14 * PAGE_SIZE_2M)
+          if (device->hasUserAllocator())
+            device->userFree(p);
+          else if (n*sizeof(value_type) >= 14 * PAGE_SIZE_2M)
             os_free(p,n*sizeof(value_type),hugepages); 
           else
             alignedFree(p);
@@ -17,6 +17,7 @@ namespace embree
       if (geometry->intersectionFilterN)
       {
         geometry->intersectionFilterN(args);
+        STAT3(normal.trav_filters,1,1,1);
 
         if (args->valid[0] == 0)
           return false;
@@ -24,14 +25,23 @@ namespace embree
 
       if (context->getFilter())
       {
-        if (context->enforceArgumentFilterFunction() || geometry->hasArgumentFilterFunctions())
+        if (context->enforceArgumentFilterFunction() || geometry->hasArgumentFilterFunctions()) {
           context->getFilter()(args);
+          STAT3(normal.trav_filters,1,1,1);
+        }
 
         if (args->valid[0] == 0)
           return false;
       }
-      
+
       copyHitToRay(*(RayHit*)args->ray,*(Hit*)args->hit);
+
+      /* multi-hit queries record the hit and only shrink the ray to the farthest recorded hit */
+      if (MultiHitList* list = context->getMultiHitList()) {
+        RayHit& ray = *(RayHit*)args->ray;
+        list->insert(ray.tfar,*(RTCHit*)args->hit);
+        ray.tfar = list->tfar();
+      }
       return true;
     }
     
@@ -53,6 +63,7 @@ namespace embree
       if (geometry->occlusionFilterN)
       {
         geometry->occlusionFilterN(args);
+        STAT3(shadow.trav_filters,1,1,1);
 
         if (args->valid[0] == 0)
           return false;
@@ -60,8 +71,10 @@ namespace embree
 
       if (context->getFilter())
       {
-        if (context->enforceArgumentFilterFunction() || geometry->hasArgumentFilterFunctions())
+        if (context->enforceArgumentFilterFunction() || geometry->hasArgumentFilterFunctions()) {
           context->getFilter()(args);
+          STAT3(shadow.trav_filters,1,1,1);
+        }
 
         if (args->valid[0] == 0)
           return false;
@@ -87,15 +100,19 @@ namespace embree
       __forceinline vbool<K> runIntersectionFilterHelper(RTCFilterFunctionNArguments* args, const Geometry* const geometry, RayQueryContext* context)
     {
       vint<K>* mask = (vint<K>*) args->valid;
-      if (geometry->intersectionFilterN)
+      if (geometry->intersectionFilterN) {
         geometry->intersectionFilterN(args);
+        STAT3(normal.trav_filters,1,1,1);
+      }
       
       vbool<K> valid_o = *mask != vint<K>(zero);
       if (none(valid_o)) return valid_o;
 
       if (context->getFilter()) {
-        if (context->enforceArgumentFilterFunction() || geometry->hasArgumentFilterFunctions())
+        if (context->enforceArgumentFilterFunction() || geometry->hasArgumentFilterFunctions()) {
           context->getFilter()(args);
+          STAT3(normal.trav_filters,1,1,1);
+        }
       }
 
       valid_o = *mask != vint<K>(zero);
@@ -123,15 +140,19 @@ namespace embree
       __forceinline vbool<K> runOcclusionFilterHelper(RTCFilterFunctionNArguments* args, const Geometry* const geometry, RayQueryContext* context)
     {
       vint<K>* mask = (vint<K>*) args->valid;
-      if (geometry->occlusionFilterN)
+      if (geometry->occlusionFilterN) {
         geometry->occlusionFilterN(args);
+        STAT3(shadow.trav_filters,1,1,1);
+      }
       
       vbool<K> valid_o = *mask != vint<K>(zero);
       if (none(valid_o)) return valid_o;
 
       if (context->getFilter()) {
-        if (context->enforceArgumentFilterFunction() || geometry->hasArgumentFilterFunctions())
+        if (context->enforceArgumentFilterFunction() || geometry->hasArgumentFilterFunctions()) {
           context->getFilter()(args);
+          STAT3(shadow.trav_filters,1,1,1);
+        }
       }
       valid_o = *mask != vint<K>(zero);
 
@@ -22,6 +22,7 @@ namespace embree
       RTCRayQueryContext* user_context = context->user;
       if (likely(instance_id_stack::push(user_context, prim.instID_)))
       {
+        STAT3(normal.trav_xfm_nodes,1,1,1);
         const AffineSpace3fa world2local = instance->getWorld2Local();
         const Vec3ff ray_org = ray.org;
         const Vec3ff ray_dir = ray.dir;
@@ -49,6 +50,7 @@ namespace embree
       bool occluded = false;
       if (likely(instance_id_stack::push(user_context, prim.instID_)))
       {
+        STAT3(shadow.trav_xfm_nodes,1,1,1);
         const AffineSpace3fa world2local = instance->getWorld2Local();
         const Vec3ff ray_org = ray.org;
         const Vec3ff ray_dir = ray.dir;
@@ -77,6 +79,7 @@ namespace embree
 
       if (likely(instance_id_stack::push(context->userContext, prim.instID_, world2local, local2world)))
       {
+        STAT3(point_query.trav_xfm_nodes,1,1,1);
         PointQuery query_inst;
         query_inst.time = query->time;
         query_inst.p = xfmPoint(world2local, query->p); 
@@ -111,6 +114,7 @@ namespace embree
       RTCRayQueryContext* user_context = context->user;
       if (likely(instance_id_stack::push(user_context, prim.instID_)))
       {
+        STAT3(normal.trav_xfm_nodes,1,1,1);
         const AffineSpace3fa world2local = instance->getWorld2Local(ray.time());
         const Vec3ff ray_org = ray.org;
         const Vec3ff ray_dir = ray.dir;
@@ -138,6 +142,7 @@ namespace embree
       bool occluded = false;
       if (likely(instance_id_stack::push(user_context, prim.instID_)))
       {
+        STAT3(shadow.trav_xfm_nodes,1,1,1);
         const AffineSpace3fa world2local = instance->getWorld2Local(ray.time());
         const Vec3ff ray_org = ray.org;
         const Vec3ff ray_dir = ray.dir;
@@ -165,6 +170,7 @@ namespace embree
 
       if (likely(instance_id_stack::push(context->userContext, prim.instID_, world2local, local2world)))
       {
+        STAT3(point_query.trav_xfm_nodes,1,1,1);
         PointQuery query_inst;
         query_inst.time = query->time;
         query_inst.p = xfmPoint(world2local, query->p); 
@@ -202,6 +208,7 @@ namespace embree
       RTCRayQueryContext* user_context = context->user;
       if (likely(instance_id_stack::push(user_context, prim.instID_)))
       {
+        STAT3(normal.trav_xfm_nodes,1,1,1);
         AffineSpace3vf<K> world2local = instance->getWorld2Local();
         const Vec3vf<K> ray_org = ray.org;
         const Vec3vf<K> ray_dir = ray.dir;
@@ -231,6 +238,7 @@ namespace embree
       vbool<K> occluded = false;
       if (likely(instance_id_stack::push(user_context, prim.instID_)))
       {
+        STAT3(shadow.trav_xfm_nodes,1,1,1);
         AffineSpace3vf<K> world2local = instance->getWorld2Local();
         const Vec3vf<K> ray_org = ray.org;
         const Vec3vf<K> ray_dir = ray.dir;
@@ -261,6 +269,7 @@ namespace embree
       RTCRayQueryContext* user_context = context->user;
       if (likely(instance_id_stack::push(user_context, prim.instID_)))
       {
+        STAT3(normal.trav_xfm_nodes,1,1,1);
         AffineSpace3vf<K> world2local = instance->getWorld2Local<K>(valid, ray.time());
         const Vec3vf<K> ray_org = ray.org;
         const Vec3vf<K> ray_dir = ray.dir;
@@ -290,6 +299,7 @@ namespace embree
       vbool<K> occluded = false;
       if (likely(instance_id_stack::push(user_context, prim.instID_)))
       {
+        STAT3(shadow.trav_xfm_nodes,1,1,1);
         AffineSpace3vf<K> world2local = instance->getWorld2Local<K>(valid, ray.time());
         const Vec3vf<K> ray_org = ray.org;
         const Vec3vf<K> ray_dir = ray.dir;
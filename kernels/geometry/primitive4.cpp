@@ -10,6 +10,8 @@
 #include "trianglev.h"
 #include "trianglev_mb.h"
 #include "trianglei.h"
+#include "triangleq.h"
+#include "trianglepairi.h"
 #include "quadv.h"
 #include "quadi.h"
 #include "subdivpatch1.h"
@@ -209,6 +211,50 @@ namespace embree
     return sizeof(Triangle4i);
   }
 
+  /********************** Triangle4q **************************/
+
+  template<>
+  const char* Triangle4q::Type::name () const {
+    return "triangle4q";
+  }
+
+  template<>
+  size_t Triangle4q::Type::sizeActive(const char* This) const {
+    return ((Triangle4q*)This)->size();
+  }
+
+  template<>
+  size_t Triangle4q::Type::sizeTotal(const char* This) const {
+    return 4;
+  }
+
+  template<>
+  size_t Triangle4q::Type::getBytes(const char* This) const {
+    return sizeof(Triangle4q);
+  }
+
+  /********************** TrianglePair4i **************************/
+
+  template<>
+  const char* TrianglePair4i::Type::name () const {
+    return "trianglepair4i";
+  }
+
+  template<>
+  size_t TrianglePair4i::Type::sizeActive(const char* This) const {
+    return ((TrianglePair4i*)This)->numTriangles();
+  }
+
+  template<>
+  size_t TrianglePair4i::Type::sizeTotal(const char* This) const {
+    return 8;
+  }
+
+  template<>
+  size_t TrianglePair4i::Type::getBytes(const char* This) const {
+    return sizeof(TrianglePair4i);
+  }
+
   /********************** Triangle4vMB **************************/
 
   template<>
@@ -0,0 +1,240 @@
+// Copyright 2009-2021 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include "primitive.h"
+#include "../common/scene.h"
+#include "../rthwif/rtbuild/quadifier.h"
+
+namespace embree
+{
+  /* Stores M pairs of triangles that share an edge from an indexed
+   * face set. The first triangle of a pair is (v0,v1,v2), the second
+   * triangle selects its vertices from v0,v1,v2,v3 in its original
+   * order, thus hits report the barycentric coordinates of the
+   * original triangle. Unpaired triangles have no second triangle. */
+  template <int M>
+  struct TrianglePairMi
+  {
+    /* Virtual interface to query information about the triangle pair type */
+    struct Type : public PrimitiveType
+    {
+      const char* name() const;
+      size_t sizeActive(const char* This) const;
+      size_t sizeTotal(const char* This) const;
+      size_t getBytes(const char* This) const;
+    };
+    static Type type;
+
+  public:
+
+    /* Returns maximum number of stored triangle pairs */
+    static __forceinline size_t max_size() { return M; }
+
+    /* Returns required number of primitive blocks for N triangle pairs */
+    static __forceinline size_t blocks(size_t N) { return (N+max_size()-1)/max_size(); }
+
+  public:
+
+    /* Default constructor */
+    __forceinline TrianglePairMi() {  }
+
+    /* Construction from vertices and IDs */
+    __forceinline TrianglePairMi(const vuint<M>& v0,
+                                 const vuint<M>& v1,
+                                 const vuint<M>& v2,
+                                 const vuint<M>& v3,
+                                 const vuint<M>& geomIDs,
+                                 const vuint<M>& primIDs,
+                                 const vuint<M>& pairs)
+      : v0_(v0), v1_(v1), v2_(v2), v3_(v3), geomIDs(geomIDs), primIDs(primIDs), pairs(pairs) {}
+
+    /* Returns a mask that tells which triangle pairs are valid */
+    __forceinline vbool<M> valid() const { return primIDs != vuint<M>(-1); }
+
+    /* Returns if the specified triangle pair is valid */
+    __forceinline bool valid(const size_t i) const { assert(i<M); return primIDs[i] != -1; }
+
+    /* Returns the number of stored triangle pairs */
+    __forceinline size_t size() const { return bsf(~movemask(valid())); }
+
+    /* Returns the number of stored triangles */
+    __forceinline size_t numTriangles() const { return size() + popcnt(valid() & ((pairs >> 6) != vuint<M>(zero))); }
+
+    /* Returns the geometry IDs */
+    __forceinline vuint<M> geomID() const { return geomIDs; }
+    __forceinline unsigned int geomID(const size_t i) const { assert(i<M); return geomIDs[i]; }
+
+    /* Returns the primitive IDs of the first triangles */
+    __forceinline vuint<M> primID() const { return primIDs; }
+    __forceinline unsigned int primID(const size_t i) const { assert(i<M); return primIDs[i]; }
+
+    /* Returns the primitive IDs of the second triangles */
+    __forceinline vuint<M> primID1() const { return primIDs + (pairs >> 6); }
+    __forceinline unsigned int primID1(const size_t i) const { assert(i<M); return primIDs[i] + (pairs[i] >> 6); }
+
+    /* Returns true if the specified triangle pair has a second triangle */
+    __forceinline bool hasSecond(const size_t i) const { assert(i<M); return (pairs[i] >> 6) != 0; }
+
+    /* Returns the index of the j'th vertex of the second triangles into v0,v1,v2,v3 */
+    __forceinline vuint<M> secondVertex(const size_t j) const { return (pairs >> (2*j)) & vuint<M>(3); }
+    __forceinline unsigned int secondVertex(const size_t i, const size_t j) const { return (pairs[i] >> (2*j)) & 3; }
+
+    /* Returns the 4 byte vertex offset of the j'th vertex of the i'th triangle pair */
+    __forceinline unsigned int vertexOffset(const size_t i, const size_t j) const
+    {
+      assert(i<M && j<4);
+      switch (j) {
+      case 0 : return v0_[i];
+      case 1 : return v1_[i];
+      case 2 : return v2_[i];
+      default: return v3_[i];
+      }
+    }
+
+    /* Calculate the bounds of the triangle pairs */
+    __forceinline const BBox3fa bounds(const Scene *const scene) const
+    {
+      BBox3fa bounds = empty;
+      for (size_t i=0; i<M && valid(i); i++) {
+        const TriangleMesh* mesh = scene->get<TriangleMesh>(geomID(i));
+        bounds.extend(mesh->bounds(primID(i)));
+        if (hasSecond(i)) bounds.extend(mesh->bounds(primID1(i)));
+      }
+      return bounds;
+    }
+
+    /* Fill triangle pairs from a list of primitive references to the first triangle of each pair */
+    __forceinline void fill(const PrimRef* prims, size_t& begin, size_t end, Scene* scene, const std::vector<std::vector<uint16_t>>& quadification)
+    {
+      vuint<M> v0 = zero, v1 = zero, v2 = zero, v3 = zero;
+      vuint<M> geomID = -1, primID = -1, pair = zero;
+      const PrimRef* prim = &prims[begin];
+
+      for (size_t i=0; i<M; i++)
+      {
+        if (begin<end) {
+          geomID[i] = prim->geomID();
+          primID[i] = prim->primID();
+          const TriangleMesh* mesh = scene->get<TriangleMesh>(prim->geomID());
+          const TriangleMesh::Triangle& tri0 = mesh->triangle(prim->primID());
+          const unsigned int int_stride = mesh->vertices0.getStride()/4;
+          v0[i] = tri0.v[0] * int_stride;
+          v1[i] = tri0.v[1] * int_stride;
+          v2[i] = tri0.v[2] * int_stride;
+          v3[i] = v2[i];
+
+          const uint16_t second = quadification[prim->geomID()][prim->primID()];
+          if (second != QUADIFIER_TRIANGLE)
+          {
+            const TriangleMesh::Triangle& tri1 = mesh->triangle(prim->primID()+second);
+            uint8_t lb0,lb1,lb2;
+            bool paired MAYBE_UNUSED = pair_triangles(Vec3<uint32_t>(tri0.v[0],tri0.v[1],tri0.v[2]),Vec3<uint32_t>(tri1.v[0],tri1.v[1],tri1.v[2]),lb0,lb1,lb2);
+            assert(paired);
+            if (lb0 == 3) v3[i] = tri1.v[0] * int_stride;
+            if (lb1 == 3) v3[i] = tri1.v[1] * int_stride;
+            if (lb2 == 3) v3[i] = tri1.v[2] * int_stride;
+            pair[i] = (unsigned(second) << 6) | (lb2 << 4) | (lb1 << 2) | lb0;
+          }
+          begin++;
+        } else {
+          assert(i);
+          if (likely(i > 0)) {
+            geomID[i] = geomID[0]; // always valid geomIDs
+            primID[i] = -1;        // indicates invalid data
+            v0[i] = v0[0];
+            v1[i] = v0[0];
+            v2[i] = v0[0];
+            v3[i] = v0[0];
+          }
+        }
+        if (begin<end) prim = &prims[begin];
+      }
+      new (this) TrianglePairMi(v0,v1,v2,v3,geomID,primID,pair);
+    }
+
+    friend embree_ostream operator<<(embree_ostream cout, const TrianglePairMi& tri) {
+      return cout << "TrianglePairMi<" << M << ">( "
+                  << "v0 = " << tri.v0_ << ", v1 = " << tri.v1_ << ", v2 = " << tri.v2_ << ", v3 = " << tri.v3_ << ", "
+                  << "geomID = " << tri.geomIDs << ", primID = " << tri.primIDs << ", primID1 = " << tri.primID1() << " )";
+    }
+
+  protected:
+    vuint<M> v0_;         // 4 byte offset of 1st vertex
+    vuint<M> v1_;         // 4 byte offset of 2nd vertex
+    vuint<M> v2_;         // 4 byte offset of 3rd vertex
+    vuint<M> v3_;         // 4 byte offset of the vertex only used by the second triangle
+    vuint<M> geomIDs;     // geometry ID of mesh
+    vuint<M> primIDs;     // primitive ID of the first triangle
+    vuint<M> pairs;       // offset of the primitive ID of the second triangle (upper bits), and 2 bit vertex indices of the second triangle (lower 6 bits)
+  };
+
+  namespace isa
+  {
+  template<int M>
+    struct TrianglePairMi : public embree::TrianglePairMi<M>
+  {
+    using embree::TrianglePairMi<M>::v0_;
+    using embree::TrianglePairMi<M>::v1_;
+    using embree::TrianglePairMi<M>::v2_;
+    using embree::TrianglePairMi<M>::v3_;
+    using embree::TrianglePairMi<M>::geomID;
+    using embree::TrianglePairMi<M>::secondVertex;
+    using embree::TrianglePairMi<M>::vertexOffset;
+
+    /* loads the j'th vertex of the i'th triangle pair */
+    __forceinline Vec3f getVertex(const size_t i, const size_t j, const Scene *const scene) const
+    {
+      const float* vertices = scene->vertices[geomID(i)];
+      return (Vec3f&) vertices[vertexOffset(i,j)];
+    }
+
+    /* loads the j'th vertex of the second triangle of the i'th triangle pair */
+    __forceinline Vec3f getSecondVertex(const size_t i, const size_t j, const Scene *const scene) const {
+      return getVertex(i,secondVertex(i,j),scene);
+    }
+
+    /* Gather the vertices of the first and second triangles */
+    __forceinline void gather(Vec3vf<M>& p0, Vec3vf<M>& p1, Vec3vf<M>& p2,
+                              Vec3vf<M>& q0, Vec3vf<M>& q1, Vec3vf<M>& q2,
+                              const Scene* const scene) const;
+
+  private:
+
+    /* selects one of the four vertices per triangle pair */
+    static __forceinline Vec3vf<M> selectVertex(const vuint<M>& j, const Vec3vf<M>& p0, const Vec3vf<M>& p1, const Vec3vf<M>& p2, const Vec3vf<M>& p3) {
+      return select(j == vuint<M>(0),p0,select(j == vuint<M>(1),p1,select(j == vuint<M>(2),p2,p3)));
+    }
+  };
+
+  template<>
+  __forceinline void TrianglePairMi<4>::gather(Vec3vf4& p0, Vec3vf4& p1, Vec3vf4& p2,
+                                               Vec3vf4& q0, Vec3vf4& q1, Vec3vf4& q2,
+                                               const Scene* const scene) const
+  {
+    vfloat4 a[4][4];
+    for (size_t i=0; i<4; i++)
+    {
+      const float* vertices = scene->vertices[geomID(i)];
+      a[i][0] = vfloat4::loadu(vertices + v0_[i]);
+      a[i][1] = vfloat4::loadu(vertices + v1_[i]);
+      a[i][2] = vfloat4::loadu(vertices + v2_[i]);
+      a[i][3] = vfloat4::loadu(vertices + v3_[i]);
+    }
+    Vec3vf4 p3;
+    transpose(a[0][0],a[1][0],a[2][0],a[3][0],p0.x,p0.y,p0.z);
+    transpose(a[0][1],a[1][1],a[2][1],a[3][1],p1.x,p1.y,p1.z);
+    transpose(a[0][2],a[1][2],a[2][2],a[3][2],p2.x,p2.y,p2.z);
+    transpose(a[0][3],a[1][3],a[2][3],a[3][3],p3.x,p3.y,p3.z);
+    q0 = selectVertex(secondVertex(0),p0,p1,p2,p3);
+    q1 = selectVertex(secondVertex(1),p0,p1,p2,p3);
+    q2 = selectVertex(secondVertex(2),p0,p1,p2,p3);
+  }
+  }
+
+  template<int M>
+  typename TrianglePairMi<M>::Type TrianglePairMi<M>::type;
+
+  typedef TrianglePairMi<4> TrianglePair4i;
+}
@@ -0,0 +1,126 @@
+// Copyright 2009-2021 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include "trianglepairi.h"
+#include "triangle_intersector_moeller.h"
+
+namespace embree
+{
+  namespace isa
+  {
+    /*! Intersects M triangle pairs with 1 ray */
+    template<int M, bool filter>
+    struct TrianglePairMiIntersector1Moeller
+    {
+      typedef TrianglePairMi<M> Primitive;
+      typedef MoellerTrumboreIntersector1<M> Precalculations;
+
+      static __forceinline void intersect(const Precalculations& pre, RayHit& ray, RayQueryContext* context, const Primitive& tri)
+      {
+        STAT3(normal.trav_prims,1,1,1);
+        Vec3vf<M> v0, v1, v2, w0, w1, w2; tri.gather(v0,v1,v2,w0,w1,w2,context->scene);
+        pre.intersect(ray,v0,v1,v2,Intersect1EpilogM<M,filter>(ray,context,tri.geomID(),tri.primID()));
+        pre.intersect(ray,w0,w1,w2,Intersect1EpilogM<M,filter>(ray,context,tri.geomID(),tri.primID1()));
+      }
+
+      static __forceinline bool occluded(const Precalculations& pre, Ray& ray, RayQueryContext* context, const Primitive& tri)
+      {
+        STAT3(shadow.trav_prims,1,1,1);
+        Vec3vf<M> v0, v1, v2, w0, w1, w2; tri.gather(v0,v1,v2,w0,w1,w2,context->scene);
+        if (pre.intersect(ray,v0,v1,v2,Occluded1EpilogM<M,filter>(ray,context,tri.geomID(),tri.primID())))
+          return true;
+        return pre.intersect(ray,w0,w1,w2,Occluded1EpilogM<M,filter>(ray,context,tri.geomID(),tri.primID1()));
+      }
+
+      static __forceinline bool pointQuery(PointQuery* query, PointQueryContext* context, const Primitive& tri)
+      {
+        bool changed = false;
+        for (size_t i=0; i<Primitive::max_size(); i++)
+        {
+          if (!tri.valid(i)) break;
+          STAT3(point_query.trav_prims,1,1,1);
+          AccelSet* accel = (AccelSet*)context->scene->get(tri.geomID(i));
+          context->geomID = tri.geomID(i);
+          context->primID = tri.primID(i);
+          changed |= accel->pointQuery(query, context);
+          if (!tri.hasSecond(i)) continue;
+          context->primID = tri.primID1(i);
+          changed |= accel->pointQuery(query, context);
+        }
+        return changed;
+      }
+    };
+
+    /*! Intersects M triangle pairs with K rays */
+    template<int M, int K, bool filter>
+    struct TrianglePairMiIntersectorKMoeller
+    {
+      typedef TrianglePairMi<M> Primitive;
+      typedef MoellerTrumboreIntersectorK<M,K> Precalculations;
+
+      static __forceinline void intersect(const vbool<K>& valid_i, Precalculations& pre, RayHitK<K>& ray, RayQueryContext* context, const Primitive& tri)
+      {
+        const Scene* scene = context->scene;
+        const vuint<M> primIDs1 = tri.primID1();
+        for (size_t i=0; i<Primitive::max_size(); i++)
+        {
+          if (!tri.valid(i)) break;
+          STAT3(normal.trav_prims,1,popcnt(valid_i),RayHitK<K>::size());
+          const Vec3vf<K> v0 = tri.getVertex(i,0,scene);
+          const Vec3vf<K> v1 = tri.getVertex(i,1,scene);
+          const Vec3vf<K> v2 = tri.getVertex(i,2,scene);
+          pre.intersectK(valid_i,ray,v0,v1,v2,IntersectKEpilogM<M,K,filter>(ray,context,tri.geomID(),tri.primID(),i));
+          if (!tri.hasSecond(i)) continue;
+          const Vec3vf<K> w0 = tri.getSecondVertex(i,0,scene);
+          const Vec3vf<K> w1 = tri.getSecondVertex(i,1,scene);
+          const Vec3vf<K> w2 = tri.getSecondVertex(i,2,scene);
+          pre.intersectK(valid_i,ray,w0,w1,w2,IntersectKEpilogM<M,K,filter>(ray,context,tri.geomID(),primIDs1,i));
+        }
+      }
+
+      static __forceinline vbool<K> occluded(const vbool<K>& valid_i, Precalculations& pre, RayK<K>& ray, RayQueryContext* context, const Primitive& tri)
+      {
+        vbool<K> valid0 = valid_i;
+        const Scene* scene = context->scene;
+        const vuint<M> primIDs1 = tri.primID1();
+
+        for (size_t i=0; i<Primitive::max_size(); i++)
+        {
+          if (!tri.valid(i)) break;
+          STAT3(shadow.trav_prims,1,popcnt(valid_i),RayHitK<K>::size());
+          const Vec3vf<K> v0 = tri.getVertex(i,0,scene);
+          const Vec3vf<K> v1 = tri.getVertex(i,1,scene);
+          const Vec3vf<K> v2 = tri.getVertex(i,2,scene);
+          pre.intersectK(valid0,ray,v0,v1,v2,OccludedKEpilogM<M,K,filter>(valid0,ray,context,tri.geomID(),tri.primID(),i));
+          if (none(valid0)) break;
+          if (!tri.hasSecond(i)) continue;
+          const Vec3vf<K> w0 = tri.getSecondVertex(i,0,scene);
+          const Vec3vf<K> w1 = tri.getSecondVertex(i,1,scene);
+          const Vec3vf<K> w2 = tri.getSecondVertex(i,2,scene);
+          pre.intersectK(valid0,ray,w0,w1,w2,OccludedKEpilogM<M,K,filter>(valid0,ray,context,tri.geomID(),primIDs1,i));
+          if (none(valid0)) break;
+        }
+        return !valid0;
+      }
+
+      static __forceinline void intersect(Precalculations& pre, RayHitK<K>& ray, size_t k, RayQueryContext* context, const Primitive& tri)
+      {
+        STAT3(normal.trav_prims,1,1,1);
+        Vec3vf<M> v0, v1, v2, w0, w1, w2; tri.gather(v0,v1,v2,w0,w1,w2,context->scene);
+        pre.intersect(ray,k,v0,v1,v2,Intersect1KEpilogM<M,K,filter>(ray,k,context,tri.geomID(),tri.primID()));
+        pre.intersect(ray,k,w0,w1,w2,Intersect1KEpilogM<M,K,filter>(ray,k,context,tri.geomID(),tri.primID1()));
+      }
+
+      static __forceinline bool occluded(Precalculations& pre, RayK<K>& ray, size_t k, RayQueryContext* context, const Primitive& tri)
+      {
+        STAT3(shadow.trav_prims,1,1,1);
+        Vec3vf<M> v0, v1, v2, w0, w1, w2; tri.gather(v0,v1,v2,w0,w1,w2,context->scene);
+        if (pre.intersect(ray,k,v0,v1,v2,Occluded1KEpilogM<M,K,filter>(ray,k,context,tri.geomID(),tri.primID())))
+          return true;
+        return pre.intersect(ray,k,w0,w1,w2,Occluded1KEpilogM<M,K,filter>(ray,k,context,tri.geomID(),tri.primID1()));
+      }
+    };
+  }
+}
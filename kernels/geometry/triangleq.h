@@ -0,0 +1,162 @@
+// Copyright 2009-2021 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include "primitive.h"
+
+namespace embree
+{
+  /* Stores the vertices of M triangles quantized to 16 bits relative
+   * to the bounds of the block. The decoded vertices differ by at
+   * most the stored error from the original vertices. */
+  template <int M>
+  struct TriangleMq
+  {
+  public:
+    struct Type : public PrimitiveType
+    {
+      const char* name() const;
+      size_t sizeActive(const char* This) const;
+      size_t sizeTotal(const char* This) const;
+      size_t getBytes(const char* This) const;
+    };
+    static Type type;
+
+  public:
+
+    /* Returns maximum number of stored triangles */
+    static __forceinline size_t max_size() { return M; }
+
+    /* Returns required number of primitive blocks for N primitives */
+    static __forceinline size_t blocks(size_t N) { return (N+max_size()-1)/max_size(); }
+
+  public:
+
+    /* Default constructor */
+    __forceinline TriangleMq() {}
+
+    /* Returns a mask that tells which triangles are valid */
+    __forceinline vbool<M> valid() const { return geomID() != vuint<M>(-1); }
+
+    /* Returns true if the specified triangle is valid */
+    __forceinline bool valid(const size_t i) const { assert(i<M); return geomIDs[i] != -1; }
+
+    /* Returns the number of stored triangles */
+    __forceinline size_t size() const { return bsf(~movemask(valid())); }
+
+    /* Returns the geometry IDs */
+    __forceinline vuint<M> geomID() const { return vuint<M>::loadu(geomIDs); }
+    __forceinline unsigned int geomID(const size_t i) const { assert(i<M); return geomIDs[i]; }
+
+    /* Returns the primitive IDs */
+    __forceinline vuint<M> primID() const { return vuint<M>::loadu(primIDs); }
+    __forceinline unsigned int primID(const size_t i) const { assert(i<M); return primIDs[i]; }
+
+    /* Returns the maximal distance of a decoded vertex to its original vertex */
+    __forceinline float error() const { return err; }
+
+    /* Decodes the j'th vertex of all triangles */
+    __forceinline Vec3vf<M> vertex(const size_t j) const
+    {
+      const vfloat<M> x = madd(vfloat<M>(vint<M>::load(vertices[j][0])),vfloat<M>(scale.x),vfloat<M>(lower.x));
+      const vfloat<M> y = madd(vfloat<M>(vint<M>::load(vertices[j][1])),vfloat<M>(scale.y),vfloat<M>(lower.y));
+      const vfloat<M> z = madd(vfloat<M>(vint<M>::load(vertices[j][2])),vfloat<M>(scale.z),vfloat<M>(lower.z));
+      return Vec3vf<M>(x,y,z);
+    }
+
+    /* Decodes the vertices of all triangles */
+    __forceinline void gather(Vec3vf<M>& v0, Vec3vf<M>& v1, Vec3vf<M>& v2) const
+    {
+      v0 = vertex(0);
+      v1 = vertex(1);
+      v2 = vertex(2);
+    }
+
+    /* Calculate the bounds of the decoded triangles */
+    __forceinline BBox3fa bounds() const
+    {
+      Vec3vf<M> v0,v1,v2; gather(v0,v1,v2);
+      Vec3vf<M> lower = min(v0,v1,v2);
+      Vec3vf<M> upper = max(v0,v1,v2);
+      vbool<M> mask = valid();
+      lower.x = select(mask,lower.x,vfloat<M>(pos_inf));
+      lower.y = select(mask,lower.y,vfloat<M>(pos_inf));
+      lower.z = select(mask,lower.z,vfloat<M>(pos_inf));
+      upper.x = select(mask,upper.x,vfloat<M>(neg_inf));
+      upper.y = select(mask,upper.y,vfloat<M>(neg_inf));
+      upper.z = select(mask,upper.z,vfloat<M>(neg_inf));
+      return BBox3fa(Vec3fa(reduce_min(lower.x),reduce_min(lower.y),reduce_min(lower.z)),
+                     Vec3fa(reduce_max(upper.x),reduce_max(upper.y),reduce_max(upper.z)));
+    }
+
+    /* Fill triangle from triangle list */
+    __forceinline void fill(const PrimRef* prims, size_t& begin, size_t end, Scene* scene)
+    {
+      Vec3fa p[3][M];
+      BBox3fa box = empty;
+      size_t n = 0;
+
+      for (; n<M && begin<end; n++, begin++)
+      {
+        const PrimRef& prim = prims[begin];
+        const unsigned geomID = prim.geomID();
+        const unsigned primID = prim.primID();
+        const TriangleMesh* __restrict__ const mesh = scene->get<TriangleMesh>(geomID);
+        const TriangleMesh::Triangle& tri = mesh->triangle(primID);
+        p[0][n] = mesh->vertex(tri.v[0]);
+        p[1][n] = mesh->vertex(tri.v[1]);
+        p[2][n] = mesh->vertex(tri.v[2]);
+        box.extend(merge(BBox3fa(p[0][n]),BBox3fa(p[1][n]),BBox3fa(p[2][n])));
+        geomIDs[n] = geomID;
+        primIDs[n] = primID;
+      }
+
+      /* the bounds of the primitive references may be clipped by spatial splits, thus we quantize relative to the vertex bounds */
+      const Vec3fa vscale = (box.upper-box.lower)*(1.0f/65535.0f);
+      const Vec3fa rcp_scale = select(gt_mask(vscale,Vec3fa(zero)),rcp(vscale),Vec3fa(zero));
+      lower = Vec3f(box.lower.x,box.lower.y,box.lower.z);
+      scale = Vec3f(vscale.x,vscale.y,vscale.z);
+
+      float maxDist = 0.0f;
+      for (size_t i=0; i<M; i++)
+      {
+        for (size_t j=0; j<3; j++)
+        {
+          if (i >= n) {
+            vertices[j][0][i] = vertices[j][1][i] = vertices[j][2][i] = 0;
+            continue;
+          }
+          const Vec3fa q = min(max(floor(madd(p[j][i]-box.lower,rcp_scale,Vec3fa(0.5f))),Vec3fa(zero)),Vec3fa(65535.0f));
+          vertices[j][0][i] = (unsigned short) q.x;
+          vertices[j][1][i] = (unsigned short) q.y;
+          vertices[j][2][i] = (unsigned short) q.z;
+          const Vec3fa d = madd(q,vscale,box.lower);
+          maxDist = max(maxDist,length(Vec3fa(p[j][i]-d)));
+        }
+      }
+
+      for (size_t i=n; i<M; i++) {
+        geomIDs[i] = -1;
+        primIDs[i] = -1;
+      }
+
+      /* account for rounding differences of the SIMD decoding in the intersectors */
+      const float maxCoord = reduce_max(max(abs(box.lower),abs(box.upper)));
+      err = maxDist + 4.0f*float(ulp)*maxCoord;
+    }
+
+  private:
+    unsigned short vertices[3][3][M];   // quantized vertices of the triangles, stored first as SIMD loads may read past the last row
+    unsigned int geomIDs[M];            // geometry ID
+    unsigned int primIDs[M];            // primitive ID
+    Vec3f lower;                        // lower bounds of the quantization grid
+    Vec3f scale;                        // size of one quantization step
+    float err;                          // maximal distance of a decoded vertex to its original vertex
+  };
+
+  template<int M>
+  typename TriangleMq<M>::Type TriangleMq<M>::type;
+
+  typedef TriangleMq<4> Triangle4q;
+}
@@ -0,0 +1,260 @@
+// Copyright 2009-2021 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include "triangleq.h"
+#include "triangle_intersector_pluecker.h"
+
+/*! Pluecker ray/triangle intersector for quantized triangles. The
+ *  decoded vertices of a triangle differ from the original vertices
+ *  by up to the quantization error of its block, thus neighboring
+ *  triangles stored in different blocks no longer share their edges
+ *  exactly. To not let rays slip through the resulting cracks, the
+ *  edge tests conservatively accept rays that pass an edge at a
+ *  distance of up to the quantization error on the outside. The
+ *  barycentric coordinates of such hits are clamped to the
+ *  triangle. */
+
+namespace embree
+{
+  namespace isa
+  {
+    template<int N>
+    struct QuantizedPlueckerTest
+    {
+      /*! Intersects N rays with N triangles, returns the unnormalized barycentrics of all hits. */
+      static __forceinline vbool<N> intersect(const vbool<N>& valid0,
+                                              const Vec3vf<N>& O,
+                                              const Vec3vf<N>& D,
+                                              const vfloat<N>& tnear,
+                                              const vfloat<N>& tfar,
+                                              const Vec3vf<N>& tri_v0,
+                                              const Vec3vf<N>& tri_v1,
+                                              const Vec3vf<N>& tri_v2,
+                                              const vfloat<N>& err,
+                                              vfloat<N>& U_o,
+                                              vfloat<N>& V_o,
+                                              vfloat<N>& UVW_o,
+                                              vfloat<N>& t_o,
+                                              Vec3vf<N>& Ng_o)
+      {
+        vbool<N> valid = valid0;
+
+        /* calculate vertices relative to ray origin */
+        const Vec3vf<N> v0 = tri_v0-O;
+        const Vec3vf<N> v1 = tri_v1-O;
+        const Vec3vf<N> v2 = tri_v2-O;
+
+        /* calculate triangle edges */
+        const Vec3vf<N> e0 = v2-v0;
+        const Vec3vf<N> e1 = v0-v1;
+        const Vec3vf<N> e2 = v1-v2;
+
+        /* perform edge tests, an edge test is twice the distance of the ray to the edge times |cross(e,D)| */
+        const vfloat<N> U = dot(Vec3vf<N>(cross(e0,v2+v0)),D);
+        const vfloat<N> V = dot(Vec3vf<N>(cross(e1,v0+v1)),D);
+        const vfloat<N> W = dot(Vec3vf<N>(cross(e2,v1+v2)),D);
+        const vfloat<N> tU = twice(err*length(Vec3vf<N>(cross(e0,D))));
+        const vfloat<N> tV = twice(err*length(Vec3vf<N>(cross(e1,D))));
+        const vfloat<N> tW = twice(err*length(Vec3vf<N>(cross(e2,D))));
+        const vfloat<N> UVW = U+V+W;
+        const vfloat<N> eps = float(ulp)*abs(UVW);
+        const vbool<N> back = max(U-tU,V-tV,W-tW) <= eps;
+#if defined(EMBREE_BACKFACE_CULLING)
+        valid &= back;
+#else
+        const vbool<N> front = min(U+tU,V+tV,W+tW) >= -eps;
+        valid &= front | back;
+#endif
+        if (unlikely(none(valid))) return valid;
+
+        /* calculate geometry normal and denominator */
+        const Vec3vf<N> Ng = stable_triangle_normal(e0,e1,e2);
+        const vfloat<N> den = twice(dot(Vec3vf<N>(Ng),D));
+
+        /* perform depth test */
+        const vfloat<N> T = twice(dot(v0,Vec3vf<N>(Ng)));
+        const vfloat<N> t = rcp(den)*T;
+        valid &= tnear <= t & t <= tfar;
+        valid &= den != vfloat<N>(zero);
+        if (unlikely(none(valid))) return valid;
+
+        /* clamp hits outside the decoded triangle onto its edges */
+        const vbool<N> neg = UVW < vfloat<N>(zero);
+        const vfloat<N> Uc = select(neg,min(U,vfloat<N>(zero)),max(U,vfloat<N>(zero)));
+        const vfloat<N> Vc = select(neg,min(V,vfloat<N>(zero)),max(V,vfloat<N>(zero)));
+        const vfloat<N> Wc = select(neg,min(W,vfloat<N>(zero)),max(W,vfloat<N>(zero)));
+        U_o = Uc; V_o = Vc; UVW_o = Uc+Vc+Wc; t_o = t; Ng_o = Ng;
+        return valid;
+      }
+    };
+
+    template<int M>
+    struct QuantizedPlueckerIntersector1
+    {
+      __forceinline QuantizedPlueckerIntersector1() {}
+
+      __forceinline QuantizedPlueckerIntersector1(const Ray& ray, const void* ptr) {}
+
+      template<typename Epilog>
+      __forceinline bool intersect(Ray& ray,
+                                   const Vec3vf<M>& tri_v0,
+                                   const Vec3vf<M>& tri_v1,
+                                   const Vec3vf<M>& tri_v2,
+                                   const float err,
+                                   const Epilog& epilog) const
+      {
+        vfloat<M> U,V,UVW,t; Vec3vf<M> Ng;
+        const vbool<M> valid = QuantizedPlueckerTest<M>::intersect(true,Vec3vf<M>((Vec3fa)ray.org),Vec3vf<M>((Vec3fa)ray.dir),
+                                                                     vfloat<M>(ray.tnear()),vfloat<M>(ray.tfar),
+                                                                     tri_v0,tri_v1,tri_v2,vfloat<M>(err),U,V,UVW,t,Ng);
+        if (unlikely(none(valid))) return false;
+
+        UVIdentity<M> mapUV;
+        PlueckerHitM<M,UVIdentity<M>> hit(valid,U,V,UVW,t,Ng,mapUV);
+        return epilog(valid,hit);
+      }
+    };
+
+    template<int M, int K>
+    struct QuantizedPlueckerIntersectorK
+    {
+      __forceinline QuantizedPlueckerIntersectorK() {}
+
+      __forceinline QuantizedPlueckerIntersectorK(const vbool<K>& valid, const RayK<K>& ray) {}
+
+      /*! Intersects K rays with one of M triangles. */
+      template<typename Epilog>
+      __forceinline vbool<K> intersectK(const vbool<K>& valid0,
+                                        RayK<K>& ray,
+                                        const Vec3vf<K>& tri_v0,
+                                        const Vec3vf<K>& tri_v1,
+                                        const Vec3vf<K>& tri_v2,
+                                        const float err,
+                                        const Epilog& epilog) const
+      {
+        vfloat<K> U,V,UVW,t; Vec3vf<K> Ng;
+        const vbool<K> valid = QuantizedPlueckerTest<K>::intersect(valid0,ray.org,ray.dir,ray.tnear(),ray.tfar,
+                                                                     tri_v0,tri_v1,tri_v2,vfloat<K>(err),U,V,UVW,t,Ng);
+        if (unlikely(none(valid))) return valid;
+
+        UVIdentity<K> mapUV;
+        PlueckerHitK<K,UVIdentity<K>> hit(U,V,UVW,t,Ng,mapUV);
+        return epilog(valid,hit);
+      }
+
+      /*! Intersect k'th ray from ray packet of size K with M triangles. */
+      template<typename Epilog>
+      __forceinline bool intersect(RayK<K>& ray, size_t k,
+                                   const Vec3vf<M>& tri_v0,
+                                   const Vec3vf<M>& tri_v1,
+                                   const Vec3vf<M>& tri_v2,
+                                   const float err,
+                                   const Epilog& epilog) const
+      {
+        vfloat<M> U,V,UVW,t; Vec3vf<M> Ng;
+        const vbool<M> valid = QuantizedPlueckerTest<M>::intersect(true,broadcast<vfloat<M>>(ray.org,k),broadcast<vfloat<M>>(ray.dir,k),
+                                                                     vfloat<M>(ray.tnear()[k]),vfloat<M>(ray.tfar[k]),
+                                                                     tri_v0,tri_v1,tri_v2,vfloat<M>(err),U,V,UVW,t,Ng);
+        if (unlikely(none(valid))) return false;
+
+        UVIdentity<M> mapUV;
+        PlueckerHitM<M,UVIdentity<M>> hit(valid,U,V,UVW,t,Ng,mapUV);
+        return epilog(valid,hit);
+      }
+    };
+
+    /*! Intersects M quantized triangles with 1 ray */
+    template<int M, bool filter>
+    struct TriangleMqIntersector1Pluecker
+    {
+      typedef TriangleMq<M> Primitive;
+      typedef QuantizedPlueckerIntersector1<M> Precalculations;
+
+      /*! Intersect a ray with M triangles and updates the hit. */
+      static __forceinline void intersect(Precalculations& pre, RayHit& ray, RayQueryContext* context, const Primitive& tri)
+      {
+        STAT3(normal.trav_prims,1,1,1);
+        Vec3vf<M> v0, v1, v2; tri.gather(v0,v1,v2);
+        const vuint<M> geomIDs = tri.geomID(), primIDs = tri.primID();
+        pre.intersect(ray,v0,v1,v2,tri.error(),Intersect1EpilogM<M,filter>(ray,context,geomIDs,primIDs));
+      }
+
+      /*! Test if the ray is occluded by one of the M triangles. */
+      static __forceinline bool occluded(const Precalculations& pre, Ray& ray, RayQueryContext* context, const Primitive& tri)
+      {
+        STAT3(shadow.trav_prims,1,1,1);
+        Vec3vf<M> v0, v1, v2; tri.gather(v0,v1,v2);
+        const vuint<M> geomIDs = tri.geomID(), primIDs = tri.primID();
+        return pre.intersect(ray,v0,v1,v2,tri.error(),Occluded1EpilogM<M,filter>(ray,context,geomIDs,primIDs));
+      }
+
+      static __forceinline bool pointQuery(PointQuery* query, PointQueryContext* context, const Primitive& tri)
+      {
+        return PrimitivePointQuery1<Primitive>::pointQuery(query, context, tri);
+      }
+    };
+
+    /*! Intersects M quantized triangles with K rays */
+    template<int M, int K, bool filter>
+    struct TriangleMqIntersectorKPluecker
+    {
+      typedef TriangleMq<M> Primitive;
+      typedef QuantizedPlueckerIntersectorK<M,K> Precalculations;
+
+      /*! Intersects K rays with M triangles. */
+      static __forceinline void intersect(const vbool<K>& valid_i, Precalculations& pre, RayHitK<K>& ray, RayQueryContext* context, const Primitive& tri)
+      {
+        Vec3vf<M> v0, v1, v2; tri.gather(v0,v1,v2);
+        const vuint<M> geomIDs = tri.geomID(), primIDs = tri.primID();
+        for (size_t i=0; i<M; i++)
+        {
+          if (!tri.valid(i)) break;
+          STAT3(normal.trav_prims,1,popcnt(valid_i),K);
+          const Vec3vf<K> p0 = broadcast<vfloat<K>>(v0,i);
+          const Vec3vf<K> p1 = broadcast<vfloat<K>>(v1,i);
+          const Vec3vf<K> p2 = broadcast<vfloat<K>>(v2,i);
+          pre.intersectK(valid_i,ray,p0,p1,p2,tri.error(),IntersectKEpilogM<M,K,filter>(ray,context,geomIDs,primIDs,i));
+        }
+      }
+
+      /*! Test for K rays if they are occluded by any of the M triangles. */
+      static __forceinline vbool<K> occluded(const vbool<K>& valid_i, Precalculations& pre, RayK<K>& ray, RayQueryContext* context, const Primitive& tri)
+      {
+        vbool<K> valid0 = valid_i;
+        Vec3vf<M> v0, v1, v2; tri.gather(v0,v1,v2);
+        const vuint<M> geomIDs = tri.geomID(), primIDs = tri.primID();
+        for (size_t i=0; i<M; i++)
+        {
+          if (!tri.valid(i)) break;
+          STAT3(shadow.trav_prims,1,popcnt(valid_i),K);
+          const Vec3vf<K> p0 = broadcast<vfloat<K>>(v0,i);
+          const Vec3vf<K> p1 = broadcast<vfloat<K>>(v1,i);
+          const Vec3vf<K> p2 = broadcast<vfloat<K>>(v2,i);
+          pre.intersectK(valid0,ray,p0,p1,p2,tri.error(),OccludedKEpilogM<M,K,filter>(valid0,ray,context,geomIDs,primIDs,i));
+          if (none(valid0)) break;
+        }
+        return !valid0;
+      }
+
+      /*! Intersect a ray with M triangles and updates the hit. */
+      static __forceinline void intersect(Precalculations& pre, RayHitK<K>& ray, size_t k, RayQueryContext* context, const Primitive& tri)
+      {
+        STAT3(normal.trav_prims,1,1,1);
+        Vec3vf<M> v0, v1, v2; tri.gather(v0,v1,v2);
+        const vuint<M> geomIDs = tri.geomID(), primIDs = tri.primID();
+        pre.intersect(ray,k,v0,v1,v2,tri.error(),Intersect1KEpilogM<M,K,filter>(ray,k,context,geomIDs,primIDs));
+      }
+
+      /*! Test if the ray is occluded by one of the M triangles. */
+      static __forceinline bool occluded(Precalculations& pre, RayK<K>& ray, size_t k, RayQueryContext* context, const Primitive& tri)
+      {
+        STAT3(shadow.trav_prims,1,1,1);
+        Vec3vf<M> v0, v1, v2; tri.gather(v0,v1,v2);
+        const vuint<M> geomIDs = tri.geomID(), primIDs = tri.primID();
+        return pre.intersect(ray,k,v0,v1,v2,tri.error(),Occluded1KEpilogM<M,K,filter>(ray,k,context,geomIDs,primIDs));
+      }
+    };
+  }
+}
@@ -19,20 +19,20 @@ namespace embree
         typedef typename Patch::Ref Ref;
         typedef CatmullClarkPatchT<Vertex,Vertex_t> CatmullClarkPatch;
 
-        PatchEvalSimd (SharedLazyTessellationCache::CacheEntry& entry, size_t commitCounter, 
+        PatchEvalSimd (SharedLazyTessellationCache& cache, SharedLazyTessellationCache::CacheEntry& entry, size_t commitCounter, 
                        const HalfEdge* edge, const char* vertices, size_t stride, const vbool& valid0, const vfloat& u, const vfloat& v, 
                        float* P, float* dPdu, float* dPdv, float* ddPdudu, float* ddPdvdv, float* ddPdudv, const size_t dstride, const size_t N)
         : P(P), dPdu(dPdu), dPdv(dPdv), ddPdudu(ddPdudu), ddPdvdv(ddPdvdv), ddPdudv(ddPdudv), dstride(dstride), N(N)
         {
           /* conservative time for the very first allocation */
-          auto time = SharedLazyTessellationCache::sharedLazyTessellationCache.getTime(commitCounter);
+          auto time = cache.getTime(commitCounter);
 
-          Ref patch = SharedLazyTessellationCache::lookup(entry,commitCounter,[&] () {
-              auto alloc = [](size_t bytes) { return SharedLazyTessellationCache::malloc(bytes); };
+          Ref patch = cache.lookup(entry,commitCounter,[&] () {
+              auto alloc = [&](size_t bytes) { return cache.malloc(bytes); };
               return Patch::create(alloc,edge,vertices,stride);
             }, true);
 
-          auto curTime = SharedLazyTessellationCache::sharedLazyTessellationCache.getTime(commitCounter);
+          auto curTime = cache.getTime(commitCounter);
           const bool allAllocationsValid = SharedLazyTessellationCache::validTime(time,curTime);
           
           patch = allAllocationsValid ? patch : nullptr;
@@ -7,25 +7,26 @@
 
 namespace embree
 {
-  SharedLazyTessellationCache SharedLazyTessellationCache::sharedLazyTessellationCache;
-
   __thread ThreadWorkState* SharedLazyTessellationCache::init_t_state = nullptr;
   ThreadWorkState* SharedLazyTessellationCache::current_t_state = nullptr;
+  ThreadWorkState SharedLazyTessellationCache::threadWorkState[NUM_PREALLOC_THREAD_WORK_STATES];
+  SpinLock SharedLazyTessellationCache::linkedlist_mtx;
+  std::atomic<size_t> SharedLazyTessellationCache::numRenderThreads(0);
 
-  void resizeTessellationCache(size_t new_size)
-  {    
-    if (new_size >= SharedLazyTessellationCache::MAX_TESSELLATION_CACHE_SIZE)
-      new_size = SharedLazyTessellationCache::MAX_TESSELLATION_CACHE_SIZE;
-    if (SharedLazyTessellationCache::sharedLazyTessellationCache.getSize() != new_size) 
-      SharedLazyTessellationCache::sharedLazyTessellationCache.realloc(new_size);    
-  }
-
-  void resetTessellationCache()
+  /* frees the thread states that did not fit into the preallocated array */
+  static struct ThreadWorkStateCleanup
   {
-    //SharedLazyTessellationCache::sharedLazyTessellationCache.addCurrentIndex(SharedLazyTessellationCache::NUM_CACHE_SEGMENTS);
-    SharedLazyTessellationCache::sharedLazyTessellationCache.reset();
-  }
-  
+    ~ThreadWorkStateCleanup()
+    {
+      for (ThreadWorkState* t=SharedLazyTessellationCache::current_t_state; t!=nullptr; ) 
+      {
+        ThreadWorkState* next = t->next;
+        if (t->allocated) delete t;
+        t = next;
+      }
+    }
+  } threadWorkStateCleanup;
+
   SharedLazyTessellationCache::SharedLazyTessellationCache()
   {
     size = 0;
@@ -34,28 +35,16 @@ namespace embree
     maxBlocks              = size/BLOCK_SIZE;
     localTime              = NUM_CACHE_SEGMENTS;
     next_block             = 0;
-    numRenderThreads       = 0;
 #if FORCE_SIMPLE_FLUSH == 1
     switch_block_threshold = maxBlocks;
 #else
     switch_block_threshold = maxBlocks/NUM_CACHE_SEGMENTS;
 #endif
-    threadWorkState     = new ThreadWorkState[NUM_PREALLOC_THREAD_WORK_STATES];
-
-    //reset_state.reset();
-    //linkedlist_mtx.reset();
   }
 
   SharedLazyTessellationCache::~SharedLazyTessellationCache() 
   {
-    for (ThreadWorkState* t=current_t_state; t!=nullptr; ) 
-    {
-      ThreadWorkState* next = t->next;
-      if (t->allocated) delete t;
-      t = next;
-    }
-
-    delete[] threadWorkState;
+    if (data) os_free(data,size,hugepages);
   }
 
   void SharedLazyTessellationCache::getNextRenderThreadWorkState() 
@@ -100,7 +89,6 @@ namespace embree
         
         /* switch to the next segment */
         addCurrentIndex();
-        CACHE_STATS(PRINT("RESET TESS CACHE"));
         
 #if FORCE_SIMPLE_FLUSH == 1
         next_block = 0;
@@ -112,7 +100,7 @@ namespace embree
         assert( switch_block_threshold <= maxBlocks );
 #endif
         
-        CACHE_STATS(SharedTessellationCacheStats::cache_flushes++);
+        stats.flushes++;
         
         /* release all blocked threads */
         
@@ -167,7 +155,7 @@ namespace embree
     reset_state.unlock();
   }
 
-  void SharedLazyTessellationCache::realloc(const size_t new_size)
+  void SharedLazyTessellationCache::realloc(size_t new_size)
   {
     /* lock the reset_state */
     reset_state.lock();
@@ -181,6 +169,8 @@ namespace embree
         waitForUsersLessEqual(t,THREAD_BLOCK_ATOMIC_ADD);
 
     /* reallocate data */
+    if (new_size >= MAX_TESSELLATION_CACHE_SIZE)
+      new_size = MAX_TESSELLATION_CACHE_SIZE;
     if (data) os_free(data,size,hugepages);
     size      = new_size;
     data      = nullptr;
@@ -213,42 +203,13 @@ namespace embree
   }
 
 
-  ////////////////////////////////////////////////////////////////////////////////////////////////////////////
-  ////////////////////////////////////////////////////////////////////////////////////////////////////////////
-  ////////////////////////////////////////////////////////////////////////////////////////////////////////////
-
-  std::atomic<size_t> SharedTessellationCacheStats::cache_accesses(0);
-  std::atomic<size_t> SharedTessellationCacheStats::cache_hits(0);
-  std::atomic<size_t> SharedTessellationCacheStats::cache_misses(0);
-  std::atomic<size_t> SharedTessellationCacheStats::cache_flushes(0);  
-  SpinLock   SharedTessellationCacheStats::mtx;  
-  size_t SharedTessellationCacheStats::cache_num_patches(0);
-
-  void SharedTessellationCacheStats::printStats()
-  {
-    PRINT(cache_accesses);
-    PRINT(cache_misses);
-    PRINT(cache_hits);
-    PRINT(cache_flushes);
-    PRINT(100.0f * cache_hits / cache_accesses);
-    assert(cache_hits + cache_misses == cache_accesses);
-    PRINT(cache_num_patches);
-  }
-
-  void SharedTessellationCacheStats::clearStats()
-  {
-    SharedTessellationCacheStats::cache_accesses  = 0;
-    SharedTessellationCacheStats::cache_hits      = 0;
-    SharedTessellationCacheStats::cache_misses    = 0;
-    SharedTessellationCacheStats::cache_flushes   = 0;
-  }
-
   struct cache_regression_test : public RegressionTest
   {
     BarrierSys barrier;
     std::atomic<size_t> numFailed;
     std::atomic<int> threadIDCounter;
     static const size_t numEntries = 4*1024;
+    SharedLazyTessellationCache cache;
     SharedLazyTessellationCache::CacheEntry entry[numEntries];
 
     cache_regression_test() 
@@ -260,7 +221,7 @@ namespace embree
     static void thread_alloc(cache_regression_test* This)
     {
       int threadID = This->threadIDCounter++;
-      size_t maxN = SharedLazyTessellationCache::sharedLazyTessellationCache.maxAllocSize()/4;
+      size_t maxN = This->cache.maxAllocSize()/4;
       This->barrier.wait();
 
       for (size_t j=0; j<100000; j++)
@@ -268,14 +229,14 @@ namespace embree
         size_t elt = (threadID+j)%numEntries;
         size_t N = min(1+10*(elt%1000),maxN);
           
-        volatile int* data = (volatile int*) SharedLazyTessellationCache::lookup(This->entry[elt],0,[&] () {
-            int* data = (int*) SharedLazyTessellationCache::sharedLazyTessellationCache.malloc(4*N);
+        volatile int* data = (volatile int*) This->cache.lookup(This->entry[elt],0,[&] () {
+            int* data = (int*) This->cache.malloc(4*N);
             for (size_t k=0; k<N; k++) data[k] = (int)elt;
             return data;
           });
         
         if (data == nullptr) {
-          SharedLazyTessellationCache::sharedLazyTessellationCache.unlock();
+          SharedLazyTessellationCache::unlock();
           This->numFailed++;
           continue;
         }
@@ -288,7 +249,7 @@ namespace embree
           }
         }
         
-        SharedLazyTessellationCache::sharedLazyTessellationCache.unlock();
+        SharedLazyTessellationCache::unlock();
       }
       This->barrier.wait();
     }
@@ -296,6 +257,7 @@ namespace embree
     bool run ()
     {
       numFailed.store(0);
+      cache.realloc(32*1024*1024);
 
       size_t numThreads = getNumberOfLogicalThreads();
       barrier.init(numThreads+1);
@@ -319,10 +281,3 @@ namespace embree
 
   cache_regression_test cache_regression;
 };
-
-extern "C" void printTessCacheStats()
-{
-  PRINT("SHARED TESSELLATION CACHE");
-  embree::SharedTessellationCacheStats::printStats();
-  embree::SharedTessellationCacheStats::clearStats();
-}
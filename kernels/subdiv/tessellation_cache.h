@@ -10,33 +10,8 @@
 
 #define THREAD_BLOCK_ATOMIC_ADD 4
 
-#if defined(DEBUG)
-#define CACHE_STATS(x) 
-#else
-#define CACHE_STATS(x) 
-#endif
-
 namespace embree
 {
-  class SharedTessellationCacheStats
-  {
-  public:
-    /* stats */
-    static std::atomic<size_t> cache_accesses;
-    static std::atomic<size_t> cache_hits;
-    static std::atomic<size_t> cache_misses;
-    static std::atomic<size_t> cache_flushes;                
-    static size_t        cache_num_patches;
-    __aligned(64) static SpinLock mtx;
-    
-    /* print stats for debugging */                 
-    static void printStats();
-    static void clearStats();
-  };
-  
-  void resizeTessellationCache(size_t new_size);
-  void resetTessellationCache();
-  
  ////////////////////////////////////////////////////////////////////////////////
  ////////////////////////////////////////////////////////////////////////////////
  ////////////////////////////////////////////////////////////////////////////////
@@ -58,6 +33,8 @@ namespace embree
 
  class __aligned(64) SharedLazyTessellationCache 
  {
+   ALIGNED_CLASS_(64);
+
  public:
    
    static const size_t NUM_CACHE_SEGMENTS              = 8;
@@ -70,9 +47,12 @@ namespace embree
 #endif
    static const size_t MAX_TESSELLATION_CACHE_SIZE     = REF_TAG_MASK+1;
    static const size_t BLOCK_SIZE                      = 64;
+   static const size_t NUM_STAT_SLOTS                  = 16;
    
 
-    /*! Per thread tessellation ref cache */
+    /*! Per thread tessellation ref cache, the thread states are shared
+     *  by all cache instances, thus a cache blocks all render threads
+     *  when switching to its next segment */
    static __thread ThreadWorkState* init_t_state;
    static ThreadWorkState* current_t_state;
    
@@ -80,30 +60,61 @@ namespace embree
    {
      if (unlikely(!init_t_state))
        /* sets init_t_state, can't return pointer due to macosx icc bug*/
-       SharedLazyTessellationCache::sharedLazyTessellationCache.getNextRenderThreadWorkState();
+       SharedLazyTessellationCache::getNextRenderThreadWorkState();
      return init_t_state;
    }
 
+   /*! hit, miss and flush counters of a cache instance, hits get
+    *  counted in per thread slots to avoid contention on the hit path */
+   struct Statistics
+   {
+     struct __aligned(64) Slot { std::atomic<size_t> hits; };
+
+     Statistics () { clear(); }
+
+     __forceinline void hit(ThreadWorkState* t_state) {
+       slots[((size_t)t_state/sizeof(ThreadWorkState)) % NUM_STAT_SLOTS].hits.fetch_add(1,std::memory_order_relaxed);
+     }
+
+     size_t getHits() const
+     {
+       size_t h = 0;
+       for (size_t i=0; i<NUM_STAT_SLOTS; i++) h += slots[i].hits.load();
+       return h;
+     }
+
+     void clear()
+     {
+       for (size_t i=0; i<NUM_STAT_SLOTS; i++) slots[i].hits.store(0);
+       misses.store(0);
+       flushes.store(0);
+     }
+
+     Slot slots[NUM_STAT_SLOTS];
+     __aligned(64) std::atomic<size_t> misses;  //!< number of constructed cache entries
+     std::atomic<size_t> flushes;               //!< number of evicted cache segments
+   };
+
    struct Tag
    {
      __forceinline Tag() : data(0) {}
 
-     __forceinline Tag(void* ptr, size_t combinedTime) { 
-       init(ptr,combinedTime);
+     __forceinline Tag(void* ptr, void* base, size_t combinedTime) { 
+       init(ptr,base,combinedTime);
      }
 
-     __forceinline Tag(size_t ptr, size_t combinedTime) {
-       init((void*)ptr,combinedTime); 
+     __forceinline Tag(size_t ptr, void* base, size_t combinedTime) {
+       init((void*)ptr,base,combinedTime);
      }
 
-     __forceinline void init(void* ptr, size_t combinedTime)
+     __forceinline void init(void* ptr, void* base, size_t combinedTime)
      {
        if (ptr == nullptr) {
          data = 0;
          return;
        }
        int64_t new_root_ref = (int64_t) ptr;
-       new_root_ref -= (int64_t)SharedLazyTessellationCache::sharedLazyTessellationCache.getDataPtr();                                
+       new_root_ref -= (int64_t) base;
        assert( new_root_ref <= (int64_t)REF_TAG_MASK );
        new_root_ref |= (int64_t)combinedTime << COMMIT_INDEX_SHIFT; 
        data = new_root_ref;
@@ -131,15 +142,18 @@ namespace embree
    bool hugepages;
    size_t size;
    size_t maxBlocks;
-   ThreadWorkState *threadWorkState;
       
    __aligned(64) std::atomic<size_t> localTime;
    __aligned(64) std::atomic<size_t> next_block;
    __aligned(64) SpinLock   reset_state;
-   __aligned(64) SpinLock   linkedlist_mtx;
    __aligned(64) std::atomic<size_t> switch_block_threshold;
-   __aligned(64) std::atomic<size_t> numRenderThreads;
 
+   static ThreadWorkState threadWorkState[NUM_PREALLOC_THREAD_WORK_STATES];
+   static SpinLock linkedlist_mtx;
+   static std::atomic<size_t> numRenderThreads;
+
+ public:
+   Statistics stats;
 
  public:
 
@@ -147,7 +161,7 @@ namespace embree
    SharedLazyTessellationCache();
    ~SharedLazyTessellationCache();
 
-   void getNextRenderThreadWorkState();
+   static void getNextRenderThreadWorkState();
 
    __forceinline size_t maxAllocSize() const {
      return switch_block_threshold;
@@ -161,88 +175,83 @@ namespace embree
    }
 
 
-   __forceinline size_t lockThread  (ThreadWorkState *const t_state, const ssize_t plus=1) { return t_state->counter.fetch_add(plus);  }
-   __forceinline size_t unlockThread(ThreadWorkState *const t_state, const ssize_t plus=-1) { assert(isLocked(t_state)); return t_state->counter.fetch_add(plus); }
+   static __forceinline size_t lockThread  (ThreadWorkState *const t_state, const ssize_t plus=1) { return t_state->counter.fetch_add(plus);  }
+   static __forceinline size_t unlockThread(ThreadWorkState *const t_state, const ssize_t plus=-1) { assert(isLocked(t_state)); return t_state->counter.fetch_add(plus); }
 
-   __forceinline bool isLocked(ThreadWorkState *const t_state) { return t_state->counter.load() != 0; }
+   static __forceinline bool isLocked(ThreadWorkState *const t_state) { return t_state->counter.load() != 0; }
 
-   static __forceinline void lock  () { sharedLazyTessellationCache.lockThread(threadState()); }
-   static __forceinline void unlock() { sharedLazyTessellationCache.unlockThread(threadState()); }
-   static __forceinline bool isLocked() { return sharedLazyTessellationCache.isLocked(threadState()); }
+   static __forceinline void lock  () { lockThread(threadState()); }
+   static __forceinline void unlock() { unlockThread(threadState()); }
+   static __forceinline bool isLocked() { return isLocked(threadState()); }
    static __forceinline size_t getState() { return threadState()->counter.load(); }
-   static __forceinline void lockThreadLoop() { sharedLazyTessellationCache.lockThreadLoop(threadState()); }
-
-   static __forceinline size_t getTCacheTime(const size_t globalTime) {
-     return sharedLazyTessellationCache.getTime(globalTime);
-   }
+   static __forceinline void lockThreadLoop() { lockThreadLoop(threadState()); }
 
    /* per thread lock */
-   __forceinline void lockThreadLoop (ThreadWorkState *const t_state) 
+   static __forceinline void lockThreadLoop (ThreadWorkState *const t_state) 
    { 
      while(1)
      {
-       size_t lock = SharedLazyTessellationCache::sharedLazyTessellationCache.lockThread(t_state,1);
+       size_t lock = lockThread(t_state,1);
        if (unlikely(lock >= THREAD_BLOCK_ATOMIC_ADD))
        {
          /* lock failed wait until sync phase is over */
-         sharedLazyTessellationCache.unlockThread(t_state,-1);	       
-         sharedLazyTessellationCache.waitForUsersLessEqual(t_state,0);
+         unlockThread(t_state,-1);	       
+         waitForUsersLessEqual(t_state,0);
        }
        else
          break;
      }
    }
 
-   static __forceinline void* lookup(CacheEntry& entry, size_t globalTime)
+   __forceinline void* lookup(CacheEntry& entry, size_t globalTime)
    {   
      const int64_t subdiv_patch_root_ref = entry.tag.get(); 
-     CACHE_STATS(SharedTessellationCacheStats::cache_accesses++);
      
      if (likely(subdiv_patch_root_ref != 0)) 
      {
-       const size_t subdiv_patch_root = (subdiv_patch_root_ref & REF_TAG_MASK) + (size_t)sharedLazyTessellationCache.getDataPtr();
+       const size_t subdiv_patch_root = (subdiv_patch_root_ref & REF_TAG_MASK) + (size_t)getDataPtr();
        const size_t subdiv_patch_cache_index = extractCommitIndex(subdiv_patch_root_ref);
        
-       if (likely( sharedLazyTessellationCache.validCacheIndex(subdiv_patch_cache_index,globalTime) ))
-       {
-         CACHE_STATS(SharedTessellationCacheStats::cache_hits++);
+       if (likely( validCacheIndex(subdiv_patch_cache_index,globalTime) ))
          return (void*) subdiv_patch_root;
-       }
      }
-     CACHE_STATS(SharedTessellationCacheStats::cache_misses++);
      return nullptr;
    }
 
    template<typename Constructor>
-     static __forceinline auto lookup (CacheEntry& entry, size_t globalTime, const Constructor constructor, const bool before=false) -> decltype(constructor())
+     __forceinline auto lookup (CacheEntry& entry, size_t globalTime, const Constructor constructor, const bool before=false) -> decltype(constructor())
    {
      ThreadWorkState *t_state = SharedLazyTessellationCache::threadState();
 
      while (true)
      {
-       sharedLazyTessellationCache.lockThreadLoop(t_state);
-       void* patch = SharedLazyTessellationCache::lookup(entry,globalTime);
-       if (patch) return (decltype(constructor())) patch;
+       lockThreadLoop(t_state);
+       void* patch = lookup(entry,globalTime);
+       if (patch) {
+         stats.hit(t_state);
+         return (decltype(constructor())) patch;
+       }
        
        if (entry.mutex.try_lock())
        {
          if (!validTag(entry.tag,globalTime)) 
          {
-           auto timeBefore = sharedLazyTessellationCache.getTime(globalTime);
+           auto timeBefore = getTime(globalTime);
            auto ret = constructor(); // thread is locked here!
            assert(ret);
            /* this should never return nullptr */
-           auto timeAfter = sharedLazyTessellationCache.getTime(globalTime);
+           auto timeAfter = getTime(globalTime);
            auto time = before ? timeBefore : timeAfter;
            __memory_barrier();
-           entry.tag = SharedLazyTessellationCache::Tag(ret,time);
+           entry.tag = SharedLazyTessellationCache::Tag(ret,getDataPtr(),time);
            __memory_barrier();
            entry.mutex.unlock();
+           stats.misses++;
            return ret;
          }
          entry.mutex.unlock();
        }
-       SharedLazyTessellationCache::sharedLazyTessellationCache.unlockThread(t_state);
+       unlockThread(t_state);
      }
    }
    
@@ -261,16 +270,16 @@ namespace embree
    }
 
 
-    static __forceinline bool validTag(const Tag& tag, size_t globalTime)
+    __forceinline bool validTag(const Tag& tag, size_t globalTime)
     {
       const int64_t subdiv_patch_root_ref = tag.get(); 
       if (subdiv_patch_root_ref == 0) return false;
       const size_t subdiv_patch_cache_index = extractCommitIndex(subdiv_patch_root_ref);
-      return sharedLazyTessellationCache.validCacheIndex(subdiv_patch_cache_index,globalTime);
+      return validCacheIndex(subdiv_patch_cache_index,globalTime);
     }
 
-   void waitForUsersLessEqual(ThreadWorkState *const t_state,
-			      const unsigned int users);
+   static void waitForUsersLessEqual(ThreadWorkState *const t_state,
+                                     const unsigned int users);
     
    __forceinline size_t alloc(const size_t blocks)
    {
@@ -283,23 +292,23 @@ namespace embree
      return index;
    }
 
-   static __forceinline void* malloc(const size_t bytes)
+   __forceinline void* malloc(const size_t bytes)
    {
      size_t block_index = -1;
      ThreadWorkState *const t_state = threadState();
      while (true)
      {
-       block_index = sharedLazyTessellationCache.alloc((bytes+BLOCK_SIZE-1)/BLOCK_SIZE);
+       block_index = alloc((bytes+BLOCK_SIZE-1)/BLOCK_SIZE);
        if (block_index == (size_t)-1)
        {
-         sharedLazyTessellationCache.unlockThread(t_state);		  
-         sharedLazyTessellationCache.allocNextSegment();
-         sharedLazyTessellationCache.lockThread(t_state);
+         unlockThread(t_state);		  
+         allocNextSegment();
+         lockThread(t_state);
          continue; 
        }
        break;
      }
-     return sharedLazyTessellationCache.getBlockPtr(block_index);
+     return getBlockPtr(block_index);
    }
 
    __forceinline void *getBlockPtr(const size_t block_index)
@@ -319,7 +328,5 @@ namespace embree
    void realloc(const size_t newSize);
 
    void reset();
-
-   static SharedLazyTessellationCache sharedLazyTessellationCache;
  };
 }
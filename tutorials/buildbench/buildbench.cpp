@@ -46,10 +46,19 @@ namespace embree
   {
     if (!tutorial) {
       tutorial.reset(new Tutorial());
+      /* the task scheduler uses the maximal thread count of all
+       * devices, thus the tutorial device must not use more threads
+       * than the phase timings devices */
+      if (buildParams.buildBenchType == BuildBenchType::PHASE_TIMINGS)
+        tutorial->rtcore += ",threads=1";
       tutorial->main(argc,argv);
     }
 
-    if (buildParams.userThreads == 0)
+    if (buildParams.buildBenchType == BuildBenchType::PHASE_TIMINGS)
+    {
+      Benchmark_Phase_Timings(params, buildParams, tutorial->ispc_scene.get());
+    }
+    else if (buildParams.userThreads == 0)
     {
       /* set error handler */
       if (buildParams.buildBenchType & BuildBenchType::UPDATE_DYNAMIC_DEFORMABLE) {
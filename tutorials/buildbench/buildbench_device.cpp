@@ -11,6 +11,8 @@
 #endif
 
 #include <thread>
+#include <fstream>
+#include <algorithm>
 
 namespace embree {
 
@@ -626,6 +628,115 @@ namespace embree {
 #endif
   }
 
+  /* phase timings of one BVH averaged over all benchmark iterations */
+  struct PhaseTimings
+  {
+    std::string builder;
+    std::string primitiveType;
+    size_t numPrimitives = 0;
+    double phases[8] = { 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0 };
+  };
+
+  static const char* phase_names[8] = { "total", "primrefs", "presplits", "binning", "partitioning", "leaves", "allocator", "toplevel" };
+
+  static void accumulatePhaseTimings(std::vector<PhaseTimings>& timings, RTCScene scene)
+  {
+    const unsigned int numBVHs = rtcGetSceneBuildStatistics(scene,nullptr,0);
+    std::vector<RTCBuildStatistics> stats(numBVHs);
+    rtcGetSceneBuildStatistics(scene,stats.data(),numBVHs);
+
+    timings.resize(std::max(timings.size(),stats.size()));
+    for (size_t i=0; i<stats.size(); i++)
+    {
+      const RTCBuildStatistics& s = stats[i];
+      timings[i].builder = s.builder;
+      timings[i].primitiveType = s.primitiveType;
+      timings[i].numPrimitives = s.numPrimitives;
+      const double phases[8] = { s.total, s.primRefs, s.presplits, s.binning, s.partitioning, s.leaves, s.allocator, s.topLevel };
+      for (size_t j=0; j<8; j++)
+        timings[i].phases[j] += phases[j];
+    }
+  }
+
+  void Benchmark_Phase_Timings(BenchParams& params, BuildBenchParams& buildParams, ISPCScene* scene_in)
+  {
+    size_t benchmark_iterations = params.minTimeOrIterations;
+    if (benchmark_iterations <= 0)
+      benchmark_iterations = iterations_static_static;
+
+    /* sweep over 1, 2, 4, ... threads up to the specified maximum */
+    std::vector<int> threadCounts;
+    for (int t=1; t<buildParams.phaseTimingsThreads; t*=2)
+      threadCounts.push_back(t);
+    threadCounts.push_back(buildParams.phaseTimingsThreads);
+
+    const std::string& filename = buildParams.phaseTimingsFile;
+    const bool json = filename.size() >= 5 && filename.substr(filename.size()-5) == ".json";
+    std::ofstream out(filename.c_str());
+    if (!out) FATAL("cannot open file " + filename);
+    out.precision(9);
+
+    if (json) out << "[";
+    else {
+      out << "scene,version,threads,quality,builder,primitive_type,primitives";
+      for (size_t j=0; j<8; j++) out << "," << phase_names[j];
+      out << std::endl;
+    }
+
+    /* the scenes get converted using g_device, thus temporarily replace it */
+    RTCDevice tutorial_device = g_device;
+    bool first = true;
+
+    for (int threads : threadCounts)
+    {
+      const std::string cfg = "threads=" + std::to_string(threads) + ",build_statistics=1";
+      g_device = rtcNewDevice(cfg.c_str());
+      if (!g_device) FATAL("cannot create device");
+
+      const RTCBuildQuality qualities[2] = { RTC_BUILD_QUALITY_MEDIUM, RTC_BUILD_QUALITY_HIGH };
+      for (RTCBuildQuality qflags : qualities)
+      {
+        std::vector<PhaseTimings> timings;
+        for (size_t i=0; i<benchmark_iterations+params.skipIterations; i++)
+        {
+          RTCScene scene = createScene(RTC_SCENE_FLAG_NONE,qflags);
+          convertScene(scene,scene_in,RTC_BUILD_QUALITY_MEDIUM);
+          rtcCommitScene(scene);
+          if (i >= params.skipIterations)
+            accumulatePhaseTimings(timings,scene);
+          rtcReleaseScene(scene);
+        }
+
+        const char* quality = qflags == RTC_BUILD_QUALITY_HIGH ? "high" : "medium";
+        for (const PhaseTimings& t : timings)
+        {
+          if (json) {
+            out << (first ? "" : ",") << std::endl;
+            out << "  { \"scene\": \"" << buildParams.sceneName << "\", \"version\": \"" << RTC_VERSION_STRING << "\", "
+                << "\"threads\": " << threads << ", \"quality\": \"" << quality << "\", "
+                << "\"builder\": \"" << t.builder << "\", \"primitive_type\": \"" << t.primitiveType << "\", "
+                << "\"primitives\": " << t.numPrimitives;
+            for (size_t j=0; j<8; j++) out << ", \"" << phase_names[j] << "\": " << t.phases[j]/benchmark_iterations;
+            out << " }";
+          } else {
+            out << buildParams.sceneName << "," << RTC_VERSION_STRING << "," << threads << "," << quality << ","
+                << t.builder << "," << t.primitiveType << "," << t.numPrimitives;
+            for (size_t j=0; j<8; j++) out << "," << t.phases[j]/benchmark_iterations;
+            out << std::endl;
+          }
+          first = false;
+        }
+        std::cout << "BENCHMARK_PHASE_TIMINGS " << threads << " threads, " << quality << " quality, "
+                  << timings.size() << " BVHs" << std::endl;
+      }
+
+      rtcReleaseDevice(g_device);
+    }
+
+    g_device = tutorial_device;
+    if (json) out << std::endl << "]" << std::endl;
+  }
+
   extern "C" void device_init (char* cfg)
   {
   }
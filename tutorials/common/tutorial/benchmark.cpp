@@ -12,6 +12,8 @@
 #include <sstream>
 #include <fstream>
 #include <memory>
+#include <thread>
+#include <algorithm>
 
 #include "benchmark.h"
 
@@ -215,8 +217,10 @@ void TutorialBuildBenchmark::registerBuildBenchmark(std::string name, BuildBench
     if (attach) name += "_" + getBuildBenchTypeString(buildBenchType);
     BuildBenchParams p = buildParams;
     p.buildBenchType = buildBenchType;
+    p.sceneName = name;
 #ifdef USE_GOOGLE_BENCHMARK
-    if (params.legacy) {
+    // phase timings are not measured per iteration and thus not run as google benchmark
+    if (params.legacy || buildBenchType == BuildBenchType::PHASE_TIMINGS) {
       std::cout << "BENCHMARK SCENE: " << name << std::endl;
       BenchState benchState;
       buildBenchFunc(benchState, params, p, argc, argv);
@@ -243,11 +247,20 @@ void TutorialBuildBenchmark::registerBenchmark(std::string const& name, int argc
   registerBuildBenchmark(name, BuildBenchType::CREATE_STATIC_STATIC,              argc, argv);
   registerBuildBenchmark(name, BuildBenchType::CREATE_HIGH_QUALITY_STATIC_STATIC, argc, argv);
   registerBuildBenchmark(name, BuildBenchType::CREATE_USER_THREADS_STATIC_STATIC, argc, argv);
+  registerBuildBenchmark(name, BuildBenchType::PHASE_TIMINGS,                     argc, argv);
 }
 
 void TutorialBuildBenchmark::postParseCommandLine()
 {
-  if (buildParams.userThreads > 0) {
+  if (buildParams.phaseTimingsFile != "")
+    buildParams.buildBenchType = BuildBenchType::PHASE_TIMINGS;
+
+  if (buildParams.buildBenchType == BuildBenchType::PHASE_TIMINGS) {
+    if (buildParams.phaseTimingsFile == "")
+      buildParams.phaseTimingsFile = "phase_timings.csv";
+    if (buildParams.phaseTimingsThreads <= 0)
+      buildParams.phaseTimingsThreads = std::max(1,(int)std::thread::hardware_concurrency());
+  } else if (buildParams.userThreads > 0) {
     buildParams.buildBenchType = BuildBenchType::CREATE_USER_THREADS_STATIC_STATIC;
   } else {
     buildParams.buildBenchType = (BuildBenchType)(buildParams.buildBenchType & ~(BuildBenchType::CREATE_USER_THREADS_STATIC_STATIC));
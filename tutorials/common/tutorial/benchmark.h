@@ -22,7 +22,8 @@ enum BuildBenchType {
   CREATE_STATIC_STATIC = 64,
   CREATE_HIGH_QUALITY_STATIC_STATIC = 128,
   CREATE_USER_THREADS_STATIC_STATIC = 256,
-  ALL = 511
+  ALL = 511,
+  PHASE_TIMINGS = 512
 };
 
 static MAYBE_UNUSED BuildBenchType getBuildBenchType(std::string const& str)
@@ -36,6 +37,7 @@ static MAYBE_UNUSED BuildBenchType getBuildBenchType(std::string const& str)
   else if (str == "create_static_static")              return BuildBenchType::CREATE_STATIC_STATIC;
   else if (str == "create_high_quality_static_static") return BuildBenchType::CREATE_HIGH_QUALITY_STATIC_STATIC;
   else if (str == "create_user_threads_static_static") return BuildBenchType::CREATE_USER_THREADS_STATIC_STATIC;
+  else if (str == "phase_timings")                     return BuildBenchType::PHASE_TIMINGS;
   return BuildBenchType::ALL;
 }
 
@@ -50,6 +52,7 @@ static MAYBE_UNUSED std::string getBuildBenchTypeString(BuildBenchType type)
   else if (type == BuildBenchType::CREATE_STATIC_STATIC)              return "create_static_static";
   else if (type == BuildBenchType::CREATE_HIGH_QUALITY_STATIC_STATIC) return "create_high_quality_static_static";
   else if (type == BuildBenchType::CREATE_USER_THREADS_STATIC_STATIC) return "create_user_threads_static_static";
+  else if (type == BuildBenchType::PHASE_TIMINGS)                     return "phase_timings";
   return "all";
 }
 
@@ -68,6 +71,9 @@ struct BenchParams {
 struct BuildBenchParams {
   BuildBenchType buildBenchType = BuildBenchType::ALL;
   int userThreads = 0;
+  std::string sceneName = "";         // name of the benchmarked scene
+  std::string phaseTimingsFile = "";  // JSON (.json) or CSV output file of phase timings mode
+  int phaseTimingsThreads = 0;        // maximal number of threads of phase timings mode
 };
 
 using BenchFunc = void(*)(BenchState& state, BenchParams& params, int argc, char** argv);
@@ -150,6 +156,14 @@ struct TutorialBuildBenchmark : public TutorialBenchmark
     commandLineParser.registerOption("user_threads", [this] (Ref<ParseStream> cin, const FileName& path) {
         buildParams.userThreads = cin->getInt();
       }, "--user_threads <int>: invokes user thread benchmark with specified number of application provided build threads");
+    commandLineParser.registerOption("phase_timings", [this] (Ref<ParseStream> cin, const FileName& path) {
+        buildParams.phaseTimingsFile = cin->getString();
+        processedCommandLineOptions.push_back("--phase_timings");
+      }, "--phase_timings <filename>: writes the time of each build phase per BVH and thread count to a JSON (.json) or CSV file");
+    commandLineParser.registerOption("phase_timings_threads", [this] (Ref<ParseStream> cin, const FileName& path) {
+        buildParams.phaseTimingsThreads = cin->getInt();
+        processedCommandLineOptions.push_back("--phase_timings_threads");
+      }, "--phase_timings_threads <int>: measures phase timings for 1, 2, 4, ... up to the specified number of threads");
   }
 
 private:
@@ -0,0 +1,94 @@
+// Copyright 2009-2021 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include "tracebench.h"
+
+#include "../common/tutorial/tutorial.h"
+
+#include <iostream>
+#include <sstream>
+
+RTC_NAMESPACE_USE;
+
+namespace embree
+{
+  static std::vector<std::string> splitList(const std::string& str)
+  {
+    std::vector<std::string> tokens;
+    std::stringstream ss(str);
+    std::string token;
+    while (std::getline(ss,token,','))
+      if (token != "") tokens.push_back(token);
+    return tokens;
+  }
+
+  struct Tutorial : public SceneLoadingTutorialApplication
+  {
+    TraceBenchParams params;
+
+    Tutorial()
+      : SceneLoadingTutorialApplication("trace_bench",FEATURE_RTCORE)
+    {
+      interactive = false;
+
+      registerOption("bench_isas", [this] (Ref<ParseStream> cin, const FileName& path) {
+          params.isas = splitList(cin->getString());
+        }, "--bench_isas <list>: comma separated list of ISAs to benchmark, e.g. sse2,avx2,avx512 (default: all supported ISAs)");
+
+      registerOption("bench_threads", [this] (Ref<ParseStream> cin, const FileName& path) {
+          for (auto& str : splitList(cin->getString()))
+            params.threads.push_back(std::stoi(str));
+        }, "--bench_threads <list>: comma separated list of thread counts to benchmark (default: 1, 2, 4, ... up to all threads)");
+
+      registerOption("bench_iterations", [this] (Ref<ParseStream> cin, const FileName& path) {
+          params.skipIterations = cin->getInt();
+          params.iterations = cin->getInt();
+        }, "--bench_iterations <N> <M>: traces all rays N times for warm-up and M times for measurement");
+
+      registerOption("seed", [this] (Ref<ParseStream> cin, const FileName& path) {
+          params.seed = cin->getInt();
+        }, "--seed <int>: seed of the random ray distributions");
+
+      registerOption("bench_output", [this] (Ref<ParseStream> cin, const FileName& path) {
+          params.outputFile = cin->getString();
+        }, "--bench_output <filename>: writes the results to a JSON (.json) or CSV file");
+    }
+
+    void postParseCommandLine() override
+    {
+      /* load default scene if none specified */
+      if (scene_empty_post_parse()) {
+        FileName file = FileName::executableFolder() + FileName("models/cornell_box.ecs");
+        parseCommandLine(new ParseStream(new LineCommentFilter(file, "#")), file.path());
+      }
+    }
+
+    /* traces the rays of the loaded scene after main loaded it */
+    int benchmark()
+    {
+      if (!ispc_scene) return 1;
+
+      params.sceneName = sceneFilename.size() ? sceneFilename[0].name() : "default";
+      params.rtcore = rtcore;
+      params.width = width;
+      params.height = height;
+      Benchmark_Trace(params,ispc_scene.get(),camera);
+      return 0;
+    }
+  };
+}
+
+int main(int argc, char** argv)
+{
+  embree::Tutorial tutorial;
+  if (int code = tutorial.main(argc,argv))
+    return code;
+
+  try {
+    return tutorial.benchmark();
+  }
+  catch (const std::exception& e) {
+    std::cout << "Error: " << e.what() << std::endl;
+    return 1;
+  }
+}
@@ -0,0 +1,28 @@
+// Copyright 2009-2021 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+namespace embree {
+  struct ISPCScene;
+  struct Camera;
+
+  struct TraceBenchParams
+  {
+    std::string sceneName = "";        // name of the benchmarked scene
+    std::string rtcore = "";           // configuration of the benchmarked devices
+    std::vector<std::string> isas;     // ISAs to benchmark, all supported ISAs if empty
+    std::vector<int> threads;          // thread counts to benchmark, 1, 2, 4, ... up to all threads if empty
+    unsigned int width = 0;            // resolution of the primary rays
+    unsigned int height = 0;
+    unsigned int seed = 0;             // seed of all random ray distributions
+    int skipIterations = 1;            // number of warm-up passes over all rays
+    int iterations = 4;                // number of measured passes over all rays
+    std::string outputFile = "";       // JSON (.json) or CSV output file
+  };
+
+  void Benchmark_Trace(TraceBenchParams& params, ISPCScene* ispc_scene, Camera& camera);
+}
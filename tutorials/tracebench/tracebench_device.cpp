@@ -0,0 +1,530 @@
+// Copyright 2009-2021 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include "tracebench.h"
+
+#include "../common/math/random_sampler.h"
+#include "../common/math/sampling.h"
+#include "../common/tutorial/tutorial_device.h"
+#include "../common/tutorial/scene_device.h"
+
+#include <atomic>
+#include <thread>
+#include <fstream>
+#include <functional>
+
+namespace embree {
+
+  /* number of rays or point queries a thread processes at once */
+  static const size_t BLOCK_SIZE = 256;
+
+  /* all ISAs Embree got compiled for */
+  static const int g_isas[] = {
+#if defined(EMBREE_TARGET_SSE2)
+    SSE2,
+#endif
+#if defined(EMBREE_TARGET_SSE42)
+    SSE42,
+#endif
+#if defined(EMBREE_TARGET_AVX)
+    AVX,
+#endif
+#if defined(EMBREE_TARGET_AVX2)
+    AVX2,
+#endif
+#if defined(EMBREE_TARGET_AVX512)
+    AVX512,
+#endif
+  };
+
+  static bool hasISA(const int isa) {
+    return (getCPUFeatures() & isa) == isa;
+  }
+
+  enum QueryType { INTERSECT1, INTERSECT4, INTERSECT8, INTERSECT16, OCCLUDED1, OCCLUDED4, OCCLUDED8, OCCLUDED16 };
+
+  static const char* query_names[] = { "intersect1", "intersect4", "intersect8", "intersect16", "occluded1", "occluded4", "occluded8", "occluded16" };
+
+  /* a named set of rays traced by the benchmark */
+  struct RayDistribution
+  {
+    RayDistribution (const std::string& name)
+      : name(name) {}
+
+    std::string name;
+    std::vector<RTCRay> rays;
+  };
+
+  void convertTriangleMesh(RTCDevice device, ISPCTriangleMesh* mesh, RTCScene scene_out)
+  {
+    RTCGeometry geom = rtcNewGeometry (device, RTC_GEOMETRY_TYPE_TRIANGLE);
+    rtcSetGeometryTimeStepCount(geom,mesh->numTimeSteps);
+    for (unsigned int t=0; t<mesh->numTimeSteps; t++) {
+      rtcSetSharedGeometryBuffer(geom, RTC_BUFFER_TYPE_VERTEX, t, RTC_FORMAT_FLOAT3, mesh->positions[t], 0, sizeof(Vec3fa), mesh->numVertices);
+    }
+    rtcSetSharedGeometryBuffer(geom, RTC_BUFFER_TYPE_INDEX, 0, RTC_FORMAT_UINT3, mesh->triangles, 0, sizeof(ISPCTriangle), mesh->numTriangles);
+    rtcCommitGeometry(geom);
+    rtcAttachGeometry(scene_out,geom);
+    rtcReleaseGeometry(geom);
+  }
+
+  void convertQuadMesh(RTCDevice device, ISPCQuadMesh* mesh, RTCScene scene_out)
+  {
+    RTCGeometry geom = rtcNewGeometry (device, RTC_GEOMETRY_TYPE_QUAD);
+    rtcSetGeometryTimeStepCount(geom,mesh->numTimeSteps);
+    for (unsigned int t=0; t<mesh->numTimeSteps; t++) {
+      rtcSetSharedGeometryBuffer(geom, RTC_BUFFER_TYPE_VERTEX, t, RTC_FORMAT_FLOAT3, mesh->positions[t], 0, sizeof(Vec3fa), mesh->numVertices);
+    }
+    rtcSetSharedGeometryBuffer(geom, RTC_BUFFER_TYPE_INDEX, 0, RTC_FORMAT_UINT4, mesh->quads, 0, sizeof(ISPCQuad), mesh->numQuads);
+    rtcCommitGeometry(geom);
+    rtcAttachGeometry(scene_out,geom);
+    rtcReleaseGeometry(geom);
+  }
+
+  void convertGridMesh(RTCDevice device, ISPCGridMesh* mesh, RTCScene scene_out)
+  {
+    RTCGeometry geom = rtcNewGeometry (device, RTC_GEOMETRY_TYPE_GRID);
+    rtcSetGeometryTimeStepCount(geom,mesh->numTimeSteps);
+    for (unsigned int t=0; t<mesh->numTimeSteps; t++) {
+      rtcSetSharedGeometryBuffer(geom, RTC_BUFFER_TYPE_VERTEX, t, RTC_FORMAT_FLOAT3, mesh->positions[t], 0, sizeof(Vec3fa), mesh->numVertices);
+    }
+    rtcSetSharedGeometryBuffer(geom, RTC_BUFFER_TYPE_GRID, 0, RTC_FORMAT_GRID, mesh->grids, 0, sizeof(ISPCGrid), mesh->numGrids);
+    rtcCommitGeometry(geom);
+    rtcAttachGeometry(scene_out,geom);
+    rtcReleaseGeometry(geom);
+  }
+
+  void convertSubdivMesh(RTCDevice device, ISPCSubdivMesh* mesh, RTCScene scene_out)
+  {
+    RTCGeometry geom = rtcNewGeometry(device, RTC_GEOMETRY_TYPE_SUBDIVISION);
+    rtcSetGeometryTimeStepCount(geom,mesh->numTimeSteps);
+    for (unsigned int t=0; t<mesh->numTimeSteps; t++) {
+      rtcSetSharedGeometryBuffer(geom, RTC_BUFFER_TYPE_VERTEX, t, RTC_FORMAT_FLOAT3, mesh->positions[t], 0, sizeof(Vec3fa), mesh->numVertices);
+    }
+    rtcSetSharedGeometryBuffer(geom, RTC_BUFFER_TYPE_LEVEL, 0, RTC_FORMAT_FLOAT, mesh->subdivlevel,      0, sizeof(float),        mesh->numEdges);
+    rtcSetSharedGeometryBuffer(geom, RTC_BUFFER_TYPE_INDEX, 0, RTC_FORMAT_UINT,  mesh->position_indices, 0, sizeof(unsigned int), mesh->numEdges);
+    rtcSetSharedGeometryBuffer(geom, RTC_BUFFER_TYPE_FACE,  0, RTC_FORMAT_UINT,  mesh->verticesPerFace,  0, sizeof(unsigned int), mesh->numFaces);
+    rtcSetSharedGeometryBuffer(geom, RTC_BUFFER_TYPE_HOLE,  0, RTC_FORMAT_UINT,  mesh->holes,            0, sizeof(unsigned int), mesh->numHoles);
+    rtcSetSharedGeometryBuffer(geom, RTC_BUFFER_TYPE_EDGE_CREASE_INDEX,    0, RTC_FORMAT_UINT2, mesh->edge_creases,          0, 2*sizeof(unsigned int), mesh->numEdgeCreases);
+    rtcSetSharedGeometryBuffer(geom, RTC_BUFFER_TYPE_EDGE_CREASE_WEIGHT,   0, RTC_FORMAT_FLOAT, mesh->edge_crease_weights,   0, sizeof(float),          mesh->numEdgeCreases);
+    rtcSetSharedGeometryBuffer(geom, RTC_BUFFER_TYPE_VERTEX_CREASE_INDEX,  0, RTC_FORMAT_UINT,  mesh->vertex_creases,        0, sizeof(unsigned int),   mesh->numVertexCreases);
+    rtcSetSharedGeometryBuffer(geom, RTC_BUFFER_TYPE_VERTEX_CREASE_WEIGHT, 0, RTC_FORMAT_FLOAT, mesh->vertex_crease_weights, 0, sizeof(float),          mesh->numVertexCreases);
+    rtcSetGeometrySubdivisionMode(geom, 0, mesh->position_subdiv_mode);
+    rtcCommitGeometry(geom);
+    rtcAttachGeometry(scene_out,geom);
+    rtcReleaseGeometry(geom);
+  }
+
+  void convertCurveGeometry(RTCDevice device, ISPCHairSet* hair, RTCScene scene_out)
+  {
+    RTCGeometry geom = rtcNewGeometry (device, hair->type);
+    rtcSetGeometryTimeStepCount(geom,hair->numTimeSteps);
+    for (unsigned int t=0; t<hair->numTimeSteps; t++) {
+      rtcSetSharedGeometryBuffer(geom, RTC_BUFFER_TYPE_VERTEX, t, RTC_FORMAT_FLOAT4, hair->positions[t], 0, sizeof(Vertex), hair->numVertices);
+      if (hair->normals)
+        rtcSetSharedGeometryBuffer(geom, RTC_BUFFER_TYPE_NORMAL, t, RTC_FORMAT_FLOAT3, hair->normals[t], 0, sizeof(Vec3fa), hair->numVertices);
+      if (hair->tangents)
+        rtcSetSharedGeometryBuffer(geom, RTC_BUFFER_TYPE_TANGENT, t, RTC_FORMAT_FLOAT4, hair->tangents[t], 0, sizeof(Vec3fa), hair->numVertices);
+      if (hair->dnormals)
+        rtcSetSharedGeometryBuffer(geom, RTC_BUFFER_TYPE_NORMAL_DERIVATIVE, t, RTC_FORMAT_FLOAT3, hair->dnormals[t], 0, sizeof(Vec3fa), hair->numVertices);
+    }
+    rtcSetSharedGeometryBuffer(geom, RTC_BUFFER_TYPE_INDEX, 0, RTC_FORMAT_UINT, hair->hairs, 0, sizeof(ISPCHair), hair->numHairs);
+    if (hair->flags)
+      rtcSetSharedGeometryBuffer(geom, RTC_BUFFER_TYPE_FLAGS, 0, RTC_FORMAT_UCHAR, hair->flags, 0, sizeof(unsigned char), hair->numHairs);
+    if (hair->type != RTC_GEOMETRY_TYPE_FLAT_LINEAR_CURVE)
+      rtcSetGeometryTessellationRate(geom,(float)hair->tessellation_rate);
+    rtcCommitGeometry(geom);
+    rtcAttachGeometry(scene_out,geom);
+    rtcReleaseGeometry(geom);
+  }
+
+  void convertPoints(RTCDevice device, ISPCPointSet* points, RTCScene scene_out)
+  {
+    RTCGeometry geom = rtcNewGeometry (device, points->type);
+    rtcSetGeometryTimeStepCount(geom,points->numTimeSteps);
+    for (unsigned int t=0; t<points->numTimeSteps; t++) {
+      rtcSetSharedGeometryBuffer(geom, RTC_BUFFER_TYPE_VERTEX, t, RTC_FORMAT_FLOAT4, points->positions[t], 0, sizeof(Vertex), points->numVertices);
+      if (points->normals)
+        rtcSetSharedGeometryBuffer(geom, RTC_BUFFER_TYPE_NORMAL, t, RTC_FORMAT_FLOAT3, points->normals[t], 0, sizeof(Vec3fa), points->numVertices);
+    }
+    rtcCommitGeometry(geom);
+    rtcAttachGeometry(scene_out,geom);
+    rtcReleaseGeometry(geom);
+  }
+
+  /* converts the scene for the specified device, instances are not supported as the tutorial flattens scenes by default */
+  RTCScene convertScene(RTCDevice device, ISPCScene* scene_in)
+  {
+    RTCScene scene_out = rtcNewScene(device);
+    for (unsigned int i=0; i<scene_in->numGeometries; i++)
+    {
+      ISPCGeometry* geometry = scene_in->geometries[i];
+      if      (geometry->type == TRIANGLE_MESH) convertTriangleMesh(device,(ISPCTriangleMesh*) geometry,scene_out);
+      else if (geometry->type == QUAD_MESH)     convertQuadMesh    (device,(ISPCQuadMesh*) geometry,scene_out);
+      else if (geometry->type == GRID_MESH)     convertGridMesh    (device,(ISPCGridMesh*) geometry,scene_out);
+      else if (geometry->type == SUBDIV_MESH)   convertSubdivMesh  (device,(ISPCSubdivMesh*) geometry,scene_out);
+      else if (geometry->type == CURVES)        convertCurveGeometry(device,(ISPCHairSet*) geometry,scene_out);
+      else if (geometry->type == POINTS)        convertPoints      (device,(ISPCPointSet*) geometry,scene_out);
+      else
+        std::cout << "warning: geometry " << i << " of unsupported type ignored" << std::endl;
+    }
+    rtcCommitScene(scene_out);
+    return scene_out;
+  }
+
+  static RTCRay makeRay(const Vec3fa& org, const Vec3fa& dir, float tnear, float tfar)
+  {
+    RTCRay ray;
+    ray.org_x = org.x; ray.org_y = org.y; ray.org_z = org.z;
+    ray.dir_x = dir.x; ray.dir_y = dir.y; ray.dir_z = dir.z;
+    ray.tnear = tnear;
+    ray.tfar = tfar;
+    ray.time = 0.0f;
+    ray.mask = -1;
+    ray.id = 0;
+    ray.flags = 0;
+    return ray;
+  }
+
+  /* generates primary rays, shadow and diffuse rays starting at the primary hits, and random rays inside the scene bounds */
+  static void generateRays(RTCScene scene, const TraceBenchParams& params, const ISPCCamera& camera, std::vector<RayDistribution>& distributions)
+  {
+    RTCBounds b; rtcGetSceneBounds(scene,&b);
+    const Vec3fa lower(b.lower_x,b.lower_y,b.lower_z);
+    const Vec3fa upper(b.upper_x,b.upper_y,b.upper_z);
+    const float eps = 1E-4f * length(upper-lower);
+    const Vec3fa lightPos = Vec3fa(0.5f*(lower.x+upper.x),upper.y,0.5f*(lower.z+upper.z));
+
+    RayDistribution primary("primary"), shadow("shadow"), diffuse("diffuse"), random("random");
+    for (unsigned int y=0; y<params.height; y++)
+    {
+      for (unsigned int x=0; x<params.width; x++)
+      {
+        RandomSampler sampler;
+        RandomSampler_init(sampler,x,y,params.seed);
+
+        const Vec2f s = RandomSampler_get2D(sampler);
+        const Vec3fa dir = Vec3fa(normalize((x+s.x)*camera.xfm.l.vx + (y+s.y)*camera.xfm.l.vy + camera.xfm.l.vz));
+        primary.rays.push_back(makeRay(Vec3fa(camera.xfm.p),dir,0.0f,inf));
+
+        const Vec3fa org = lower + RandomSampler_get3D(sampler)*(upper-lower);
+        const Vec2f r = RandomSampler_get2D(sampler);
+        random.rays.push_back(makeRay(org,cartesian(2.0f*float(M_PI)*r.x,1.0f-2.0f*r.y),0.0f,inf));
+
+        RTCRayHit rayhit;
+        rayhit.ray = primary.rays.back();
+        rayhit.hit.geomID = RTC_INVALID_GEOMETRY_ID;
+        rayhit.hit.instID[0] = RTC_INVALID_GEOMETRY_ID;
+        rtcIntersect1(scene,&rayhit);
+        if (rayhit.hit.geomID == RTC_INVALID_GEOMETRY_ID) continue;
+
+        const Vec3fa P = Vec3fa(camera.xfm.p) + rayhit.ray.tfar*dir;
+        Vec3fa Ng = normalize(Vec3fa(rayhit.hit.Ng_x,rayhit.hit.Ng_y,rayhit.hit.Ng_z));
+        if (dot(Ng,dir) > 0.0f) Ng = -Ng;
+        shadow.rays.push_back(makeRay(P,lightPos-P,eps,1.0f-eps));
+
+        const Vec2f d = RandomSampler_get2D(sampler);
+        diffuse.rays.push_back(makeRay(P,cosineSampleHemisphere(d.x,d.y,Ng).v,eps,inf));
+      }
+    }
+
+    distributions.push_back(primary);
+    distributions.push_back(shadow);
+    distributions.push_back(diffuse);
+    distributions.push_back(random);
+  }
+
+  template<typename Ray>
+  __forceinline void setRay(Ray& dst, size_t i, const RTCRay& src)
+  {
+    dst.org_x[i] = src.org_x; dst.org_y[i] = src.org_y; dst.org_z[i] = src.org_z;
+    dst.dir_x[i] = src.dir_x; dst.dir_y[i] = src.dir_y; dst.dir_z[i] = src.dir_z;
+    dst.tnear[i] = src.tnear;
+    dst.tfar[i] = src.tfar;
+    dst.time[i] = src.time;
+    dst.mask[i] = src.mask;
+    dst.id[i] = src.id;
+    dst.flags[i] = src.flags;
+  }
+
+  template<int N> struct RayPacket {};
+
+  template<> struct RayPacket<4> {
+    typedef RTCRay4 Ray; typedef RTCRayHit4 RayHit;
+    static void intersect(const int* valid, RTCScene scene, RayHit* rayhit) { rtcIntersect4(valid,scene,rayhit); }
+    static void occluded (const int* valid, RTCScene scene, Ray* ray) { rtcOccluded4(valid,scene,ray); }
+  };
+
+  template<> struct RayPacket<8> {
+    typedef RTCRay8 Ray; typedef RTCRayHit8 RayHit;
+    static void intersect(const int* valid, RTCScene scene, RayHit* rayhit) { rtcIntersect8(valid,scene,rayhit); }
+    static void occluded (const int* valid, RTCScene scene, Ray* ray) { rtcOccluded8(valid,scene,ray); }
+  };
+
+  template<> struct RayPacket<16> {
+    typedef RTCRay16 Ray; typedef RTCRayHit16 RayHit;
+    static void intersect(const int* valid, RTCScene scene, RayHit* rayhit) { rtcIntersect16(valid,scene,rayhit); }
+    static void occluded (const int* valid, RTCScene scene, Ray* ray) { rtcOccluded16(valid,scene,ray); }
+  };
+
+  template<int N>
+  static void traceBlockN(RTCScene scene, bool occluded, const RTCRay* rays, size_t num)
+  {
+    typedef RayPacket<N> Packet;
+    for (size_t i=0; i<num; i+=N)
+    {
+      int valid[N];
+      typename Packet::RayHit rayhit;
+      for (size_t j=0; j<N; j++) {
+        valid[j] = i+j < num ? -1 : 0;
+        setRay(rayhit.ray,j,rays[min(i+j,num-1)]);
+        rayhit.hit.geomID[j] = RTC_INVALID_GEOMETRY_ID;
+        rayhit.hit.instID[0][j] = RTC_INVALID_GEOMETRY_ID;
+      }
+      if (occluded) Packet::occluded(valid,scene,&rayhit.ray);
+      else          Packet::intersect(valid,scene,&rayhit);
+    }
+  }
+
+  static void traceBlock(RTCScene scene, QueryType query, const RTCRay* rays, size_t num)
+  {
+    switch (query)
+    {
+    case INTERSECT1:
+      for (size_t i=0; i<num; i++) {
+        RTCRayHit rayhit;
+        rayhit.ray = rays[i];
+        rayhit.hit.geomID = RTC_INVALID_GEOMETRY_ID;
+        rayhit.hit.instID[0] = RTC_INVALID_GEOMETRY_ID;
+        rtcIntersect1(scene,&rayhit);
+      }
+      break;
+    case OCCLUDED1:
+      for (size_t i=0; i<num; i++) {
+        RTCRay ray = rays[i];
+        rtcOccluded1(scene,&ray);
+      }
+      break;
+    case INTERSECT4:  traceBlockN<4> (scene,false,rays,num); break;
+    case INTERSECT8:  traceBlockN<8> (scene,false,rays,num); break;
+    case INTERSECT16: traceBlockN<16>(scene,false,rays,num); break;
+    case OCCLUDED4:   traceBlockN<4> (scene,true,rays,num); break;
+    case OCCLUDED8:   traceBlockN<8> (scene,true,rays,num); break;
+    case OCCLUDED16:  traceBlockN<16>(scene,true,rays,num); break;
+    }
+  }
+
+  static bool countPrimitives(RTCPointQueryFunctionArguments* args)
+  {
+    (*(size_t*)args->userPtr)++;
+    return false;
+  }
+
+  /* processes all items in blocks using the specified number of threads and returns the measured time per pass */
+  static double measure(const TraceBenchParams& params, int numThreads, size_t numItems, const std::function<void(size_t,size_t)>& func)
+  {
+    double time = 0.0;
+    for (int i=0; i<params.skipIterations+params.iterations; i++)
+    {
+      std::atomic<size_t> next(0);
+      auto work = [&] () {
+        for (size_t begin = next.fetch_add(BLOCK_SIZE); begin < numItems; begin = next.fetch_add(BLOCK_SIZE))
+          func(begin,min(begin+BLOCK_SIZE,numItems));
+      };
+
+      const double t0 = getSeconds();
+      std::vector<std::thread> threads;
+      for (int t=1; t<numThreads; t++)
+        threads.push_back(std::thread(work));
+      work();
+      for (auto& thread : threads)
+        thread.join();
+      const double t1 = getSeconds();
+
+      if (i >= params.skipIterations)
+        time += t1-t0;
+    }
+    return time/max(params.iterations,1);
+  }
+
+  struct ResultWriter
+  {
+    ResultWriter (const TraceBenchParams& params)
+      : params(params), json(false), first(true)
+    {
+      const std::string& filename = params.outputFile;
+      if (filename == "") return;
+      json = filename.size() >= 5 && filename.substr(filename.size()-5) == ".json";
+      out.open(filename.c_str());
+      if (!out) FATAL("cannot open file " + filename);
+      out.precision(9);
+      if (json) out << "[";
+      else out << "scene,version,isa,threads,rays,query,count,seconds,mrays_per_s" << std::endl;
+    }
+
+    ~ResultWriter ()
+    {
+      if (out.is_open() && json)
+        out << std::endl << "]" << std::endl;
+    }
+
+    void add(const std::string& isa, int threads, const std::string& rays, const std::string& query, size_t count, double seconds)
+    {
+      const double mrays = seconds > 0.0 ? double(count)/seconds*1E-6 : 0.0;
+      std::cout << "BENCHMARK_TRACE " << isa << " " << threads << " threads, " << rays << " " << query << ", "
+                << count << " queries, " << mrays << " M/s" << std::endl;
+
+      if (!out.is_open()) return;
+      if (json) {
+        out << (first ? "" : ",") << std::endl;
+        out << "  { \"scene\": \"" << params.sceneName << "\", \"version\": \"" << RTC_VERSION_STRING << "\", "
+            << "\"isa\": \"" << isa << "\", \"threads\": " << threads << ", \"rays\": \"" << rays << "\", "
+            << "\"query\": \"" << query << "\", \"count\": " << count << ", \"seconds\": " << seconds << ", "
+            << "\"mrays_per_s\": " << mrays << " }";
+      } else {
+        out << params.sceneName << "," << RTC_VERSION_STRING << "," << isa << "," << threads << "," << rays << ","
+            << query << "," << count << "," << seconds << "," << mrays << std::endl;
+      }
+      first = false;
+    }
+
+    const TraceBenchParams& params;
+    std::ofstream out;
+    bool json;
+    bool first;
+  };
+
+  void Benchmark_Trace(TraceBenchParams& params, ISPCScene* scene_in, Camera& tutorial_camera)
+  {
+    const ISPCCamera camera = tutorial_camera.getISPCCamera(params.width,params.height);
+
+    /* select the ISAs to benchmark */
+    std::vector<int> isas;
+    if (params.isas.empty()) {
+      for (int isa : g_isas)
+        if (hasISA(isa)) isas.push_back(isa);
+    }
+    for (const std::string& name : params.isas)
+    {
+      int isa = 0;
+      for (int i : g_isas)
+        if (toLowerCase(name) == toLowerCase(stringOfISA(i))) isa = i;
+      if (isa == 0) FATAL("unknown or not compiled in ISA " + name);
+      if (!hasISA(isa)) {
+        std::cout << "warning: ISA " << name << " not supported by CPU, skipping" << std::endl;
+        continue;
+      }
+      isas.push_back(isa);
+    }
+
+    /* select the thread counts to benchmark */
+    std::vector<int> threadCounts = params.threads;
+    if (threadCounts.empty()) {
+      const int numThreads = (int) getNumberOfLogicalThreads();
+      for (int t=1; t<numThreads; t*=2)
+        threadCounts.push_back(t);
+      threadCounts.push_back(numThreads);
+    }
+
+    ResultWriter writer(params);
+    std::vector<RayDistribution> distributions;
+    std::vector<RTCPointQuery> pointQueries;
+
+    for (int isa : isas)
+    {
+      const std::string isa_name = stringOfISA(isa);
+      const std::string cfg = params.rtcore + ",isa=" + toLowerCase(isa_name);
+      RTCDevice device = rtcNewDevice(cfg.c_str());
+      if (!device) FATAL("cannot create device");
+      RTCScene scene = convertScene(device,scene_in);
+
+      /* the rays are generated once, such that all ISAs trace the same rays */
+      if (distributions.empty())
+      {
+        generateRays(scene,params,camera,distributions);
+
+        RTCBounds b; rtcGetSceneBounds(scene,&b);
+        const Vec3fa lower(b.lower_x,b.lower_y,b.lower_z);
+        const Vec3fa upper(b.upper_x,b.upper_y,b.upper_z);
+        for (unsigned int i=0; i<params.width*params.height; i++)
+        {
+          RandomSampler sampler;
+          RandomSampler_init(sampler,i,params.seed);
+          const Vec3fa p = lower + RandomSampler_get3D(sampler)*(upper-lower);
+          RTCPointQuery query;
+          query.x = p.x; query.y = p.y; query.z = p.z;
+          query.time = 0.0f;
+          query.radius = 0.01f * length(upper-lower);
+          pointQueries.push_back(query);
+        }
+      }
+
+      for (int threads : threadCounts)
+      {
+        for (const RayDistribution& dist : distributions)
+        {
+          for (int q=INTERSECT1; q<=OCCLUDED16; q++)
+          {
+            const double seconds = measure(params,threads,dist.rays.size(),[&] (size_t begin, size_t end) {
+                traceBlock(scene,(QueryType)q,dist.rays.data()+begin,end-begin);
+              });
+            writer.add(isa_name,threads,dist.name,query_names[q],dist.rays.size(),seconds);
+          }
+        }
+
+        const double seconds = measure(params,threads,pointQueries.size(),[&] (size_t begin, size_t end) {
+            size_t numPrimitives = 0;
+            RTCPointQueryContext context;
+            rtcInitPointQueryContext(&context);
+            for (size_t i=begin; i<end; i++) {
+              RTCPointQuery query = pointQueries[i];
+              rtcPointQuery(scene,&query,&context,countPrimitives,&numPrimitives);
+            }
+          });
+        writer.add(isa_name,threads,"random","point_query",pointQueries.size(),seconds);
+      }
+
+      rtcReleaseScene(scene);
+      rtcReleaseDevice(device);
+    }
+  }
+
+  extern "C" void device_init (char* cfg)
+  {
+  }
+
+  void renderFrameStandard (int* pixels,
+                            const unsigned int width,
+                            const unsigned int height,
+                            const float time,
+                            const ISPCCamera& camera)
+  {
+  }
+
+  /* called by the C++ code to render */
+  extern "C" void device_render (int* pixels,
+                                 const unsigned int width,
+                                 const unsigned int height,
+                                 const float time,
+                                 const ISPCCamera& camera)
+  {
+  }
+
+  /* renders a single screen tile */
+  void renderTileStandard(int taskIndex,
+                          int threadIndex,
+                          int* pixels,
+                          const unsigned int width,
+                          const unsigned int height,
+                          const float time,
+                          const ISPCCamera& camera,
+                          const int numTilesX,
+                          const int numTilesY)
+  {
+  }
+
+  /* called by the C++ code for cleanup */
+  extern "C" void device_cleanup ()
+  {
+  }
+} // namespace embree
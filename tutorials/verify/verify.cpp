@@ -1697,6 +1697,1545 @@ namespace embree
     }
   };
   
+  struct SaveLoadSceneTest : public VerifyApplication::Test
+  {
+    SceneFlags sflags;
+
+    SaveLoadSceneTest (std::string name, int isa, SceneFlags sflags)
+      : VerifyApplication::Test(name,isa,VerifyApplication::TEST_SHOULD_PASS), sflags(sflags) {}
+    
+    VerifyApplication::TestReturnValue run(VerifyApplication* state, bool silent)
+    {
+      std::string cfg = state->rtcore + ",isa="+stringOfISA(isa);
+      RTCDeviceRef device = rtcNewDevice(cfg.c_str());
+      errorHandler(nullptr,rtcGetDeviceError(device));
+      const std::string fileName = "verify_save_load_scene_" + stringOfISA(isa) + ".bin";
+
+      const Vec3fa center = zero;
+      const float radius = 1.0f;
+      std::vector<Ref<SceneGraph::Node>> nodes;
+      nodes.push_back(SceneGraph::createTriangleSphere(center,radius,50));
+      nodes.push_back(SceneGraph::createTriangleSphere(center,radius,50)->set_motion_vector(random_motion_vector(1.0f)));
+      nodes.push_back(SceneGraph::createQuadSphere(center+Vec3fa(0.5f,0,0),radius,50));
+      nodes.push_back(SceneGraph::createQuadSphere(center+Vec3fa(0.5f,0,0),radius,50)->set_motion_vector(random_motion_vector(1.0f)));
+
+      VerifyScene scene0(device,sflags);
+      for (auto& node : nodes) scene0.addGeometry(RTC_BUILD_QUALITY_MEDIUM,node);
+      rtcCommitScene (scene0);
+      AssertNoError(device);
+      rtcSaveScene(scene0,fileName.c_str());
+      AssertNoError(device);
+
+      VerifyScene scene1(device,sflags);
+      for (auto& node : nodes) scene1.addGeometry(RTC_BUILD_QUALITY_MEDIUM,node);
+      rtcLoadScene(scene1,fileName.c_str());
+      AssertNoError(device);
+
+      /* loaded scene has to produce the same hits as the built scene */
+      bool passed = true;
+      for (size_t i=0; i<1000 && passed; i++)
+      {
+        const Vec3fa org = 4.0f*random_Vec3fa()-Vec3fa(2.0f);
+        const Vec3fa dir = 2.0f*random_Vec3fa()-Vec3fa(1.0f);
+        const float time = RandomSampler_get1D(sampler);
+        RTCRayHit ray0 = makeRay(org,dir); ray0.ray.time = time;
+        RTCRayHit ray1 = makeRay(org,dir); ray1.ray.time = time;
+        rtcIntersect1(scene0,&ray0);
+        rtcIntersect1(scene1,&ray1);
+        passed &= ray0.hit.geomID == ray1.hit.geomID;
+        passed &= ray0.hit.primID == ray1.hit.primID;
+        passed &= ray0.ray.tfar == ray1.ray.tfar;
+      }
+      AssertNoError(device);
+
+      /* loading into a scene with different geometries has to fail */
+      VerifyScene scene2(device,sflags);
+      scene2.addGeometry(RTC_BUILD_QUALITY_MEDIUM,nodes[0]);
+      rtcLoadScene(scene2,fileName.c_str());
+      AssertError(device,RTC_ERROR_INVALID_OPERATION);
+
+      std::remove(fileName.c_str());
+      return passed ? VerifyApplication::PASSED : VerifyApplication::FAILED;
+    }
+  };
+  
+  struct RefitTopLevelTest : public VerifyApplication::Test
+  {
+    RefitTopLevelTest (std::string name, int isa)
+      : VerifyApplication::Test(name,isa,VerifyApplication::TEST_SHOULD_PASS) {}
+
+    static void translate(Ref<SceneGraph::TriangleMeshNode> mesh, const Vec3fa& dP)
+    {
+      for (auto& p : mesh->positions[0])
+        p = Vec3fa(p) + dP;
+    }
+
+    VerifyApplication::TestReturnValue run(VerifyApplication* state, bool silent)
+    {
+      std::string cfg = state->rtcore + ",isa="+stringOfISA(isa);
+      RTCDeviceRef device = rtcNewDevice(cfg.c_str());
+      errorHandler(nullptr,rtcGetDeviceError(device));
+
+      /* scene0 refits its top level BVHs, scene1 gets rebuilt from scratch */
+      VerifyScene exemplar(device,SceneFlags(RTC_SCENE_FLAG_NONE,RTC_BUILD_QUALITY_MEDIUM));
+      exemplar.addGeometry(RTC_BUILD_QUALITY_MEDIUM,SceneGraph::createTriangleSphere(zero,0.1f,10));
+      rtcCommitScene(exemplar);
+      VerifyScene scene0(device,SceneFlags(RTC_SCENE_FLAG_DYNAMIC,RTC_BUILD_QUALITY_REFIT));
+      VerifyScene scene1(device,SceneFlags(RTC_SCENE_FLAG_NONE,RTC_BUILD_QUALITY_MEDIUM));
+      AssertNoError(device);
+
+      const size_t numInstances = 100;
+      avector<AffineSpace3fa> xfms(numInstances);
+      std::vector<RTCGeometry> instances0(numInstances), instances1(numInstances);
+      for (size_t i=0; i<numInstances; i++)
+      {
+        xfms[i] = AffineSpace3fa::translate(4.0f*random_Vec3fa()-Vec3fa(2.0f));
+        instances0[i] = rtcNewGeometry(device,RTC_GEOMETRY_TYPE_INSTANCE);
+        instances1[i] = rtcNewGeometry(device,RTC_GEOMETRY_TYPE_INSTANCE);
+        rtcSetGeometryInstancedScene(instances0[i],exemplar);
+        rtcSetGeometryInstancedScene(instances1[i],exemplar);
+        rtcSetGeometryTransform(instances0[i],0,RTC_FORMAT_FLOAT4X4_COLUMN_MAJOR,(float*)&xfms[i]);
+        rtcSetGeometryTransform(instances1[i],0,RTC_FORMAT_FLOAT4X4_COLUMN_MAJOR,(float*)&xfms[i]);
+        rtcCommitGeometry(instances0[i]);
+        rtcCommitGeometry(instances1[i]);
+        rtcAttachGeometry(scene0,instances0[i]);
+        rtcAttachGeometry(scene1,instances1[i]);
+        rtcReleaseGeometry(instances0[i]);
+        rtcReleaseGeometry(instances1[i]);
+      }
+
+      /* one large and one small mesh that move over time */
+      Ref<SceneGraph::TriangleMeshNode> sphere = SceneGraph::createTriangleSphere(Vec3fa(0.5f,0,0),0.5f,20).dynamicCast<SceneGraph::TriangleMeshNode>();
+      Ref<SceneGraph::TriangleMeshNode> plane = SceneGraph::createTrianglePlane(Vec3fa(-1,-1,0),Vec3fa(0.5f,0,0),Vec3fa(0,0.5f,0),1,1).dynamicCast<SceneGraph::TriangleMeshNode>();
+      RTCGeometry meshes0[2] = { rtcGetGeometry(scene0,scene0.addGeometry(RTC_BUILD_QUALITY_MEDIUM,sphere.dynamicCast<SceneGraph::Node>())),
+                                 rtcGetGeometry(scene0,scene0.addGeometry(RTC_BUILD_QUALITY_MEDIUM,plane.dynamicCast<SceneGraph::Node>())) };
+      RTCGeometry meshes1[2] = { rtcGetGeometry(scene1,scene1.addGeometry(RTC_BUILD_QUALITY_MEDIUM,sphere.dynamicCast<SceneGraph::Node>())),
+                                 rtcGetGeometry(scene1,scene1.addGeometry(RTC_BUILD_QUALITY_MEDIUM,plane.dynamicCast<SceneGraph::Node>())) };
+      AssertNoError(device);
+
+      bool passed = true;
+      for (size_t frame=0; frame<10 && passed; frame++)
+      {
+        if (frame > 0)
+        {
+          /* move few instances, and in one frame all of them to trigger a full rebuild */
+          const size_t numMoved = frame == 5 ? numInstances : 10;
+          for (size_t j=0; j<numMoved; j++)
+          {
+            const size_t i = frame == 5 ? j : size_t(RandomSampler_get1D(sampler)*numInstances) % numInstances;
+            xfms[i] = AffineSpace3fa::translate(0.2f*random_Vec3fa()-Vec3fa(0.1f)) * xfms[i];
+            rtcSetGeometryTransform(instances0[i],0,RTC_FORMAT_FLOAT4X4_COLUMN_MAJOR,(float*)&xfms[i]);
+            rtcSetGeometryTransform(instances1[i],0,RTC_FORMAT_FLOAT4X4_COLUMN_MAJOR,(float*)&xfms[i]);
+            rtcCommitGeometry(instances0[i]);
+            rtcCommitGeometry(instances1[i]);
+          }
+
+          translate(sphere,0.2f*random_Vec3fa()-Vec3fa(0.1f));
+          translate(plane,0.2f*random_Vec3fa()-Vec3fa(0.1f));
+          for (size_t i=0; i<2; i++) {
+            rtcUpdateGeometryBuffer(meshes0[i],RTC_BUFFER_TYPE_VERTEX,0);
+            rtcUpdateGeometryBuffer(meshes1[i],RTC_BUFFER_TYPE_VERTEX,0);
+            rtcCommitGeometry(meshes0[i]);
+            rtcCommitGeometry(meshes1[i]);
+          }
+        }
+        rtcCommitScene(scene0);
+        rtcCommitScene(scene1);
+        AssertNoError(device);
+
+        /* refitted scene has to produce the same hits as the rebuilt scene */
+        for (size_t i=0; i<1000 && passed; i++)
+        {
+          const Vec3fa org = 4.0f*random_Vec3fa()-Vec3fa(2.0f);
+          const Vec3fa dir = 2.0f*random_Vec3fa()-Vec3fa(1.0f);
+          RTCRayHit ray0 = makeRay(org,dir);
+          RTCRayHit ray1 = makeRay(org,dir);
+          rtcIntersect1(scene0,&ray0);
+          rtcIntersect1(scene1,&ray1);
+          passed &= ray0.hit.geomID == ray1.hit.geomID;
+          passed &= ray0.hit.primID == ray1.hit.primID;
+          passed &= ray0.hit.instID[0] == ray1.hit.instID[0];
+          passed &= ray0.ray.tfar == ray1.ray.tfar;
+        }
+      }
+      AssertNoError(device);
+
+      return passed ? VerifyApplication::PASSED : VerifyApplication::FAILED;
+    }
+  };
+
+  struct InsertRemoveTopLevelTest : public VerifyApplication::Test
+  {
+    InsertRemoveTopLevelTest (std::string name, int isa)
+      : VerifyApplication::Test(name,isa,VerifyApplication::TEST_SHOULD_PASS) {}
+
+    VerifyApplication::TestReturnValue run(VerifyApplication* state, bool silent)
+    {
+      /* disable the quality fallback such that all commits update the top level BVHs in place */
+      std::string cfg = state->rtcore + ",isa="+stringOfISA(isa)+",toplevel_refit_max_sah_growth=1000";
+      RTCDeviceRef device = rtcNewDevice(cfg.c_str());
+      errorHandler(nullptr,rtcGetDeviceError(device));
+
+      /* scene0 inserts and removes objects in its top level BVHs, scene1 gets rebuilt from scratch */
+      VerifyScene exemplar(device,SceneFlags(RTC_SCENE_FLAG_NONE,RTC_BUILD_QUALITY_MEDIUM));
+      exemplar.addGeometry(RTC_BUILD_QUALITY_MEDIUM,SceneGraph::createTriangleSphere(zero,0.1f,10));
+      rtcCommitScene(exemplar);
+      VerifyScene scene0(device,SceneFlags(RTC_SCENE_FLAG_DYNAMIC,RTC_BUILD_QUALITY_REFIT));
+      VerifyScene scene1(device,SceneFlags(RTC_SCENE_FLAG_NONE,RTC_BUILD_QUALITY_MEDIUM));
+      AssertNoError(device);
+
+      /* even slots hold instances, odd slots small or large meshes */
+      const unsigned int numSlots = 200;
+      std::vector<bool> attached(numSlots,false), enabled(numSlots,false);
+      std::vector<Ref<SceneGraph::TriangleMeshNode>> meshes;
+      auto attach = [&] (unsigned int slot)
+      {
+        const Vec3fa P = 4.0f*random_Vec3fa()-Vec3fa(2.0f);
+        RTCGeometry geom[2];
+        for (size_t s=0; s<2; s++)
+        {
+          if (slot % 2 == 0) {
+            const AffineSpace3fa xfm = AffineSpace3fa::translate(P);
+            geom[s] = rtcNewGeometry(device,RTC_GEOMETRY_TYPE_INSTANCE);
+            rtcSetGeometryInstancedScene(geom[s],exemplar);
+            rtcSetGeometryTransform(geom[s],0,RTC_FORMAT_FLOAT4X4_COLUMN_MAJOR,(float*)&xfm);
+          } else {
+            Ref<SceneGraph::TriangleMeshNode> mesh = (slot % 4 == 1 ? SceneGraph::createTriangleSphere(P,0.1f,10)
+                                                                   : SceneGraph::createTrianglePlane(P,Vec3fa(0.2f,0,0),Vec3fa(0,0.2f,0),1,1)).dynamicCast<SceneGraph::TriangleMeshNode>();
+            meshes.push_back(mesh);
+            geom[s] = rtcNewGeometry(device,RTC_GEOMETRY_TYPE_TRIANGLE);
+            rtcSetSharedGeometryBuffer(geom[s],RTC_BUFFER_TYPE_INDEX,0,RTC_FORMAT_UINT3,mesh->triangles.data(),0,sizeof(SceneGraph::TriangleMeshNode::Triangle),mesh->triangles.size());
+            rtcSetSharedGeometryBuffer(geom[s],RTC_BUFFER_TYPE_VERTEX,0,RTC_FORMAT_FLOAT3,mesh->positions[0].data(),0,sizeof(SceneGraph::TriangleMeshNode::Vertex),mesh->positions[0].size());
+          }
+          rtcCommitGeometry(geom[s]);
+        }
+        rtcAttachGeometryByID(scene0,geom[0],slot);
+        rtcAttachGeometryByID(scene1,geom[1],slot);
+        rtcReleaseGeometry(geom[0]);
+        rtcReleaseGeometry(geom[1]);
+        attached[slot] = enabled[slot] = true;
+      };
+      for (unsigned int slot=0; slot<numSlots; slot+=3)
+        attach(slot);
+      AssertNoError(device);
+
+      bool passed = true;
+      for (size_t frame=0; frame<20 && passed; frame++)
+      {
+        /* attach, detach, enable, and disable some objects */
+        for (size_t j=0; frame>0 && j<20; j++)
+        {
+          const unsigned int slot = (unsigned int)(RandomSampler_get1D(sampler)*numSlots) % numSlots;
+          if (!attached[slot]) {
+            attach(slot);
+          }
+          else if (RandomSampler_get1D(sampler) < 0.5f) {
+            rtcDetachGeometry(scene0,slot);
+            rtcDetachGeometry(scene1,slot);
+            attached[slot] = false;
+          }
+          else {
+            enabled[slot] = !enabled[slot];
+            RTCGeometry geom[2] = { rtcGetGeometry(scene0,slot), rtcGetGeometry(scene1,slot) };
+            for (size_t s=0; s<2; s++) {
+              if (enabled[slot]) rtcEnableGeometry(geom[s]);
+              else               rtcDisableGeometry(geom[s]);
+              rtcCommitGeometry(geom[s]);
+            }
+          }
+        }
+        rtcCommitScene(scene0);
+        rtcCommitScene(scene1);
+        AssertNoError(device);
+
+        /* updated scene has to produce the same hits as the rebuilt scene */
+        for (size_t i=0; i<1000 && passed; i++)
+        {
+          const Vec3fa org = 4.0f*random_Vec3fa()-Vec3fa(2.0f);
+          const Vec3fa dir = 2.0f*random_Vec3fa()-Vec3fa(1.0f);
+          RTCRayHit ray0 = makeRay(org,dir);
+          RTCRayHit ray1 = makeRay(org,dir);
+          rtcIntersect1(scene0,&ray0);
+          rtcIntersect1(scene1,&ray1);
+          passed &= ray0.hit.geomID == ray1.hit.geomID;
+          passed &= ray0.hit.primID == ray1.hit.primID;
+          passed &= ray0.hit.instID[0] == ray1.hit.instID[0];
+          passed &= ray0.ray.tfar == ray1.ray.tfar;
+        }
+      }
+      AssertNoError(device);
+
+      return passed ? VerifyApplication::PASSED : VerifyApplication::FAILED;
+    }
+  };
+
+  struct RefitRotationTest : public VerifyApplication::Test
+  {
+    RefitRotationTest (std::string name, int isa)
+      : VerifyApplication::Test(name,isa,VerifyApplication::TEST_SHOULD_PASS) {}
+
+    VerifyApplication::TestReturnValue run(VerifyApplication* state, bool silent)
+    {
+      std::string cfg = state->rtcore + ",isa="+stringOfISA(isa)+",refit_rotation_max_time=100";
+      RTCDeviceRef device = rtcNewDevice(cfg.c_str());
+      errorHandler(nullptr,rtcGetDeviceError(device));
+
+      /* scene0 refits and rotates the BVH of the mesh, scene1 rebuilds it */
+      VerifyScene scene0(device,SceneFlags(RTC_SCENE_FLAG_DYNAMIC,RTC_BUILD_QUALITY_LOW));
+      VerifyScene scene1(device,SceneFlags(RTC_SCENE_FLAG_NONE,RTC_BUILD_QUALITY_MEDIUM));
+      Ref<SceneGraph::TriangleMeshNode> mesh = SceneGraph::createTriangleSphere(zero,1.0f,80).dynamicCast<SceneGraph::TriangleMeshNode>();
+      RTCGeometry geom0 = rtcGetGeometry(scene0,scene0.addGeometry(RTC_BUILD_QUALITY_REFIT,mesh.dynamicCast<SceneGraph::Node>()));
+      RTCGeometry geom1 = rtcGetGeometry(scene1,scene1.addGeometry(RTC_BUILD_QUALITY_MEDIUM,mesh.dynamicCast<SceneGraph::Node>()));
+      AssertNoError(device);
+
+      bool passed = true;
+      for (size_t frame=0; frame<10 && passed; frame++)
+      {
+        /* swapping vertices heavily degrades the refitted BVH */
+        if (frame > 0)
+        {
+          auto& positions = mesh->positions[0];
+          for (size_t i=0; i<positions.size()/10; i++) {
+            const size_t a = size_t(RandomSampler_get1D(sampler)*positions.size()) % positions.size();
+            const size_t b = size_t(RandomSampler_get1D(sampler)*positions.size()) % positions.size();
+            std::swap(positions[a],positions[b]);
+          }
+          rtcUpdateGeometryBuffer(geom0,RTC_BUFFER_TYPE_VERTEX,0);
+          rtcUpdateGeometryBuffer(geom1,RTC_BUFFER_TYPE_VERTEX,0);
+          rtcCommitGeometry(geom0);
+          rtcCommitGeometry(geom1);
+        }
+        rtcCommitScene(scene0);
+        rtcCommitScene(scene1);
+        AssertNoError(device);
+
+        /* rotated BVH has to produce the same hits as the rebuilt BVH */
+        for (size_t i=0; i<1000 && passed; i++)
+        {
+          const Vec3fa org = 4.0f*random_Vec3fa()-Vec3fa(2.0f);
+          const Vec3fa dir = 2.0f*random_Vec3fa()-Vec3fa(1.0f);
+          RTCRayHit ray0 = makeRay(org,dir);
+          RTCRayHit ray1 = makeRay(org,dir);
+          rtcIntersect1(scene0,&ray0);
+          rtcIntersect1(scene1,&ray1);
+          passed &= ray0.hit.geomID == ray1.hit.geomID;
+          passed &= ray0.hit.primID == ray1.hit.primID;
+          passed &= ray0.ray.tfar == ray1.ray.tfar;
+        }
+      }
+      AssertNoError(device);
+
+      return passed ? VerifyApplication::PASSED : VerifyApplication::FAILED;
+    }
+  };
+
+  struct NUMAReplicationTest : public VerifyApplication::Test
+  {
+    NUMAReplicationTest (std::string name, int isa)
+      : VerifyApplication::Test(name,isa,VerifyApplication::TEST_SHOULD_PASS) {}
+
+    VerifyApplication::TestReturnValue run(VerifyApplication* state, bool silent)
+    {
+      std::string cfg0 = state->rtcore + ",isa="+stringOfISA(isa)+",numa_alloc=1,numa_replicate_depth=3";
+      std::string cfg1 = state->rtcore + ",isa="+stringOfISA(isa)+",numa_alloc=0";
+      RTCDeviceRef device0 = rtcNewDevice(cfg0.c_str());
+      errorHandler(nullptr,rtcGetDeviceError(device0));
+      RTCDeviceRef device1 = rtcNewDevice(cfg1.c_str());
+      errorHandler(nullptr,rtcGetDeviceError(device1));
+
+      /* scene0 traverses replicated top levels, scene1 the original BVH */
+      VerifyScene scene0(device0,SceneFlags(RTC_SCENE_FLAG_NONE,RTC_BUILD_QUALITY_MEDIUM));
+      VerifyScene scene1(device1,SceneFlags(RTC_SCENE_FLAG_NONE,RTC_BUILD_QUALITY_MEDIUM));
+      for (size_t i=0; i<4; i++) {
+        Ref<SceneGraph::Node> node = SceneGraph::createTriangleSphere(2.0f*random_Vec3fa()-Vec3fa(1.0f),0.5f,50);
+        scene0.addGeometry(RTC_BUILD_QUALITY_MEDIUM,node);
+        scene1.addGeometry(RTC_BUILD_QUALITY_MEDIUM,node);
+      }
+
+      bool passed = true;
+      for (size_t frame=0; frame<2 && passed; frame++)
+      {
+        rtcCommitScene(scene0);
+        rtcCommitScene(scene1);
+        AssertNoError(device0);
+        AssertNoError(device1);
+
+        for (size_t i=0; i<1000 && passed; i++)
+        {
+          const Vec3fa org = 4.0f*random_Vec3fa()-Vec3fa(2.0f);
+          const Vec3fa dir = 2.0f*random_Vec3fa()-Vec3fa(1.0f);
+          RTCRayHit ray0 = makeRay(org,dir);
+          RTCRayHit ray1 = makeRay(org,dir);
+          rtcIntersect1(scene0,&ray0);
+          rtcIntersect1(scene1,&ray1);
+          passed &= ray0.hit.geomID == ray1.hit.geomID;
+          passed &= ray0.hit.primID == ray1.hit.primID;
+          passed &= ray0.ray.tfar == ray1.ray.tfar;
+        }
+
+        /* recommit to replace the replicas */
+        rtcCommitGeometry(rtcGetGeometry(scene0,0));
+        rtcCommitGeometry(rtcGetGeometry(scene1,0));
+      }
+      AssertNoError(device0);
+      AssertNoError(device1);
+
+      return passed ? VerifyApplication::PASSED : VerifyApplication::FAILED;
+    }
+  };
+
+  struct UserAllocatorTest : public VerifyApplication::Test
+  {
+    struct Allocations
+    {
+      std::atomic<size_t> numAllocs;
+      std::atomic<ssize_t> numLive;
+    };
+
+    static void* userAlloc(void* userPtr, size_t bytes, size_t align)
+    {
+      Allocations* allocations = (Allocations*) userPtr;
+      allocations->numAllocs++;
+      allocations->numLive++;
+      return alignedMalloc(bytes,align);
+    }
+
+    static void userFree(void* userPtr, void* ptr)
+    {
+      Allocations* allocations = (Allocations*) userPtr;
+      allocations->numLive--;
+      alignedFree(ptr);
+    }
+
+    UserAllocatorTest (std::string name, int isa)
+      : VerifyApplication::Test(name,isa,VerifyApplication::TEST_SHOULD_PASS) {}
+
+    VerifyApplication::TestReturnValue run(VerifyApplication* state, bool silent)
+    {
+      std::string cfg = state->rtcore + ",isa="+stringOfISA(isa);
+      Allocations allocations;
+      allocations.numAllocs = 0;
+      allocations.numLive = 0;
+
+      bool passed = true;
+      {
+        RTCDeviceRef device = rtcNewDevice(cfg.c_str());
+        errorHandler(nullptr,rtcGetDeviceError(device));
+        rtcSetDeviceAllocator(device,userAlloc,userFree,&allocations);
+        AssertNoError(device);
+
+        {
+          VerifyScene scene(device,SceneFlags(RTC_SCENE_FLAG_NONE,RTC_BUILD_QUALITY_MEDIUM));
+          scene.addGeometry(RTC_BUILD_QUALITY_MEDIUM,SceneGraph::createTriangleSphere(zero,1.0f,50));
+          RTCBuffer buffer = rtcNewBuffer(device,1024);
+          AssertNoError(device);
+
+          /* the allocator cannot be changed once objects exist */
+          rtcSetDeviceAllocator(device,nullptr,nullptr,nullptr);
+          AssertError(device,RTC_ERROR_INVALID_OPERATION);
+
+          rtcCommitScene(scene);
+          AssertNoError(device);
+          RTCRayHit ray = makeRay(Vec3fa(0,0,-2),Vec3fa(0,0,1));
+          rtcIntersect1(scene,&ray);
+          passed &= ray.hit.geomID != RTC_INVALID_GEOMETRY_ID;
+          rtcReleaseBuffer(buffer);
+        }
+        passed &= allocations.numAllocs > 0;
+      }
+
+      /* all memory has to be returned to the user allocator */
+      passed &= allocations.numLive == 0;
+      return passed ? VerifyApplication::PASSED : VerifyApplication::FAILED;
+    }
+  };
+
+  struct PersistentBuildMemoryTest : public VerifyApplication::Test
+  {
+    struct MemoryCounters
+    {
+      std::atomic<ssize_t> allocated;
+      std::atomic<ssize_t> live;
+    };
+
+    static bool monitorMemory(void* userPtr, ssize_t bytes, bool post)
+    {
+      MemoryCounters* counters = (MemoryCounters*) userPtr;
+      if (bytes > 0) counters->allocated += bytes;
+      counters->live += bytes;
+      return true;
+    }
+
+    PersistentBuildMemoryTest (std::string name, int isa)
+      : VerifyApplication::Test(name,isa,VerifyApplication::TEST_SHOULD_PASS) {}
+
+    /* returns the number of bytes allocated when committing a scene the second time */
+    ssize_t recommit(VerifyApplication* state, RTCSceneFlags sflags, size_t numTriangles, bool& passed)
+    {
+      std::string cfg = state->rtcore + ",isa="+stringOfISA(isa);
+      RTCDeviceRef device = rtcNewDevice(cfg.c_str());
+      errorHandler(nullptr,rtcGetDeviceError(device));
+      MemoryCounters counters;
+      counters.allocated = 0;
+      counters.live = 0;
+      rtcSetDeviceMemoryMonitorFunction(device,monitorMemory,&counters);
+
+      ssize_t bytes = 0;
+      {
+        VerifyScene scene(device,SceneFlags(sflags,RTC_BUILD_QUALITY_MEDIUM));
+        scene.addGeometry(RTC_BUILD_QUALITY_MEDIUM,SceneGraph::createTriangleSphere(zero,1.0f,100));
+        rtcCommitScene(scene);
+        AssertNoError(device);
+
+        rtcCommitGeometry(rtcGetGeometry(scene,0));
+        const ssize_t allocated0 = counters.allocated;
+        rtcCommitScene(scene);
+        AssertNoError(device);
+        bytes = counters.allocated - allocated0;
+
+        RTCRayHit ray = makeRay(Vec3fa(0,0,-2),Vec3fa(0,0,1));
+        rtcIntersect1(scene,&ray);
+        passed &= ray.hit.geomID != RTC_INVALID_GEOMETRY_ID;
+
+        /* removing the flag releases the kept builder arrays immediately */
+        if (sflags & RTC_SCENE_FLAG_PERSISTENT_BUILD_MEMORY)
+        {
+          const ssize_t live0 = counters.live;
+          rtcSetSceneFlags(scene,RTC_SCENE_FLAG_NONE);
+          passed &= counters.live + ssize_t(numTriangles*16) <= live0;
+        }
+      }
+      passed &= counters.live == 0;
+      rtcSetDeviceMemoryMonitorFunction(device,nullptr,nullptr);
+      return bytes;
+    }
+
+    VerifyApplication::TestReturnValue run(VerifyApplication* state, bool silent)
+    {
+      /* the sphere has 2*100*200 triangles, each commit needs a 32 byte PrimRef per triangle */
+      const size_t numTriangles = 2*100*200;
+      bool passed = true;
+      const ssize_t bytes0 = recommit(state,RTC_SCENE_FLAG_NONE,numTriangles,passed);
+      const ssize_t bytes1 = recommit(state,RTC_SCENE_FLAG_PERSISTENT_BUILD_MEMORY,numTriangles,passed);
+      passed &= bytes1 + ssize_t(numTriangles*16) <= bytes0;
+      return passed ? VerifyApplication::PASSED : VerifyApplication::FAILED;
+    }
+  };
+
+  struct RayStreamTest : public VerifyApplication::Test
+  {
+    RayStreamTest (std::string name, int isa)
+      : VerifyApplication::Test(name,isa,VerifyApplication::TEST_SHOULD_PASS) {}
+
+    VerifyApplication::TestReturnValue run(VerifyApplication* state, bool silent)
+    {
+      std::string cfg = state->rtcore + ",isa="+stringOfISA(isa);
+      RTCDeviceRef device = rtcNewDevice(cfg.c_str());
+      errorHandler(nullptr,rtcGetDeviceError(device));
+      VerifyScene scene(device,SceneFlags(RTC_SCENE_FLAG_NONE,RTC_BUILD_QUALITY_MEDIUM));
+      for (size_t i=0; i<8; i++)
+        scene.addGeometry(RTC_BUILD_QUALITY_MEDIUM,SceneGraph::createTriangleSphere(2.0f*random_Vec3fa()-Vec3fa(1.0f),0.3f,20));
+      rtcCommitScene(scene);
+      AssertNoError(device);
+
+      /* incoherent rays, the stream size is not a multiple of any packet size */
+      const size_t N = 10007;
+      std::vector<RTCRayHit> rays(N), rays1M(N);
+      std::vector<float> org_x(N), org_y(N), org_z(N), dir_x(N), dir_y(N), dir_z(N), tfar(N), u(N), v(N);
+      std::vector<unsigned int> primID(N), geomID(N);
+      for (size_t i=0; i<N; i++)
+      {
+        rays[i] = makeRay(4.0f*random_Vec3fa()-Vec3fa(2.0f),2.0f*random_Vec3fa()-Vec3fa(1.0f));
+        rays1M[i] = rays[i];
+        org_x[i] = rays[i].ray.org_x; org_y[i] = rays[i].ray.org_y; org_z[i] = rays[i].ray.org_z;
+        dir_x[i] = rays[i].ray.dir_x; dir_y[i] = rays[i].ray.dir_y; dir_z[i] = rays[i].ray.dir_z;
+        tfar[i] = rays[i].ray.tfar;
+        geomID[i] = RTC_INVALID_GEOMETRY_ID;
+      }
+
+      RTCRayHitNp raysNp;
+      memset(&raysNp,0,sizeof(raysNp));
+      raysNp.ray.org_x = org_x.data(); raysNp.ray.org_y = org_y.data(); raysNp.ray.org_z = org_z.data();
+      raysNp.ray.dir_x = dir_x.data(); raysNp.ray.dir_y = dir_y.data(); raysNp.ray.dir_z = dir_z.data();
+      raysNp.ray.tfar = tfar.data();
+      raysNp.hit.u = u.data(); raysNp.hit.v = v.data();
+      raysNp.hit.primID = primID.data(); raysNp.hit.geomID = geomID.data();
+
+      for (size_t i=0; i<N; i++) rtcIntersect1(scene,&rays[i]);
+      rtcIntersect1M(scene,rays1M.data(),N,sizeof(RTCRayHit));
+      rtcIntersectNp(scene,&raysNp,N);
+      AssertNoError(device);
+
+      /* packet kernels may disagree with single ray kernels for rays hitting edges */
+      size_t numHits = 0, numErrors = 0;
+      for (size_t i=0; i<N; i++)
+      {
+        numHits += rays[i].hit.geomID != RTC_INVALID_GEOMETRY_ID;
+        numErrors += rays1M[i].hit.geomID != rays[i].hit.geomID || rays1M[i].hit.primID != rays[i].hit.primID;
+        numErrors += abs(rays1M[i].ray.tfar - rays[i].ray.tfar) > 1E-4f*rays[i].ray.tfar;
+        numErrors += geomID[i] != rays[i].hit.geomID;
+        numErrors += geomID[i] != RTC_INVALID_GEOMETRY_ID && primID[i] != rays[i].hit.primID;
+        numErrors += abs(tfar[i] - rays[i].ray.tfar) > 1E-4f*rays[i].ray.tfar;
+      }
+      bool passed = numHits > 0 && numHits < N;
+
+      /* occlusion rays have to agree with the closest hits */
+      std::vector<RTCRay> shadows(N);
+      for (size_t i=0; i<N; i++) {
+        shadows[i] = makeRay(Vec3fa(org_x[i],org_y[i],org_z[i]),Vec3fa(dir_x[i],dir_y[i],dir_z[i])).ray;
+        tfar[i] = shadows[i].tfar;
+      }
+      rtcOccluded1M(scene,shadows.data(),N,sizeof(RTCRay));
+      rtcOccludedNp(scene,&raysNp.ray,N);
+      AssertNoError(device);
+
+      for (size_t i=0; i<N; i++)
+      {
+        const bool hit = rays[i].hit.geomID != RTC_INVALID_GEOMETRY_ID;
+        numErrors += (shadows[i].tfar < 0.0f) != hit;
+        numErrors += (tfar[i] < 0.0f) != hit;
+      }
+      passed &= numErrors <= N/1000;
+      return passed ? VerifyApplication::PASSED : VerifyApplication::FAILED;
+    }
+  };
+
+  struct PointQueryBatchTest : public VerifyApplication::Test
+  {
+    PointQueryBatchTest (std::string name, int isa)
+      : VerifyApplication::Test(name,isa,VerifyApplication::TEST_SHOULD_PASS) {}
+
+    struct ClosestVertex
+    {
+      RTCScene scene;
+      float distance;
+      unsigned int numCalls;
+    };
+
+    /* shrinks the query radius to the distance of the closest triangle vertex */
+    static bool closestVertex(RTCPointQueryFunctionArguments* args)
+    {
+      ClosestVertex* result = (ClosestVertex*) args->userPtr;
+      result->numCalls++;
+      RTCGeometry geom = rtcGetGeometry(result->scene,args->geomID);
+      const Vec3fa* vertices = (const Vec3fa*) rtcGetGeometryBufferData(geom,RTC_BUFFER_TYPE_VERTEX,0);
+      const unsigned int* indices = (const unsigned int*) rtcGetGeometryBufferData(geom,RTC_BUFFER_TYPE_INDEX,0);
+      const Vec3fa p(args->query->x,args->query->y,args->query->z);
+
+      bool changed = false;
+      for (size_t i=0; i<3; i++)
+      {
+        const float d = length(vertices[indices[3*args->primID+i]]-p);
+        if (d < args->query->radius) {
+          args->query->radius = d;
+          changed = true;
+        }
+      }
+      result->distance = args->query->radius;
+      return changed;
+    }
+
+    VerifyApplication::TestReturnValue run(VerifyApplication* state, bool silent)
+    {
+      std::string cfg = state->rtcore + ",isa="+stringOfISA(isa);
+      RTCDeviceRef device = rtcNewDevice(cfg.c_str());
+      errorHandler(nullptr,rtcGetDeviceError(device));
+      VerifyScene scene(device,SceneFlags(RTC_SCENE_FLAG_NONE,RTC_BUILD_QUALITY_MEDIUM));
+      for (size_t i=0; i<8; i++)
+        scene.addGeometry(RTC_BUILD_QUALITY_MEDIUM,SceneGraph::createTriangleSphere(2.0f*random_Vec3fa()-Vec3fa(1.0f),0.3f,20));
+      rtcCommitScene(scene);
+      AssertNoError(device);
+
+      /* some query points have a radius too small to reach any geometry */
+      const size_t N = 10007;
+      std::vector<float> x(N), y(N), z(N), radius(N);
+      std::vector<ClosestVertex> results(N), expected(N);
+      std::vector<void*> userPtrs(N);
+      for (size_t i=0; i<N; i++)
+      {
+        const Vec3fa p = 4.0f*random_Vec3fa()-Vec3fa(2.0f);
+        x[i] = p.x; y[i] = p.y; z[i] = p.z;
+        radius[i] = i%4 == 0 ? 0.1f : float(inf);
+        results[i] = expected[i] = { scene, radius[i], 0 };
+        userPtrs[i] = &results[i];
+      }
+
+      RTCPointQueryContext context;
+      rtcInitPointQueryContext(&context);
+      for (size_t i=0; i<N; i++)
+      {
+        RTCPointQuery query;
+        query.x = x[i]; query.y = y[i]; query.z = z[i];
+        query.time = 0.0f;
+        query.radius = radius[i];
+        rtcPointQuery(scene,&query,&context,closestVertex,&expected[i]);
+      }
+
+      RTCPointQueryNp queries;
+      queries.x = x.data(); queries.y = y.data(); queries.z = z.data();
+      queries.time = nullptr;
+      queries.radius = radius.data();
+      rtcPointQueryBatch(scene,&queries,N,&context,closestVertex,userPtrs.data());
+      AssertNoError(device);
+
+      /* the closest vertex does not depend on the order primitives are visited in */
+      bool passed = context.instStackSize == 0;
+      size_t numFound = 0;
+      for (size_t i=0; i<N; i++)
+      {
+        passed &= results[i].distance == expected[i].distance;
+        passed &= radius[i] == expected[i].distance;
+        passed &= (results[i].numCalls > 0) == (expected[i].numCalls > 0);
+        numFound += expected[i].numCalls > 0;
+      }
+      passed &= numFound > 0 && numFound < N;
+      return passed ? VerifyApplication::PASSED : VerifyApplication::FAILED;
+    }
+  };
+
+  struct CollideTest : public VerifyApplication::Test
+  {
+    CollideTest (std::string name, int isa)
+      : VerifyApplication::Test(name,isa,VerifyApplication::TEST_SHOULD_PASS) {}
+
+    struct Collisions
+    {
+      MutexSys mutex;
+      std::vector<RTCCollision> collisions;
+    };
+
+    static void collideFunc(void* userPtr, RTCCollision* collisions, unsigned int num_collisions)
+    {
+      Collisions* result = (Collisions*) userPtr;
+      Lock<MutexSys> lock(result->mutex);
+      result->collisions.insert(result->collisions.end(),collisions,collisions+num_collisions);
+    }
+
+    /* returns the sorted list of colliding primitive pairs, or an empty list if a pair was reported twice */
+    static std::vector<std::pair<unsigned,unsigned>> collide(RTCScene scene0, RTCScene scene1, bool swap = false)
+    {
+      Collisions result;
+      rtcCollide(scene0,scene1,collideFunc,&result);
+      std::vector<std::pair<unsigned,unsigned>> pairs;
+      for (const RTCCollision& c : result.collisions) {
+        if (swap) pairs.push_back(std::make_pair(c.primID1,c.primID0));
+        else      pairs.push_back(std::make_pair(c.primID0,c.primID1));
+      }
+      std::sort(pairs.begin(),pairs.end());
+      if (std::adjacent_find(pairs.begin(),pairs.end()) != pairs.end()) pairs.clear();
+      return pairs;
+    }
+
+    VerifyApplication::TestReturnValue run(VerifyApplication* state, bool silent)
+    {
+      std::string cfg = state->rtcore + ",isa="+stringOfISA(isa);
+      RTCDeviceRef device = rtcNewDevice(cfg.c_str());
+      errorHandler(nullptr,rtcGetDeviceError(device));
+      const SceneFlags sflags(RTC_SCENE_FLAG_NONE,RTC_BUILD_QUALITY_MEDIUM);
+
+      VerifyScene sphere0(device,sflags), sphere1(device,sflags), quadSphere(device,sflags), farSphere(device,sflags);
+      sphere0.addGeometry(RTC_BUILD_QUALITY_MEDIUM,SceneGraph::createTriangleSphere(Vec3fa(0.0f),1.0f,16));
+      sphere1.addGeometry(RTC_BUILD_QUALITY_MEDIUM,SceneGraph::createTriangleSphere(Vec3fa(1.0f,0.1f,0.2f),1.0f,16));
+      quadSphere.addGeometry(RTC_BUILD_QUALITY_MEDIUM,SceneGraph::createQuadSphere(Vec3fa(1.0f,0.1f,0.2f),1.0f,16));
+      farSphere.addGeometry(RTC_BUILD_QUALITY_MEDIUM,SceneGraph::createTriangleSphere(Vec3fa(5.0f,0.0f,0.0f),1.0f,16));
+      rtcCommitScene(sphere0);
+      rtcCommitScene(sphere1);
+      rtcCommitScene(quadSphere);
+      rtcCommitScene(farSphere);
+      AssertNoError(device);
+
+      /* intersecting spheres collide along a circle, independent of the order of the scenes */
+      const auto pairs01 = collide(sphere0,sphere1);
+      const auto pairs10 = collide(sphere1,sphere0,true);
+      const auto pairsQuad = collide(sphere0,quadSphere);
+      AssertNoError(device);
+      bool passed = pairs01.size() > 0 && pairs01 == pairs10 && pairsQuad.size() > 0;
+
+      /* triangles of a closed mesh only touch their neighbors */
+      passed &= collide(sphere0,sphere0).size() == 0;
+      passed &= collide(sphere0,farSphere).size() == 0;
+      AssertNoError(device);
+      return passed ? VerifyApplication::PASSED : VerifyApplication::FAILED;
+    }
+  };
+
+  struct TraversalStatisticsTest : public VerifyApplication::Test
+  {
+    TraversalStatisticsTest (std::string name, int isa)
+      : VerifyApplication::Test(name,isa,VerifyApplication::TEST_SHOULD_PASS) {}
+
+    static void acceptHitFunc(const RTCFilterFunctionNArguments* args) {
+    }
+
+    static bool counted(const RTCTraversalStatistics& stats, size_t numQueries) {
+      return stats.queries == numQueries && stats.nodes > 0 && stats.leaves > 0 && stats.primitives > 0;
+    }
+
+    static bool zero(const RTCTraversalStatistics& stats) {
+      return !stats.queries && !stats.nodes && !stats.leaves && !stats.primitives && !stats.filters && !stats.instances && !stats.earlyOuts;
+    }
+
+    VerifyApplication::TestReturnValue run(VerifyApplication* state, bool silent)
+    {
+      std::string cfg = state->rtcore + ",isa="+stringOfISA(isa)+",traversal_statistics_sample_rate=1";
+      RTCDeviceRef device = rtcNewDevice(cfg.c_str());
+      errorHandler(nullptr,rtcGetDeviceError(device));
+      const SceneFlags sflags(RTC_SCENE_FLAG_NONE,RTC_BUILD_QUALITY_MEDIUM);
+
+      /* a sphere with a filter function that gets instanced into the top level scene */
+      VerifyScene sphere(device,sflags);
+      RTCGeometry geom = rtcGetGeometry(sphere,sphere.addGeometry(RTC_BUILD_QUALITY_MEDIUM,SceneGraph::createTriangleSphere(Vec3fa(0.0f),1.0f,16)));
+      rtcSetGeometryIntersectFilterFunction(geom,acceptHitFunc);
+      rtcCommitGeometry(geom);
+      rtcCommitScene(sphere);
+
+      VerifyScene scene(device,sflags);
+      RTCGeometry instance = rtcNewGeometry(device,RTC_GEOMETRY_TYPE_INSTANCE);
+      rtcSetGeometryInstancedScene(instance,sphere);
+      const AffineSpace3fa xfm = AffineSpace3fa::translate(Vec3fa(0.5f,0.0f,0.0f));
+      rtcSetGeometryTransform(instance,0,RTC_FORMAT_FLOAT4X4_COLUMN_MAJOR,(float*)&xfm);
+      rtcCommitGeometry(instance);
+      rtcAttachGeometry(scene,instance);
+      rtcReleaseGeometry(instance);
+      rtcCommitScene(scene);
+      AssertNoError(device);
+
+      /* all rays hit the sphere */
+      const size_t N = 100;
+      for (size_t i=0; i<N; i++) {
+        const Vec3fa dir(0.2f*random_float()-0.1f,0.2f*random_float()-0.1f,1.0f);
+        RTCRayHit rayhit = makeRay(Vec3fa(0.5f,0.0f,-4.0f),dir);
+        RTCRayHit shadow = makeRay(Vec3fa(0.5f,0.0f,-4.0f),dir);
+        rtcIntersect1(scene,&rayhit);
+        rtcOccluded1(scene,&shadow.ray);
+      }
+      AssertNoError(device);
+
+      RTCSceneStatistics stats;
+      rtcGetSceneStatistics(scene,&stats);
+      bool passed = counted(stats.intersect,N) && counted(stats.occluded,N) && zero(stats.pointQuery);
+      passed &= stats.intersect.filters >= N && stats.intersect.instances == N;
+      passed &= stats.occluded.filters == 0 && stats.occluded.instances == N && stats.occluded.earlyOuts == N;
+
+      /* the instanced scene is accounted to the top level scene */
+      rtcGetSceneStatistics(sphere,&stats);
+      passed &= zero(stats.intersect) && zero(stats.occluded);
+
+      rtcResetSceneStatistics(scene);
+      rtcGetSceneStatistics(scene,&stats);
+      passed &= zero(stats.intersect) && zero(stats.occluded) && zero(stats.pointQuery);
+      AssertNoError(device);
+      return passed ? VerifyApplication::PASSED : VerifyApplication::FAILED;
+    }
+  };
+
+  struct BVHStatisticsTest : public VerifyApplication::Test
+  {
+    BVHStatisticsTest (std::string name, int isa)
+      : VerifyApplication::Test(name,isa,VerifyApplication::TEST_SHOULD_PASS) {}
+
+    static std::vector<RTCBVHStatistics> getStatistics(RTCScene scene)
+    {
+      std::vector<RTCBVHStatistics> stats(rtcGetSceneBVHStatistics(scene,nullptr,0));
+      rtcGetSceneBVHStatistics(scene,stats.data(),(unsigned int)stats.size());
+      return stats;
+    }
+
+    static bool valid(const RTCBVHStatistics& s)
+    {
+      const RTCBVHNodeStatistics* nodes[] = { &s.aabbNodes, &s.obbNodes, &s.aabbNodesMB, &s.aabbNodesMB4D, &s.obbNodesMB, &s.quantizedNodes, &s.compressedNodes, &s.leaves };
+      size_t bytes = 0;
+      for (auto n : nodes) {
+        if (n->fillRate < 0.0f || n->fillRate > 1.0f) return false;
+        bytes += n->bytes;
+      }
+      return (s.branchingFactor == 4 || s.branchingFactor == 8) && s.primitiveType != nullptr && s.bytes == bytes &&
+        s.sah > 0.0f && s.traversalCost > 0.0f && s.leafOverlap >= 0.0f && s.fillRate > 0.0f && s.fillRate <= 1.0f &&
+        s.leaves.numNodes > 0 && s.depth > 0;
+    }
+
+    VerifyApplication::TestReturnValue run(VerifyApplication* state, bool silent)
+    {
+      std::string cfg = state->rtcore + ",isa="+stringOfISA(isa);
+      RTCDeviceRef device = rtcNewDevice(cfg.c_str());
+      errorHandler(nullptr,rtcGetDeviceError(device));
+      const SceneFlags sflags(RTC_SCENE_FLAG_NONE,RTC_BUILD_QUALITY_MEDIUM);
+
+      /* the same spheres once placed next to each other and once stacked onto each other */
+      VerifyScene spread(device,sflags), stacked(device,sflags);
+      size_t numTriangles = 0;
+      for (size_t i=0; i<8; i++) {
+        Ref<SceneGraph::Node> sphere = SceneGraph::createTriangleSphere(Vec3fa(3.0f*i,0.0f,0.0f),1.0f,16);
+        numTriangles += sphere.dynamicCast<SceneGraph::TriangleMeshNode>()->triangles.size();
+        spread.addGeometry(RTC_BUILD_QUALITY_MEDIUM,sphere);
+        stacked.addGeometry(RTC_BUILD_QUALITY_MEDIUM,SceneGraph::createTriangleSphere(Vec3fa(0.01f*i,0.0f,0.0f),1.0f,16));
+      }
+      rtcCommitScene(spread);
+      rtcCommitScene(stacked);
+      AssertNoError(device);
+
+      const std::vector<RTCBVHStatistics> spreadStats = getStatistics(spread);
+      const std::vector<RTCBVHStatistics> stackedStats = getStatistics(stacked);
+      AssertNoError(device);
+      if (spreadStats.size() != 1 || stackedStats.size() != 1)
+        return VerifyApplication::FAILED;
+
+      bool passed = valid(spreadStats[0]) && valid(stackedStats[0]);
+      passed &= spreadStats[0].numPrimitives == numTriangles;
+
+      /* overlapping geometry results in overlapping leaves and expensive traversal */
+      passed &= stackedStats[0].leafOverlap > spreadStats[0].leafOverlap;
+      passed &= stackedStats[0].traversalCost > spreadStats[0].traversalCost;
+      return passed ? VerifyApplication::PASSED : VerifyApplication::FAILED;
+    }
+  };
+
+  struct BuildStatisticsTest : public VerifyApplication::Test
+  {
+    BuildStatisticsTest (std::string name, int isa)
+      : VerifyApplication::Test(name,isa,VerifyApplication::TEST_SHOULD_PASS) {}
+
+    static bool check(const RTCDeviceRef& device, RTCBuildQuality quality, bool enabled)
+    {
+      VerifyScene scene(device,SceneFlags(RTC_SCENE_FLAG_NONE,quality));
+      size_t numTriangles = 0;
+      for (size_t i=0; i<8; i++) {
+        Ref<SceneGraph::Node> sphere = SceneGraph::createTriangleSphere(Vec3fa(3.0f*i,0.0f,0.0f),1.0f,16);
+        numTriangles += sphere.dynamicCast<SceneGraph::TriangleMeshNode>()->triangles.size();
+        scene.addGeometry(RTC_BUILD_QUALITY_MEDIUM,sphere);
+      }
+      rtcCommitScene(scene);
+      std::vector<RTCBuildStatistics> stats(rtcGetSceneBuildStatistics(scene,nullptr,0));
+      rtcGetSceneBuildStatistics(scene,stats.data(),(unsigned int)stats.size());
+      AssertNoError(device);
+      if (stats.size() != 1)
+        return false;
+
+      const RTCBuildStatistics& s = stats[0];
+      bool passed = s.builder != nullptr && std::string(s.builder) != "" && s.primitiveType != nullptr;
+      passed &= s.numPrimitives == numTriangles;
+
+      /* without the build_statistics option no phases get measured */
+      if (enabled) {
+        passed &= s.total > 0.0 && s.primRefs > 0.0 && s.binning > 0.0 && s.partitioning > 0.0;
+        passed &= s.primRefs <= s.total;
+      } else {
+        passed &= s.total == 0.0 && s.primRefs == 0.0 && s.binning == 0.0 && s.partitioning == 0.0;
+      }
+      return passed;
+    }
+
+    VerifyApplication::TestReturnValue run(VerifyApplication* state, bool silent)
+    {
+      std::string cfg = state->rtcore + ",isa="+stringOfISA(isa);
+      RTCDeviceRef device = rtcNewDevice((cfg+",build_statistics=1").c_str());
+      errorHandler(nullptr,rtcGetDeviceError(device));
+      RTCDeviceRef deviceNoStats = rtcNewDevice(cfg.c_str());
+      errorHandler(nullptr,rtcGetDeviceError(deviceNoStats));
+
+      bool passed = true;
+      for (RTCBuildQuality quality : { RTC_BUILD_QUALITY_MEDIUM, RTC_BUILD_QUALITY_HIGH }) {
+        passed &= check(device,quality,true);
+        passed &= check(deviceNoStats,quality,false);
+      }
+      return passed ? VerifyApplication::PASSED : VerifyApplication::FAILED;
+    }
+  };
+
+  struct QuantizedLeavesTest : public VerifyApplication::Test
+  {
+    static const size_t N = 100;
+    static const size_t maxStreamSize = 16;
+
+    QuantizedLeavesTest (std::string name, int isa)
+      : VerifyApplication::Test(name,isa,VerifyApplication::TEST_SHOULD_PASS) {}
+
+    VerifyApplication::TestReturnValue run(VerifyApplication* state, bool silent)
+    {
+      std::string cfg = state->rtcore + ",isa="+stringOfISA(isa);
+      RTCDeviceRef device = rtcNewDevice((cfg+",quantized_leaves=1").c_str());
+      errorHandler(nullptr,rtcGetDeviceError(device));
+
+      /* a closed sphere far away from the origin, once stored in quantized leaves and once in full precision leaves */
+      const Vec3fa pos(1000.0f,0.0f,0.0f);
+      const float radius = 2.0f;
+      VerifyScene quantized(device,SceneFlags(RTC_SCENE_FLAG_COMPACT,RTC_BUILD_QUALITY_MEDIUM));
+      VerifyScene reference(device,SceneFlags(RTC_SCENE_FLAG_NONE,RTC_BUILD_QUALITY_MEDIUM));
+      quantized.addGeometry(RTC_BUILD_QUALITY_MEDIUM,SceneGraph::createTriangleSphere(pos,radius,200));
+      reference.addGeometry(RTC_BUILD_QUALITY_MEDIUM,SceneGraph::createTriangleSphere(pos,radius,200));
+      rtcCommitScene(quantized);
+      rtcCommitScene(reference);
+      AssertNoError(device);
+
+      const std::vector<RTCBVHStatistics> quantizedStats = BVHStatisticsTest::getStatistics(quantized);
+      const std::vector<RTCBVHStatistics> referenceStats = BVHStatisticsTest::getStatistics(reference);
+      AssertNoError(device);
+      if (quantizedStats.size() != 1 || referenceStats.size() != 1)
+        return VerifyApplication::FAILED;
+
+      bool passed = std::string(quantizedStats[0].primitiveType) == "triangle4q";
+      passed &= quantizedStats[0].leaves.bytes < referenceStats[0].leaves.bytes;
+
+      /* rays from inside the sphere have to hit the quantized sphere close to the original sphere */
+      size_t numFailures = 0;
+      for (IntersectMode imode : { MODE_INTERSECT1, MODE_INTERSECT4, MODE_INTERSECT8, MODE_INTERSECT16 })
+      {
+        for (size_t i=0; i<size_t(N*state->intensity); i++)
+        {
+          __aligned(16) RTCRayHit rays0[maxStreamSize];
+          __aligned(16) RTCRayHit rays1[maxStreamSize];
+          for (size_t j=0; j<maxStreamSize; j++) {
+            const Vec3fa org = pos + 0.5f*(2.0f*random_Vec3fa() - Vec3fa(1.0f));
+            const Vec3fa dir = 2.0f*random_Vec3fa() - Vec3fa(1.0f);
+            rays0[j] = rays1[j] = makeRay(org,dir);
+          }
+          IntersectWithMode(imode,VARIANT_INTERSECT,quantized,rays0,maxStreamSize);
+          IntersectWithMode(imode,VARIANT_INTERSECT,reference,rays1,maxStreamSize);
+          for (size_t j=0; j<maxStreamSize; j++)
+          {
+            const RTCRayHit& h0 = rays0[j];
+            const RTCRayHit& h1 = rays1[j];
+            bool ok = h0.hit.geomID != RTC_INVALID_GEOMETRY_ID;
+            ok &= h0.hit.u >= 0.0f && h0.hit.v >= 0.0f && h0.hit.u + h0.hit.v <= 1.0f + 1E-5f;
+            ok &= std::abs(h0.ray.tfar - h1.ray.tfar)*length(Vec3fa(h1.ray.dir_x,h1.ray.dir_y,h1.ray.dir_z)) < 1E-3f*radius;
+            numFailures += !ok;
+          }
+        }
+      }
+      AssertNoError(device);
+
+      if (!silent) { printf(" (%zu failures)", numFailures); fflush(stdout); }
+      passed &= numFailures == 0;
+      return passed ? VerifyApplication::PASSED : VerifyApplication::FAILED;
+    }
+  };
+
+  struct CompressedNodesTest : public VerifyApplication::Test
+  {
+    static const size_t N = 100;
+    static const size_t maxStreamSize = 16;
+
+    CompressedNodesTest (std::string name, int isa)
+      : VerifyApplication::Test(name,isa,VerifyApplication::TEST_SHOULD_PASS) {}
+
+    VerifyApplication::TestReturnValue run(VerifyApplication* state, bool silent)
+    {
+      std::string cfg = state->rtcore + ",isa="+stringOfISA(isa);
+      RTCDeviceRef device = rtcNewDevice((cfg+",tri_accel=qbvh8.triangle4i").c_str());
+      RTCDeviceRef cdevice = rtcNewDevice((cfg+",tri_accel=cbvh8.triangle4i").c_str());
+      errorHandler(nullptr,rtcGetDeviceError(device));
+      errorHandler(nullptr,rtcGetDeviceError(cdevice));
+
+      /* the same set of spheres once stored in compressed nodes and once in quantized nodes, both using the same triangle intersector */
+      VerifyScene compressed(cdevice,SceneFlags(RTC_SCENE_FLAG_NONE,RTC_BUILD_QUALITY_MEDIUM));
+      VerifyScene reference(device,SceneFlags(RTC_SCENE_FLAG_NONE,RTC_BUILD_QUALITY_MEDIUM));
+      for (size_t i=0; i<32; i++) {
+        const Vec3fa pos = 100.0f*random_Vec3fa();
+        const float radius = 1.0f + 4.0f*random_float();
+        compressed.addGeometry(RTC_BUILD_QUALITY_MEDIUM,SceneGraph::createTriangleSphere(pos,radius,50));
+        reference.addGeometry(RTC_BUILD_QUALITY_MEDIUM,SceneGraph::createTriangleSphere(pos,radius,50));
+      }
+      rtcCommitScene(compressed);
+      rtcCommitScene(reference);
+      AssertNoError(device);
+      AssertNoError(cdevice);
+
+      const std::vector<RTCBVHStatistics> compressedStats = BVHStatisticsTest::getStatistics(compressed);
+      AssertNoError(cdevice);
+      if (compressedStats.size() != 1)
+        return VerifyApplication::FAILED;
+      bool passed = compressedStats[0].compressedNodes.numNodes > 0 && compressedStats[0].aabbNodes.numNodes == 0;
+
+      /* conservative node bounds have to find exactly the same hits as the reference BVH */
+      size_t numFailures = 0;
+      for (size_t i=0; i<size_t(N*state->intensity); i++)
+      {
+        __aligned(16) RTCRayHit rays0[maxStreamSize];
+        __aligned(16) RTCRayHit rays1[maxStreamSize];
+        for (size_t j=0; j<maxStreamSize; j++) {
+          const Vec3fa org = 100.0f*random_Vec3fa();
+          const Vec3fa dir = 2.0f*random_Vec3fa() - Vec3fa(1.0f);
+          rays0[j] = rays1[j] = makeRay(org,dir);
+        }
+        IntersectWithMode(MODE_INTERSECT1,VARIANT_INTERSECT,compressed,rays0,maxStreamSize);
+        IntersectWithMode(MODE_INTERSECT1,VARIANT_INTERSECT,reference,rays1,maxStreamSize);
+        for (size_t j=0; j<maxStreamSize; j++)
+        {
+          const RTCRayHit& h0 = rays0[j];
+          const RTCRayHit& h1 = rays1[j];
+          bool ok = h0.hit.geomID == h1.hit.geomID && h0.hit.primID == h1.hit.primID;
+          ok &= h0.ray.tfar == h1.ray.tfar;
+          numFailures += !ok;
+        }
+      }
+      AssertNoError(cdevice);
+
+      if (!silent) { printf(" (%zu failures)", numFailures); fflush(stdout); }
+      passed &= numFailures == 0;
+      return passed ? VerifyApplication::PASSED : VerifyApplication::FAILED;
+    }
+  };
+
+  struct TrianglePairsTest : public VerifyApplication::Test
+  {
+    static const size_t N = 100;
+    static const size_t maxStreamSize = 16;
+
+    TrianglePairsTest (std::string name, int isa)
+      : VerifyApplication::Test(name,isa,VerifyApplication::TEST_SHOULD_PASS) {}
+
+    VerifyApplication::TestReturnValue run(VerifyApplication* state, bool silent)
+    {
+      std::string cfg = state->rtcore + ",isa="+stringOfISA(isa);
+      RTCDeviceRef device = rtcNewDevice((cfg+",tri_accel=bvh4.triangle4i").c_str());
+      RTCDeviceRef pdevice = rtcNewDevice((cfg+",triangle_pairs=1").c_str());
+      errorHandler(nullptr,rtcGetDeviceError(device));
+      errorHandler(nullptr,rtcGetDeviceError(pdevice));
+
+      /* the same set of spheres once stored as triangle pairs and once as single triangles, some spheres contain invalid triangles */
+      VerifyScene paired(pdevice,SceneFlags(RTC_SCENE_FLAG_NONE,RTC_BUILD_QUALITY_MEDIUM));
+      VerifyScene reference(device,SceneFlags(RTC_SCENE_FLAG_NONE,RTC_BUILD_QUALITY_MEDIUM));
+      for (size_t i=0; i<32; i++) {
+        const Vec3fa pos = 100.0f*random_Vec3fa();
+        const float radius = 1.0f + 4.0f*random_float();
+        Ref<SceneGraph::TriangleMeshNode> sphere = SceneGraph::createTriangleSphere(pos,radius,50).dynamicCast<SceneGraph::TriangleMeshNode>();
+        if (i%4 == 0) sphere->positions[0][100+i].x = float(nan);
+        paired.addGeometry(RTC_BUILD_QUALITY_MEDIUM,sphere.dynamicCast<SceneGraph::Node>());
+        reference.addGeometry(RTC_BUILD_QUALITY_MEDIUM,sphere.dynamicCast<SceneGraph::Node>());
+      }
+      rtcCommitScene(paired);
+      rtcCommitScene(reference);
+      AssertNoError(device);
+      AssertNoError(pdevice);
+
+      const std::vector<RTCBVHStatistics> pairedStats = BVHStatisticsTest::getStatistics(paired);
+      const std::vector<RTCBVHStatistics> referenceStats = BVHStatisticsTest::getStatistics(reference);
+      AssertNoError(device);
+      AssertNoError(pdevice);
+      if (pairedStats.size() != 1 || referenceStats.size() != 1)
+        return VerifyApplication::FAILED;
+
+      bool passed = std::string(pairedStats[0].primitiveType) == "trianglepair4i";
+      passed &= pairedStats[0].numPrimitives < referenceStats[0].numPrimitives;
+
+      /* both triangles of a pair use the same intersector as single triangles, thus have to report exactly the same hits */
+      size_t numFailures = 0;
+      for (IntersectMode imode : { MODE_INTERSECT1, MODE_INTERSECT4, MODE_INTERSECT8, MODE_INTERSECT16 })
+      {
+        for (size_t i=0; i<size_t(N*state->intensity); i++)
+        {
+          __aligned(16) RTCRayHit rays0[maxStreamSize];
+          __aligned(16) RTCRayHit rays1[maxStreamSize];
+          for (size_t j=0; j<maxStreamSize; j++) {
+            const Vec3fa org = 100.0f*random_Vec3fa();
+            const Vec3fa dir = 2.0f*random_Vec3fa() - Vec3fa(1.0f);
+            rays0[j] = rays1[j] = makeRay(org,dir);
+          }
+          IntersectWithMode(imode,VARIANT_INTERSECT,paired,rays0,maxStreamSize);
+          IntersectWithMode(imode,VARIANT_INTERSECT,reference,rays1,maxStreamSize);
+          for (size_t j=0; j<maxStreamSize; j++)
+          {
+            const RTCRayHit& h0 = rays0[j];
+            const RTCRayHit& h1 = rays1[j];
+            bool ok = h0.hit.geomID == h1.hit.geomID && h0.hit.primID == h1.hit.primID;
+            ok &= h0.ray.tfar == h1.ray.tfar && h0.hit.u == h1.hit.u && h0.hit.v == h1.hit.v;
+            numFailures += !ok;
+          }
+        }
+      }
+      AssertNoError(pdevice);
+
+      if (!silent) { printf(" (%zu failures)", numFailures); fflush(stdout); }
+      passed &= numFailures == 0;
+      return passed ? VerifyApplication::PASSED : VerifyApplication::FAILED;
+    }
+  };
+
+  struct MultiHitTest : public VerifyApplication::Test
+  {
+    static const size_t N = 1000;
+    static const unsigned int capacity = 8;
+
+    struct HitRecord
+    {
+      HitRecord () {}
+      HitRecord (float t, unsigned int geomID, unsigned int primID)
+        : t(t), geomID(geomID), primID(primID) {}
+
+      __forceinline friend bool operator< (const HitRecord& a, const HitRecord& b) {
+        if (a.t != b.t) return a.t < b.t;
+        if (a.geomID != b.geomID) return a.geomID < b.geomID;
+        return a.primID < b.primID;
+      }
+
+      __forceinline friend bool operator== (const HitRecord& a, const HitRecord& b) {
+        return a.t == b.t && a.geomID == b.geomID && a.primID == b.primID;
+      }
+
+    public:
+      float t;
+      unsigned int geomID;
+      unsigned int primID;
+    };
+
+    struct RayQueryContext
+    {
+      RTCRayQueryContext context;
+      std::vector<HitRecord>* hits;
+    };
+
+    MultiHitTest (std::string name, int isa)
+      : VerifyApplication::Test(name,isa,VerifyApplication::TEST_SHOULD_PASS) {}
+
+    /* returns the first hit distance of the ray with the sphere that is not before tnear */
+    static float intersectSphere(const Sphere& sphere, const RTCRay& ray)
+    {
+      const Vec3fa org(ray.org_x,ray.org_y,ray.org_z);
+      const Vec3fa dir(ray.dir_x,ray.dir_y,ray.dir_z);
+      const Vec3fa v = org-sphere.pos;
+      const float A = dot(dir,dir);
+      const float B = 2.0f*dot(v,dir);
+      const float C = dot(v,v) - sqr(sphere.r);
+      const float D = B*B - 4.0f*A*C;
+      if (D < 0.0f) return float(pos_inf);
+      const float Q = sqrt(D);
+      const float t0 = (-B-Q)/(2.0f*A);
+      const float t1 = (-B+Q)/(2.0f*A);
+      if (t0 >= ray.tnear) return t0;
+      if (t1 >= ray.tnear) return t1;
+      return float(pos_inf);
+    }
+
+    static void intersectSphereN(const RTCIntersectFunctionNArguments* args)
+    {
+      assert(args->N == 1);
+      if (!args->valid[0]) return;
+      const Sphere* sphere = (const Sphere*) args->geometryUserPtr;
+      RTCRayHit* rayhit = (RTCRayHit*) args->rayhit;
+      const float t = intersectSphere(*sphere,rayhit->ray);
+      if (t >= rayhit->ray.tfar) return;
+      rayhit->ray.tfar = t;
+      rayhit->hit.Ng_x = rayhit->ray.org_x + t*rayhit->ray.dir_x - sphere->pos.x;
+      rayhit->hit.Ng_y = rayhit->ray.org_y + t*rayhit->ray.dir_y - sphere->pos.y;
+      rayhit->hit.Ng_z = rayhit->ray.org_z + t*rayhit->ray.dir_z - sphere->pos.z;
+      rayhit->hit.u = rayhit->hit.v = 0.0f;
+      rayhit->hit.primID = args->primID;
+      rayhit->hit.geomID = args->geomID;
+      rayhit->hit.instID[0] = args->context->instID[0];
+    }
+
+    /* gathers all hits and rejects them */
+    static void gatherAllHits(const RTCFilterFunctionNArguments* args)
+    {
+      assert(args->N == 1);
+      RayQueryContext* context = (RayQueryContext*) args->context;
+      const RTCRay* ray = (const RTCRay*) args->ray;
+      const RTCHit* hit = (const RTCHit*) args->hit;
+      context->hits->push_back(HitRecord(ray->tfar,hit->geomID,hit->primID));
+      args->valid[0] = 0;
+    }
+
+    VerifyApplication::TestReturnValue run(VerifyApplication* state, bool silent)
+    {
+      std::string cfg = state->rtcore + ",isa="+stringOfISA(isa);
+      RTCDeviceRef device = rtcNewDevice(cfg.c_str());
+      errorHandler(nullptr,rtcGetDeviceError(device));
+
+      VerifyScene scene(device,SceneFlags(RTC_SCENE_FLAG_FILTER_FUNCTION_IN_ARGUMENTS,RTC_BUILD_QUALITY_MEDIUM));
+      for (size_t i=0; i<16; i++)
+        scene.addSphere(sampler,RTC_BUILD_QUALITY_MEDIUM,10.0f*random_Vec3fa(),1.0f+random_float(),20);
+      for (size_t i=0; i<8; i++)
+        scene.addQuadSphere(sampler,RTC_BUILD_QUALITY_MEDIUM,10.0f*random_Vec3fa(),1.0f+random_float(),20);
+      if (rtcGetDeviceProperty(device,RTC_DEVICE_PROPERTY_SUBDIVISION_GEOMETRY_SUPPORTED))
+        for (size_t i=0; i<2; i++)
+          scene.addSubdivSphere(sampler,RTC_BUILD_QUALITY_MEDIUM,10.0f*random_Vec3fa(),1.0f+random_float(),4,4);
+
+      Sphere spheres[4];
+      unsigned int sphereIDs[4];
+      const size_t numSpheres = rtcGetDeviceProperty(device,RTC_DEVICE_PROPERTY_USER_GEOMETRY_SUPPORTED) ? 4 : 0;
+      for (size_t i=0; i<numSpheres; i++)
+      {
+        spheres[i] = Sphere(10.0f*random_Vec3fa(),1.0f+random_float());
+        RTCGeometry geom = rtcNewGeometry(device,RTC_GEOMETRY_TYPE_USER);
+        rtcSetGeometryUserPrimitiveCount(geom,1);
+        rtcSetGeometryBoundsFunction(geom,BoundsFunc,nullptr);
+        rtcSetGeometryUserData(geom,&spheres[i]);
+        rtcSetGeometryIntersectFunction(geom,intersectSphereN);
+        rtcSetGeometryOccludedFunction(geom,OccludedFuncN);
+        rtcCommitGeometry(geom);
+        sphereIDs[i] = rtcAttachGeometry(scene,geom);
+        rtcReleaseGeometry(geom);
+      }
+      rtcCommitScene(scene);
+      AssertNoError(device);
+
+      /* a capacity of zero is invalid */
+      {
+        RTCMultiHit hits[1];
+        RTCRayHit ray = makeRay(Vec3fa(zero),Vec3fa(1,0,0));
+        rtcIntersect1Multi(scene,&ray,hits,0);
+        AssertError(device,RTC_ERROR_INVALID_ARGUMENT);
+      }
+
+      size_t numFailures = 0;
+      size_t numHits = 0;
+      for (size_t i=0; i<size_t(N*state->intensity); i++)
+      {
+        const Vec3fa org = 10.0f*random_Vec3fa();
+        const Vec3fa dir = 2.0f*random_Vec3fa() - Vec3fa(1.0f);
+
+        /* reference: gather all hits through a filter function, add the first hit of the user geometries analytically */
+        std::vector<HitRecord> expected;
+        RayQueryContext context;
+        rtcInitRayQueryContext(&context.context);
+        context.hits = &expected;
+        RTCIntersectArguments args;
+        rtcInitIntersectArguments(&args);
+        args.context = &context.context;
+        args.filter = gatherAllHits;
+        args.flags = RTC_RAY_QUERY_FLAG_INVOKE_ARGUMENT_FILTER;
+        args.intersect = IntersectFuncN;
+        RTCRayHit ray0 = makeRay(org,dir);
+        rtcIntersect1(scene,&ray0,&args);
+        for (size_t j=0; j<numSpheres; j++) {
+          const float t = intersectSphere(spheres[j],ray0.ray);
+          if (t < float(inf)) expected.push_back(HitRecord(t,sphereIDs[j],0));
+        }
+        std::sort(expected.begin(),expected.end());
+        expected.erase(std::unique(expected.begin(),expected.end()),expected.end());
+        expected.resize(std::min(expected.size(),size_t(capacity)));
+
+        RTCMultiHit hits[capacity];
+        RTCRayHit ray1 = makeRay(org,dir);
+        const unsigned int num = rtcIntersect1Multi(scene,&ray1,hits,capacity);
+        std::vector<HitRecord> found;
+        for (unsigned int j=0; j<num; j++) {
+          found.push_back(HitRecord(hits[j].tfar,hits[j].hit.geomID,hits[j].hit.primID));
+          if (j > 0 && hits[j].tfar < hits[j-1].tfar) numFailures++;
+        }
+        std::sort(found.begin(),found.end());
+        numFailures += found != expected;
+        numHits += num;
+
+        /* the ray reports the closest hit */
+        if (num) {
+          numFailures += ray1.ray.tfar != hits[0].tfar || ray1.hit.geomID != hits[0].hit.geomID || ray1.hit.primID != hits[0].hit.primID;
+        } else {
+          numFailures += ray1.ray.tfar != float(inf) || ray1.hit.geomID != RTC_INVALID_GEOMETRY_ID;
+        }
+      }
+      AssertNoError(device);
+
+      if (!silent) { printf(" (%zu hits, %zu failures)", numHits, numFailures); fflush(stdout); }
+      return numFailures == 0 ? VerifyApplication::PASSED : VerifyApplication::FAILED;
+    }
+  };
+
+  struct RayTileTest : public VerifyApplication::Test
+  {
+    RayTileTest (std::string name, int isa)
+      : VerifyApplication::Test(name,isa,VerifyApplication::TEST_SHOULD_PASS) {}
+
+    VerifyApplication::TestReturnValue run(VerifyApplication* state, bool silent)
+    {
+      std::string cfg = state->rtcore + ",isa="+stringOfISA(isa);
+      RTCDeviceRef device = rtcNewDevice(cfg.c_str());
+      errorHandler(nullptr,rtcGetDeviceError(device));
+      VerifyScene scene(device,SceneFlags(RTC_SCENE_FLAG_NONE,RTC_BUILD_QUALITY_MEDIUM));
+      for (size_t i=0; i<16; i++)
+        scene.addSphere(sampler,RTC_BUILD_QUALITY_MEDIUM,4.0f*random_Vec3fa()-Vec3fa(2.0f),0.2f+0.3f*random_float(),20);
+      for (size_t i=0; i<8; i++)
+        scene.addQuadSphere(sampler,RTC_BUILD_QUALITY_MEDIUM,4.0f*random_Vec3fa()-Vec3fa(2.0f),0.2f+0.3f*random_float(),20);
+      rtcCommitScene(scene);
+      AssertNoError(device);
+
+      /* camera rays in 16x16 pixel tiles, the image is not a multiple of the tile size and spans all octants */
+      const size_t W = 200, H = 120;
+      const Vec3fa org(0.1f,0.2f,-5.0f);
+      std::vector<RTCRayHit> rays, rays1M;
+      for (size_t ty=0; ty<H; ty+=16)
+        for (size_t tx=0; tx<W; tx+=16)
+          for (size_t y=ty; y<min(H,ty+16); y++)
+            for (size_t x=tx; x<min(W,tx+16); x++)
+              rays.push_back(makeRay(org,Vec3fa(float(x)/float(W)-0.5f,float(y)/float(H)-0.5f,1.0f)));
+      const size_t N = rays.size();
+      rays1M = rays;
+
+      RTCIntersectArguments iargs;
+      rtcInitIntersectArguments(&iargs);
+      iargs.flags = RTC_RAY_QUERY_FLAG_COHERENT;
+      for (size_t i=0; i<N; i++) rtcIntersect1(scene,&rays[i]);
+      rtcIntersect1M(scene,rays1M.data(),N,sizeof(RTCRayHit),&iargs);
+      AssertNoError(device);
+
+      /* packet kernels may disagree with single ray kernels for rays hitting edges */
+      size_t numHits = 0, numErrors = 0;
+      for (size_t i=0; i<N; i++)
+      {
+        numHits += rays[i].hit.geomID != RTC_INVALID_GEOMETRY_ID;
+        numErrors += rays1M[i].hit.geomID != rays[i].hit.geomID || rays1M[i].hit.primID != rays[i].hit.primID;
+        numErrors += abs(rays1M[i].ray.tfar - rays[i].ray.tfar) > 1E-4f*rays[i].ray.tfar;
+      }
+      bool passed = numHits > 0 && numHits < N;
+
+      /* shadow rays from the hit points towards an area light */
+      std::vector<RTCRay> shadows, shadows1M;
+      for (size_t i=0; i<N; i++)
+      {
+        if (rays[i].hit.geomID == RTC_INVALID_GEOMETRY_ID) continue;
+        const Vec3fa p = org + rays[i].ray.tfar*Vec3fa(rays[i].ray.dir_x,rays[i].ray.dir_y,rays[i].ray.dir_z);
+        const Vec3fa l = Vec3fa(-1.0f,4.0f,-1.0f) + Vec3fa(random_float(),0.0f,random_float());
+        RTCRay ray = makeRay(l,p-l).ray;
+        ray.tfar = 0.999f;
+        shadows.push_back(ray);
+      }
+      shadows1M = shadows;
+
+      RTCOccludedArguments oargs;
+      rtcInitOccludedArguments(&oargs);
+      oargs.flags = RTC_RAY_QUERY_FLAG_COHERENT;
+      for (size_t i=0; i<shadows.size(); i++) rtcOccluded1(scene,&shadows[i]);
+      rtcOccluded1M(scene,shadows1M.data(),shadows.size(),sizeof(RTCRay),&oargs);
+      AssertNoError(device);
+
+      size_t numOccluded = 0;
+      for (size_t i=0; i<shadows.size(); i++) {
+        numOccluded += shadows[i].tfar < 0.0f;
+        numErrors += (shadows[i].tfar < 0.0f) != (shadows1M[i].tfar < 0.0f);
+      }
+      passed &= numOccluded > 0 && numOccluded < shadows.size();
+      passed &= numErrors <= N/1000;
+      return passed ? VerifyApplication::PASSED : VerifyApplication::FAILED;
+    }
+  };
+
+  struct RayTreeletTest : public VerifyApplication::Test
+  {
+    RayTreeletTest (std::string name, int isa)
+      : VerifyApplication::Test(name,isa,VerifyApplication::TEST_SHOULD_PASS) {}
+
+    VerifyApplication::TestReturnValue run(VerifyApplication* state, bool silent)
+    {
+      std::string cfg = state->rtcore + ",isa="+stringOfISA(isa);
+      RTCDeviceRef device = rtcNewDevice(cfg.c_str());
+      errorHandler(nullptr,rtcGetDeviceError(device));
+
+      /* enough triangles for the BVH to span multiple treelet levels */
+      VerifyScene scene(device,SceneFlags(RTC_SCENE_FLAG_NONE,RTC_BUILD_QUALITY_MEDIUM));
+      for (size_t i=0; i<24; i++)
+        scene.addSphere(sampler,RTC_BUILD_QUALITY_MEDIUM,4.0f*random_Vec3fa()-Vec3fa(2.0f),0.2f+0.3f*random_float(),30);
+      for (size_t i=0; i<8; i++)
+        scene.addQuadSphere(sampler,RTC_BUILD_QUALITY_MEDIUM,4.0f*random_Vec3fa()-Vec3fa(2.0f),0.2f+0.3f*random_float(),30);
+      rtcCommitScene(scene);
+      AssertNoError(device);
+
+      /* incoherent rays spanning multiple stream blocks */
+      const size_t N = 10000;
+      std::vector<RTCRayHit> rays, rays1M;
+      for (size_t i=0; i<N; i++)
+        rays.push_back(makeRay(4.0f*random_Vec3fa()-Vec3fa(2.0f),random_Vec3fa()-Vec3fa(0.5f)));
+      rays1M = rays;
+
+      RTCIntersectArguments iargs;
+      rtcInitIntersectArguments(&iargs);
+      iargs.flags = RTC_RAY_QUERY_FLAG_TREELETS;
+      for (size_t i=0; i<N; i++) rtcIntersect1(scene,&rays[i]);
+      rtcIntersect1M(scene,rays1M.data(),N,sizeof(RTCRayHit),&iargs);
+      AssertNoError(device);
+
+      /* rays hitting a shared edge may report either triangle */
+      size_t numHits = 0, numErrors = 0;
+      for (size_t i=0; i<N; i++)
+      {
+        numHits += rays[i].hit.geomID != RTC_INVALID_GEOMETRY_ID;
+        numErrors += rays1M[i].hit.geomID != rays[i].hit.geomID || rays1M[i].hit.primID != rays[i].hit.primID;
+        numErrors += rays1M[i].ray.tfar != rays[i].ray.tfar;
+      }
+      bool passed = numHits > 0 && numHits < N;
+
+      /* shadow rays of random length */
+      std::vector<RTCRay> shadows, shadows1M;
+      for (size_t i=0; i<N; i++) {
+        RTCRay ray = makeRay(4.0f*random_Vec3fa()-Vec3fa(2.0f),random_Vec3fa()-Vec3fa(0.5f)).ray;
+        ray.tfar = 4.0f*random_float();
+        shadows.push_back(ray);
+      }
+      shadows1M = shadows;
+
+      RTCOccludedArguments oargs;
+      rtcInitOccludedArguments(&oargs);
+      oargs.flags = RTC_RAY_QUERY_FLAG_TREELETS;
+      for (size_t i=0; i<N; i++) rtcOccluded1(scene,&shadows[i]);
+      rtcOccluded1M(scene,shadows1M.data(),N,sizeof(RTCRay),&oargs);
+      AssertNoError(device);
+
+      size_t numOccluded = 0;
+      for (size_t i=0; i<N; i++) {
+        numOccluded += shadows[i].tfar < 0.0f;
+        numErrors += (shadows[i].tfar < 0.0f) != (shadows1M[i].tfar < 0.0f);
+      }
+      passed &= numOccluded > 0 && numOccluded < N;
+      passed &= numErrors <= N/1000;
+      return passed ? VerifyApplication::PASSED : VerifyApplication::FAILED;
+    }
+  };
+
+  struct FeatureMaskTest : public VerifyApplication::Test
+  {
+    FeatureMaskTest (std::string name, int isa)
+      : VerifyApplication::Test(name,isa,VerifyApplication::TEST_SHOULD_PASS) {}
+
+    VerifyApplication::TestReturnValue run(VerifyApplication* state, bool silent)
+    {
+      std::string cfg = state->rtcore + ",isa="+stringOfISA(isa);
+      RTCDeviceRef device = rtcNewDevice(cfg.c_str());
+      errorHandler(nullptr,rtcGetDeviceError(device));
+      VerifyScene scene(device,SceneFlags(RTC_SCENE_FLAG_NONE,RTC_BUILD_QUALITY_MEDIUM));
+      const unsigned int triID  = scene.addSphere    (sampler,RTC_BUILD_QUALITY_MEDIUM,Vec3fa(-1,0,0),0.8f,20).first;
+      const unsigned int quadID = scene.addQuadSphere(sampler,RTC_BUILD_QUALITY_MEDIUM,Vec3fa(+1,0,0),0.8f,20).first;
+      rtcCommitScene(scene);
+      AssertNoError(device);
+
+      RTCIntersectArguments iargs0, iargs1;
+      rtcInitIntersectArguments(&iargs0);
+      rtcInitIntersectArguments(&iargs1);
+      iargs0.feature_mask = (RTCFeatureFlags) (RTC_FEATURE_FLAG_TRIANGLE | RTC_FEATURE_FLAG_QUAD);
+      iargs1.feature_mask = RTC_FEATURE_FLAG_TRIANGLE;
+      RTCOccludedArguments oargs1;
+      rtcInitOccludedArguments(&oargs1);
+      oargs1.feature_mask = RTC_FEATURE_FLAG_TRIANGLE;
+
+      size_t numTriHits = 0, numQuadHits = 0, numErrors = 0;
+      for (size_t y=0; y<32; y++)
+      {
+        for (size_t x=0; x<64; x++)
+        {
+          const Vec3fa org(4.0f*float(x)/64.0f-2.0f,2.0f*float(y)/32.0f-1.0f,-5.0f);
+          RTCRayHit ray  = makeRay(org,Vec3fa(0,0,1));
+          RTCRayHit ray0 = ray, ray1 = ray;
+          RTCRay shadow1 = ray.ray;
+          rtcIntersect1(scene,&ray);
+          rtcIntersect1(scene,&ray0,&iargs0);
+          rtcIntersect1(scene,&ray1,&iargs1);
+          rtcOccluded1(scene,&shadow1,&oargs1);
+          numTriHits  += ray.hit.geomID == triID;
+          numQuadHits += ray.hit.geomID == quadID;
+
+          /* enabling all geometry types of the scene gives the same hits */
+          numErrors += ray0.hit.geomID != ray.hit.geomID || ray0.hit.primID != ray.hit.primID || ray0.ray.tfar != ray.ray.tfar;
+
+          /* the quad mesh is not traversed when only triangles are enabled */
+          if (ray.hit.geomID == quadID)
+            numErrors += ray1.hit.geomID != RTC_INVALID_GEOMETRY_ID || shadow1.tfar < 0.0f;
+          else
+            numErrors += ray1.hit.geomID != ray.hit.geomID || ray1.hit.primID != ray.hit.primID || (ray.hit.geomID != RTC_INVALID_GEOMETRY_ID) != (shadow1.tfar < 0.0f);
+        }
+      }
+      AssertNoError(device);
+      return (numTriHits > 0 && numQuadHits > 0 && numErrors == 0) ? VerifyApplication::PASSED : VerifyApplication::FAILED;
+    }
+  };
+
   struct DisableAndDetachGeometryTest : public VerifyApplication::Test
   {
     SceneFlags sflags;
@@ -2122,6 +3661,122 @@ namespace embree
     }
   };
 
+  struct TessellationCacheTest : public VerifyApplication::Test
+  {
+    TessellationCacheTest (std::string name, int isa)
+      : VerifyApplication::Test(name,isa,VerifyApplication::TEST_SHOULD_PASS) {}
+
+    VerifyApplication::TestReturnValue run(VerifyApplication* state, bool silent)
+    {
+      std::string cfg = state->rtcore + ",isa="+stringOfISA(isa);
+      RTCDeviceRef device0 = rtcNewDevice(cfg.c_str());
+      errorHandler(nullptr,rtcGetDeviceError(device0));
+      RTCDeviceRef device1 = rtcNewDevice(cfg.c_str());
+      errorHandler(nullptr,rtcGetDeviceError(device1));
+      if (!rtcGetDeviceProperty(device0,RTC_DEVICE_PROPERTY_SUBDIVISION_GEOMETRY_SUPPORTED))
+        return VerifyApplication::SKIPPED;
+
+      RTCGeometry geom = rtcNewGeometry(device0, RTC_GEOMETRY_TYPE_SUBDIVISION);
+      rtcSetSharedGeometryBuffer(geom, RTC_BUFFER_TYPE_INDEX, 0, RTC_FORMAT_UINT, interpolation_quad_indices, 0, sizeof(unsigned int), num_interpolation_quad_faces*4);
+      rtcSetSharedGeometryBuffer(geom, RTC_BUFFER_TYPE_FACE,  0, RTC_FORMAT_UINT, interpolation_quad_faces,   0, sizeof(unsigned int), num_interpolation_quad_faces);
+      std::vector<float> vertices(3*num_interpolation_vertices+16);
+      for (size_t i=0; i<vertices.size(); i++) vertices[i] = random_float();
+      rtcSetSharedGeometryBuffer(geom, RTC_BUFFER_TYPE_VERTEX, 0, RTC_FORMAT_FLOAT3, vertices.data(), 0, 3*sizeof(float), num_interpolation_vertices);
+      rtcCommitGeometry(geom);
+      AssertNoError(device0);
+
+      auto interpolate = [&] () {
+        float P[3];
+        for (unsigned int primID=0; primID<num_interpolation_quad_faces; primID++)
+          rtcInterpolate0(geom,primID,0.5f,0.5f,RTC_BUFFER_TYPE_VERTEX,0,P,3);
+      };
+
+      bool passed = true;
+      RTCTessellationCacheStatistics stats0, stats1;
+      rtcResetDeviceTessellationCacheStatistics(device0);
+      passed &= rtcGetDeviceProperty(device0,RTC_DEVICE_PROPERTY_TESSELLATION_CACHE_SIZE) > 0;
+
+      /* the first evaluation constructs the patches, the second one finds them in the cache */
+      interpolate();
+      rtcGetDeviceTessellationCacheStatistics(device0,&stats0);
+      passed &= stats0.misses == num_interpolation_quad_faces && stats0.hits == 0;
+      interpolate();
+      rtcGetDeviceTessellationCacheStatistics(device0,&stats0);
+      passed &= stats0.misses == num_interpolation_quad_faces && stats0.hits == num_interpolation_quad_faces;
+
+      /* the other device has its own cache */
+      rtcGetDeviceTessellationCacheStatistics(device1,&stats1);
+      passed &= stats1.hits == 0 && stats1.misses == 0 && stats1.flushes == 0;
+
+      /* resizing the cache invalidates all patches */
+      rtcSetDeviceProperty(device0,RTC_DEVICE_PROPERTY_TESSELLATION_CACHE_SIZE,16*1024*1024);
+      passed &= rtcGetDeviceProperty(device0,RTC_DEVICE_PROPERTY_TESSELLATION_CACHE_SIZE) == 16*1024*1024;
+      rtcResetDeviceTessellationCacheStatistics(device0);
+      interpolate();
+      rtcGetDeviceTessellationCacheStatistics(device0,&stats0);
+      passed &= stats0.size == 16*1024*1024 && stats0.misses == num_interpolation_quad_faces && stats0.hits == 0;
+
+      rtcReleaseGeometry(geom);
+      AssertNoError(device0);
+      AssertNoError(device1);
+      return (VerifyApplication::TestReturnValue) passed;
+    }
+  };
+
+  struct AdaptiveTessellationTest : public VerifyApplication::Test
+  {
+    AdaptiveTessellationTest (std::string name, int isa)
+      : VerifyApplication::Test(name,isa,VerifyApplication::TEST_SHOULD_PASS) {}
+
+    VerifyApplication::TestReturnValue run(VerifyApplication* state, bool silent)
+    {
+      std::string cfg = state->rtcore + ",isa="+stringOfISA(isa);
+      RTCDeviceRef device = rtcNewDevice(cfg.c_str());
+      errorHandler(nullptr,rtcGetDeviceError(device));
+      if (!rtcGetDeviceProperty(device,RTC_DEVICE_PROPERTY_SUBDIVISION_GEOMETRY_SUPPORTED))
+        return VerifyApplication::SKIPPED;
+
+      VerifyScene scene(device,SceneFlags(RTC_SCENE_FLAG_NONE,RTC_BUILD_QUALITY_MEDIUM));
+      const unsigned int geomID = scene.addGeometry(RTC_BUILD_QUALITY_MEDIUM,SceneGraph::createSubdivSphere(Vec3fa(zero),1.0f,8,16));
+      RTCGeometry geom = rtcGetGeometry(scene,geomID);
+
+      /* commits the scene and returns the number of grids, if the sphere is still hit */
+      auto build = [&] () -> size_t {
+        rtcCommitGeometry(geom);
+        rtcCommitScene(scene);
+        AssertNoError(device);
+        RTCRayHit ray = makeRay(Vec3fa(0.1f,0.1f,-5.0f),Vec3fa(0,0,1));
+        rtcIntersect1(scene,&ray);
+        if (ray.hit.geomID != geomID) return 0;
+        RTCBVHStatistics stats;
+        if (rtcGetSceneBVHStatistics(scene,&stats,1) != 1) return 0;
+        return stats.numPrimitives;
+      };
+
+      const size_t numGrids = build();
+
+      /* far away the ray footprint covers entire edges */
+      const float farPos[3] = { 0.0f, 0.0f, 1000.0f };
+      rtcSetGeometryTessellationCamera(geom,farPos,0.001f);
+      const size_t numGridsFar = build();
+
+      /* close to the camera the tessellation rate limits the edge levels */
+      const float nearPos[3] = { 0.0f, 0.0f, -2.0f };
+      rtcSetGeometryTessellationCamera(geom,nearPos,0.0001f);
+      const size_t numGridsNear = build();
+
+      rtcSetGeometryTessellationCamera(geom,nullptr,0.0f);
+      const size_t numGridsDisabled = build();
+
+      /* the spread angle has to be positive */
+      rtcSetGeometryTessellationCamera(geom,farPos,0.0f);
+      AssertError(device,RTC_ERROR_INVALID_ARGUMENT);
+
+      const bool passed = numGrids > 0 && numGridsFar > 0 && numGridsFar < numGrids && numGridsNear == numGrids && numGridsDisabled == numGrids;
+      return passed ? VerifyApplication::PASSED : VerifyApplication::FAILED;
+    }
+  };
+
   struct InterpolateTrianglesTest : public VerifyApplication::Test
   {
     size_t N;
@@ -5499,6 +7154,7 @@ namespace embree
     sceneFlagsDynamic.push_back(SceneFlags(RTC_SCENE_FLAG_DYNAMIC | RTC_SCENE_FLAG_ROBUST,        RTC_BUILD_QUALITY_LOW));
     sceneFlagsDynamic.push_back(SceneFlags(RTC_SCENE_FLAG_DYNAMIC | RTC_SCENE_FLAG_COMPACT,       RTC_BUILD_QUALITY_LOW));
     sceneFlagsDynamic.push_back(SceneFlags(RTC_SCENE_FLAG_DYNAMIC | RTC_SCENE_FLAG_ROBUST | RTC_SCENE_FLAG_COMPACT,RTC_BUILD_QUALITY_LOW));
+    sceneFlagsDynamic.push_back(SceneFlags(RTC_SCENE_FLAG_DYNAMIC,       RTC_BUILD_QUALITY_REFIT));
 
     /**************************************************************************/
     /*                      Smaller API Tests                                 */
@@ -5589,6 +7245,33 @@ namespace embree
         groups.top()->add(new EnableDisableGeometryTest(to_string(sflags),isa,sflags));
       groups.pop();
       
+      push(new TestGroup("save_load_scene",true,true));
+      for (auto sflags : sceneFlags)
+        groups.top()->add(new SaveLoadSceneTest(to_string(sflags),isa,sflags));
+      groups.pop();
+
+      groups.top()->add(new RefitTopLevelTest("refit_toplevel",isa));
+      groups.top()->add(new InsertRemoveTopLevelTest("insert_remove_toplevel",isa));
+      groups.top()->add(new RefitRotationTest("refit_rotation",isa));
+      groups.top()->add(new NUMAReplicationTest("numa_replication",isa));
+      groups.top()->add(new UserAllocatorTest("user_allocator",isa));
+      groups.top()->add(new PersistentBuildMemoryTest("persistent_build_memory",isa));
+      groups.top()->add(new RayStreamTest("ray_stream",isa));
+      groups.top()->add(new PointQueryBatchTest("point_query_batch",isa));
+      groups.top()->add(new CollideTest("collide",isa));
+      groups.top()->add(new TraversalStatisticsTest("traversal_statistics",isa));
+      groups.top()->add(new BVHStatisticsTest("bvh_statistics",isa));
+      groups.top()->add(new BuildStatisticsTest("build_statistics",isa));
+      groups.top()->add(new QuantizedLeavesTest("quantized_leaves",isa));
+      if ((isa & AVX) == AVX)
+        groups.top()->add(new CompressedNodesTest("compressed_nodes",isa));
+      groups.top()->add(new TrianglePairsTest("triangle_pairs",isa));
+      if (rtcGetDeviceProperty(device,RTC_DEVICE_PROPERTY_FILTER_FUNCTION_SUPPORTED))
+        groups.top()->add(new MultiHitTest("multi_hit",isa));
+      groups.top()->add(new RayTileTest("ray_tiles",isa));
+      groups.top()->add(new RayTreeletTest("ray_treelets",isa));
+      groups.top()->add(new FeatureMaskTest("feature_mask",isa));
+
       push(new TestGroup("disable_detach_geometry",true,true));
       for (auto sflags : sceneFlagsDynamic)
         groups.top()->add(new DisableAndDetachGeometryTest(to_string(sflags),isa,sflags));
@@ -5650,6 +7333,9 @@ namespace embree
       for (auto s : interpolateTests)
         groups.top()->add(new InterpolateSubdivTest(std::to_string((long long)(s)),isa,s));
       groups.pop();
+
+      groups.top()->add(new TessellationCacheTest("tessellation_cache",isa));
+      groups.top()->add(new AdaptiveTessellationTest("adaptive_tessellation",isa));
         
       push(new TestGroup("hair",true,true));
       for (auto s : interpolateTests) 
@@ -5868,6 +7554,7 @@ namespace embree
           groups.top()->add(new PointQueryTest(to_string(sflags),isa,sflags,"bvh8.triangle4i"));
           groups.top()->add(new PointQueryTest(to_string(sflags),isa,sflags,"qbvh8.triangle4"));
           groups.top()->add(new PointQueryTest(to_string(sflags),isa,sflags,"qbvh8.triangle4i"));
+          groups.top()->add(new PointQueryTest(to_string(sflags),isa,sflags,"cbvh8.triangle4i"));
         }
         groups.top()->add(new PointQueryTest(to_string(sflags),isa,sflags));
       }